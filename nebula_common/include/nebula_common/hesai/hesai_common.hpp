@@ -17,6 +17,7 @@
 
 #include "nebula_common/nebula_common.hpp"
 #include "nebula_common/nebula_status.hpp"
+#include "nebula_common/point_filter_configuration.hpp"
 #include "nebula_common/util/string_conversions.hpp"
 
 #include <algorithm>
@@ -49,6 +50,41 @@ struct HesaiSensorConfiguration : public LidarConfigurationBase
   uint8_t ptp_domain;
   PtpTransportType ptp_transport_type;
   PtpSwitchType ptp_switch_type;
+  /// @brief Compute azimuth sin/cos from compact per-block and per-channel tables instead of one
+  /// large table per (block, channel). Azimuth sin/cos values may differ from the large table's by
+  /// 1 ulp.
+  bool use_compact_trig_tables{false};
+  /// @brief Decode all return modes with the generic (runtime-dispatched) return group kernel
+  /// instead of the compile-time specialized ones. Only intended for A/B testing of the decoder.
+  bool use_generic_return_kernel{false};
+  /// @brief The number of pre-reserved point clouds the decoder recycles. Two are always used by
+  /// the decoder itself, each additional one allows a completed scan to be queued or published
+  /// while decoding continues.
+  uint16_t point_cloud_pool_size{4};
+  /// @brief The number of threads converting packets to points. With more than one, packets are
+  /// converted in parallel while scans are still cut and assembled in packet order.
+  uint16_t decoder_threads{1};
+  /// @brief Check the CRCs of incoming packets and drop corrupted ones. Only has an effect for
+  /// sensors whose packets carry CRCs (AT128, QT128, 128E3X/E4X).
+  bool validate_packet_crcs{false};
+  /// @brief If non-zero, output organized point clouds (range images) with one row per channel and
+  /// return of `return_mode`, and this many columns, each covering an equal share of the FoV.
+  /// Empty cells have NaN coordinates.
+  uint16_t organized_cloud_columns{0};
+  /// @brief If non-zero, additionally output the points of each scan in sectors of this many
+  /// degrees of azimuth as soon as each sector is complete, starting at the cut angle
+  uint16_t sector_angle{0};
+  /// @brief If non-zero, a scan that has not been completed this many milliseconds after it was
+  /// expected to (based on `rotation_speed`) is output as is and flagged as incomplete
+  uint16_t scan_deadline_ms{0};
+  /// @brief Crop box, vehicle mask and channel/return type filters applied while decoding
+  PointFilterConfiguration point_filter;
+  /// @brief Correct the points of each scan for the sensor's motion, based on twist/IMU input,
+  /// such that they are in the sensor frame at the scan timestamp
+  bool deskew{false};
+  /// @brief Receive packets from a UDP socket, or zero-copy from a memory-mapped packet capture
+  /// ring (needs CAP_NET_RAW)
+  ReceiveBackend receive_backend{ReceiveBackend::SOCKET};
 };
 /// @brief Convert HesaiSensorConfiguration to string (Overloading the << operator)
 /// @param os
@@ -71,7 +107,18 @@ inline std::ostream & operator<<(std::ostream & os, HesaiSensorConfiguration con
   os << "PTP Profile: " << arg.ptp_profile << '\n';
   os << "PTP Domain: " << std::to_string(arg.ptp_domain) << '\n';
   os << "PTP Transport Type: " << arg.ptp_transport_type << '\n';
-  os << "PTP Switch Type: " << arg.ptp_switch_type;
+  os << "PTP Switch Type: " << arg.ptp_switch_type << '\n';
+  os << "Compact Trig Tables: " << (arg.use_compact_trig_tables ? "yes" : "no") << '\n';
+  os << "Point Cloud Pool Size: " << arg.point_cloud_pool_size << '\n';
+  os << "Decoder Threads: " << arg.decoder_threads << '\n';
+  os << "Validate Packet CRCs: " << (arg.validate_packet_crcs ? "yes" : "no") << '\n';
+  os << "Organized Cloud Columns: " << arg.organized_cloud_columns << '\n';
+  os << "Sector Angle: " << arg.sector_angle << '\n';
+  os << "Scan Deadline: "
+     << (arg.scan_deadline_ms ? std::to_string(arg.scan_deadline_ms) + " ms" : "disabled") << '\n';
+  os << "Point Filter: " << arg.point_filter << '\n';
+  os << "Deskew: " << (arg.deskew ? "yes" : "no") << '\n';
+  os << "Receive Backend: " << arg.receive_backend;
   return os;
 }
 
@@ -400,6 +447,27 @@ struct HesaiCorrection : public HesaiCalibrationConfigurationBase
     return round((1 - k) * elevationOffset[ch * 180 + i] + k * elevationOffset[ch * 180 + i + 1]);
   }
 
+  /// @brief Get azimuth and elevation adjustments for the first `n_channels` channels at once.
+  /// This is equivalent to calling `get_azimuth_adjust_v3` and `get_elevation_adjust_v3` per
+  /// channel, but the interpolation weights are only computed once.
+  /// @param azi The precision azimuth in (0.01 / 256) degree unit
+  /// @param n_channels The number of channels
+  /// @param azimuth_adjusts Output: the azimuth adjustments in 0.01 degree unit
+  /// @param elevation_adjusts Output: the elevation adjustments in 0.01 degree unit
+  void get_angle_adjusts_v3(
+    uint32_t azi, size_t n_channels, int8_t * azimuth_adjusts, int8_t * elevation_adjusts) const
+  {
+    unsigned int i = std::floor(1.f * azi / g_step3);
+    unsigned int l = azi - i * g_step3;
+    float k = 1.f * l / g_step3;
+    for (size_t ch = 0; ch < n_channels; ++ch) {
+      azimuth_adjusts[ch] =
+        round((1 - k) * azimuthOffset[ch * 180 + i] + k * azimuthOffset[ch * 180 + i + 1]);
+      elevation_adjusts[ch] =
+        round((1 - k) * elevationOffset[ch * 180 + i] + k * elevationOffset[ch * 180 + i + 1]);
+    }
+  }
+
   [[nodiscard]] std::tuple<float, float> get_fov_padding() const override
   {
     // TODO(mojomex): calculate instead of hard-coding
@@ -362,6 +362,10 @@ enum class PtpTransportType { UDP_IP = 0, L2, UNKNOWN_TRANSPORT };
 
 enum class PtpSwitchType { NON_TSN = 0, TSN, UNKNOWN_SWITCH };
 
+/// @brief How sensor packets are received: from a UDP socket, or from a memory-mapped packet
+/// capture ring
+enum class ReceiveBackend { SOCKET = 0, PACKET_MMAP, UNKNOWN_BACKEND };
+
 /// @brief not used?
 struct PointField
 {
@@ -487,6 +491,11 @@ struct LidarConfigurationBase : EthernetSensorConfigurationBase
   bool remove_nans;  /// todo: consider changing to only_finite
   std::vector<PointField> fields;
   bool use_sensor_time{false};
+  /// @brief The frame points are output in. If empty, they are output in `frame_id`.
+  std::string output_frame{};
+  /// @brief The pose of `frame_id` in `output_frame` as [x, y, z, roll, pitch, yaw] in meters and
+  /// radians, applied to the points while decoding. Empty if points are output in `frame_id`.
+  std::vector<double> output_transform{};
 };
 
 /// @brief Convert SensorConfigurationBase to string (Overloading the << operator)
@@ -539,7 +548,15 @@ inline std::ostream & operator<<(
   os << "Return Mode: " << arg.return_mode << '\n';
   os << "Frequency: " << arg.frequency_ms << '\n';
   os << "MTU: " << arg.packet_mtu_size << '\n';
-  os << "Use Sensor Time: " << arg.use_sensor_time;
+  os << "Use Sensor Time: " << arg.use_sensor_time << '\n';
+  os << "Output Frame: " << (arg.output_frame.empty() ? arg.frame_id : arg.output_frame);
+  if (!arg.output_transform.empty()) {
+    os << " (";
+    for (size_t i = 0; i < arg.output_transform.size(); ++i) {
+      os << (i ? ", " : "") << arg.output_transform[i];
+    }
+    os << ')';
+  }
   return os;
 }
 
@@ -759,6 +776,41 @@ inline std::ostream & operator<<(std::ostream & os, nebula::drivers::PtpSwitchTy
   return os;
 }
 
+/// @brief Converts String to ReceiveBackend
+/// @param receive_backend Backend as String
+/// @return Corresponding ReceiveBackend
+inline ReceiveBackend receive_backend_from_string(const std::string & receive_backend)
+{
+  auto tmp_str = receive_backend;
+  std::transform(tmp_str.begin(), tmp_str.end(), tmp_str.begin(), [](unsigned char c) {
+    return std::tolower(c);
+  });
+  if (tmp_str == "socket") return ReceiveBackend::SOCKET;
+  if (tmp_str == "packet_mmap") return ReceiveBackend::PACKET_MMAP;
+
+  return ReceiveBackend::UNKNOWN_BACKEND;
+}
+
+/// @brief Convert ReceiveBackend enum to string (Overloading the << operator)
+/// @param os
+/// @param arg
+/// @return stream
+inline std::ostream & operator<<(std::ostream & os, nebula::drivers::ReceiveBackend const & arg)
+{
+  switch (arg) {
+    case ReceiveBackend::SOCKET:
+      os << "socket";
+      break;
+    case ReceiveBackend::PACKET_MMAP:
+      os << "packet_mmap";
+      break;
+    case ReceiveBackend::UNKNOWN_BACKEND:
+      os << "UNKNOWN";
+      break;
+  }
+  return os;
+}
+
 [[maybe_unused]] pcl::PointCloud<PointXYZIR>::Ptr convert_point_xyziradt_to_point_xyzir(
   const pcl::PointCloud<PointXYZIRADT>::ConstPtr & input_pointcloud);
 
@@ -0,0 +1,200 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "nebula_common/nebula_common.hpp"
+#include "nebula_common/util/expected.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace nebula::drivers
+{
+
+/// @brief Filters applied to points while decoding. Points rejected by any of them are never
+/// written to the output cloud. All coordinates are in the sensor frame.
+struct PointFilterConfiguration
+{
+  /// @brief Only keep points inside this box: [min_x, min_y, min_z, max_x, max_y, max_z] in
+  /// meters, optionally followed by the yaw of the box around its center in degrees. Empty to
+  /// disable.
+  std::vector<double> crop_box;
+  /// @brief Remove points whose x/y coordinates are inside this polygon (e.g. the footprint of the
+  /// ego vehicle): [x0, y0, x1, y1, ...] in meters. Empty to disable.
+  std::vector<double> mask_polygon;
+  /// @brief Remove all points of these channels
+  std::vector<uint32_t> excluded_channels;
+  /// @brief If non-empty, only keep points with one of these return types
+  std::vector<ReturnType> kept_return_types;
+
+  /// @brief Whether no filter is configured
+  [[nodiscard]] bool is_empty() const
+  {
+    return crop_box.empty() && mask_polygon.empty() && excluded_channels.empty() &&
+           kept_return_types.empty();
+  }
+};
+
+/// @brief Convert PointFilterConfiguration to string (Overloading the << operator)
+/// @param os
+/// @param arg
+/// @return stream
+inline std::ostream & operator<<(std::ostream & os, PointFilterConfiguration const & arg)
+{
+  auto print_list = [&os](const auto & list) {
+    os << '[';
+    for (size_t i = 0; i < list.size(); ++i) {
+      os << (i ? ", " : "") << list[i];
+    }
+    os << ']';
+  };
+
+  if (arg.is_empty()) {
+    return os << "none";
+  }
+
+  os << "crop box ";
+  print_list(arg.crop_box);
+  os << ", mask polygon ";
+  print_list(arg.mask_polygon);
+  os << ", excluded channels ";
+  print_list(arg.excluded_channels);
+  os << ", kept return types ";
+  print_list(arg.kept_return_types);
+  return os;
+}
+
+/// @brief Converts String to ReturnType, the inverse of `operator<<(ReturnType)`, ignoring case
+/// @param return_type Return type as String, e.g. "Strongest"
+/// @return Corresponding ReturnType, UNKNOWN if the name is not known
+inline ReturnType return_type_from_string(const std::string & return_type)
+{
+  auto tmp_str = return_type;
+  std::transform(tmp_str.begin(), tmp_str.end(), tmp_str.begin(), [](unsigned char c) {
+    return std::tolower(c);
+  });
+  if (tmp_str == "last") return ReturnType::LAST;
+  if (tmp_str == "first") return ReturnType::FIRST;
+  if (tmp_str == "strongest") return ReturnType::STRONGEST;
+  if (tmp_str == "firstweak") return ReturnType::FIRST_WEAK;
+  if (tmp_str == "lastweak") return ReturnType::LAST_WEAK;
+  if (tmp_str == "identical") return ReturnType::IDENTICAL;
+  if (tmp_str == "second") return ReturnType::SECOND;
+  if (tmp_str == "secondstrongest") return ReturnType::SECONDSTRONGEST;
+  if (tmp_str == "firststrongest") return ReturnType::FIRST_STRONGEST;
+  if (tmp_str == "laststrongest") return ReturnType::LAST_STRONGEST;
+
+  return ReturnType::UNKNOWN;
+}
+
+namespace point_filter_detail
+{
+
+/// @brief Split a list separated by commas and/or whitespace into its non-empty items
+inline std::vector<std::string> split_list(const std::string & list)
+{
+  std::vector<std::string> items;
+  std::string item;
+  for (char c : list + ",") {
+    if (c == ',' || std::isspace(static_cast<unsigned char>(c))) {
+      if (!item.empty()) items.push_back(item);
+      item.clear();
+    } else {
+      item += c;
+    }
+  }
+  return items;
+}
+
+/// @brief Parse a list of numbers, returning false if any item is not a finite number
+inline bool parse_numbers(const std::string & list, std::vector<double> & numbers)
+{
+  numbers.clear();
+  for (const auto & item : split_list(list)) {
+    char * end = nullptr;
+    double number = std::strtod(item.c_str(), &end);
+    if (end != item.c_str() + item.size() || !std::isfinite(number)) return false;
+    numbers.push_back(number);
+  }
+  return true;
+}
+
+}  // namespace point_filter_detail
+
+/// @brief Parse the point filters from their string representations (as used for ROS parameters),
+/// which are lists of numbers or names separated by commas and/or whitespace. Empty strings
+/// disable the respective filter.
+/// @param crop_box "min_x, min_y, min_z, max_x, max_y, max_z[, yaw_deg]"
+/// @param mask_polygon "x0, y0, x1, y1, x2, y2[, ...]", at least 3 vertices
+/// @param excluded_channels "channel0, channel1, ..."
+/// @param kept_return_types "ReturnType0, ReturnType1, ...", e.g. "Strongest, Last"
+/// @return The configuration, or an error message describing the first invalid filter
+inline util::expected<PointFilterConfiguration, std::string>
+point_filter_configuration_from_strings(
+  const std::string & crop_box, const std::string & mask_polygon,
+  const std::string & excluded_channels, const std::string & kept_return_types)
+{
+  namespace detail = point_filter_detail;
+  PointFilterConfiguration config;
+
+  if (!detail::parse_numbers(crop_box, config.crop_box)) {
+    return std::string("crop_box has to be a list of numbers");
+  }
+  const auto & box = config.crop_box;
+  if (!box.empty() && box.size() != 6 && box.size() != 7) {
+    return std::string(
+      "crop_box needs 6 values (min_x, min_y, min_z, max_x, max_y, max_z) and an optional yaw");
+  }
+  if (!box.empty() && (box[0] > box[3] || box[1] > box[4] || box[2] > box[5])) {
+    return std::string("crop_box minimum has to be smaller than its maximum");
+  }
+
+  if (!detail::parse_numbers(mask_polygon, config.mask_polygon)) {
+    return std::string("mask_polygon has to be a list of numbers");
+  }
+  if (!config.mask_polygon.empty() && (config.mask_polygon.size() % 2 != 0 ||
+                                       config.mask_polygon.size() < 6)) {
+    return std::string("mask_polygon needs x/y pairs of at least 3 vertices");
+  }
+
+  std::vector<double> channels;
+  if (!detail::parse_numbers(excluded_channels, channels)) {
+    return std::string("excluded_channels has to be a list of channel numbers");
+  }
+  for (double channel : channels) {
+    if (channel < 0 || channel != std::floor(channel)) {
+      return std::string("excluded_channels has to be a list of channel numbers");
+    }
+    config.excluded_channels.push_back(static_cast<uint32_t>(channel));
+  }
+
+  for (const auto & name : detail::split_list(kept_return_types)) {
+    ReturnType return_type = return_type_from_string(name);
+    if (return_type == ReturnType::UNKNOWN) {
+      return "Unknown return type in kept_return_types: " + name;
+    }
+    config.kept_return_types.push_back(return_type);
+  }
+
+  return config;
+}
+
+}  // namespace nebula::drivers
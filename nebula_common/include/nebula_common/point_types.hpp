@@ -18,6 +18,7 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <cstdint>
 #include <memory>
 
 namespace nebula::drivers
@@ -74,6 +75,23 @@ using NebulaPointPtr = std::shared_ptr<NebulaPoint>;
 using NebulaPointCloud = pcl::PointCloud<NebulaPoint>;
 using NebulaPointCloudPtr = pcl::PointCloud<NebulaPoint>::Ptr;
 
+/// @brief A set of `NebulaPoint` fields as a bit mask of the `point_field` flags, e.g. the fields
+/// that the consumers of a point cloud read
+using PointFieldMask = uint16_t;
+
+namespace point_field
+{
+constexpr PointFieldMask xyz = 1U << 0;
+constexpr PointFieldMask intensity = 1U << 1;
+constexpr PointFieldMask return_type = 1U << 2;
+constexpr PointFieldMask channel = 1U << 3;
+constexpr PointFieldMask azimuth = 1U << 4;
+constexpr PointFieldMask elevation = 1U << 5;
+constexpr PointFieldMask distance = 1U << 6;
+constexpr PointFieldMask time_stamp = 1U << 7;
+constexpr PointFieldMask all = (1U << 8) - 1;
+}  // namespace point_field
+
 }  // namespace nebula::drivers
 
 POINT_CLOUD_REGISTER_POINT_STRUCT(
@@ -38,6 +38,10 @@ struct RobosenseSensorConfiguration : LidarConfigurationBase
   uint16_t gnss_port{};  // difop
   double scan_phase{};   // start/end angle
   double dual_return_distance_threshold{};
+  /// @brief Compute azimuth sin/cos from compact per-block and per-channel tables instead of one
+  /// large table per (block, channel). Azimuth sin/cos values may differ from the large table's by
+  /// 1 ulp.
+  bool use_compact_trig_tables{false};
 };
 
 /// @brief Convert RobosenseSensorConfiguration to string (Overloading the << operator)
@@ -49,7 +53,8 @@ inline std::ostream & operator<<(std::ostream & os, RobosenseSensorConfiguration
   os << "Robosense Sensor Configuration:" << '\n';
   os << (LidarConfigurationBase)(arg) << '\n';
   os << "GNSS Port: " << arg.gnss_port << '\n';
-  os << "Scan Phase: " << arg.scan_phase;
+  os << "Scan Phase: " << arg.scan_phase << '\n';
+  os << "Compact Trig Tables: " << (arg.use_compact_trig_tables ? "yes" : "no");
   return os;
 }
 
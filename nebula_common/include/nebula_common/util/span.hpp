@@ -0,0 +1,104 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace nebula
+{
+namespace util
+{
+
+/// @brief A poor man's backport of C++20's std::span with dynamic extent.
+///
+/// A non-owning view of a contiguous sequence of elements. The viewed memory has to outlive the
+/// span.
+///
+/// More info here: https://en.cppreference.com/w/cpp/container/span
+///
+/// @tparam T Element type, `const`-qualified for read-only views
+template <typename T>
+class span
+{
+public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using pointer = T *;
+  using reference = T &;
+  using iterator = T *;
+
+  constexpr span() noexcept = default;
+
+  constexpr span(pointer data, size_type size) noexcept : data_(data), size_(size) {}
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  span(std::vector<U> & vector) noexcept  // NOLINT(google-explicit-constructor)
+  : data_(vector.data()), size_(vector.size())
+  {
+  }
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+  span(const std::vector<U> & vector) noexcept  // NOLINT(google-explicit-constructor)
+  : data_(vector.data()), size_(vector.size())
+  {
+  }
+
+  template <
+    typename U, std::size_t N,
+    typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+  constexpr span(const std::array<U, N> & array) noexcept  // NOLINT(google-explicit-constructor)
+  : data_(array.data()), size_(N)
+  {
+  }
+
+  /// @brief Allow `span<T>` to be converted to `span<const T>`
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr span(const span<U> & other) noexcept  // NOLINT(google-explicit-constructor)
+  : data_(other.data()), size_(other.size())
+  {
+  }
+
+  [[nodiscard]] constexpr pointer data() const noexcept { return data_; }
+  [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+  [[nodiscard]] constexpr size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+  constexpr reference operator[](size_type idx) const { return data_[idx]; }
+
+  /// @brief A view of `count` elements starting at `offset`. Throws `std::out_of_range` if that
+  /// range is not within this span.
+  [[nodiscard]] span subspan(size_type offset, size_type count) const
+  {
+    if (offset > size_ || count > size_ - offset) {
+      throw std::out_of_range("subspan out of range");
+    }
+    return {data_ + offset, count};
+  }
+
+private:
+  pointer data_ = nullptr;
+  size_type size_ = 0;
+};
+
+}  // namespace util
+}  // namespace nebula
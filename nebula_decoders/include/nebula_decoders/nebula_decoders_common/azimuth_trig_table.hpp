@@ -0,0 +1,174 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nebula_common/nebula_common.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nebula::drivers
+{
+
+/// @brief Sine and cosine of an angle
+struct SinCos
+{
+  float sin;
+  float cos;
+};
+
+/// @brief Sine/cosine lookup for the corrected azimuth of a channel, i.e. the block azimuth plus
+/// the channel's azimuth offset, as used by calibration-based angle correctors.
+///
+/// Two storage modes are supported:
+/// - Full: one precomputed entry per (block azimuth, channel), computed with `sinf`/`cosf` of the
+///   float angle. Fastest lookups but large
+///   (`360 * AngleUnit * ChannelN * 8 B`, e.g. 36.9 MB for 128 channels at 0.01 deg).
+/// - Compact: sin/cos per block azimuth and per channel offset, combined via angle addition on
+///   lookup (`360 * AngleUnit * 20 B + ChannelN * 20 B`, e.g. 720 kB at 0.01 deg).
+///
+/// The two modes are not bit-identical. Compact mode evaluates the sin/cos of the same float angle
+/// in double precision (see `evaluate`) and only rounds to float at the end, so its values are
+/// correctly rounded (barring rare double rounding) and do not depend on the platform's math
+/// library. `sinf`/`cosf` are not correctly rounded for all inputs (glibc's are off for roughly
+/// 0.1 % of angles), so the modes can differ by 1 ulp.
+///
+/// @tparam ChannelN The number of channels
+/// @tparam AngleUnit The number of raw azimuth steps per degree
+template <size_t ChannelN, size_t AngleUnit>
+class AzimuthTrigTable
+{
+public:
+  static constexpr size_t max_azimuth = 360 * AngleUnit;
+
+  /// @param azimuth_offset_rad The azimuth offset of each channel in radians
+  /// @param compact Whether to use compact tables instead of full ones
+  AzimuthTrigTable(const std::array<float, ChannelN> & azimuth_offset_rad, bool compact)
+  : azimuth_offset_rad_(azimuth_offset_rad), compact_(compact), block_azimuth_rad_(max_azimuth)
+  {
+    for (size_t channel_id = 0; channel_id < ChannelN; ++channel_id) {
+      offset_sin_[channel_id] = std::sin(static_cast<double>(azimuth_offset_rad_[channel_id]));
+      offset_cos_[channel_id] = std::cos(static_cast<double>(azimuth_offset_rad_[channel_id]));
+    }
+
+    if (compact_) {
+      block_sin_.resize(max_azimuth);
+      block_cos_.resize(max_azimuth);
+    } else {
+      full_.resize(max_azimuth * ChannelN);
+    }
+
+    for (size_t block_azimuth = 0; block_azimuth < max_azimuth; ++block_azimuth) {
+      float block_azimuth_rad = deg2rad(block_azimuth / static_cast<double>(AngleUnit));
+      block_azimuth_rad_[block_azimuth] = block_azimuth_rad;
+
+      if (compact_) {
+        block_sin_[block_azimuth] = std::sin(static_cast<double>(block_azimuth_rad));
+        block_cos_[block_azimuth] = std::cos(static_cast<double>(block_azimuth_rad));
+        continue;
+      }
+
+      for (size_t channel_id = 0; channel_id < ChannelN; ++channel_id) {
+        float precision_azimuth = block_azimuth_rad + azimuth_offset_rad_[channel_id];
+        full_[block_azimuth * ChannelN + channel_id] = {
+          sinf(precision_azimuth), cosf(precision_azimuth)};
+      }
+    }
+  }
+
+  /// @brief The block azimuth in radians, rounded to float
+  [[nodiscard]] float get_block_azimuth_rad(uint32_t block_azimuth) const
+  {
+    return block_azimuth_rad_[block_azimuth];
+  }
+
+  /// @brief The channel's azimuth offset in radians
+  [[nodiscard]] float get_azimuth_offset_rad(uint32_t channel_id) const
+  {
+    return azimuth_offset_rad_[channel_id];
+  }
+
+  /// @brief Sine and cosine of the float angle
+  /// `get_block_azimuth_rad(block_azimuth) + get_azimuth_offset_rad(channel_id)`
+  [[nodiscard]] SinCos get_sin_cos(uint32_t block_azimuth, uint32_t channel_id) const
+  {
+    if (!compact_) {
+      return full_[block_azimuth * ChannelN + channel_id];
+    }
+
+    return evaluate(
+      block_azimuth_rad_[block_azimuth], azimuth_offset_rad_[channel_id], block_sin_[block_azimuth],
+      block_cos_[block_azimuth], offset_sin_[channel_id], offset_cos_[channel_id]);
+  }
+
+  /// @brief Whether the compact tables are used
+  [[nodiscard]] bool is_compact() const { return compact_; }
+
+  /// @brief The memory occupied by the lookup tables in bytes
+  [[nodiscard]] size_t get_memory_usage_bytes() const
+  {
+    return sizeof(*this) + block_azimuth_rad_.capacity() * sizeof(float) +
+           (block_sin_.capacity() + block_cos_.capacity()) * sizeof(double) +
+           full_.capacity() * sizeof(SinCos);
+  }
+
+  /// @brief Computes sin/cos of the float angle `fl(block_rad + offset_rad)` from the sin/cos of
+  /// its two summands. The difference between the float sum and the exact sum is accounted for
+  /// with a second-order correction, so that the result is accurate to double precision before
+  /// being rounded to float.
+  static SinCos evaluate(
+    float block_rad, float offset_rad, double block_sin, double block_cos, double offset_sin,
+    double offset_cos)
+  {
+    const float angle_rad = block_rad + offset_rad;
+
+    // Both subtractions are exact since all operands are floats
+    const double rounding_error =
+      (static_cast<double>(angle_rad) - static_cast<double>(block_rad)) -
+      static_cast<double>(offset_rad);
+
+    const double sum_sin = block_sin * offset_cos + block_cos * offset_sin;
+    const double sum_cos = block_cos * offset_cos - block_sin * offset_sin;
+
+    // |rounding_error| <= 2.4e-7, so higher order terms are below double precision
+    const double error_cos = 1. - 0.5 * rounding_error * rounding_error;
+    const double error_sin = rounding_error;
+
+    return {
+      static_cast<float>(sum_sin * error_cos + sum_cos * error_sin),
+      static_cast<float>(sum_cos * error_cos - sum_sin * error_sin)};
+  }
+
+private:
+  std::array<float, ChannelN> azimuth_offset_rad_;
+  std::array<double, ChannelN> offset_sin_{};
+  std::array<double, ChannelN> offset_cos_{};
+
+  bool compact_;
+
+  std::vector<float> block_azimuth_rad_;
+
+  /// @brief Compact mode only: sin/cos of each block azimuth
+  std::vector<double> block_sin_;
+  std::vector<double> block_cos_;
+
+  /// @brief Full mode only: sin/cos for each (block azimuth, channel), row-major
+  std::vector<SinCos> full_;
+};
+
+}  // namespace nebula::drivers
@@ -0,0 +1,99 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace nebula::drivers::crc32
+{
+
+/// @brief The CRC-32/MPEG-2 parameters: polynomial 0x04C11DB7, initial value 0xFFFFFFFF, no input
+/// or output reflection and no final XOR. This is the variant used by e.g. Hesai sensors.
+inline constexpr uint32_t mpeg2_polynomial = 0x04C11DB7;
+inline constexpr uint32_t mpeg2_initial_value = 0xFFFFFFFF;
+
+/// @brief Slice-by-8 lookup tables, indexed by [slice][byte]. Slice 0 is the classic byte-wise
+/// table, slice k advances a byte by k further zero bytes.
+using slice_tables_t = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr slice_tables_t make_slice_tables(uint32_t polynomial)
+{
+  slice_tables_t tables{};
+  for (uint32_t byte = 0; byte < 256; ++byte) {
+    uint32_t crc = byte << 24;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x80000000U) ? (crc << 1) ^ polynomial : crc << 1;
+    }
+    tables[0][byte] = crc;
+  }
+
+  for (size_t slice = 1; slice < tables.size(); ++slice) {
+    for (uint32_t byte = 0; byte < 256; ++byte) {
+      uint32_t prev = tables[slice - 1][byte];
+      tables[slice][byte] = (prev << 8) ^ tables[0][prev >> 24];
+    }
+  }
+
+  return tables;
+}
+
+inline constexpr slice_tables_t mpeg2_tables = make_slice_tables(mpeg2_polynomial);
+
+/// @brief Continue a CRC-32/MPEG-2 computation over the given bytes, one byte at a time. Serves as
+/// the reference for @ref mpeg2.
+constexpr uint32_t mpeg2_bytewise(const uint8_t * data, size_t size, uint32_t crc)
+{
+  for (size_t i = 0; i < size; ++i) {
+    crc = (crc << 8) ^ mpeg2_tables[0][(crc >> 24) ^ data[i]];
+  }
+  return crc;
+}
+
+/// @brief Continue a CRC-32/MPEG-2 computation over the given bytes, eight bytes at a time. This
+/// is the portable fallback of @ref mpeg2.
+inline uint32_t mpeg2_slice_by_8(const uint8_t * data, size_t size, uint32_t crc)
+{
+  const auto & t = mpeg2_tables;
+
+  for (; size >= 8; data += 8, size -= 8) {
+    uint32_t hi = crc ^ (static_cast<uint32_t>(data[0]) << 24 |
+                         static_cast<uint32_t>(data[1]) << 16 |
+                         static_cast<uint32_t>(data[2]) << 8 | static_cast<uint32_t>(data[3]));
+    uint32_t lo = static_cast<uint32_t>(data[4]) << 24 | static_cast<uint32_t>(data[5]) << 16 |
+                  static_cast<uint32_t>(data[6]) << 8 | static_cast<uint32_t>(data[7]);
+    crc = t[7][hi >> 24] ^ t[6][(hi >> 16) & 0xFF] ^ t[5][(hi >> 8) & 0xFF] ^ t[4][hi & 0xFF] ^
+          t[3][lo >> 24] ^ t[2][(lo >> 16) & 0xFF] ^ t[1][(lo >> 8) & 0xFF] ^ t[0][lo & 0xFF];
+  }
+
+  return mpeg2_bytewise(data, size, crc);
+}
+
+/// @brief Compute the CRC-32/MPEG-2 of the given bytes.
+///
+/// Uses carry-less multiplication (PCLMULQDQ) if the CPU supports it (detected at runtime) and
+/// @ref mpeg2_slice_by_8 otherwise. SSE4.2's `crc32` instruction implements the (reflected)
+/// Castagnoli polynomial and is thus of no use here.
+/// @param data The bytes to checksum
+/// @param size The number of bytes
+/// @param crc The CRC of any preceding bytes, to compute the CRC of discontiguous data
+/// @return The CRC
+uint32_t mpeg2(const uint8_t * data, size_t size, uint32_t crc = mpeg2_initial_value);
+
+/// @brief Whether @ref mpeg2 uses the PCLMULQDQ implementation on this CPU
+bool is_mpeg2_accelerated();
+
+}  // namespace nebula::drivers::crc32
@@ -0,0 +1,172 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nebula_common/point_types.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace nebula::drivers
+{
+
+/// @brief The cell layout of an organized point cloud (range image) with one row per channel and
+/// return, and one column per azimuth bin.
+///
+/// The rows of each return are a contiguous block: row `return_idx * n_channels + channel` holds
+/// the points of the given return (the index within the return group) of the given channel. In
+/// single return mode, there is only one block and the rows are the channels.
+///
+/// The columns split the field of view into bins of equal width, starting at the FoV start. Each
+/// cell holds at most one point: the first one decoded into it. Cells without a point hold a point
+/// whose coordinates and distance are NaN, see `is_empty()`.
+///
+/// Since the clouds are written in place, decoders can write points to their cells directly while
+/// decoding instead of reprojecting the finished cloud.
+class OrganizedCloudLayout
+{
+public:
+  /// @brief Constructor
+  /// @param n_channels The number of channels of the sensor
+  /// @param n_returns The number of returns per return group
+  /// @param n_columns The number of azimuth bins
+  /// @param fov_min_rad The start of the field of view in radians
+  /// @param fov_max_rad The end of the field of view in radians. If equal to `fov_min_rad` (modulo
+  /// 2 pi), the FoV is 360 deg.
+  OrganizedCloudLayout(
+    uint32_t n_channels, uint32_t n_returns, uint32_t n_columns, float fov_min_rad,
+    float fov_max_rad)
+  : n_channels_(n_channels),
+    n_returns_(n_returns),
+    n_columns_(n_columns),
+    fov_min_rad_(normalize(fov_min_rad))
+  {
+    float fov_width_rad = normalize(fov_max_rad - fov_min_rad);
+    if (fov_width_rad == 0) {
+      fov_width_rad = two_pi;
+    }
+    fov_width_rad_ = fov_width_rad;
+    columns_per_rad_ = static_cast<float>(n_columns_) / fov_width_rad;
+  }
+
+  [[nodiscard]] uint32_t get_n_channels() const { return n_channels_; }
+  [[nodiscard]] uint32_t get_n_returns() const { return n_returns_; }
+  [[nodiscard]] uint32_t get_n_rows() const { return n_channels_ * n_returns_; }
+  [[nodiscard]] uint32_t get_n_columns() const { return n_columns_; }
+
+  /// @brief Clear the given cloud and fill it with empty cells in the dimensions of this layout
+  void reset(NebulaPointCloud & cloud) const
+  {
+    cloud.points.assign(static_cast<size_t>(get_n_rows()) * n_columns_, get_empty_point());
+    cloud.width = n_columns_;
+    cloud.height = get_n_rows();
+    cloud.is_dense = false;
+  }
+
+  /// @brief Get the column of the given azimuth. Azimuths outside the FoV are clamped to the
+  /// closer edge of the FoV.
+  /// @param azimuth_rad The azimuth in radians, in [0, 2 pi)
+  [[nodiscard]] uint32_t get_column(float azimuth_rad) const
+  {
+    float offset_rad = azimuth_rad - fov_min_rad_;
+    if (offset_rad < 0) {
+      offset_rad += two_pi;
+    }
+
+    if (offset_rad >= fov_width_rad_) {
+      // Outside the FoV: before its start if closer to it than to its end
+      bool is_before_start = offset_rad - fov_width_rad_ > (two_pi - fov_width_rad_) / 2;
+      return is_before_start ? 0 : n_columns_ - 1;
+    }
+
+    auto column = static_cast<uint32_t>(offset_rad * columns_per_rad_);
+    return column < n_columns_ ? column : n_columns_ - 1;
+  }
+
+  /// @brief Get the row of the given channel and return
+  [[nodiscard]] uint32_t get_row(uint32_t channel, uint32_t return_idx) const
+  {
+    return return_idx * n_channels_ + channel;
+  }
+
+  /// @brief Get the cell of the given channel, return and azimuth if it is still empty
+  /// @param cloud A cloud that has been `reset()` by this layout
+  /// @param channel The channel of the point
+  /// @param return_idx The index of the point's return within its return group
+  /// @param azimuth_rad The azimuth of the point in radians, in [0, 2 pi)
+  /// @return The cell to write the point to, or nullptr if the cell is taken or the channel or
+  /// return is out of range
+  NebulaPoint * get_empty_cell(
+    NebulaPointCloud & cloud, uint32_t channel, uint32_t return_idx, float azimuth_rad) const
+  {
+    if (channel >= n_channels_ || return_idx >= n_returns_) {
+      return nullptr;
+    }
+
+    const size_t row = get_row(channel, return_idx);
+    NebulaPoint & cell = cloud.points[row * n_columns_ + get_column(azimuth_rad)];
+    return is_empty(cell) ? &cell : nullptr;
+  }
+
+  /// @brief Write the given point to its cell, unless that is taken already
+  /// @param return_idx The index of the point's return within its return group
+  /// @return Whether the point was written
+  bool insert(NebulaPointCloud & cloud, const NebulaPoint & point, uint32_t return_idx = 0) const
+  {
+    NebulaPoint * cell = get_empty_cell(cloud, point.channel, return_idx, point.azimuth);
+    if (!cell) {
+      return false;
+    }
+
+    *cell = point;
+    return true;
+  }
+
+  /// @brief The point empty cells are filled with: NaN coordinates and distance, all other fields
+  /// zero
+  static NebulaPoint get_empty_point()
+  {
+    constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+    NebulaPoint point{};
+    point.x = nan;
+    point.y = nan;
+    point.z = nan;
+    point.distance = nan;
+    return point;
+  }
+
+  /// @brief Whether the given cell of an organized cloud is empty
+  static bool is_empty(const NebulaPoint & point) { return std::isnan(point.x); }
+
+private:
+  static constexpr float two_pi = 2 * static_cast<float>(M_PI);
+
+  static float normalize(float angle_rad)
+  {
+    angle_rad = std::fmod(angle_rad, two_pi);
+    return angle_rad < 0 ? angle_rad + two_pi : angle_rad;
+  }
+
+  uint32_t n_channels_;
+  uint32_t n_returns_;
+  uint32_t n_columns_;
+  float fov_min_rad_;
+  float fov_width_rad_;
+  float columns_per_rad_;
+};
+
+}  // namespace nebula::drivers
@@ -0,0 +1,113 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace nebula::drivers
+{
+
+/// @brief Loss, reordering and duplication of packets, as seen from their sequence numbers
+struct PacketSequenceStats
+{
+  /// @brief The number of packets that carried a sequence number
+  uint64_t n_packets{0};
+  /// @brief The number of sequence numbers skipped. A packet that arrives late is counted here
+  /// when the gap is first seen, and in `n_reordered` once it arrives.
+  uint64_t n_lost{0};
+  /// @brief The number of packets that arrived after a packet with a higher sequence number
+  uint64_t n_reordered{0};
+  /// @brief The number of packets whose sequence number had already been received
+  uint64_t n_duplicates{0};
+  /// @brief The number of times the sequence jumped so far that it is assumed to have restarted
+  /// (e.g. because the sensor rebooted), instead of counting the jump as loss
+  uint64_t n_resets{0};
+
+  PacketSequenceStats & operator+=(const PacketSequenceStats & other)
+  {
+    n_packets += other.n_packets;
+    n_lost += other.n_lost;
+    n_reordered += other.n_reordered;
+    n_duplicates += other.n_duplicates;
+    n_resets += other.n_resets;
+    return *this;
+  }
+};
+
+/// @brief Detects gaps, reordering and duplicates in a stream of 32-bit sequence numbers that
+/// increase by one per packet and wrap around.
+///
+/// The most recent `window_size` sequence numbers are remembered, so that late packets can be
+/// told apart from duplicates. Packets arriving later than that are counted as reordered.
+class PacketSequenceTracker
+{
+public:
+  /// @brief The number of sequence numbers behind the latest one that are remembered
+  static constexpr uint32_t window_size = 64;
+  /// @brief Jumps by at least this many sequence numbers (forwards or backwards) restart tracking
+  /// instead of being counted as loss. At 10 kpps, this corresponds to a gap of 6.5 seconds.
+  static constexpr uint32_t max_jump = 1U << 16;
+
+  /// @brief Account for a received packet
+  /// @param sequence The packet's sequence number
+  /// @param stats The statistics to update
+  void update(uint32_t sequence, PacketSequenceStats & stats)
+  {
+    ++stats.n_packets;
+
+    if (!has_received_) {
+      restart(sequence);
+      return;
+    }
+
+    // Distance from the expected sequence number, modulo 2^32
+    const uint32_t ahead = sequence - next_expected_;
+    const uint32_t behind = next_expected_ - sequence;
+
+    if (ahead < max_jump) {
+      stats.n_lost += ahead;
+      received_mask_ = ahead + 1 < window_size ? (received_mask_ << (ahead + 1)) | 1U : 1U;
+      next_expected_ = sequence + 1;
+    } else if (behind <= window_size) {
+      const uint64_t bit = uint64_t{1} << (behind - 1);
+      if (received_mask_ & bit) {
+        ++stats.n_duplicates;
+      } else {
+        ++stats.n_reordered;
+        received_mask_ |= bit;
+      }
+    } else if (behind < max_jump) {
+      ++stats.n_reordered;
+    } else {
+      ++stats.n_resets;
+      restart(sequence);
+    }
+  }
+
+private:
+  void restart(uint32_t sequence)
+  {
+    has_received_ = true;
+    next_expected_ = sequence + 1;
+    received_mask_ = 1U;
+  }
+
+  bool has_received_{false};
+  uint32_t next_expected_{0};
+  /// @brief Bit i is set if sequence number `next_expected_ - 1 - i` has been received
+  uint64_t received_mask_{0};
+};
+
+}  // namespace nebula::drivers
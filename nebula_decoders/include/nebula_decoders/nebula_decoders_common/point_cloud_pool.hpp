@@ -0,0 +1,93 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nebula_common/point_types.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace nebula::drivers
+{
+
+/// @brief A fixed set of pre-reserved point clouds that are recycled once nobody uses them anymore.
+///
+/// Decoders acquire an empty cloud to decode a scan into and hand the finished cloud out as a
+/// shared pointer. As soon as all consumers (e.g. a publishing thread) have dropped their
+/// references, the cloud can be acquired again, so no point memory is allocated in steady state.
+///
+/// Only the thread owning the pool may call `acquire()`. Consumers may release their references
+/// from any thread.
+class PointCloudPool
+{
+public:
+  /// @brief Constructor
+  /// @param pool_size The number of clouds to pre-allocate. A decoder holds two clouds at any time
+  /// (the one being decoded and the last completed one), so at least 2 are allocated. Every
+  /// additional cloud allows one more completed scan to be in use by consumers.
+  /// @param reserved_points The number of points to reserve for each cloud
+  PointCloudPool(size_t pool_size, size_t reserved_points) : reserved_points_(reserved_points)
+  {
+    pool_.resize(std::max<size_t>(pool_size, 2));
+    for (auto & cloud : pool_) {
+      cloud = make_cloud();
+    }
+  }
+
+  /// @brief Get an empty cloud that is not referenced anywhere else. If all pooled clouds are still
+  /// in use, a new cloud outside of the pool is allocated and `get_n_misses()` is incremented.
+  NebulaPointCloudPtr acquire()
+  {
+    for (size_t i = 0; i < pool_.size(); ++i) {
+      auto & cloud = pool_[next_idx_];
+      next_idx_ = (next_idx_ + 1) % pool_.size();
+
+      if (cloud.use_count() != 1) continue;
+
+      // Synchronize with the reference count decrement of the consumer that released the cloud
+      // last, so that its reads of the cloud happen before the cloud is overwritten
+      std::atomic_thread_fence(std::memory_order_acquire);
+      cloud->clear();
+      return cloud;
+    }
+
+    ++n_misses_;
+    return make_cloud();
+  }
+
+  /// @brief The number of pooled clouds
+  [[nodiscard]] size_t size() const { return pool_.size(); }
+
+  /// @brief The number of times `acquire()` had to allocate a cloud because the pool was exhausted
+  [[nodiscard]] size_t get_n_misses() const { return n_misses_; }
+
+private:
+  [[nodiscard]] NebulaPointCloudPtr make_cloud() const
+  {
+    auto cloud = std::make_shared<NebulaPointCloud>();
+    cloud->reserve(reserved_points_);
+    return cloud;
+  }
+
+  size_t reserved_points_;
+  std::vector<NebulaPointCloudPtr> pool_;
+  size_t next_idx_{0};
+  size_t n_misses_{0};
+};
+
+}  // namespace nebula::drivers
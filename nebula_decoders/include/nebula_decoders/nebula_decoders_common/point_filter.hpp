@@ -0,0 +1,142 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nebula_common/nebula_common.hpp>
+#include <nebula_common/point_filter_configuration.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nebula::drivers
+{
+
+/// @brief Evaluates a `PointFilterConfiguration` on single points, precomputing everything that
+/// does not depend on the point.
+///
+/// The checks are split so that decoders can reject points as early as possible: by channel and
+/// return type before computing coordinates, and by position right after.
+class PointFilter
+{
+public:
+  /// @brief Constructor
+  /// @param config The filters to apply
+  /// @param n_channels The number of channels of the sensor. Excluded channels outside of
+  /// [0, n_channels) are ignored.
+  PointFilter(const PointFilterConfiguration & config, size_t n_channels)
+  : channel_enabled_(n_channels, true)
+  {
+    for (uint32_t channel : config.excluded_channels) {
+      if (channel < n_channels) channel_enabled_[channel] = false;
+    }
+
+    if (config.kept_return_types.empty()) {
+      kept_return_types_ = ~0U;
+    } else {
+      for (ReturnType return_type : config.kept_return_types) {
+        kept_return_types_ |= 1U << static_cast<uint8_t>(return_type);
+      }
+      // Identical returns are both the first/last/strongest etc. return, so they match any type
+      kept_return_types_ |= 1U << static_cast<uint8_t>(ReturnType::IDENTICAL);
+    }
+
+    const auto & box = config.crop_box;
+    if (!box.empty()) {
+      has_crop_box_ = true;
+      box_center_x_ = static_cast<float>((box[0] + box[3]) / 2);
+      box_center_y_ = static_cast<float>((box[1] + box[4]) / 2);
+      box_min_z_ = static_cast<float>(box[2]);
+      box_max_z_ = static_cast<float>(box[5]);
+      box_half_length_ = static_cast<float>((box[3] - box[0]) / 2);
+      box_half_width_ = static_cast<float>((box[4] - box[1]) / 2);
+      double yaw_rad = box.size() > 6 ? box[6] * M_PI / 180. : 0.;
+      box_cos_yaw_ = static_cast<float>(std::cos(yaw_rad));
+      box_sin_yaw_ = static_cast<float>(std::sin(yaw_rad));
+    }
+
+    for (size_t i = 0; i + 1 < config.mask_polygon.size(); i += 2) {
+      polygon_x_.push_back(static_cast<float>(config.mask_polygon[i]));
+      polygon_y_.push_back(static_cast<float>(config.mask_polygon[i + 1]));
+    }
+  }
+
+  /// @brief Whether points of the given channel and return type can pass the filter
+  [[nodiscard]] bool accepts_attributes(uint32_t channel, ReturnType return_type) const
+  {
+    if (channel < channel_enabled_.size() && !channel_enabled_[channel]) return false;
+    return (kept_return_types_ >> static_cast<uint8_t>(return_type)) & 1U;
+  }
+
+  /// @brief Whether a point at the given position in the sensor frame passes the filter
+  [[nodiscard]] bool accepts_position(float x, float y, float z) const
+  {
+    if (has_crop_box_ && !is_inside_crop_box(x, y, z)) return false;
+    if (!polygon_x_.empty() && is_inside_mask_polygon(x, y)) return false;
+    return true;
+  }
+
+private:
+  /// @brief Whether the point is inside the (possibly rotated) crop box, boundaries included
+  [[nodiscard]] bool is_inside_crop_box(float x, float y, float z) const
+  {
+    if (z < box_min_z_ || z > box_max_z_) return false;
+
+    // Rotate the point into the frame of the box
+    float dx = x - box_center_x_;
+    float dy = y - box_center_y_;
+    float box_x = box_cos_yaw_ * dx + box_sin_yaw_ * dy;
+    float box_y = -box_sin_yaw_ * dx + box_cos_yaw_ * dy;
+    return std::abs(box_x) <= box_half_length_ && std::abs(box_y) <= box_half_width_;
+  }
+
+  /// @brief Even-odd rule point-in-polygon test, by counting the polygon edges crossed by a ray
+  /// from the point in +x direction
+  [[nodiscard]] bool is_inside_mask_polygon(float x, float y) const
+  {
+    bool inside = false;
+    const size_t n_vertices = polygon_x_.size();
+    for (size_t i = 0, j = n_vertices - 1; i < n_vertices; j = i++) {
+      const float xi = polygon_x_[i];
+      const float yi = polygon_y_[i];
+      const float xj = polygon_x_[j];
+      const float yj = polygon_y_[j];
+      if ((yi > y) != (yj > y) && x < (xj - xi) * (y - yi) / (yj - yi) + xi) {
+        inside = !inside;
+      }
+    }
+    return inside;
+  }
+
+  std::vector<bool> channel_enabled_;
+  /// @brief Bit `i` is set if return type `i` is kept
+  uint32_t kept_return_types_{0};
+
+  bool has_crop_box_{false};
+  float box_center_x_{0};
+  float box_center_y_{0};
+  float box_min_z_{0};
+  float box_max_z_{0};
+  float box_half_length_{0};
+  float box_half_width_{0};
+  float box_cos_yaw_{1};
+  float box_sin_yaw_{0};
+
+  std::vector<float> polygon_x_;
+  std::vector<float> polygon_y_;
+};
+
+}  // namespace nebula::drivers
@@ -0,0 +1,180 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "nebula_common/nebula_common.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace nebula::drivers
+{
+
+/// @brief The velocity of the sensor, expressed in the sensor frame
+struct SensorTwist
+{
+  /// @brief Linear velocity (x, y, z) in m/s
+  std::array<double, 3> linear{};
+  /// @brief Angular velocity around (x, y, z) in rad/s
+  std::array<double, 3> angular{};
+};
+
+/// @brief A rotation followed by a translation, applied to single points in float precision
+struct RigidTransform
+{
+  /// @brief Row-major rotation matrix
+  std::array<float, 9> rotation{1, 0, 0, 0, 1, 0, 0, 0, 1};
+  std::array<float, 3> translation{};
+
+  /// @brief Transform the given point in place
+  void apply(float & x, float & y, float & z) const
+  {
+    const auto & r = rotation;
+    const float x_in = x;
+    const float y_in = y;
+    const float z_in = z;
+    x = r[0] * x_in + r[1] * y_in + r[2] * z_in + translation[0];
+    y = r[3] * x_in + r[4] * y_in + r[5] * z_in + translation[1];
+    z = r[6] * x_in + r[7] * y_in + r[8] * z_in + translation[2];
+  }
+
+  /// @brief The inverse transform
+  [[nodiscard]] RigidTransform inverse() const
+  {
+    RigidTransform result;
+    const auto & r = rotation;
+    result.rotation = {r[0], r[3], r[6], r[1], r[4], r[7], r[2], r[5], r[8]};
+    for (size_t row = 0; row < 3; ++row) {
+      result.translation[row] = -(result.rotation[row * 3] * translation[0] +
+                                  result.rotation[row * 3 + 1] * translation[1] +
+                                  result.rotation[row * 3 + 2] * translation[2]);
+    }
+    return result;
+  }
+
+  /// @brief The transform from a child frame to its parent, given the pose of the child
+  /// @param x, y, z The position of the child in the parent frame in meters
+  /// @param roll, pitch, yaw The orientation of the child in radians, as rotations around the fixed
+  /// x, y and z axes, in that order (the ROS convention)
+  static RigidTransform from_pose(
+    double x, double y, double z, double roll, double pitch, double yaw)
+  {
+    const double cr = std::cos(roll);
+    const double sr = std::sin(roll);
+    const double cp = std::cos(pitch);
+    const double sp = std::sin(pitch);
+    const double cy = std::cos(yaw);
+    const double sy = std::sin(yaw);
+
+    // R = Rz(yaw) Ry(pitch) Rx(roll)
+    const std::array<double, 9> r{cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr,
+                                  sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr,
+                                  -sp,     cp * sr,                cp * cr};
+
+    RigidTransform result;
+    for (size_t i = 0; i < 9; ++i) {
+      result.rotation[i] = static_cast<float>(r[i]);
+    }
+    result.translation = {static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)};
+    return result;
+  }
+
+  /// @brief The motion of a sensor moving with a constant twist for the given time: the pose of the
+  /// sensor after `dt_s` seconds in the sensor frame at time 0. Applied to a point measured at
+  /// `dt_s`, it yields that point in the sensor frame at time 0.
+  /// @param twist The sensor's velocity in its own frame
+  /// @param dt_s The time since time 0 in seconds, may be negative
+  static RigidTransform from_twist(const SensorTwist & twist, double dt_s)
+  {
+    // Exponential map of se(3): R = I + a K + b K^2 and t = (I + b K + c K^2) v dt, with K the
+    // skew-symmetric matrix of the rotation vector w dt of length theta
+    const double wx = twist.angular[0] * dt_s;
+    const double wy = twist.angular[1] * dt_s;
+    const double wz = twist.angular[2] * dt_s;
+    const double theta_sq = wx * wx + wy * wy + wz * wz;
+
+    double a = 1;
+    double b = 0.5;
+    double c = 1. / 6;
+    if (theta_sq > 1e-8) {
+      const double theta = std::sqrt(theta_sq);
+      a = std::sin(theta) / theta;
+      b = (1 - std::cos(theta)) / theta_sq;
+      c = (theta - std::sin(theta)) / (theta_sq * theta);
+    } else {
+      // Taylor expansions, accurate to double precision for small angles
+      a = 1 - theta_sq / 6;
+      b = 0.5 - theta_sq / 24;
+      c = 1. / 6 - theta_sq / 120;
+    }
+
+    const std::array<double, 9> k{0, -wz, wy, wz, 0, -wx, -wy, wx, 0};
+    const std::array<double, 9> k_sq{-(wy * wy + wz * wz), wx * wy, wx * wz,
+                                     wx * wy, -(wx * wx + wz * wz), wy * wz,
+                                     wx * wz, wy * wz, -(wx * wx + wy * wy)};
+    const std::array<double, 3> v{
+      twist.linear[0] * dt_s, twist.linear[1] * dt_s, twist.linear[2] * dt_s};
+
+    RigidTransform result;
+    for (size_t row = 0; row < 3; ++row) {
+      double t = 0;
+      for (size_t col = 0; col < 3; ++col) {
+        const size_t i = row * 3 + col;
+        const double identity = row == col ? 1 : 0;
+        result.rotation[i] = static_cast<float>(identity + a * k[i] + b * k_sq[i]);
+        t += (identity + b * k[i] + c * k_sq[i]) * v[col];
+      }
+      result.translation[row] = static_cast<float>(t);
+    }
+    return result;
+  }
+};
+
+/// @brief Compose two transforms
+/// @return The transform that applies `rhs` first, then `lhs`
+inline RigidTransform operator*(const RigidTransform & lhs, const RigidTransform & rhs)
+{
+  RigidTransform result;
+  const auto & a = lhs.rotation;
+  const auto & b = rhs.rotation;
+  for (size_t row = 0; row < 3; ++row) {
+    for (size_t col = 0; col < 3; ++col) {
+      result.rotation[row * 3 + col] =
+        a[row * 3] * b[col] + a[row * 3 + 1] * b[3 + col] + a[row * 3 + 2] * b[6 + col];
+    }
+    result.translation[row] = a[row * 3] * rhs.translation[0] +
+                              a[row * 3 + 1] * rhs.translation[1] +
+                              a[row * 3 + 2] * rhs.translation[2] + lhs.translation[row];
+  }
+  return result;
+}
+
+/// @brief Get the transform from the sensor frame to the output frame of a lidar
+/// @param config The sensor configuration holding the output transform
+/// @return The transform, or nullopt if points are output in the sensor frame
+inline std::optional<RigidTransform> get_output_transform(const LidarConfigurationBase & config)
+{
+  const std::vector<double> & pose = config.output_transform;
+  if (pose.size() != 6) {
+    return std::nullopt;
+  }
+
+  return RigidTransform::from_pose(pose[0], pose[1], pose[2], pose[3], pose[4], pose[5]);
+}
+
+}  // namespace nebula::drivers
@@ -46,7 +46,7 @@ public:
   /// @brief Function for parsing NebulaPackets
   /// @param nebula_packets
   /// @return Resulting flag
-  bool process_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg) override;
+  bool process_packet(const nebula_msgs::msg::NebulaPacket & packet_msg) override;
 
   /// @brief Register function to call when a new detection list is processed
   /// @param detection_list_callback
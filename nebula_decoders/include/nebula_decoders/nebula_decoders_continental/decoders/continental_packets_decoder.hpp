@@ -44,7 +44,7 @@ public:
   /// @brief Virtual function for parsing a NebulaPacket
   /// @param packet_msg
   /// @return Resulting flag
-  virtual bool process_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg) = 0;
+  virtual bool process_packet(const nebula_msgs::msg::NebulaPacket & packet_msg) = 0;
 };
 }  // namespace nebula::drivers
 #endif  // NEBULA_WS_CONTINENTAL_PACKETS_DECODER_HPP
@@ -48,7 +48,7 @@ public:
   /// @brief Function for parsing NebulaPackets
   /// @param nebula_packets
   /// @return Resulting flag
-  bool process_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg) override;
+  bool process_packet(const nebula_msgs::msg::NebulaPacket & packet_msg) override;
 
   /// @brief Register function to call whenever a new RDI near detection list is processed
   /// @param detection_list_callback
@@ -97,63 +97,63 @@ private:
   /// @brief Process a new near detection header packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_near_header_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_near_header_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new near element packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_near_element_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_near_element_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new hrr header packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_hrr_header_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_hrr_header_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new hrr element packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_hrr_element_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_hrr_element_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new object header packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_object_header_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_object_header_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new object element packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_object_element_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_object_element_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new crc list packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_crc_list_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_crc_list_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new Near detections crc list packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_near_crc_list_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_near_crc_list_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new HRR crc list packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
   void process_hrrcrc_list_packet(
-    std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);  // cspell:ignore HRRCRC
+    const nebula_msgs::msg::NebulaPacket & packet_msg);  // cspell:ignore HRRCRC
 
   /// @brief Process a new objects crc list packet
   /// @param buffer The buffer containing the packet
   /// @param stamp The stamp in nanoseconds
-  void process_object_crc_list_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_object_crc_list_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new sensor status packet
   /// @param buffer The buffer containing the status packet
   /// @param stamp The stamp in nanoseconds
-  void process_sensor_status_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_sensor_status_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Process a new sensor status packet
   /// @param buffer The buffer containing the status packet
   /// @param stamp The stamp in nanoseconds
-  void process_sync_follow_up_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_sync_follow_up_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Printing the string to RCLCPP_INFO_STREAM
   /// @param info Target string
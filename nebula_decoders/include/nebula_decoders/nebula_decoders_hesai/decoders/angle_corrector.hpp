@@ -48,6 +48,13 @@ public:
   virtual CorrectedAngleData get_corrected_angle_data(
     uint32_t block_azimuth, uint32_t channel_id) = 0;
 
+  /// @brief Get the azimuth of a block without any per-channel corrections, e.g. to tell which
+  /// part of the scan the block belongs to
+  /// @param block_azimuth The block's azimuth (including optional fine azimuth), in the sensor's
+  /// angle unit
+  /// @return The azimuth in radians, in [0, 2 pi)
+  virtual float get_block_azimuth_rad(uint32_t block_azimuth) = 0;
+
   virtual bool passed_emit_angle(uint32_t last_azimuth, uint32_t current_azimuth) = 0;
   virtual bool passed_timestamp_reset_angle(uint32_t last_azimuth, uint32_t current_azimuth) = 0;
   virtual bool is_inside_fov(uint32_t last_azimuth, uint32_t current_azimuth) = 0;
@@ -16,6 +16,7 @@
 
 #include "nebula_common/hesai/hesai_common.hpp"
 #include "nebula_decoders/nebula_decoders_common/angles.hpp"
+#include "nebula_decoders/nebula_decoders_common/azimuth_trig_table.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector.hpp"
 
 #include <nebula_common/nebula_common.hpp>
@@ -32,21 +33,21 @@ namespace nebula::drivers
 {
 
 template <size_t ChannelN, size_t AngleUnit>
-class AngleCorrectorCalibrationBased : public AngleCorrector<HesaiCalibrationConfiguration>
+class AngleCorrectorCalibrationBased final : public AngleCorrector<HesaiCalibrationConfiguration>
 {
 private:
   static constexpr size_t max_azimuth = 360 * AngleUnit;
 
   std::array<float, ChannelN> elevation_angle_rad_{};
-  std::array<float, ChannelN> azimuth_offset_rad_{};
-  std::array<float, max_azimuth> block_azimuth_rad_{};
 
   std::array<float, ChannelN> elevation_cos_{};
   std::array<float, ChannelN> elevation_sin_{};
-  std::array<std::array<float, ChannelN>, max_azimuth> azimuth_cos_{};
-  std::array<std::array<float, ChannelN>, max_azimuth> azimuth_sin_{};
+  std::optional<AzimuthTrigTable<ChannelN, AngleUnit>> azimuth_trig_table_;
 
 public:
+  /// @brief All lookups are read-only, so one instance can be shared by multiple decoding threads
+  static constexpr bool is_thread_safe = true;
+
   uint32_t emit_angle_raw_;
   uint32_t timestamp_reset_angle_raw_;
   uint32_t fov_start_raw_;
@@ -56,7 +57,8 @@ public:
 
   explicit AngleCorrectorCalibrationBased(
     const std::shared_ptr<const HesaiCalibrationConfiguration> & sensor_calibration,
-    double fov_start_azimuth_deg, double fov_end_azimuth_deg, double scan_cut_azimuth_deg)
+    double fov_start_azimuth_deg, double fov_end_azimuth_deg, double scan_cut_azimuth_deg,
+    bool use_compact_trig_tables = false)
   {
     if (sensor_calibration == nullptr) {
       throw std::runtime_error(
@@ -70,6 +72,8 @@ public:
     int32_t correction_min = INT32_MAX;
     int32_t correction_max = INT32_MIN;
 
+    std::array<float, ChannelN> azimuth_offset_rad{};
+
     auto round_away_from_zero = [](float value) {
       return (value < 0) ? std::floor(value) : std::ceil(value);
     };
@@ -83,7 +87,7 @@ public:
       correction_max = std::max(correction_max, azimuth_offset_raw);
 
       elevation_angle_rad_[channel_id] = deg2rad(elevation_angle_deg);
-      azimuth_offset_rad_[channel_id] = deg2rad(azimuth_offset_deg);
+      azimuth_offset_rad[channel_id] = deg2rad(azimuth_offset_deg);
 
       elevation_cos_[channel_id] = cosf(elevation_angle_rad_[channel_id]);
       elevation_sin_[channel_id] = sinf(elevation_angle_rad_[channel_id]);
@@ -124,35 +128,32 @@ public:
     // Azimuth lookup tables
     // ////////////////////////////////////////
 
-    for (size_t block_azimuth = 0; block_azimuth < max_azimuth; block_azimuth++) {
-      block_azimuth_rad_[block_azimuth] = deg2rad(block_azimuth / static_cast<double>(AngleUnit));
-
-      for (size_t channel_id = 0; channel_id < ChannelN; ++channel_id) {
-        float precision_azimuth =
-          block_azimuth_rad_[block_azimuth] + azimuth_offset_rad_[channel_id];
-
-        azimuth_cos_[block_azimuth][channel_id] = cosf(precision_azimuth);
-        azimuth_sin_[block_azimuth][channel_id] = sinf(precision_azimuth);
-      }
-    }
+    azimuth_trig_table_.emplace(azimuth_offset_rad, use_compact_trig_tables);
   }
 
   CorrectedAngleData get_corrected_angle_data(uint32_t block_azimuth, uint32_t channel_id) override
   {
-    float azimuth_rad = block_azimuth_rad_[block_azimuth] + azimuth_offset_rad_[channel_id];
+    float azimuth_rad = azimuth_trig_table_->get_block_azimuth_rad(block_azimuth) +
+                        azimuth_trig_table_->get_azimuth_offset_rad(channel_id);
     azimuth_rad = normalize_angle(azimuth_rad, M_PIf * 2);
 
     float elevation_rad = elevation_angle_rad_[channel_id];
+    SinCos azimuth_sin_cos = azimuth_trig_table_->get_sin_cos(block_azimuth, channel_id);
 
     return {
       azimuth_rad,
       elevation_rad,
-      azimuth_sin_[block_azimuth][channel_id],
-      azimuth_cos_[block_azimuth][channel_id],
+      azimuth_sin_cos.sin,
+      azimuth_sin_cos.cos,
       elevation_sin_[channel_id],
       elevation_cos_[channel_id]};
   }
 
+  float get_block_azimuth_rad(uint32_t block_azimuth) override
+  {
+    return azimuth_trig_table_->get_block_azimuth_rad(block_azimuth);
+  }
+
   bool passed_emit_angle(uint32_t last_azimuth, uint32_t current_azimuth) override
   {
     return angle_is_between(last_azimuth, current_azimuth, emit_angle_raw_, false);
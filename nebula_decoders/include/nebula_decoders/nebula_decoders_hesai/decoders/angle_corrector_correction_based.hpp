@@ -16,6 +16,7 @@
 
 #include "nebula_common/hesai/hesai_common.hpp"
 #include "nebula_decoders/nebula_decoders_common/angles.hpp"
+#include "nebula_decoders/nebula_decoders_common/azimuth_trig_table.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector.hpp"
 
 #include <nebula_common/nebula_common.hpp>
@@ -23,6 +24,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -38,15 +40,25 @@ namespace nebula::drivers
 {
 
 template <size_t ChannelN, size_t AngleUnit>
-class AngleCorrectorCorrectionBased : public AngleCorrector<HesaiCorrection>
+class AngleCorrectorCorrectionBased final : public AngleCorrector<HesaiCorrection>
 {
 private:
   static constexpr size_t max_azimuth = 360 * AngleUnit;
   const std::shared_ptr<const HesaiCorrection> correction_;
   rclcpp::Logger logger_;
 
-  std::array<float, max_azimuth> cos_{};
-  std::array<float, max_azimuth> sin_{};
+  /// @brief Compact mode: one coarse table entry every `coarse_step` raw angles (0.01 deg)
+  static constexpr size_t coarse_step = std::max<size_t>(AngleUnit / 100, 1);
+  static constexpr size_t max_coarse = max_azimuth / coarse_step;
+  static constexpr double coarse_rad_step = 2. * M_PI / max_coarse;
+
+  /// @brief Full mode only: sin/cos of every raw angle
+  std::vector<float> cos_;
+  std::vector<float> sin_;
+
+  /// @brief Compact mode only: sin/cos of every coarse angle, in double precision
+  std::vector<double> coarse_cos_;
+  std::vector<double> coarse_sin_;
 
   struct FrameAngleInfo
   {
@@ -59,6 +71,11 @@ private:
 
   std::vector<FrameAngleInfo> frame_angle_info_;
 
+  /// @brief The angles of all channels at the most recently requested block azimuth. All channels
+  /// of a block are requested in a row, so the per-block work is done once per block this way.
+  uint32_t cached_block_azimuth_ = UINT32_MAX;
+  std::array<CorrectedAngleData, ChannelN> cached_angle_data_{};
+
   /// @brief For a given azimuth value, find its corresponding output field
   /// @param azimuth The azimuth to get the field for
   /// @return The correct output field, as specified in @ref HesaiCorrection
@@ -78,12 +95,92 @@ private:
     return field;
   }
 
+  /// @brief The angle in radians that the trig tables are indexed with, rounded to float
+  static float raw_angle_to_rad(uint32_t raw_angle)
+  {
+    return 2.f * raw_angle * M_PIf / max_azimuth;
+  }
+
+  /// @brief Sine/cosine of `raw_angle_to_rad(raw_angle)`
+  [[nodiscard]] SinCos get_sin_cos(uint32_t raw_angle) const
+  {
+    if (coarse_sin_.empty()) {
+      return {sin_[raw_angle], cos_[raw_angle]};
+    }
+
+    // Split the float angle into the nearest coarse angle below it and a small remainder
+    // (|remainder| < 2 pi / max_coarse), whose sin/cos are evaluated via their Taylor series.
+    // The truncated terms are below double precision.
+    size_t coarse_idx = raw_angle / coarse_step;
+    double remainder = static_cast<double>(raw_angle_to_rad(raw_angle)) -
+                       static_cast<double>(coarse_idx) * coarse_rad_step;
+    double remainder_sq = remainder * remainder;
+    double remainder_sin = remainder * (1. - remainder_sq / 6.);
+    double remainder_cos = 1. - remainder_sq / 2. * (1. - remainder_sq / 12.);
+
+    double coarse_sin = coarse_sin_[coarse_idx];
+    double coarse_cos = coarse_cos_[coarse_idx];
+    return {
+      static_cast<float>(coarse_sin * remainder_cos + coarse_cos * remainder_sin),
+      static_cast<float>(coarse_cos * remainder_cos - coarse_sin * remainder_sin)};
+  }
+
+  /// @brief The corrected azimuth of a channel as a raw angle in [0, max_azimuth)
+  uint32_t get_corrected_azimuth(uint32_t block_azimuth, uint32_t channel_id)
+  {
+    int field = find_field(block_azimuth);
+
+    int32_t azimuth = (block_azimuth + max_azimuth - correction_->startFrame[field]) * 2 -
+                      correction_->azimuth[channel_id] +
+                      correction_->get_azimuth_adjust_v3(channel_id, block_azimuth) *
+                        static_cast<int32_t>(AngleUnit / 100);
+    return (max_azimuth + azimuth) % max_azimuth;
+  }
+
+  /// @brief Compute the corrected angles of all channels for the given block azimuth
+  void update_angle_data_cache(uint32_t block_azimuth)
+  {
+    int field = find_field(block_azimuth);
+    int32_t block_azimuth_offset =
+      (block_azimuth + max_azimuth - correction_->startFrame[field]) * 2;
+
+    std::array<int8_t, ChannelN> azimuth_adjusts{};
+    std::array<int8_t, ChannelN> elevation_adjusts{};
+    correction_->get_angle_adjusts_v3(
+      block_azimuth, ChannelN, azimuth_adjusts.data(), elevation_adjusts.data());
+
+    for (size_t channel_id = 0; channel_id < ChannelN; ++channel_id) {
+      int32_t elevation = correction_->elevation[channel_id] +
+                          elevation_adjusts[channel_id] * static_cast<int32_t>(AngleUnit / 100);
+
+      // Allow negative angles in the radian value. This makes visualization of this field nicer
+      // and should have no other mathematical implications in downstream modules.
+      float elevation_rad = 2.f * elevation * M_PI / max_azimuth;
+      // Then, normalize the integer value to the positive [0, MAX_AZIMUTH] range for array indexing
+      elevation = (max_azimuth + elevation) % max_azimuth;
+
+      int32_t azimuth = block_azimuth_offset - correction_->azimuth[channel_id] +
+                        azimuth_adjusts[channel_id] * static_cast<int32_t>(AngleUnit / 100);
+      azimuth = (max_azimuth + azimuth) % max_azimuth;
+      float azimuth_rad = 2.f * azimuth * M_PI / max_azimuth;
+
+      SinCos azimuth_sin_cos = get_sin_cos(azimuth);
+      SinCos elevation_sin_cos = get_sin_cos(elevation);
+
+      cached_angle_data_[channel_id] = {
+        azimuth_rad,         elevation_rad,         azimuth_sin_cos.sin,
+        azimuth_sin_cos.cos, elevation_sin_cos.sin, elevation_sin_cos.cos};
+    }
+
+    cached_block_azimuth_ = block_azimuth;
+  }
+
   /// @brief For raw encoder angle `azi`, return whether all (any if `any == true`) channels'
   /// corrected azimuths are greater (or equal if `eq_ok == true`) than `threshold`.
   bool are_corrected_angles_above_threshold(uint32_t azi, double threshold, bool any, bool eq_ok)
   {
     for (size_t channel_id = 0; channel_id < ChannelN; ++channel_id) {
-      auto azi_corr = get_corrected_angle_data(azi, channel_id).azimuth_rad;
+      float azi_corr = 2.f * get_corrected_azimuth(azi, channel_id) * M_PI / max_azimuth;
       if (!any && (azi_corr < threshold || (!eq_ok && azi_corr == threshold))) return false;
       if (any && (azi_corr > threshold || (eq_ok && azi_corr == threshold))) return true;
     }
@@ -114,9 +211,14 @@ private:
   }
 
 public:
+  /// @brief Lookups update the per-block angle cache, so every decoding thread needs its own
+  /// instance
+  static constexpr bool is_thread_safe = false;
+
   explicit AngleCorrectorCorrectionBased(
     const std::shared_ptr<const HesaiCorrection> & sensor_correction, double fov_start_azimuth_deg,
-    double fov_end_azimuth_deg, double scan_cut_azimuth_deg)
+    double fov_end_azimuth_deg, double scan_cut_azimuth_deg,
+    bool use_compact_trig_tables = false)
   : correction_(sensor_correction), logger_(rclcpp::get_logger("AngleCorrectorCorrectionBased"))
   {
     if (sensor_correction == nullptr) {
@@ -130,10 +232,22 @@ public:
     // Trigonometry lookup tables
     // ////////////////////////////////////////
 
-    for (size_t i = 0; i < max_azimuth; ++i) {
-      float rad = 2.f * i * M_PIf / max_azimuth;
-      cos_[i] = cosf(rad);
-      sin_[i] = sinf(rad);
+    if (use_compact_trig_tables) {
+      coarse_cos_.resize(max_coarse);
+      coarse_sin_.resize(max_coarse);
+      for (size_t i = 0; i < max_coarse; ++i) {
+        double rad = static_cast<double>(i) * coarse_rad_step;
+        coarse_cos_[i] = std::cos(rad);
+        coarse_sin_[i] = std::sin(rad);
+      }
+    } else {
+      cos_.resize(max_azimuth);
+      sin_.resize(max_azimuth);
+      for (size_t i = 0; i < max_azimuth; ++i) {
+        float rad = raw_angle_to_rad(i);
+        cos_[i] = cosf(rad);
+        sin_[i] = sinf(rad);
+      }
     }
 
     // ////////////////////////////////////////
@@ -179,28 +293,25 @@ public:
 
   CorrectedAngleData get_corrected_angle_data(uint32_t block_azimuth, uint32_t channel_id) override
   {
-    int field = find_field(block_azimuth);
-
-    int32_t elevation = correction_->elevation[channel_id] +
-                        correction_->get_elevation_adjust_v3(channel_id, block_azimuth) *
-                          static_cast<int32_t>(AngleUnit / 100);
-
-    // Allow negative angles in the radian value. This makes visualization of this field nicer and
-    // should have no other mathematical implications in downstream modules.
-    float elevation_rad = 2.f * elevation * M_PI / max_azimuth;
-    // Then, normalize the integer value to the positive [0, MAX_AZIMUTH] range for array indexing
-    elevation = (max_azimuth + elevation) % max_azimuth;
+    if (block_azimuth != cached_block_azimuth_) {
+      update_angle_data_cache(block_azimuth);
+    }
 
-    int32_t azimuth = (block_azimuth + max_azimuth - correction_->startFrame[field]) * 2 -
-                      correction_->azimuth[channel_id] +
-                      correction_->get_azimuth_adjust_v3(channel_id, block_azimuth) *
-                        static_cast<int32_t>(AngleUnit / 100);
-    azimuth = (max_azimuth + azimuth) % max_azimuth;
+    return cached_angle_data_[channel_id];
+  }
 
-    float azimuth_rad = 2.f * azimuth * M_PI / max_azimuth;
+  float get_block_azimuth_rad(uint32_t block_azimuth) override
+  {
+    int field = find_field(block_azimuth);
+    uint32_t azimuth = (block_azimuth + max_azimuth - correction_->startFrame[field]) * 2;
+    return raw_angle_to_rad(azimuth % max_azimuth);
+  }
 
-    return {azimuth_rad,   elevation_rad,   sin_[azimuth],
-            cos_[azimuth], sin_[elevation], cos_[elevation]};
+  /// @brief The memory occupied by the trig lookup tables in bytes
+  [[nodiscard]] size_t get_trig_table_memory_usage_bytes() const
+  {
+    return (cos_.capacity() + sin_.capacity()) * sizeof(float) +
+           (coarse_cos_.capacity() + coarse_sin_.capacity()) * sizeof(double);
   }
 
   bool passed_emit_angle(uint32_t last_azimuth, uint32_t current_azimuth) override
@@ -15,21 +15,37 @@
 #pragma once
 
 #include "nebula_decoders/nebula_decoders_common/angles.hpp"
+#include "nebula_decoders/nebula_decoders_common/organized_cloud_layout.hpp"
+#include "nebula_decoders/nebula_decoders_common/packet_sequence_tracker.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud_pool.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_filter.hpp"
+#include "nebula_decoders/nebula_decoders_common/rigid_transform.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_scan_decoder.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_sensor.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/point_conversion.hpp"
 
 #include <nebula_common/hesai/hesai_common.hpp>
 #include <nebula_common/nebula_common.hpp>
 #include <nebula_common/point_types.hpp>
+#include <nebula_common/util/span.hpp>
 #include <rclcpp/logging.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -56,13 +72,139 @@ protected:
   /// @brief Decodes azimuth/elevation angles given calibration/correction data
   typename SensorT::angle_corrector_t angle_corrector_;
 
+  /// @brief Counts of checked and rejected packets if `validate_packet_crcs` is set
+  PacketIntegrityCounters packet_integrity_counters_;
+
+  /// @brief Decodes packet timestamps, caching the conversion of the packet date
+  hesai_packet::TimestampDecoder timestamp_decoder_;
+  /// @brief Tracks the UDP sequence numbers of incoming packets
+  PacketSequenceTracker sequence_tracker_;
+  /// @brief Sequence statistics of the packets received since the last scan was completed
+  PacketSequenceStats decode_sequence_stats_;
+  /// @brief Sequence statistics of the packets of the last completed scan
+  PacketSequenceStats output_sequence_stats_;
+  /// @brief The number of sequence gaps and packets lost in them since the decoder was created
+  uint64_t n_sequence_gaps_ = 0;
+  uint64_t n_packets_lost_ = 0;
+
+  /// @brief Pre-reserved point clouds that `decode_pc_` and `output_pc_` are taken from
+  PointCloudPool point_cloud_pool_;
+  /// @brief The cell layout of the output clouds if `organized_cloud_columns` is set
+  std::optional<OrganizedCloudLayout> organized_layout_;
+  /// @brief Whether packets with more returns than `organized_layout_` has rows for were warned
+  /// about already
+  bool has_warned_organized_returns_ = false;
+  /// @brief The decode-time point filters, if any are configured. Read-only after construction, so
+  /// it is shared by all worker threads.
+  std::optional<PointFilter> point_filter_;
+  /// @brief The transform from the sensor frame to the output frame, if they differ
+  std::optional<RigidTransform> output_transform_;
   /// @brief The point cloud new points get added to
   NebulaPointCloudPtr decode_pc_;
-  /// @brief The point cloud that is returned when a scan is complete
+  /// @brief The point cloud that is returned when a scan is complete. Once handed out, it is
+  /// replaced by a cloud from the pool and never written to by the decoder again.
   NebulaPointCloudPtr output_pc_;
 
-  /// @brief The last decoded packet
-  typename SensorT::packet_t packet_;
+  /// @brief Sector mode only: the clouds that sectors are copied to
+  std::optional<PointCloudPool> sector_cloud_pool_;
+  /// @brief Sector mode only: the width of a sector in radians
+  float sector_angle_rad_ = 0;
+  /// @brief Sector mode only: the sector of the last return group inside the FoV, counted from the
+  /// cut angle
+  uint32_t sector_index_ = 0;
+  /// @brief Sector mode only: the first point of `decode_pc_` that is not part of a sector yet
+  size_t sector_begin_ = 0;
+  /// @brief Sector mode only: the sectors completed during the current call to `unpack`
+  std::vector<std::tuple<NebulaPointCloudPtr, double>> sectors_;
+
+  /// @brief Deskew only: the latest velocity of the sensor, as set by `set_sensor_twist`. Guarded
+  /// by `sensor_twist_mtx_`, as it is set from outside the decoding thread.
+  SensorTwist sensor_twist_;
+  std::mutex sensor_twist_mtx_;
+
+  /// @brief The fields the fastest return group kernels write, if no other fields are requested
+  static constexpr PointFieldMask minimal_point_fields =
+    point_field::xyz | point_field::intensity | point_field::channel;
+
+  /// @brief The point fields as set by `set_point_fields`
+  std::atomic<PointFieldMask> requested_point_fields_{point_field::all};
+  /// @brief The fields written by the return group kernel of the packet being decoded
+  PointFieldMask packet_point_fields_ = point_field::all;
+  /// @brief The fields written to all points of the current scan so far, and to those of the next
+  /// scan that were decoded before the current one completed
+  PointFieldMask decode_point_fields_ = point_field::all;
+  PointFieldMask next_point_fields_ = point_field::all;
+  /// @brief The fields written to all points of the last completed scan
+  PointFieldMask output_point_fields_ = point_field::all;
+
+  /// @brief Points of a return group that passed all filters, in structure-of-arrays layout so
+  /// that they can be converted to cartesian coordinates in one go
+  struct PointBatch
+  {
+    static constexpr size_t capacity =
+      SensorT::packet_t::n_channels * SensorT::packet_t::max_returns;
+
+    size_t size = 0;
+    std::array<float, capacity> distance;
+    std::array<float, capacity> azimuth;
+    std::array<float, capacity> elevation;
+    std::array<float, capacity> sin_azimuth;
+    std::array<float, capacity> cos_azimuth;
+    std::array<float, capacity> sin_elevation;
+    std::array<float, capacity> cos_elevation;
+    std::array<float, capacity> x;
+    std::array<float, capacity> y;
+    std::array<float, capacity> z;
+    std::array<uint8_t, capacity> intensity;
+    std::array<uint8_t, capacity> return_type;
+    std::array<uint16_t, capacity> channel;
+    std::array<uint8_t, capacity> return_idx;
+    std::array<int32_t, capacity> time_offset_ns;
+    std::array<bool, capacity> in_current_scan;
+  };
+
+  /// @brief Everything the return group kernels read and write while converting a packet. In
+  /// parallel mode, every worker thread has its own context, so kernels must not modify any other
+  /// decoder state.
+  struct ConversionContext
+  {
+    /// @brief The packet currently being decoded. Only valid while it is being decoded.
+    const typename SensorT::packet_t * packet = nullptr;
+    /// @brief The timestamp of `packet` in nanoseconds, as decoded by `process_packet_header`
+    uint64_t packet_timestamp_ns = 0;
+    /// @brief The point time offsets of all blocks of `packet`
+    typename SensorT::PacketTimeOffsets packet_time_offsets;
+    /// @brief Deskew only: the velocity of the sensor while `packet` was recorded
+    SensorTwist sensor_twist;
+    /// @brief Scratch buffer for the return group currently being converted
+    PointBatch point_batch;
+    /// @brief The angle corrector to use, has to be exclusive to this context unless it is
+    /// thread-safe
+    typename SensorT::angle_corrector_t * angle_corrector = nullptr;
+
+    /// @brief The scan state when reaching the return group being converted. Points of the
+    /// current scan are appended to `decode_pc`, points of the next one to `output_pc`.
+    uint32_t last_azimuth = 0;
+    uint64_t decode_scan_timestamp_ns = 0;
+    uint64_t output_scan_timestamp_ns = 0;
+    NebulaPointCloud * decode_pc = nullptr;
+    NebulaPointCloud * output_pc = nullptr;
+    /// @brief If set, `decode_pc` and `output_pc` are organized clouds and points are written to
+    /// their cells instead of being appended
+    const OrganizedCloudLayout * organized_layout = nullptr;
+    /// @brief Parallel mode with organized output only: receive the return index of each point
+    /// appended to `decode_pc` and `output_pc`, so that it can be merged into the right row
+    std::vector<uint8_t> * decode_return_ids = nullptr;
+    std::vector<uint8_t> * output_return_ids = nullptr;
+  };
+
+  /// @brief The conversion context of the thread calling `unpack`
+  ConversionContext ctx_;
+
+  /// @brief Smallest valid distance in meters, combining the sensor's and the configured limits
+  float min_range_;
+  /// @brief Largest valid distance in meters, combining the sensor's and the configured limits
+  float max_range_;
 
   /// @brief The timestamp of the last completed scan in nanoseconds
   uint64_t output_scan_timestamp_ns_ = 0;
@@ -70,51 +212,191 @@ protected:
   uint64_t decode_scan_timestamp_ns_ = 0;
   /// @brief Whether a full scan has been processed
   bool has_scanned_ = false;
+  /// @brief The number of return groups inside the FoV since the last scan was completed
+  uint64_t n_scan_return_groups_ = 0;
 
   ScanCutAngles scan_cut_angles_;
   uint32_t last_azimuth_ = 0;
 
   rclcpp::Logger logger_;
 
-  /// @brief For each channel, its firing offset relative to the block in nanoseconds
-  std::array<int, SensorT::packet_t::n_channels> channel_firing_offset_ns_;
-  /// @brief For each return mode, the firing offset of each block relative to its packet in
-  /// nanoseconds
-  std::array<std::array<int, SensorT::packet_t::n_blocks>, SensorT::packet_t::max_returns>
-    block_firing_offset_ns_;
+  /// @brief Parallel mode only: the scan state at a return group, as determined by the state
+  /// machine in `advance_scan_state`
+  struct ReturnGroupPlan
+  {
+    size_t start_block_id;
+    uint32_t last_azimuth;
+    uint64_t decode_scan_timestamp_ns;
+    uint64_t output_scan_timestamp_ns;
+    bool starts_sector;
+    bool completes_scan;
+  };
+
+  /// @brief A function converting the return group starting at the given block to points. All
+  /// return group kernels share the signature of `convert_returns`.
+  using return_group_kernel_t = void (HesaiDecoder::*)(ConversionContext &, size_t, size_t);
 
-  /// @brief Validates and parse PandarPacket. Currently only checks size, not checksums etc.
+  /// @brief Parallel mode only: a packet on its way through the decoder. Packets are planned and
+  /// merged in order by the thread calling `unpack`, and converted by any worker in between.
+  struct PacketSlot
+  {
+    /// @brief A copy of the packet, as the buffer passed to `unpack` is only valid during that call
+    typename SensorT::packet_t packet;
+    uint64_t packet_timestamp_ns = 0;
+    typename SensorT::PacketTimeOffsets packet_time_offsets;
+    SensorTwist sensor_twist;
+    size_t n_returns = 0;
+    return_group_kernel_t convert_return_group_fn = nullptr;
+    size_t n_return_groups = 0;
+    std::array<ReturnGroupPlan, SensorT::packet_t::n_blocks> return_groups;
+
+    /// @brief The converted points of the current and the next scan
+    NebulaPointCloud decode_points;
+    NebulaPointCloud output_points;
+    /// @brief Organized output only: the return index of each point in `decode_points` and
+    /// `output_points`
+    std::vector<uint8_t> decode_return_ids;
+    std::vector<uint8_t> output_return_ids;
+    /// @brief For each return group, the sizes of `decode_points` and `output_points` after
+    /// converting it
+    std::array<size_t, SensorT::packet_t::n_blocks> decode_points_end;
+    std::array<size_t, SensorT::packet_t::n_blocks> output_points_end;
+
+    /// @brief Whether a worker has finished converting the packet. Guarded by `parallel_mtx_`.
+    bool is_converted = false;
+  };
+
+  /// @brief Parallel mode only: a thread converting packets with its own conversion context
+  struct Worker
+  {
+    ConversionContext ctx;
+    /// @brief A copy of the decoder's angle corrector, if that one cannot be shared
+    std::optional<typename SensorT::angle_corrector_t> angle_corrector;
+    std::thread thread;
+  };
+
+  /// @brief Parallel mode only: the number of packets that can be in flight per worker
+  static constexpr size_t packet_slots_per_worker = 8;
+
+  /// @brief Parallel mode only: packets in flight, as a ring buffer indexed by sequence number
+  std::vector<PacketSlot> packet_slots_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::mutex parallel_mtx_;
+  std::condition_variable packet_submitted_cv_;
+  std::condition_variable packet_converted_cv_;
+  /// @brief The number of packets submitted by `unpack` and taken by workers so far. Guarded by
+  /// `parallel_mtx_`.
+  uint64_t n_packets_submitted_ = 0;
+  uint64_t n_packets_dispatched_ = 0;
+  bool stop_workers_ = false;
+  /// @brief The number of packets merged into the scan point clouds so far
+  uint64_t n_packets_merged_ = 0;
+
+  /// @brief Validates and parse PandarPacket. Checks size, alignment, CRCs (if enabled) and that
+  /// the sensor supports the packet's operating modes, and selects the packet's point time offsets.
+  /// The packet is not copied but viewed in place.
   /// @param packet The incoming PandarPacket
   /// @return Whether the packet was parsed successfully
-  bool parse_packet(const std::vector<uint8_t> & packet)
+  bool parse_packet(util::span<const uint8_t> packet)
   {
-    if (packet.size() < sizeof(typename SensorT::packet_t)) {
+    using packet_t = typename SensorT::packet_t;
+    static_assert(std::is_trivially_copyable_v<packet_t>);
+
+    if (packet.size() < sizeof(packet_t)) {
       RCLCPP_ERROR_STREAM(
-        logger_, "Packet size mismatch: " << packet.size() << " | Expected at least: "
-                                          << sizeof(typename SensorT::packet_t));
+        logger_, "Packet size mismatch: " << packet.size()
+                                          << " | Expected at least: " << sizeof(packet_t));
       return false;
     }
-    if (std::memcpy(&packet_, packet.data(), sizeof(typename SensorT::packet_t))) {
-      // FIXME(mojomex) do validation?
-      // RCLCPP_DEBUG(logger_, "Packet parsed successfully");
-      return true;
+
+    // Packets are packed structs and thus byte-aligned, this only fails for future packet types
+    // that are not
+    if (reinterpret_cast<std::uintptr_t>(packet.data()) % alignof(packet_t) != 0) {
+      RCLCPP_ERROR(logger_, "Packet buffer is misaligned");
+      return false;
+    }
+
+    const auto * parsed_packet = reinterpret_cast<const packet_t *>(packet.data());
+    if (sensor_configuration_->validate_packet_crcs && !check_crcs(*parsed_packet, packet.size())) {
+      return false;
     }
 
-    RCLCPP_ERROR(logger_, "Packet memcopy failed");
-    return false;
+    const uint8_t return_mode = parsed_packet->tail.return_mode;
+    if (!hesai_packet::is_known_return_mode(return_mode)) {
+      RCLCPP_ERROR_STREAM(logger_, "Unknown return mode: " << static_cast<int>(return_mode));
+      return false;
+    }
+
+    typename SensorT::PacketTimeOffsets packet_time_offsets;
+    if (!sensor_.get_packet_time_offsets(*parsed_packet, packet_time_offsets)) {
+      RCLCPP_ERROR(logger_, "Packet has an unsupported combination of operating modes");
+      return false;
+    }
+
+    ctx_.packet = parsed_packet;
+    ctx_.packet_time_offsets = packet_time_offsets;
+    return true;
   }
 
+  /// @brief Checks the CRCs of the given packet and updates `packet_integrity_counters_`
+  /// @param packet The packet
+  /// @param packet_size The number of bytes received, possibly including optional fields that are
+  /// not part of `packet_t`
+  /// @return Whether all CRCs match (always true for sensors whose packets carry no CRCs)
+  bool check_crcs(const typename SensorT::packet_t & packet, size_t packet_size)
+  {
+    using packet_t = typename SensorT::packet_t;
+    if constexpr (!hesai_packet::has_crcs_v<packet_t>) {
+      return true;
+    } else {
+      auto & counters = packet_integrity_counters_;
+      ++counters.n_packets_checked;
+
+      switch (hesai_packet::check_crcs(packet, packet_size)) {
+        case hesai_packet::CrcCheckResult::OK:
+          return true;
+        case hesai_packet::CrcCheckResult::BODY_CRC_MISMATCH:
+          ++counters.n_body_crc_errors;
+          break;
+        case hesai_packet::CrcCheckResult::FUNCTIONAL_SAFETY_CRC_MISMATCH:
+          ++counters.n_functional_safety_crc_errors;
+          break;
+        case hesai_packet::CrcCheckResult::TAIL_CRC_MISMATCH:
+          ++counters.n_tail_crc_errors;
+          break;
+      }
+
+      // Warn on the 1st, 2nd, 4th, 8th, ... rejected packet to not flood the log
+      uint64_t n_rejected = counters.get_n_rejected();
+      if ((n_rejected & (n_rejected - 1)) == 0) {
+        RCLCPP_WARN_STREAM(
+          logger_, "Dropped packet with CRC mismatch (" << n_rejected << " of "
+                                                        << counters.n_packets_checked
+                                                        << " checked packets so far)");
+      }
+      return false;
+    }
+  }
+
+  using unit_t = typename SensorT::packet_t::body_t::block_t::unit_t;
+
   /// @brief Converts a group of returns (i.e. 1 for single return, 2 for dual return, etc.) to
   /// points and appends them to the point cloud
+  ///
+  /// This is the generic implementation that handles all return modes at runtime. It is only used
+  /// if `use_generic_return_kernel` is set, and serves as a reference for the specialized
+  /// `convert_return_group` kernels.
+  ///
+  /// @param ctx The conversion context holding the packet and the output point clouds
   /// @param start_block_id The first block in the group of returns
   /// @param n_blocks The number of returns in the group (has to align with the `n_returns` field in
   /// the packet footer)
-  void convert_returns(size_t start_block_id, size_t n_blocks)
+  void convert_returns(ConversionContext & ctx, size_t start_block_id, size_t n_blocks)
   {
-    uint64_t packet_timestamp_ns = hesai_packet::get_timestamp_ns(packet_);
-    uint32_t raw_azimuth = packet_.body.blocks[start_block_id].get_azimuth();
+    const uint64_t packet_timestamp_ns = ctx.packet_timestamp_ns;
+    uint32_t raw_azimuth = ctx.packet->body.blocks[start_block_id].get_azimuth();
 
-    std::vector<const typename SensorT::packet_t::body_t::block_t::unit_t *> return_units;
+    std::vector<const unit_t *> return_units;
 
     for (size_t channel_id = 0; channel_id < SensorT::packet_t::n_channels; ++channel_id) {
       // Find the units corresponding to the same return group as the current one.
@@ -122,7 +404,7 @@ protected:
       return_units.clear();
       for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
         return_units.push_back(
-          &packet_.body.blocks[block_offset + start_block_id].units[channel_id]);
+          &ctx.packet->body.blocks[block_offset + start_block_id].units[channel_id]);
       }
 
       for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
@@ -132,7 +414,7 @@ protected:
           continue;
         }
 
-        float distance = get_distance(unit);
+        float distance = get_distance(ctx, unit);
 
         if (
           distance < SensorT::min_range || SensorT::max_range < distance ||
@@ -142,7 +424,7 @@ protected:
         }
 
         auto return_type = sensor_.get_return_type(
-          static_cast<hesai_packet::return_mode::ReturnMode>(packet_.tail.return_mode),
+          static_cast<hesai_packet::return_mode::ReturnMode>(ctx.packet->tail.return_mode),
           block_offset, return_units);
 
         // Keep only last of multiple identical points
@@ -160,7 +442,7 @@ protected:
             }
 
             if (
-              fabsf(get_distance(*return_units[return_idx]) - distance) <
+              fabsf(get_distance(ctx, *return_units[return_idx]) - distance) <
               sensor_configuration_->dual_return_distance_threshold) {
               is_below_multi_return_threshold = true;
               break;
@@ -172,126 +454,693 @@ protected:
           }
         }
 
-        CorrectedAngleData corrected_angle_data =
-          angle_corrector_.get_corrected_angle_data(raw_azimuth, channel_id);
-        float azimuth = corrected_angle_data.azimuth_rad;
+        append_point(
+          ctx, unit, distance, return_type, start_block_id + block_offset, block_offset, channel_id,
+          raw_azimuth, packet_timestamp_ns);
+      }
+    }
+  }
+
+  /// @brief Converts a group of returns to points and appends them to the point cloud. Equivalent
+  /// to `convert_returns`, but specialized for a return mode known at compile time.
+  ///
+  /// The return group is held in fixed-size arrays, return types are looked up from a
+  /// compile-time table, and the duplicate/threshold filters are evaluated once per channel for
+  /// all returns as bitmasks. Distance scaling, range checks and the conversion to cartesian
+  /// coordinates are vectorized over all channels of a block.
+  ///
+  /// @tparam NReturns The number of returns in the group
+  /// @tparam ReturnMode The return mode the packet was recorded in
+  /// @tparam Fields The point fields to write, all others are set to zero
+  /// @param ctx The conversion context holding the packet and the output point clouds
+  /// @param start_block_id The first block in the group of returns
+  template <
+    size_t NReturns, hesai_packet::return_mode::ReturnMode ReturnMode, PointFieldMask Fields>
+  void convert_return_group(ConversionContext & ctx, size_t start_block_id, size_t /* n_blocks */)
+  {
+    using return_types_t = ReturnTypeTable<ReturnMode, NReturns, SensorT::first_last_reversed>;
+    static_assert(NReturns <= SensorT::packet_t::max_returns);
+    constexpr size_t n_channels = SensorT::packet_t::n_channels;
 
-        bool in_fov = angle_is_between(scan_cut_angles_.fov_min, scan_cut_angles_.fov_max, azimuth);
-        if (!in_fov) {
-          continue;
+    const uint32_t raw_azimuth = ctx.packet->body.blocks[start_block_id].get_azimuth();
+    const double dis_unit = hesai_packet::get_dis_unit(*ctx.packet);
+
+    std::array<std::array<uint16_t, n_channels>, NReturns> raw_distances;
+    std::array<std::array<float, n_channels>, NReturns> distances;
+    std::array<std::array<uint8_t, n_channels>, NReturns> is_in_range;
+
+    for (size_t return_idx = 0; return_idx < NReturns; ++return_idx) {
+      const auto & block = ctx.packet->body.blocks[start_block_id + return_idx];
+      for (size_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+        raw_distances[return_idx][channel_id] = block.units[channel_id].distance;
+      }
+
+      point_conversion::scale_distances(
+        raw_distances[return_idx].data(), n_channels, dis_unit, min_range_, max_range_,
+        distances[return_idx].data(), is_in_range[return_idx].data());
+    }
+
+    ctx.point_batch.size = 0;
+
+    for (size_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+      std::array<const unit_t *, NReturns> return_units;
+      for (size_t return_idx = 0; return_idx < NReturns; ++return_idx) {
+        return_units[return_idx] =
+          &ctx.packet->body.blocks[start_block_id + return_idx].units[channel_id];
+      }
+
+      // Bit i is set if unit i is identical to another unit of the group
+      uint32_t duplicate_mask = 0;
+      // Bit i is set if unit i is closer than the multi-return threshold to another unit
+      uint32_t below_threshold_mask = 0;
+      // Bit i is set if another unit of the group has a higher reflectivity than unit i
+      uint32_t weaker_mask = 0;
+
+      for (size_t i = 0; i < NReturns; ++i) {
+        for (size_t j = i + 1; j < NReturns; ++j) {
+          const uint32_t pair_mask = (1U << i) | (1U << j);
+          const bool is_identical =
+            return_units[i]->distance == return_units[j]->distance &&
+            return_units[i]->reflectivity == return_units[j]->reflectivity;
+          const bool is_below_threshold =
+            fabsf(distances[j][channel_id] - distances[i][channel_id]) <
+            sensor_configuration_->dual_return_distance_threshold;
+
+          duplicate_mask |= is_identical ? pair_mask : 0U;
+          below_threshold_mask |= is_below_threshold ? pair_mask : 0U;
+          weaker_mask |= static_cast<uint32_t>(
+                           return_units[i]->reflectivity < return_units[j]->reflectivity)
+                         << i;
+          weaker_mask |= static_cast<uint32_t>(
+                           return_units[j]->reflectivity < return_units[i]->reflectivity)
+                         << j;
         }
+      }
 
-        bool in_current_scan = true;
+      // Keep only last of multiple identical points, and only last (if any) of multiple points
+      // that are too close
+      const uint32_t dropped_mask =
+        (duplicate_mask | below_threshold_mask) & ~(1U << (NReturns - 1));
 
-        if (
-          angle_corrector_.is_inside_overlap(last_azimuth_, raw_azimuth) &&
-          angle_is_between(
-            scan_cut_angles_.scan_emit_angle, scan_cut_angles_.scan_emit_angle + deg2rad(20),
-            azimuth)) {
-          in_current_scan = false;
+      for (size_t return_idx = 0; return_idx < NReturns; ++return_idx) {
+        if (!is_in_range[return_idx][channel_id] || ((dropped_mask >> return_idx) & 1U)) {
+          continue;
         }
 
-        auto pc = in_current_scan ? decode_pc_ : output_pc_;
-        uint64_t scan_timestamp_ns =
-          in_current_scan ? decode_scan_timestamp_ns_ : output_scan_timestamp_ns_;
-
-        NebulaPoint & point = pc->emplace_back();
-        point.distance = distance;
-        point.intensity = unit.reflectivity;
-        point.time_stamp = get_point_time_relative(
-          scan_timestamp_ns, packet_timestamp_ns, block_offset + start_block_id, channel_id);
-
-        point.return_type = static_cast<uint8_t>(return_type);
-        point.channel = channel_id;
-
-        // The raw_azimuth and channel are only used as indices, sin/cos functions use the precise
-        // corrected angles
-        float xy_distance = distance * corrected_angle_data.cos_elevation;
-        point.x = xy_distance * corrected_angle_data.sin_azimuth;
-        point.y = xy_distance * corrected_angle_data.cos_azimuth;
-        point.z = distance * corrected_angle_data.sin_elevation;
-
-        // The driver wrapper converts to degrees, expects radians
-        point.azimuth = corrected_angle_data.azimuth_rad;
-        point.elevation = corrected_angle_data.elevation_rad;
+        const bool is_strongest =
+          !return_types_t::depends_on_strength || !((weaker_mask >> return_idx) & 1U);
+        const ReturnType return_type = ((duplicate_mask >> return_idx) & 1U)
+                                         ? ReturnType::IDENTICAL
+                                         : return_types_t::types[is_strongest][return_idx];
+
+        batch_point<Fields>(
+          ctx, *return_units[return_idx], distances[return_idx][channel_id], return_type,
+          start_block_id + return_idx, return_idx, channel_id, raw_azimuth);
+      }
+    }
+
+    append_point_batch<Fields>(ctx, start_block_id);
+  }
+
+  /// @brief Adds a unit that passed all return filters to the point batch, if it is inside the FoV
+  /// and its channel and return type are not filtered out
+  /// @tparam Fields The point fields to write, fields that are not needed for them are not batched
+  /// @param ctx The conversion context holding the point batch
+  /// @param unit The unit to convert
+  /// @param distance The unit's distance in meters
+  /// @param return_type The unit's return type
+  /// @param block_id The block index of the unit
+  /// @param return_idx The index of the unit's return within its return group
+  /// @param channel_id The channel index of the unit
+  /// @param raw_azimuth The raw azimuth of the return group the unit is part of
+  template <PointFieldMask Fields>
+  void batch_point(
+    ConversionContext & ctx, const unit_t & unit, float distance, ReturnType return_type,
+    size_t block_id, size_t return_idx, size_t channel_id, uint32_t raw_azimuth)
+  {
+    if (point_filter_ && !point_filter_->accepts_attributes(channel_id, return_type)) {
+      return;
+    }
+
+    CorrectedAngleData corrected_angle_data =
+      ctx.angle_corrector->get_corrected_angle_data(raw_azimuth, channel_id);
+    float azimuth = corrected_angle_data.azimuth_rad;
+
+    bool in_fov = angle_is_between(scan_cut_angles_.fov_min, scan_cut_angles_.fov_max, azimuth);
+    if (!in_fov) {
+      return;
+    }
+
+    bool in_current_scan = true;
+
+    if (
+      ctx.angle_corrector->is_inside_overlap(ctx.last_azimuth, raw_azimuth) &&
+      angle_is_between(
+        scan_cut_angles_.scan_emit_angle, scan_cut_angles_.scan_emit_angle + deg2rad(20),
+        azimuth)) {
+      in_current_scan = false;
+    }
+
+    auto & batch = ctx.point_batch;
+    const size_t i = batch.size++;
+    batch.distance[i] = distance;
+    batch.azimuth[i] = corrected_angle_data.azimuth_rad;
+    if constexpr ((Fields & point_field::elevation) != 0) {
+      batch.elevation[i] = corrected_angle_data.elevation_rad;
+    }
+    batch.sin_azimuth[i] = corrected_angle_data.sin_azimuth;
+    batch.cos_azimuth[i] = corrected_angle_data.cos_azimuth;
+    batch.sin_elevation[i] = corrected_angle_data.sin_elevation;
+    batch.cos_elevation[i] = corrected_angle_data.cos_elevation;
+    batch.intensity[i] = unit.reflectivity;
+    if constexpr ((Fields & point_field::return_type) != 0) {
+      batch.return_type[i] = static_cast<uint8_t>(return_type);
+    }
+    batch.channel[i] = channel_id;
+    batch.return_idx[i] = return_idx;
+    if constexpr ((Fields & point_field::time_stamp) != 0) {
+      batch.time_offset_ns[i] = ctx.packet_time_offsets.get(block_id, channel_id, unit.distance);
+    }
+    batch.in_current_scan[i] = in_current_scan;
+  }
+
+  /// @brief Converts all points in the point batch to cartesian coordinates in one go and appends
+  /// those that pass the position filters to the point cloud of the scan they belong to
+  /// @tparam Fields The point fields to write, all others are set to zero
+  /// @param ctx The conversion context holding the point batch and the output point clouds
+  /// @param start_block_id The first block of the return group the points are part of
+  template <PointFieldMask Fields>
+  void append_point_batch(ConversionContext & ctx, size_t start_block_id)
+  {
+    auto & batch = ctx.point_batch;
+    if (batch.size == 0) {
+      return;
+    }
+
+    point_conversion::project_to_cartesian(
+      batch.distance.data(), batch.cos_elevation.data(), batch.sin_elevation.data(),
+      batch.cos_azimuth.data(), batch.sin_azimuth.data(), batch.size, batch.x.data(),
+      batch.y.data(), batch.z.data());
+
+    // All points share the same packet, so their scan-relative time is a single addition
+    const uint64_t packet_timestamp_ns = ctx.packet_timestamp_ns;
+    const uint32_t output_offset_ns =
+      static_cast<uint32_t>(packet_timestamp_ns - ctx.output_scan_timestamp_ns);
+    const uint32_t decode_offset_ns =
+      static_cast<uint32_t>(packet_timestamp_ns - ctx.decode_scan_timestamp_ns);
+
+    // The sensor motion is interpolated per return group, as all of its points are fired within a
+    // few microseconds. It is composed with the output transform, so each point is transformed
+    // only once.
+    const bool transform = sensor_configuration_->deskew || output_transform_;
+    RigidTransform decode_transform;
+    RigidTransform output_transform;
+    if (transform) {
+      decode_transform = get_point_transform(ctx, start_block_id, ctx.decode_scan_timestamp_ns);
+      output_transform = get_point_transform(ctx, start_block_id, ctx.output_scan_timestamp_ns);
+    }
+
+    for (size_t i = 0; i < batch.size; ++i) {
+      if (point_filter_ && !point_filter_->accepts_position(batch.x[i], batch.y[i], batch.z[i])) {
+        continue;
+      }
+
+      auto & pc = batch.in_current_scan[i] ? ctx.decode_pc : ctx.output_pc;
+      uint32_t packet_to_scan_offset_ns =
+        batch.in_current_scan[i] ? decode_offset_ns : output_offset_ns;
+
+      NebulaPoint * point =
+        add_point(ctx, *pc, batch.channel[i], batch.return_idx[i], batch.azimuth[i]);
+      if (!point) {
+        continue;
       }
+
+      point->x = batch.x[i];
+      point->y = batch.y[i];
+      point->z = batch.z[i];
+      if (transform) {
+        (batch.in_current_scan[i] ? decode_transform : output_transform)
+          .apply(point->x, point->y, point->z);
+      }
+      point->intensity = batch.intensity[i];
+      point->channel = batch.channel[i];
+      // Points are recycled from the pool, so fields that are not written have to be cleared
+      point->distance = (Fields & point_field::distance) ? batch.distance[i] : 0;
+      point->time_stamp = (Fields & point_field::time_stamp)
+                            ? packet_to_scan_offset_ns + batch.time_offset_ns[i]
+                            : 0;
+      point->return_type = (Fields & point_field::return_type) ? batch.return_type[i] : 0;
+      // The driver wrapper converts to degrees, expects radians
+      point->azimuth = (Fields & point_field::azimuth) ? batch.azimuth[i] : 0;
+      point->elevation = (Fields & point_field::elevation) ? batch.elevation[i] : 0;
+    }
+  }
+
+  /// @brief Select the return group kernel for the given return mode. This is done once per packet
+  /// so that the per-point code does not have to branch on the return mode.
+  /// @param return_mode The return mode field of the packet
+  /// @param point_fields The point fields the kernel has to write, see `begin_packet`
+  /// @return A pointer to the kernel to be called for each return group in the packet
+  return_group_kernel_t get_return_group_kernel(uint8_t return_mode, PointFieldMask point_fields)
+    const
+  {
+    if (sensor_configuration_->use_generic_return_kernel) {
+      return &HesaiDecoder::convert_returns;
+    }
+
+    if (point_fields == minimal_point_fields) {
+      return get_return_group_kernel<minimal_point_fields>(return_mode);
+    }
+
+    return get_return_group_kernel<point_field::all>(return_mode);
+  }
+
+  /// @brief Select the return group kernel writing the given point fields for the given return mode
+  /// @tparam Fields The point fields the kernel writes
+  /// @param return_mode The return mode field of the packet
+  /// @return A pointer to the kernel to be called for each return group in the packet
+  template <PointFieldMask Fields>
+  return_group_kernel_t get_return_group_kernel(uint8_t return_mode) const
+  {
+    namespace rm = hesai_packet::return_mode;
+
+    switch (return_mode) {
+      case rm::SINGLE_FIRST:
+        return &HesaiDecoder::convert_return_group<1, rm::SINGLE_FIRST, Fields>;
+      case rm::SINGLE_SECOND:
+        return &HesaiDecoder::convert_return_group<1, rm::SINGLE_SECOND, Fields>;
+      case rm::SINGLE_STRONGEST:
+        return &HesaiDecoder::convert_return_group<1, rm::SINGLE_STRONGEST, Fields>;
+      case rm::SINGLE_LAST:
+        return &HesaiDecoder::convert_return_group<1, rm::SINGLE_LAST, Fields>;
+      case rm::DUAL_LAST_STRONGEST:
+        return &HesaiDecoder::convert_return_group<2, rm::DUAL_LAST_STRONGEST, Fields>;
+      case rm::DUAL_FIRST_SECOND:
+        return &HesaiDecoder::convert_return_group<2, rm::DUAL_FIRST_SECOND, Fields>;
+      case rm::DUAL_FIRST_LAST:
+        return &HesaiDecoder::convert_return_group<2, rm::DUAL_FIRST_LAST, Fields>;
+      case rm::DUAL_FIRST_STRONGEST:
+        return &HesaiDecoder::convert_return_group<2, rm::DUAL_FIRST_STRONGEST, Fields>;
+      case rm::DUAL_STRONGEST_SECONDSTRONGEST:
+        return &HesaiDecoder::convert_return_group<2, rm::DUAL_STRONGEST_SECONDSTRONGEST, Fields>;
+      default:
+        break;
+    }
+
+    if constexpr (SensorT::packet_t::max_returns >= 3) {
+      if (return_mode == rm::TRIPLE_FIRST_LAST_STRONGEST) {
+        return &HesaiDecoder::convert_return_group<3, rm::TRIPLE_FIRST_LAST_STRONGEST, Fields>;
+      }
+    }
+
+    // Unsupported return modes are handled by the generic kernel, which behaves like before the
+    // specialized kernels were introduced
+    return &HesaiDecoder::convert_returns;
+  }
+
+  /// @brief Converts a single unit that passed all return filters to a point and appends it to the
+  /// point cloud of the scan it belongs to, unless it is outside the FoV or filtered out
+  /// @param ctx The conversion context holding the output point clouds
+  /// @param unit The unit to convert
+  /// @param distance The unit's distance in meters
+  /// @param return_type The unit's return type
+  /// @param block_id The block index of the unit
+  /// @param return_idx The index of the unit's return within its return group
+  /// @param channel_id The channel index of the unit
+  /// @param raw_azimuth The raw azimuth of the return group the unit is part of
+  /// @param packet_timestamp_ns The timestamp of the current packet in nanoseconds
+  void append_point(
+    ConversionContext & ctx, const unit_t & unit, float distance, ReturnType return_type,
+    size_t block_id, size_t return_idx, size_t channel_id, uint32_t raw_azimuth,
+    uint64_t packet_timestamp_ns)
+  {
+    if (point_filter_ && !point_filter_->accepts_attributes(channel_id, return_type)) {
+      return;
+    }
+
+    CorrectedAngleData corrected_angle_data =
+      ctx.angle_corrector->get_corrected_angle_data(raw_azimuth, channel_id);
+    float azimuth = corrected_angle_data.azimuth_rad;
+
+    bool in_fov = angle_is_between(scan_cut_angles_.fov_min, scan_cut_angles_.fov_max, azimuth);
+    if (!in_fov) {
+      return;
+    }
+
+    bool in_current_scan = true;
+
+    if (
+      ctx.angle_corrector->is_inside_overlap(ctx.last_azimuth, raw_azimuth) &&
+      angle_is_between(
+        scan_cut_angles_.scan_emit_angle, scan_cut_angles_.scan_emit_angle + deg2rad(20),
+        azimuth)) {
+      in_current_scan = false;
+    }
+
+    // The raw_azimuth and channel are only used as indices, sin/cos functions use the precise
+    // corrected angles
+    float xy_distance = distance * corrected_angle_data.cos_elevation;
+    float x = xy_distance * corrected_angle_data.sin_azimuth;
+    float y = xy_distance * corrected_angle_data.cos_azimuth;
+    float z = distance * corrected_angle_data.sin_elevation;
+
+    if (point_filter_ && !point_filter_->accepts_position(x, y, z)) {
+      return;
+    }
+
+    auto & pc = in_current_scan ? ctx.decode_pc : ctx.output_pc;
+    uint64_t scan_timestamp_ns =
+      in_current_scan ? ctx.decode_scan_timestamp_ns : ctx.output_scan_timestamp_ns;
+
+    NebulaPoint * point = add_point(ctx, *pc, channel_id, return_idx, azimuth);
+    if (!point) {
+      return;
+    }
+
+    point->distance = distance;
+    point->intensity = unit.reflectivity;
+    point->time_stamp = get_point_time_relative(
+      ctx, scan_timestamp_ns, packet_timestamp_ns, block_id, channel_id, unit.distance);
+
+    point->return_type = static_cast<uint8_t>(return_type);
+    point->channel = channel_id;
+    point->x = x;
+    point->y = y;
+    point->z = z;
+    if (sensor_configuration_->deskew || output_transform_) {
+      get_point_transform(ctx, block_id, scan_timestamp_ns).apply(point->x, point->y, point->z);
+    }
+
+    // The driver wrapper converts to degrees, expects radians
+    point->azimuth = corrected_angle_data.azimuth_rad;
+    point->elevation = corrected_angle_data.elevation_rad;
+  }
+
+  /// @brief Get the transform applied to the points of a return group: the motion of the sensor
+  /// since the scan timestamp if deskewing, followed by the output transform if configured
+  /// @param ctx The conversion context holding the packet and the sensor velocity
+  /// @param start_block_id The first block of the return group
+  /// @param scan_timestamp_ns The timestamp of the scan the points are relative to
+  /// @return The transform from the sensor frame at firing time to the output frame
+  RigidTransform get_point_transform(
+    const ConversionContext & ctx, size_t start_block_id, uint64_t scan_timestamp_ns) const
+  {
+    RigidTransform transform;
+    if (sensor_configuration_->deskew) {
+      transform = get_scan_motion(ctx, start_block_id, scan_timestamp_ns);
+    }
+    if (output_transform_) {
+      transform = *output_transform_ * transform;
+    }
+    return transform;
+  }
+
+  /// @brief Deskew only: get the motion of the sensor from the start of a scan to the firing of a
+  /// return group, assuming the sensor's velocity stayed at `ctx.sensor_twist` in the meantime
+  /// @param ctx The conversion context holding the packet and the sensor velocity
+  /// @param start_block_id The first block of the return group
+  /// @param scan_timestamp_ns The timestamp of the scan the points are relative to
+  /// @return The transform from the sensor frame at firing time to the one at the scan timestamp
+  RigidTransform get_scan_motion(
+    const ConversionContext & ctx, size_t start_block_id, uint64_t scan_timestamp_ns) const
+  {
+    const uint64_t block_timestamp_ns =
+      ctx.packet_timestamp_ns + sensor_.get_earliest_point_time_offset_for_block(
+                                  start_block_id, *ctx.packet, ctx.packet_time_offsets);
+    const auto dt_ns = static_cast<int64_t>(block_timestamp_ns - scan_timestamp_ns);
+
+    // Right after startup, points can be decoded for a scan whose timestamp is not known yet.
+    // Leave those uncorrected instead of extrapolating over an arbitrary time span.
+    constexpr int64_t max_dt_ns = 1'000'000'000;
+    if (dt_ns < -max_dt_ns || dt_ns > max_dt_ns) {
+      return {};
+    }
+
+    return RigidTransform::from_twist(ctx.sensor_twist, static_cast<double>(dt_ns) * 1e-9);
+  }
+
+  /// @brief Get the point to write a new point's fields to: a new point appended to the cloud, or,
+  /// for organized clouds, the cell of the point's channel, return and azimuth
+  /// @return The point to write to, or nullptr if the cell is already taken by another point or
+  /// the organized cloud has no row for the point's return
+  static NebulaPoint * add_point(
+    const ConversionContext & ctx, NebulaPointCloud & pc, size_t channel_id, size_t return_idx,
+    float azimuth_rad)
+  {
+    if (ctx.organized_layout) {
+      return ctx.organized_layout->get_empty_cell(
+        pc, static_cast<uint32_t>(channel_id), static_cast<uint32_t>(return_idx), azimuth_rad);
+    }
+
+    if (ctx.decode_return_ids) {
+      auto * return_ids = &pc == ctx.decode_pc ? ctx.decode_return_ids : ctx.output_return_ids;
+      return_ids->push_back(static_cast<uint8_t>(return_idx));
+    }
+
+    return &pc.emplace_back();
+  }
+
+  /// @brief Parallel mode only: adds the converted points in [begin, end) to a scan point cloud,
+  /// in their cells if the output is organized
+  /// @param pc The scan point cloud
+  /// @param points The converted points of a packet
+  /// @param return_ids Organized output only: the return index of each of `points`
+  void merge_points(
+    NebulaPointCloud & pc, const NebulaPointCloud & points,
+    const std::vector<uint8_t> & return_ids, size_t begin, size_t end)
+  {
+    if (!organized_layout_) {
+      pc.insert(pc.end(), points.begin() + begin, points.begin() + end);
+      return;
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+      organized_layout_->insert(pc, points[i], return_ids[i]);
+    }
+  }
+
+  /// @brief Get the number of returns per return group of the given return mode, i.e. the number
+  /// of row blocks of organized clouds. Unknown modes are assumed to have the sensor's maximum.
+  static uint32_t get_configured_n_returns(ReturnMode return_mode)
+  {
+    switch (return_mode) {
+      case ReturnMode::SINGLE_FIRST:
+      case ReturnMode::SINGLE_LAST:
+      case ReturnMode::SINGLE_STRONGEST:
+      case ReturnMode::FIRST:
+      case ReturnMode::LAST:
+      case ReturnMode::STRONGEST:
+        return 1;
+      case ReturnMode::UNKNOWN:
+      case ReturnMode::TRIPLE:
+        return SensorT::packet_t::max_returns;
+      default:
+        return std::min<uint32_t>(2, SensorT::packet_t::max_returns);
     }
   }
 
   /// @brief Get the distance of the given unit in meters
-  float get_distance(const typename SensorT::packet_t::body_t::block_t::unit_t & unit)
+  float get_distance(const ConversionContext & ctx, const unit_t & unit)
   {
-    return unit.distance * hesai_packet::get_dis_unit(packet_);
+    return unit.distance * hesai_packet::get_dis_unit(*ctx.packet);
   }
 
   /// @brief Get timestamp of point in nanoseconds, relative to scan timestamp. Includes firing time
   /// offset correction for channel and block
+  /// @param ctx The conversion context holding the current packet's time offsets
   /// @param scan_timestamp_ns Start timestamp of the current scan in nanoseconds
   /// @param packet_timestamp_ns The timestamp of the current PandarPacket in nanoseconds
   /// @param block_id The block index of the point
   /// @param channel_id The channel index of the point
+  /// @param raw_distance The distance of the point as found in the packet
   uint32_t get_point_time_relative(
-    uint64_t scan_timestamp_ns, uint64_t packet_timestamp_ns, size_t block_id, size_t channel_id)
+    const ConversionContext & ctx, uint64_t scan_timestamp_ns, uint64_t packet_timestamp_ns,
+    size_t block_id, size_t channel_id, uint32_t raw_distance)
   {
     auto point_to_packet_offset_ns =
-      sensor_.get_packet_relative_point_time_offset(block_id, channel_id, packet_);
+      ctx.packet_time_offsets.get(block_id, channel_id, raw_distance);
     auto packet_to_scan_offset_ns = static_cast<uint32_t>(packet_timestamp_ns - scan_timestamp_ns);
     return packet_to_scan_offset_ns + point_to_packet_offset_ns;
   }
 
-public:
-  /// @brief Constructor
-  /// @param sensor_configuration SensorConfiguration for this decoder
-  /// @param correction_data Calibration data for this decoder
-  explicit HesaiDecoder(
-    const std::shared_ptr<const HesaiSensorConfiguration> & sensor_configuration,
-    const std::shared_ptr<const typename SensorT::angle_corrector_t::correction_data_t> &
-      correction_data)
-  : sensor_configuration_(sensor_configuration),
-    angle_corrector_(
-      correction_data, sensor_configuration_->cloud_min_angle,
-      sensor_configuration_->cloud_max_angle, sensor_configuration_->cut_angle),
-    logger_(rclcpp::get_logger("HesaiDecoder"))
+  /// @brief Get an empty cloud from the pool, warning if the pool is exhausted (i.e. consumers
+  /// hold on to more than `point_cloud_pool_size - 2` scans)
+  NebulaPointCloudPtr acquire_point_cloud()
   {
-    logger_.set_level(rclcpp::Logger::Level::Debug);
-    RCLCPP_INFO_STREAM(logger_, *sensor_configuration_);
+    size_t n_misses = point_cloud_pool_.get_n_misses();
+    auto cloud = point_cloud_pool_.acquire();
+    if (organized_layout_) {
+      organized_layout_->reset(*cloud);
+    }
 
-    decode_pc_ = std::make_shared<NebulaPointCloud>();
-    output_pc_ = std::make_shared<NebulaPointCloud>();
+    // Warn on the 1st, 2nd, 4th, 8th, ... miss to not flood the log when consumers are slow
+    if (point_cloud_pool_.get_n_misses() != n_misses && (n_misses & (n_misses + 1)) == 0) {
+      RCLCPP_WARN_STREAM(
+        logger_, "All " << point_cloud_pool_.size() << " pooled point clouds are in use ("
+                        << n_misses + 1
+                        << " misses so far), allocating a new one. Consider increasing "
+                           "point_cloud_pool_size.");
+    }
 
-    decode_pc_->reserve(SensorT::max_scan_buffer_points);
-    output_pc_->reserve(SensorT::max_scan_buffer_points);
+    return cloud;
+  }
 
-    scan_cut_angles_ = {
-      deg2rad(sensor_configuration_->cloud_min_angle),
-      deg2rad(sensor_configuration_->cloud_max_angle), deg2rad(sensor_configuration_->cut_angle)};
+  /// @brief Sector mode only: updates `sector_index_` with the sector of the given return group
+  /// @param block_azimuth The raw azimuth of a return group inside the FoV
+  /// @return Whether the return group is the first of a new sector within the current scan. Since
+  /// the scan cut is handled separately, wrapping around to the first sector does not count.
+  bool starts_sector(uint32_t block_azimuth)
+  {
+    if (!sector_cloud_pool_) {
+      return false;
+    }
+
+    float offset_rad = normalize_angle(
+      angle_corrector_.get_block_azimuth_rad(block_azimuth) - scan_cut_angles_.scan_emit_angle,
+      M_PIf * 2);
+    auto sector_index = static_cast<uint32_t>(offset_rad / sector_angle_rad_);
+
+    bool is_new_sector = sector_index != sector_index_ && sector_index != 0;
+    sector_index_ = sector_index;
+    return is_new_sector;
   }
 
-  int unpack(const std::vector<uint8_t> & packet) override
+  /// @brief Sector mode only: copies the points of `pc` that are not part of a sector yet to a new
+  /// sector. Its timestamp is that of its earliest point, and point times are relative to it.
+  /// @param pc The cloud of the current scan
+  /// @param scan_timestamp_ns The timestamp of the current scan, which point times are relative to
+  void emit_sector(const NebulaPointCloud & pc, uint64_t scan_timestamp_ns)
   {
-    if (!parse_packet(packet)) {
-      return -1;
+    const size_t n_points = pc.points.size() - std::min(sector_begin_, pc.points.size());
+    if (n_points == 0) {
+      return;
     }
 
+    const NebulaPoint * points = pc.points.data() + sector_begin_;
+    sector_begin_ = pc.points.size();
+
+    uint32_t sector_offset_ns = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < n_points; ++i) {
+      sector_offset_ns = std::min(sector_offset_ns, points[i].time_stamp);
+    }
+
+    auto sector = sector_cloud_pool_->acquire();
+    sector->resize(n_points);
+    for (size_t i = 0; i < n_points; ++i) {
+      NebulaPoint & point = sector->points[i];
+      point = points[i];
+      point.time_stamp -= sector_offset_ns;
+    }
+
+    // Deskewed points are relative to the sensor pose at the scan timestamp, move them to the one
+    // at the sector timestamp. The motion is expressed in the sensor frame, so with an output
+    // transform it is conjugated into the output frame.
+    if (sensor_configuration_->deskew) {
+      RigidTransform scan_to_sector =
+        RigidTransform::from_twist(ctx_.sensor_twist, static_cast<double>(sector_offset_ns) * 1e-9)
+          .inverse();
+      if (output_transform_) {
+        scan_to_sector = *output_transform_ * scan_to_sector * output_transform_->inverse();
+      }
+      for (auto & point : sector->points) {
+        scan_to_sector.apply(point.x, point.y, point.z);
+      }
+    }
+
+    double sector_timestamp_s = static_cast<double>(scan_timestamp_ns + sector_offset_ns) * 1e-9;
+    sectors_.emplace_back(std::move(sector), sector_timestamp_s);
+  }
+
+  /// @brief The header stage run on every packet before its points are decoded: decodes the
+  /// timestamp of the packet in `ctx_` once for all users, and tracks its UDP sequence number
+  /// @param packet_size The number of bytes received, possibly including optional fields that are
+  /// not part of `packet_t`
+  void process_packet_header(size_t packet_size)
+  {
+    const auto & packet = *ctx_.packet;
+    ctx_.packet_timestamp_ns = timestamp_decoder_.get_timestamp_ns(packet);
+
+    if (sensor_configuration_->deskew) {
+      std::lock_guard lock(sensor_twist_mtx_);
+      ctx_.sensor_twist = sensor_twist_;
+    }
+
+    const auto sequence = hesai_packet::get_udp_sequence(packet, packet_size);
+    if (!sequence) {
+      return;
+    }
+
+    const uint64_t n_lost_before = decode_sequence_stats_.n_lost;
+    sequence_tracker_.update(*sequence, decode_sequence_stats_);
+    n_packets_lost_ += decode_sequence_stats_.n_lost - n_lost_before;
+
+    // Warn on the 1st, 2nd, 4th, 8th, ... gap to not flood the log
+    if (decode_sequence_stats_.n_lost != n_lost_before) {
+      ++n_sequence_gaps_;
+      if ((n_sequence_gaps_ & (n_sequence_gaps_ - 1)) == 0) {
+        RCLCPP_WARN_STREAM(
+          logger_, "UDP sequence gap before packet " << *sequence << " (" << n_packets_lost_
+                                                     << " packets lost in " << n_sequence_gaps_
+                                                     << " gaps so far)");
+      }
+    }
+  }
+
+  /// @brief Prepares the decoder for the packet in `ctx_`: selects the point fields to decode, sets
+  /// the initial scan timestamp and replaces the output cloud if it has been handed out
+  void begin_packet()
+  {
+    // Only the specialized kernels skip fields, and sectors are published with all fields. A scan
+    // has the fields that all packets contributing to it were decoded with.
+    const PointFieldMask requested_fields = requested_point_fields_.load();
+    const bool decode_minimal_fields = (requested_fields & ~minimal_point_fields) == 0 &&
+                                       !sector_cloud_pool_ &&
+                                       !sensor_configuration_->use_generic_return_kernel;
+    packet_point_fields_ = decode_minimal_fields ? minimal_point_fields : point_field::all;
+    decode_point_fields_ &= packet_point_fields_;
+    next_point_fields_ &= packet_point_fields_;
+
     // This is the first scan, set scan timestamp to whatever packet arrived first
     if (decode_scan_timestamp_ns_ == 0) {
-      decode_scan_timestamp_ns_ = hesai_packet::get_timestamp_ns(packet_) +
-                                  sensor_.get_earliest_point_time_offset_for_block(0, packet_);
+      decode_scan_timestamp_ns_ = ctx_.packet_timestamp_ns +
+                                  sensor_.get_earliest_point_time_offset_for_block(
+                                    0, *ctx_.packet, ctx_.packet_time_offsets);
     }
 
+    recycle_output_cloud();
+  }
+
+  /// @brief Replaces the output cloud if it has been handed out. The completed scan might still be
+  /// in use by whoever called `get_pointcloud()`, so continue with a recycled cloud instead of
+  /// clearing it.
+  void recycle_output_cloud()
+  {
     if (has_scanned_) {
-      output_pc_->clear();
+      output_pc_ = acquire_point_cloud();
       has_scanned_ = false;
     }
+  }
+
+  /// @brief Runs the scan cutting state machine over all return groups of the packet in `ctx_`.
+  /// Resets scan timestamps and decides where scans are cut, but leaves converting the points to
+  /// the given callbacks, so that this can be done on another thread.
+  /// @param n_returns The number of returns per return group
+  /// @param on_return_group Called with the first block id of every return group inside the FoV,
+  /// and whether the return group starts a new sector (see `starts_sector`)
+  /// @param on_scan_complete Called after the return group that completed the current scan
+  template <typename ReturnGroupFn, typename ScanCompleteFn>
+  void advance_scan_state(
+    size_t n_returns, ReturnGroupFn && on_return_group, ScanCompleteFn && on_scan_complete)
+  {
+    const auto & packet = *ctx_.packet;
 
-    const size_t n_returns = hesai_packet::get_n_returns(packet_.tail.return_mode);
     for (size_t block_id = 0; block_id < SensorT::packet_t::n_blocks; block_id += n_returns) {
-      auto block_azimuth = packet_.body.blocks[block_id].get_azimuth();
+      auto block_azimuth = packet.body.blocks[block_id].get_azimuth();
 
       if (angle_corrector_.passed_timestamp_reset_angle(last_azimuth_, block_azimuth)) {
         uint64_t new_scan_timestamp_ns =
-          hesai_packet::get_timestamp_ns(packet_) +
-          sensor_.get_earliest_point_time_offset_for_block(block_id, packet_);
+          ctx_.packet_timestamp_ns + sensor_.get_earliest_point_time_offset_for_block(
+                                       block_id, packet, ctx_.packet_time_offsets);
 
         if (sensor_configuration_->cut_angle == sensor_configuration_->cloud_max_angle) {
           // In the non-360 deg case, if the cut angle and FoV end coincide, the old pointcloud has
@@ -313,22 +1162,374 @@ public:
         continue;
       }
 
-      convert_returns(block_id, n_returns);
+      ++n_scan_return_groups_;
+      on_return_group(block_id, starts_sector(block_azimuth));
 
       if (angle_corrector_.passed_emit_angle(last_azimuth_, block_azimuth)) {
-        // The current `decode` pointcloud is ready for publishing, swap buffers to continue with
-        // the last `output` pointcloud as the `decode pointcloud.
-        std::swap(decode_pc_, output_pc_);
-        std::swap(decode_scan_timestamp_ns_, output_scan_timestamp_ns_);
-        has_scanned_ = true;
+        start_next_scan();
+        on_scan_complete();
       }
 
       last_azimuth_ = block_azimuth;
     }
+  }
+
+  /// @brief Moves the per-scan state on once the current scan is complete: its timestamp, sequence
+  /// statistics and point fields become those of the output scan, and those of the next scan
+  /// become the current ones
+  void start_next_scan()
+  {
+    std::swap(decode_scan_timestamp_ns_, output_scan_timestamp_ns_);
+    output_sequence_stats_ = decode_sequence_stats_;
+    decode_sequence_stats_ = {};
+    output_point_fields_ = decode_point_fields_;
+    decode_point_fields_ = next_point_fields_;
+    next_point_fields_ = packet_point_fields_;
+    n_scan_return_groups_ = 0;
+  }
+
+  /// @brief Hands out the current scan once all of its points have been added
+  /// @param scan_timestamp_ns The timestamp of the completed scan
+  void complete_scan(uint64_t scan_timestamp_ns)
+  {
+    if (sector_cloud_pool_) {
+      emit_sector(*decode_pc_, scan_timestamp_ns);
+      sector_begin_ = 0;
+    }
+
+    // The current `decode` pointcloud is ready for publishing, swap buffers to continue with the
+    // last `output` pointcloud as the `decode pointcloud.
+    std::swap(decode_pc_, output_pc_);
+    has_scanned_ = true;
+  }
+
+  /// @brief Parallel mode only: starts `n_workers` worker threads
+  void start_workers(size_t n_workers)
+  {
+    constexpr size_t max_points_per_packet =
+      SensorT::packet_t::n_blocks * SensorT::packet_t::n_channels;
+
+    packet_slots_.resize(n_workers * packet_slots_per_worker);
+    for (auto & slot : packet_slots_) {
+      slot.decode_points.reserve(max_points_per_packet);
+      slot.output_points.reserve(max_points_per_packet);
+      if (organized_layout_) {
+        slot.decode_return_ids.reserve(max_points_per_packet);
+        slot.output_return_ids.reserve(max_points_per_packet);
+      }
+    }
+
+    for (size_t i = 0; i < n_workers; ++i) {
+      auto & worker = *workers_.emplace_back(std::make_unique<Worker>());
+
+      if constexpr (SensorT::angle_corrector_t::is_thread_safe) {
+        worker.ctx.angle_corrector = &angle_corrector_;
+      } else {
+        worker.angle_corrector.emplace(angle_corrector_);
+        worker.ctx.angle_corrector = &*worker.angle_corrector;
+      }
+
+      worker.thread = std::thread([this, &worker]() { run_worker(worker); });
+    }
+  }
+
+  /// @brief Parallel mode only: converts submitted packets in the order they were submitted in,
+  /// until the decoder is destroyed
+  void run_worker(Worker & worker)
+  {
+    while (true) {
+      PacketSlot * slot = nullptr;
+      {
+        std::unique_lock lock(parallel_mtx_);
+        packet_submitted_cv_.wait(
+          lock, [this]() { return stop_workers_ || n_packets_dispatched_ < n_packets_submitted_; });
+        if (stop_workers_) {
+          return;
+        }
+        slot = &packet_slots_[n_packets_dispatched_++ % packet_slots_.size()];
+      }
+
+      convert_packet(worker.ctx, *slot);
+
+      {
+        std::lock_guard lock(parallel_mtx_);
+        slot->is_converted = true;
+      }
+      packet_converted_cv_.notify_one();
+    }
+  }
+
+  /// @brief Parallel mode only: converts all planned return groups of a packet to points
+  /// @param ctx The calling worker's conversion context
+  /// @param slot The planned packet, receives the converted points
+  void convert_packet(ConversionContext & ctx, PacketSlot & slot)
+  {
+    slot.decode_points.clear();
+    slot.output_points.clear();
+    slot.decode_return_ids.clear();
+    slot.output_return_ids.clear();
+
+    ctx.packet = &slot.packet;
+    ctx.packet_timestamp_ns = slot.packet_timestamp_ns;
+    ctx.packet_time_offsets = slot.packet_time_offsets;
+    ctx.sensor_twist = slot.sensor_twist;
+    ctx.decode_pc = &slot.decode_points;
+    ctx.output_pc = &slot.output_points;
+    if (organized_layout_) {
+      ctx.decode_return_ids = &slot.decode_return_ids;
+      ctx.output_return_ids = &slot.output_return_ids;
+    }
+
+    for (size_t i = 0; i < slot.n_return_groups; ++i) {
+      const ReturnGroupPlan & plan = slot.return_groups[i];
+      ctx.last_azimuth = plan.last_azimuth;
+      ctx.decode_scan_timestamp_ns = plan.decode_scan_timestamp_ns;
+      ctx.output_scan_timestamp_ns = plan.output_scan_timestamp_ns;
+      (this->*slot.convert_return_group_fn)(ctx, plan.start_block_id, slot.n_returns);
+
+      slot.decode_points_end[i] = slot.decode_points.size();
+      slot.output_points_end[i] = slot.output_points.size();
+    }
+  }
+
+  /// @brief Parallel mode only: runs the scan state machine over the packet in `ctx_` and submits
+  /// it to the workers. If the packet completes a scan, waits until the scan is fully merged so
+  /// that it can be returned right away, like in sequential mode.
+  /// @param n_returns The number of returns per return group
+  /// @param convert_return_group_fn The return group kernel to convert the packet with
+  void submit_packet(size_t n_returns, return_group_kernel_t convert_return_group_fn)
+  {
+    // Wait for a free slot, and keep the scan point clouds up to date in the meantime
+    const size_t n_slots = packet_slots_.size();
+    merge_packets(n_packets_submitted_ >= n_slots ? n_packets_submitted_ - n_slots + 1 : 0);
+
+    PacketSlot & slot = packet_slots_[n_packets_submitted_ % n_slots];
+    slot.packet = *ctx_.packet;
+    slot.packet_timestamp_ns = ctx_.packet_timestamp_ns;
+    slot.packet_time_offsets = ctx_.packet_time_offsets;
+    slot.sensor_twist = ctx_.sensor_twist;
+    slot.n_returns = n_returns;
+    slot.convert_return_group_fn = convert_return_group_fn;
+    slot.n_return_groups = 0;
+
+    bool completes_scan = false;
+    advance_scan_state(
+      n_returns,
+      [&](size_t block_id, bool starts_sector) {
+        slot.return_groups[slot.n_return_groups++] = {
+          block_id, last_azimuth_, decode_scan_timestamp_ns_, output_scan_timestamp_ns_,
+          starts_sector, false};
+      },
+      [&]() {
+        slot.return_groups[slot.n_return_groups - 1].completes_scan = true;
+        completes_scan = true;
+      });
+
+    {
+      std::lock_guard lock(parallel_mtx_);
+      ++n_packets_submitted_;
+    }
+    packet_submitted_cv_.notify_one();
+
+    if (completes_scan) {
+      merge_packets(n_packets_submitted_);
+    }
+  }
+
+  /// @brief Parallel mode only: appends the points of converted packets to the scan point clouds
+  /// in submission order, and cuts scans where planned
+  /// @param n_packets_to_merge Wait until at least this many packets have been merged. Packets
+  /// after those are merged as long as they are already converted.
+  void merge_packets(uint64_t n_packets_to_merge)
+  {
+    while (n_packets_merged_ < n_packets_submitted_) {
+      PacketSlot & slot = packet_slots_[n_packets_merged_ % packet_slots_.size()];
+      {
+        std::unique_lock lock(parallel_mtx_);
+        if (!slot.is_converted && n_packets_merged_ >= n_packets_to_merge) {
+          return;
+        }
+        packet_converted_cv_.wait(lock, [&slot]() { return slot.is_converted; });
+        slot.is_converted = false;
+      }
+
+      const auto & decode_points = slot.decode_points;
+      const auto & output_points = slot.output_points;
+      size_t decode_begin = 0;
+      size_t output_begin = 0;
+
+      for (size_t i = 0; i < slot.n_return_groups; ++i) {
+        const ReturnGroupPlan & plan = slot.return_groups[i];
+        if (plan.starts_sector) {
+          emit_sector(*decode_pc_, plan.decode_scan_timestamp_ns);
+        }
+
+        merge_points(
+          *decode_pc_, decode_points, slot.decode_return_ids, decode_begin,
+          slot.decode_points_end[i]);
+        merge_points(
+          *output_pc_, output_points, slot.output_return_ids, output_begin,
+          slot.output_points_end[i]);
+        decode_begin = slot.decode_points_end[i];
+        output_begin = slot.output_points_end[i];
+
+        if (plan.completes_scan) {
+          complete_scan(plan.decode_scan_timestamp_ns);
+        }
+      }
+
+      ++n_packets_merged_;
+    }
+  }
+
+public:
+  /// @brief Constructor
+  /// @param sensor_configuration SensorConfiguration for this decoder
+  /// @param correction_data Calibration data for this decoder
+  explicit HesaiDecoder(
+    const std::shared_ptr<const HesaiSensorConfiguration> & sensor_configuration,
+    const std::shared_ptr<const typename SensorT::angle_corrector_t::correction_data_t> &
+      correction_data)
+  : sensor_configuration_(sensor_configuration),
+    angle_corrector_(
+      correction_data, sensor_configuration_->cloud_min_angle,
+      sensor_configuration_->cloud_max_angle, sensor_configuration_->cut_angle,
+      sensor_configuration_->use_compact_trig_tables),
+    point_cloud_pool_(
+      sensor_configuration_->point_cloud_pool_size, SensorT::max_scan_buffer_points),
+    logger_(rclcpp::get_logger("HesaiDecoder"))
+  {
+    logger_.set_level(rclcpp::Logger::Level::Debug);
+    RCLCPP_INFO_STREAM(logger_, *sensor_configuration_);
+
+    if (sensor_configuration_->organized_cloud_columns > 0) {
+      organized_layout_.emplace(
+        SensorT::packet_t::n_channels, get_configured_n_returns(sensor_configuration_->return_mode),
+        sensor_configuration_->organized_cloud_columns,
+        deg2rad(sensor_configuration_->cloud_min_angle),
+        deg2rad(sensor_configuration_->cloud_max_angle));
+      ctx_.organized_layout = &*organized_layout_;
+    }
+
+    if (!sensor_configuration_->point_filter.is_empty()) {
+      point_filter_.emplace(sensor_configuration_->point_filter, SensorT::packet_t::n_channels);
+    }
+
+    output_transform_ = get_output_transform(*sensor_configuration_);
+
+    decode_pc_ = acquire_point_cloud();
+    output_pc_ = acquire_point_cloud();
+    ctx_.angle_corrector = &angle_corrector_;
+
+    // The configured limits are doubles, find the float limits that reject exactly the same
+    // float distances
+    min_range_ = std::max(
+      SensorT::min_range, point_conversion::float_ceil(sensor_configuration_->min_range));
+    max_range_ = std::min(
+      SensorT::max_range, point_conversion::float_floor(sensor_configuration_->max_range));
+
+    scan_cut_angles_ = {
+      deg2rad(sensor_configuration_->cloud_min_angle),
+      deg2rad(sensor_configuration_->cloud_max_angle), deg2rad(sensor_configuration_->cut_angle)};
+
+    if (sensor_configuration_->sector_angle > 0 && organized_layout_) {
+      RCLCPP_WARN_STREAM(
+        logger_, "Sectors are not supported for organized point clouds, ignoring sector_angle.");
+    } else if (sensor_configuration_->sector_angle > 0) {
+      // Sectors are copied out of the scan cloud right away, so they only need a fraction of its
+      // capacity. Allow for one rotation's worth of sectors to be in use by consumers.
+      const uint16_t sector_angle = std::min<uint16_t>(sensor_configuration_->sector_angle, 360);
+      const size_t n_sectors = (360 + sector_angle - 1) / sector_angle;
+      sector_cloud_pool_.emplace(
+        n_sectors + 1, 2 * SensorT::max_scan_buffer_points * sector_angle / 360);
+      sector_angle_rad_ = deg2rad(sector_angle);
+      sectors_.reserve(n_sectors);
+    }
+
+    if (sensor_configuration_->decoder_threads > 1) {
+      start_workers(sensor_configuration_->decoder_threads);
+    }
+  }
+
+  ~HesaiDecoder() override
+  {
+    {
+      std::lock_guard lock(parallel_mtx_);
+      stop_workers_ = true;
+    }
+    packet_submitted_cv_.notify_all();
+
+    for (auto & worker : workers_) {
+      worker->thread.join();
+    }
+  }
+
+  int unpack(util::span<const uint8_t> packet) override
+  {
+    sectors_.clear();
+    if (!parse_packet(packet)) {
+      return -1;
+    }
+
+    process_packet_header(packet.size());
+    begin_packet();
+
+    const size_t n_returns = hesai_packet::get_n_returns(ctx_.packet->tail.return_mode);
+    if (
+      organized_layout_ && n_returns > organized_layout_->get_n_returns() &&
+      !has_warned_organized_returns_) {
+      RCLCPP_WARN_STREAM(
+        logger_, "Packets have " << n_returns << " returns but organized clouds only have rows for "
+                                 << organized_layout_->get_n_returns()
+                                 << ", dropping the others. Check return_mode.");
+      has_warned_organized_returns_ = true;
+    }
+
+    const return_group_kernel_t convert_return_group_fn =
+      get_return_group_kernel(ctx_.packet->tail.return_mode, packet_point_fields_);
+
+    if (!workers_.empty()) {
+      submit_packet(n_returns, convert_return_group_fn);
+      return last_azimuth_;
+    }
+
+    advance_scan_state(
+      n_returns,
+      [&](size_t block_id, bool starts_sector) {
+        if (starts_sector) {
+          emit_sector(*decode_pc_, decode_scan_timestamp_ns_);
+        }
+
+        ctx_.last_azimuth = last_azimuth_;
+        ctx_.decode_scan_timestamp_ns = decode_scan_timestamp_ns_;
+        ctx_.output_scan_timestamp_ns = output_scan_timestamp_ns_;
+        ctx_.decode_pc = decode_pc_.get();
+        ctx_.output_pc = output_pc_.get();
+        (this->*convert_return_group_fn)(ctx_, block_id, n_returns);
+      },
+      [&]() { complete_scan(output_scan_timestamp_ns_); });
 
     return last_azimuth_;
   }
 
+  void unpack(
+    util::span<const util::span<const uint8_t>> packets, UnpackedPackets & unpacked) override
+  {
+    // Calls are qualified so that they are not dispatched virtually
+    for (size_t i = 0; i < packets.size(); ++i) {
+      if (HesaiDecoder::unpack(packets[i]) < 0) {
+        continue;
+      }
+
+      unpacked.sectors.insert(unpacked.sectors.end(), sectors_.begin(), sectors_.end());
+      if (has_scanned_) {
+        auto [pointcloud, timestamp_s] = HesaiDecoder::get_pointcloud();
+        unpacked.scans.push_back(
+          {pointcloud, timestamp_s, output_sequence_stats_, output_point_fields_, i});
+      }
+    }
+  }
+
   bool has_scanned() override { return has_scanned_; }
 
   std::tuple<drivers::NebulaPointCloudPtr, double> get_pointcloud() override
@@ -336,6 +1537,55 @@ public:
     double scan_timestamp_s = static_cast<double>(output_scan_timestamp_ns_) * 1e-9;
     return std::make_pair(output_pc_, scan_timestamp_s);
   }
+
+  PacketIntegrityCounters get_packet_integrity_counters() override
+  {
+    return packet_integrity_counters_;
+  }
+
+  PacketSequenceStats get_scan_sequence_stats() override { return output_sequence_stats_; }
+
+  bool flush_scan() override
+  {
+    sectors_.clear();
+    if (!workers_.empty()) {
+      merge_packets(n_packets_submitted_);
+    }
+
+    // Nothing inside the FoV has been decoded since the last scan was completed
+    if (n_scan_return_groups_ == 0) {
+      return false;
+    }
+
+    recycle_output_cloud();
+
+    const uint64_t scan_timestamp_ns = decode_scan_timestamp_ns_;
+    start_next_scan();
+
+    // If the timestamp reset angle has not been passed yet, the next scan has no timestamp. It is
+    // then set by the next packet, like for the first scan.
+    if (decode_scan_timestamp_ns_ <= scan_timestamp_ns) {
+      decode_scan_timestamp_ns_ = 0;
+    }
+
+    complete_scan(output_scan_timestamp_ns_);
+    return true;
+  }
+
+  std::vector<std::tuple<drivers::NebulaPointCloudPtr, double>> get_sectors() override
+  {
+    return sectors_;
+  }
+
+  void set_sensor_twist(const SensorTwist & twist) override
+  {
+    std::lock_guard lock(sensor_twist_mtx_);
+    sensor_twist_ = twist;
+  }
+
+  void set_point_fields(PointFieldMask fields) override { requested_point_fields_ = fields; }
+
+  PointFieldMask get_scan_point_fields() override { return output_point_fields_; }
 };
 
 }  // namespace nebula::drivers
@@ -14,10 +14,15 @@
 
 #pragma once
 
+#include "nebula_decoders/nebula_decoders_common/crc32.hpp"
+
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 namespace nebula::drivers::hesai_packet
 {
 
@@ -197,6 +202,28 @@ struct PacketBase
 
 #pragma pack(pop)
 
+/// @brief Whether the given value is one of the return modes in @ref return_mode::ReturnMode
+/// @param return_mode The return mode as found in the packet
+/// @return Whether @ref get_n_returns can be called with the return mode
+inline bool is_known_return_mode(uint8_t return_mode)
+{
+  switch (return_mode) {
+    case return_mode::SINGLE_FIRST:
+    case return_mode::SINGLE_SECOND:
+    case return_mode::SINGLE_STRONGEST:
+    case return_mode::SINGLE_LAST:
+    case return_mode::DUAL_LAST_STRONGEST:
+    case return_mode::DUAL_FIRST_SECOND:
+    case return_mode::DUAL_FIRST_LAST:
+    case return_mode::DUAL_FIRST_STRONGEST:
+    case return_mode::DUAL_STRONGEST_SECONDSTRONGEST:
+    case return_mode::TRIPLE_FIRST_LAST_STRONGEST:
+      return true;
+    default:
+      return false;
+  }
+}
+
 /// @brief Get the number of returns for a given return mode
 /// @param return_mode The return mode
 /// @return The number of returns
@@ -231,6 +258,87 @@ uint64_t get_timestamp_ns(const PacketT & packet)
   return packet.tail.date_time.get_seconds() * 1000000000 + packet.tail.timestamp * 1000;
 }
 
+/// @brief Decodes packet timestamps like @ref get_timestamp_ns, but converts dates to seconds since
+/// epoch only when the date changes. Hours, minutes and seconds are added on top of the cached
+/// midnight, which yields the same result as `timegm` on the full date and time.
+class TimestampDecoder
+{
+public:
+  /// @brief Get timestamp from packet in nanoseconds
+  /// @tparam PacketT The packet type
+  /// @param packet The packet to get the timestamp from
+  /// @return The timestamp in nanoseconds
+  template <typename PacketT>
+  uint64_t get_timestamp_ns(const PacketT & packet)
+  {
+    return get_seconds(packet.tail.date_time) * 1000000000 + packet.tail.timestamp * 1000;
+  }
+
+private:
+  template <int YearOffset>
+  uint64_t get_seconds(const DateTime<YearOffset> & date_time)
+  {
+    const uint32_t date_key = static_cast<uint32_t>(date_time.year) << 16 |
+                              static_cast<uint32_t>(date_time.month) << 8 | date_time.day;
+
+    if (!cached_date_key_ || *cached_date_key_ != date_key) {
+      DateTime<YearOffset> midnight = date_time;
+      midnight.hour = 0;
+      midnight.minute = 0;
+      midnight.second = 0;
+      cached_midnight_seconds_ = midnight.get_seconds();
+      cached_date_key_ = date_key;
+    }
+
+    return cached_midnight_seconds_ + date_time.hour * 3600 + date_time.minute * 60 +
+           date_time.second;
+  }
+
+  static uint64_t get_seconds(const SecondsSinceEpoch & seconds_since_epoch)
+  {
+    return seconds_since_epoch.get_seconds();
+  }
+
+  std::optional<uint32_t> cached_date_key_;
+  uint64_t cached_midnight_seconds_ = 0;
+};
+
+template <typename PacketT, typename = void>
+struct has_udp_sequence_member : std::false_type
+{
+};
+
+template <typename PacketT>
+struct has_udp_sequence_member<PacketT, std::void_t<decltype(PacketT::udp_sequence)>>
+: std::true_type
+{
+};
+
+/// @brief Get the UDP sequence number of the given packet. Some packet formats always have one as
+/// their last field. In all others, it is an optional field directly behind the tail that is only
+/// sent if enabled on the sensor.
+/// @tparam PacketT The packet type
+/// @param packet The packet, followed by the rest of the received bytes
+/// @param packet_size The number of bytes received, which can be more than `sizeof(PacketT)`
+/// @return The sequence number, or `std::nullopt` if the packet does not contain it
+template <typename PacketT>
+std::optional<uint32_t> get_udp_sequence(const PacketT & packet, size_t packet_size)
+{
+  if constexpr (has_udp_sequence_member<PacketT>::value) {
+    return packet.udp_sequence;
+  } else {
+    constexpr size_t sequence_offset = offsetof(PacketT, tail) + sizeof(packet.tail);
+    if (packet_size < sequence_offset + sizeof(uint32_t)) {
+      return std::nullopt;
+    }
+
+    uint32_t sequence{};
+    std::memcpy(
+      &sequence, reinterpret_cast<const uint8_t *>(&packet) + sequence_offset, sizeof(sequence));
+    return sequence;
+  }
+}
+
 /// @brief Get the distance unit of the given packet type in meters. Distance values in the packet,
 /// multiplied by this value, yield the distance in meters.
 /// @tparam PacketT The packet type
@@ -243,4 +351,88 @@ double get_dis_unit(const PacketT & packet)
   return packet.header.dis_unit / 1000.;
 }
 
+/// @brief The outcome of checking the CRCs of a packet
+enum class CrcCheckResult : uint8_t {
+  OK,
+  BODY_CRC_MISMATCH,
+  FUNCTIONAL_SAFETY_CRC_MISMATCH,
+  TAIL_CRC_MISMATCH,
+};
+
+template <typename PacketT, typename = void>
+struct has_body_crc : std::false_type
+{
+};
+
+template <typename PacketT>
+struct has_body_crc<PacketT, std::void_t<decltype(PacketT::crc_body)>> : std::true_type
+{
+};
+
+template <typename PacketT, typename = void>
+struct has_functional_safety : std::false_type
+{
+};
+
+template <typename PacketT>
+struct has_functional_safety<PacketT, std::void_t<decltype(PacketT::fs)>> : std::true_type
+{
+};
+
+template <typename PacketT, typename = void>
+struct has_tail_crc : std::false_type
+{
+};
+
+template <typename PacketT>
+struct has_tail_crc<PacketT, std::void_t<decltype(PacketT::tail_crc_offset)>> : std::true_type
+{
+};
+
+/// @brief Whether packets of the given type carry CRCs that @ref check_crcs can check
+template <typename PacketT>
+inline constexpr bool has_crcs_v = has_body_crc<PacketT>::value ||
+                                   has_functional_safety<PacketT>::value ||
+                                   has_tail_crc<PacketT>::value;
+
+/// @brief Check all CRCs (CRC-32/MPEG-2) the given packet type carries: the body CRC, the
+/// functional safety CRC and the tail CRC. The tail CRC is behind optional fields and is only
+/// checked if the packet is long enough to contain it.
+/// @tparam PacketT The packet type
+/// @param packet The packet, followed by the rest of the received bytes
+/// @param packet_size The number of bytes received, which can be more than `sizeof(PacketT)`
+/// @return The first mismatching CRC, or `OK` if all of them match
+template <typename PacketT>
+CrcCheckResult check_crcs(const PacketT & packet, [[maybe_unused]] size_t packet_size)
+{
+  if constexpr (has_body_crc<PacketT>::value) {
+    const auto * body = reinterpret_cast<const uint8_t *>(&packet.body);
+    if (crc32::mpeg2(body, sizeof(packet.body)) != packet.crc_body) {
+      return CrcCheckResult::BODY_CRC_MISMATCH;
+    }
+  }
+
+  if constexpr (has_functional_safety<PacketT>::value) {
+    const auto * fs = reinterpret_cast<const uint8_t *>(&packet.fs);
+    if (crc32::mpeg2(fs, sizeof(packet.fs) - sizeof(packet.fs.crc_fs)) != packet.fs.crc_fs) {
+      return CrcCheckResult::FUNCTIONAL_SAFETY_CRC_MISMATCH;
+    }
+  }
+
+  if constexpr (has_tail_crc<PacketT>::value) {
+    constexpr size_t tail_offset = offsetof(PacketT, tail);
+    constexpr size_t crc_offset = tail_offset + PacketT::tail_crc_offset;
+    if (packet_size >= crc_offset + sizeof(uint32_t)) {
+      const auto * bytes = reinterpret_cast<const uint8_t *>(&packet);
+      uint32_t crc_tail{};
+      std::memcpy(&crc_tail, bytes + crc_offset, sizeof(crc_tail));
+      if (crc32::mpeg2(bytes + tail_offset, PacketT::tail_crc_offset) != crc_tail) {
+        return CrcCheckResult::TAIL_CRC_MISMATCH;
+      }
+    }
+  }
+
+  return CrcCheckResult::OK;
+}
+
 }  // namespace nebula::drivers::hesai_packet
@@ -15,14 +15,59 @@
 #ifndef NEBULA_WS_HESAI_SCAN_DECODER_HPP
 #define NEBULA_WS_HESAI_SCAN_DECODER_HPP
 
+#include "nebula_decoders/nebula_decoders_common/packet_sequence_tracker.hpp"
+#include "nebula_decoders/nebula_decoders_common/rigid_transform.hpp"
+
 #include <nebula_common/hesai/hesai_common.hpp>
 #include <nebula_common/point_types.hpp>
+#include <nebula_common/util/span.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <tuple>
 #include <vector>
 
 namespace nebula::drivers
 {
+/// @brief Counts of the packets whose CRCs were checked, and of those rejected per CRC type
+struct PacketIntegrityCounters
+{
+  uint64_t n_packets_checked{0};
+  uint64_t n_body_crc_errors{0};
+  uint64_t n_functional_safety_crc_errors{0};
+  uint64_t n_tail_crc_errors{0};
+
+  [[nodiscard]] uint64_t get_n_rejected() const
+  {
+    return n_body_crc_errors + n_functional_safety_crc_errors + n_tail_crc_errors;
+  }
+};
+
+/// @brief A scan completed while unpacking a batch of packets, with the information that would
+/// otherwise have to be queried right after the packet that completed it
+struct CompletedScan
+{
+  NebulaPointCloudPtr pointcloud;
+  double timestamp_s;
+  PacketSequenceStats sequence_stats;
+  PointFieldMask point_fields;
+  /// @brief The index of the packet that completed the scan within its batch
+  size_t packet_index;
+};
+
+/// @brief The scans and sectors completed while unpacking a batch of packets, in decoding order
+struct UnpackedPackets
+{
+  std::vector<CompletedScan> scans;
+  std::vector<std::tuple<NebulaPointCloudPtr, double>> sectors;
+
+  void clear()
+  {
+    scans.clear();
+    sectors.clear();
+  }
+};
+
 /// @brief Base class for Hesai LiDAR decoder
 class HesaiScanDecoder
 {
@@ -35,10 +80,18 @@ public:
   virtual ~HesaiScanDecoder() = default;
   HesaiScanDecoder() = default;
 
-  /// @brief Parses PandarPacket and add its points to the point cloud
+  /// @brief Parses PandarPacket and add its points to the point cloud. The packet is decoded in
+  /// place and not referenced after the call returns.
   /// @param packet The incoming PandarPacket
   /// @return The last azimuth processed
-  virtual int unpack(const std::vector<uint8_t> & packet) = 0;
+  virtual int unpack(util::span<const uint8_t> packet) = 0;
+
+  /// @brief Parses a batch of packets as if each was passed to `unpack` in order, and collects the
+  /// scans and sectors they complete. Malformed packets are skipped.
+  /// @param packets The incoming packets, which are not referenced after the call returns
+  /// @param unpacked The completed scans and sectors are appended to this
+  virtual void unpack(
+    util::span<const util::span<const uint8_t>> packets, UnpackedPackets & unpacked) = 0;
 
   /// @brief Indicates whether one full scan is ready
   /// @return Whether a scan is ready
@@ -47,6 +100,47 @@ public:
   /// @brief Returns the point cloud and timestamp of the last scan
   /// @return A tuple of point cloud and timestamp in nanoseconds
   virtual std::tuple<drivers::NebulaPointCloudPtr, double> get_pointcloud() = 0;
+
+  /// @brief Completes the scan in progress as is, e.g. because packets have stopped arriving before
+  /// it could be completed. The scan can then be retrieved with `get_pointcloud()` like any other,
+  /// but it may lack part of the FoV. Its last sector, if any, is returned by `get_sectors()`.
+  /// @return Whether any of the FoV had been decoded into the scan in progress, i.e. whether a scan
+  /// was completed
+  virtual bool flush_scan() = 0;
+
+  /// @brief Returns the sectors completed by the last call to `unpack`, if `sector_angle` is set.
+  /// Each sector holds the points of the current scan decoded since the previous sector, with point
+  /// times relative to the sector's timestamp.
+  /// @return A tuple of point cloud and timestamp in seconds per sector, in decoding order
+  virtual std::vector<std::tuple<drivers::NebulaPointCloudPtr, double>> get_sectors() = 0;
+
+  /// @brief Returns the CRC validation counters. These stay zero unless `validate_packet_crcs` is
+  /// set and the sensor's packets carry CRCs.
+  /// @return The counters since the decoder was created
+  virtual PacketIntegrityCounters get_packet_integrity_counters() = 0;
+
+  /// @brief Returns the UDP sequence statistics of the packets that made up the last scan, i.e.
+  /// those received between the completion of the previous scan and that of the last one. Packets
+  /// without a sequence number (the field is optional for most sensors) are not counted.
+  /// @return The statistics of the last completed scan
+  virtual PacketSequenceStats get_scan_sequence_stats() = 0;
+
+  /// @brief Sets the current velocity of the sensor, used to deskew the points of subsequent
+  /// packets if `deskew` is set. Can be called from any thread.
+  /// @param twist The velocity of the sensor in the sensor frame
+  virtual void set_sensor_twist(const SensorTwist & twist) = 0;
+
+  /// @brief Sets the point fields that the consumers of subsequent scans read. Fields not in the
+  /// set may be left zero, which lets the decoder skip computing them. Can be called from any
+  /// thread.
+  /// @param fields The fields to decode, `point_field::all` by default
+  virtual void set_point_fields(PointFieldMask fields) = 0;
+
+  /// @brief Returns the fields that were decoded for all points of the last scan. After a call to
+  /// `set_point_fields`, this can lag behind by up to two scans, as scans already in progress keep
+  /// the fields they were started with.
+  /// @return The fields of the last completed scan
+  virtual PointFieldMask get_scan_point_fields() = 0;
 };
 }  // namespace nebula::drivers
 
@@ -21,6 +21,9 @@
 #include <nebula_common/nebula_common.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -29,6 +32,152 @@ namespace nebula::drivers
 
 enum class AngleCorrectionType { CALIBRATION, CORRECTION };
 
+/// @brief Get the return type of a non-duplicate point from its position in the return group
+///
+/// This is the `constexpr` equivalent of @ref HesaiSensor::get_return_type, minus the duplicate
+/// check, which has to be done on the point data by the caller.
+///
+/// @param return_mode The sensor's currently active return mode
+/// @param return_idx The block index of the point within the return group
+/// @param is_strongest Whether the point's reflectivity is greater or equal to that of all other
+/// points in the return group
+/// @param first_last_reversed Whether the sensor outputs DUAL_FIRST_LAST returns in (last, first)
+/// order
+/// @return The return type of the point
+constexpr ReturnType get_positional_return_type(
+  hesai_packet::return_mode::ReturnMode return_mode, unsigned int return_idx, bool is_strongest,
+  bool first_last_reversed)
+{
+  switch (return_mode) {
+    case hesai_packet::return_mode::SINGLE_FIRST:
+      return ReturnType::FIRST;
+    case hesai_packet::return_mode::SINGLE_SECOND:
+      return ReturnType::SECOND;
+    case hesai_packet::return_mode::SINGLE_STRONGEST:
+      return ReturnType::STRONGEST;
+    case hesai_packet::return_mode::SINGLE_LAST:
+      return ReturnType::LAST;
+    case hesai_packet::return_mode::DUAL_LAST_STRONGEST:
+      if (is_strongest) {
+        return return_idx == 0 ? ReturnType::LAST_STRONGEST : ReturnType::STRONGEST;
+      }
+      return return_idx == 0 ? ReturnType::LAST : ReturnType::SECONDSTRONGEST;
+    case hesai_packet::return_mode::DUAL_FIRST_SECOND:
+      return return_idx == 0 ? ReturnType::FIRST : ReturnType::SECOND;
+    case hesai_packet::return_mode::DUAL_FIRST_LAST:
+      return (return_idx == 0) != first_last_reversed ? ReturnType::FIRST : ReturnType::LAST;
+    case hesai_packet::return_mode::DUAL_FIRST_STRONGEST:
+      if (is_strongest) {
+        return return_idx == 0 ? ReturnType::FIRST_STRONGEST : ReturnType::STRONGEST;
+      }
+      return return_idx == 0 ? ReturnType::FIRST : ReturnType::SECONDSTRONGEST;
+    case hesai_packet::return_mode::DUAL_STRONGEST_SECONDSTRONGEST:
+      return return_idx == 0 ? ReturnType::STRONGEST : ReturnType::SECONDSTRONGEST;
+    case hesai_packet::return_mode::TRIPLE_FIRST_LAST_STRONGEST:
+      switch (return_idx) {
+        case 0:
+          return ReturnType::FIRST;
+        case 1:
+          return ReturnType::LAST;
+        case 2:
+          return ReturnType::STRONGEST;
+        default:
+          return ReturnType::UNKNOWN;
+      }
+    default:
+      return ReturnType::UNKNOWN;
+  }
+}
+
+/// @brief Compile-time table of the return types of all points in a return group
+/// @tparam ReturnMode The return mode the table is generated for
+/// @tparam NReturns The number of returns (blocks) per return group in that return mode
+/// @tparam FirstLastReversed Whether the sensor outputs DUAL_FIRST_LAST returns in (last, first)
+/// order
+template <
+  hesai_packet::return_mode::ReturnMode ReturnMode, size_t NReturns, bool FirstLastReversed>
+struct ReturnTypeTable
+{
+  /// @brief Whether the return type depends on which point in the group is the strongest
+  static constexpr bool depends_on_strength =
+    ReturnMode == hesai_packet::return_mode::DUAL_LAST_STRONGEST ||
+    ReturnMode == hesai_packet::return_mode::DUAL_FIRST_STRONGEST;
+
+  /// @brief Return types of non-duplicate points, indexed by [is_strongest][return_idx]
+  static constexpr std::array<std::array<ReturnType, NReturns>, 2> types = []() {
+    std::array<std::array<ReturnType, NReturns>, 2> result{};
+    for (unsigned int is_strongest = 0; is_strongest < 2; ++is_strongest) {
+      for (unsigned int return_idx = 0; return_idx < NReturns; ++return_idx) {
+        result[is_strongest][return_idx] = get_positional_return_type(
+          ReturnMode, return_idx, is_strongest != 0, FirstLastReversed);
+      }
+    }
+    return result;
+  }();
+};
+
+/// @brief The point time offsets of all channels of one block, relative to the packet timestamp
+/// @tparam NChannels The number of channels per block
+template <size_t NChannels>
+struct FiringTimeOffsets
+{
+  /// @brief Point time offset of each channel in nanoseconds
+  std::array<int, NChannels> channel_offset_ns{};
+  /// @brief The lowest of all channel offsets in nanoseconds
+  int min_offset_ns{0};
+};
+
+/// @brief Compile-time table of the point time offsets of a sensor, for all combinations of firing
+/// mode, azimuth state, near/far field firing, block and channel
+/// @tparam NModes The number of firing modes. Sensors combine the number of returns and any
+/// operational state that affects timing into one mode index.
+/// @tparam NAzimuthStates The number of azimuth states (1 for sensors without them)
+/// @tparam NFields The number of firing fields, 2 for sensors with near/far field firing, else 1
+/// @tparam NBlocks The number of blocks per packet
+/// @tparam NChannels The number of channels per block
+template <size_t NModes, size_t NAzimuthStates, size_t NFields, size_t NBlocks, size_t NChannels>
+struct FiringTimeOffsetTable
+{
+  using block_offsets_t = FiringTimeOffsets<NChannels>;
+
+  /// @brief Offsets, indexed by [mode][azimuth_state][field][block]
+  std::array<std::array<std::array<std::array<block_offsets_t, NBlocks>, NFields>, NAzimuthStates>,
+             NModes>
+    offsets{};
+
+  /// @brief Generate the table from the given function
+  /// @param get_offset_ns A `constexpr` callable taking (mode, azimuth_state, field, block_id,
+  /// channel_id) and returning the point time offset relative to the packet in nanoseconds
+  /// @return The complete table
+  template <typename OffsetFunctionT>
+  static constexpr FiringTimeOffsetTable generate(OffsetFunctionT get_offset_ns)
+  {
+    FiringTimeOffsetTable table{};
+    for (size_t mode = 0; mode < NModes; ++mode) {
+      for (size_t azimuth_state = 0; azimuth_state < NAzimuthStates; ++azimuth_state) {
+        for (size_t field = 0; field < NFields; ++field) {
+          for (uint32_t block_id = 0; block_id < NBlocks; ++block_id) {
+            auto & block_offsets = table.offsets[mode][azimuth_state][field][block_id];
+            block_offsets.min_offset_ns = 0x7FFFFFFF;  // MAXINT (max. positive value)
+            for (uint32_t channel_id = 0; channel_id < NChannels; ++channel_id) {
+              int offset_ns = get_offset_ns(mode, azimuth_state, field, block_id, channel_id);
+              block_offsets.channel_offset_ns[channel_id] = offset_ns;
+              block_offsets.min_offset_ns = std::min(block_offsets.min_offset_ns, offset_ns);
+            }
+          }
+        }
+      }
+    }
+    return table;
+  }
+
+  constexpr const block_offsets_t & at(
+    size_t mode, size_t azimuth_state, size_t field, size_t block_id) const
+  {
+    return offsets[mode][azimuth_state][field][block_id];
+  }
+};
+
 /// @brief Base class for all sensor definitions
 /// @tparam PacketT The packet type of the sensor
 template <typename PacketT, AngleCorrectionType AngleCorrection = AngleCorrectionType::CALIBRATION>
@@ -92,39 +241,111 @@ public:
     AngleCorrectorCalibrationBased<PacketT::n_channels, PacketT::degree_subdivisions>,
     AngleCorrectorCorrectionBased<PacketT::n_channels, PacketT::degree_subdivisions>>::type;
 
+  /// @brief Whether the sensor outputs DUAL_FIRST_LAST returns in (last, first) order. Sensors that
+  /// do so shadow this with `true`.
+  static constexpr bool first_last_reversed = false;
+
+  using block_offsets_t = FiringTimeOffsets<PacketT::n_channels>;
+  template <size_t NModes, size_t NAzimuthStates = 1, size_t NFields = 1>
+  using firing_time_offset_table_t = FiringTimeOffsetTable<
+    NModes, NAzimuthStates, NFields, PacketT::n_blocks, PacketT::n_channels>;
+
+  /// @brief The point time offsets of all blocks of one packet, selected from the sensor's
+  /// @ref FiringTimeOffsetTable by @ref get_packet_time_offsets
+  struct PacketTimeOffsets
+  {
+    /// @brief For each block, the offsets of its points in the far field firing sequence
+    std::array<const block_offsets_t *, PacketT::n_blocks> far_field{};
+    /// @brief For each block, the offsets of its points in the near field firing sequence. Same as
+    /// `far_field` for sensors without near field firing.
+    std::array<const block_offsets_t *, PacketT::n_blocks> near_field{};
+    /// @brief Units with a raw distance of up to this value are fired in the near field sequence
+    uint32_t max_near_field_distance{0};
+
+    /// @brief Get the point time offset of the given unit relative to the packet timestamp
+    /// @param block_id The unit's block id
+    /// @param channel_id The unit's channel id
+    /// @param raw_distance The unit's distance as found in the packet
+    /// @return The relative time offset in nanoseconds
+    int get(uint32_t block_id, uint32_t channel_id, uint32_t raw_distance) const
+    {
+      const block_offsets_t * block_offsets =
+        raw_distance <= max_near_field_distance ? near_field[block_id] : far_field[block_id];
+      return block_offsets->channel_offset_ns[channel_id];
+    }
+  };
+
   HesaiSensor() = default;
   virtual ~HesaiSensor() = default;
 
+  /// @brief Select the point time offsets of all blocks of the given packet. This is done once per
+  /// packet, so that finding the time offset of a point is a single lookup.
+  /// @param packet The packet, whose return mode has to be known (see
+  /// @ref hesai_packet::is_known_return_mode)
+  /// @param offsets The offsets to be filled in
+  /// @return Whether the sensor has firing times for the packet's combination of operating modes.
+  /// If not, `offsets` is not valid and the packet cannot be decoded.
+  [[nodiscard]] virtual bool get_packet_time_offsets(
+    const PacketT & packet, PacketTimeOffsets & offsets) = 0;
+
   /// @brief Computes the exact relative time between the timestamp of the given packet and the one
   /// of the point identified by the given block and channel, in nanoseconds
   /// @param block_id The point's block id
   /// @param channel_id The point's channel id
   /// @param packet The packet
   /// @return The relative time offset in nanoseconds
-  virtual int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const PacketT & packet) = 0;
+  int get_packet_relative_point_time_offset(
+    uint32_t block_id, uint32_t channel_id, const PacketT & packet)
+  {
+    PacketTimeOffsets offsets;
+    get_checked_packet_time_offsets(packet, offsets);
+    const auto & unit = packet.body.blocks[block_id].units[channel_id];
+    return offsets.get(block_id, channel_id, unit.distance);
+  }
 
   /// @brief For a given start block index, find the earliest (lowest) relative time offset of any
   /// point in the packet in or after the start block
   /// @param start_block_id The index of the block in and after which to consider points
   /// @param packet The packet
+  /// @param offsets The packet's time offsets as returned by @ref get_packet_time_offsets
   /// @return The lowest point time offset (relative to the packet timestamp) of any point in or
   /// after the start block, in nanoseconds
-  int get_earliest_point_time_offset_for_block(uint32_t start_block_id, const PacketT & packet)
+  static int get_earliest_point_time_offset_for_block(
+    uint32_t start_block_id, const PacketT & packet, const PacketTimeOffsets & offsets)
   {
     unsigned int n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
     int min_offset_ns = 0x7FFFFFFF;  // MAXINT (max. positive value)
 
     for (uint32_t block_id = start_block_id; block_id < start_block_id + n_returns; ++block_id) {
+      if (offsets.near_field[block_id] == offsets.far_field[block_id]) {
+        min_offset_ns = std::min(min_offset_ns, offsets.far_field[block_id]->min_offset_ns);
+        continue;
+      }
+
+      // Which sequence a channel fired in depends on its distance, so check them one by one
+      const auto & units = packet.body.blocks[block_id].units;
       for (uint32_t channel_id = 0; channel_id < PacketT::n_channels; ++channel_id) {
-        min_offset_ns = std::min(
-          min_offset_ns, get_packet_relative_point_time_offset(block_id, channel_id, packet));
+        min_offset_ns =
+          std::min(min_offset_ns, offsets.get(block_id, channel_id, units[channel_id].distance));
       }
     }
 
     return min_offset_ns;
   }
 
+  /// @brief For a given start block index, find the earliest (lowest) relative time offset of any
+  /// point in the packet in or after the start block
+  /// @param start_block_id The index of the block in and after which to consider points
+  /// @param packet The packet
+  /// @return The lowest point time offset (relative to the packet timestamp) of any point in or
+  /// after the start block, in nanoseconds
+  int get_earliest_point_time_offset_for_block(uint32_t start_block_id, const PacketT & packet)
+  {
+    PacketTimeOffsets offsets;
+    get_checked_packet_time_offsets(packet, offsets);
+    return get_earliest_point_time_offset_for_block(start_block_id, packet, offsets);
+  }
+
   /// @brief Get the return type of the point given by return_idx
   ///
   /// For duplicate points, the return type is reported as @ref ReturnType::IDENTICAL for all
@@ -189,6 +410,44 @@ public:
         return ReturnType::UNKNOWN;
     }
   }
+
+protected:
+  /// @brief The number of different return counts (single, dual, triple) covered by the firing
+  /// time tables of sensors. Index 0 is single return.
+  static constexpr size_t n_return_counts = 3;
+
+  /// @brief Select the offsets of all blocks for sensors whose timing only depends on the number of
+  /// returns, with the table's mode being the return count index
+  /// @param table The sensor's firing time table
+  /// @param packet The packet
+  /// @param offsets The offsets to be filled in
+  /// @return Always true, all return counts are covered
+  template <typename TableT>
+  static bool select_offsets_by_return_count(
+    const TableT & table, const PacketT & packet, PacketTimeOffsets & offsets)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    for (size_t block_id = 0; block_id < PacketT::n_blocks; ++block_id) {
+      offsets.far_field[block_id] = &table.at(n_returns - 1, 0, 0, block_id);
+    }
+    offsets.near_field = offsets.far_field;
+    offsets.max_near_field_distance = 0;
+    return true;
+  }
+
+private:
+  /// @brief @ref get_packet_time_offsets for the single-packet helpers, which throw on packets that
+  /// cannot be decoded
+  void get_checked_packet_time_offsets(const PacketT & packet, PacketTimeOffsets & offsets)
+  {
+    if (!hesai_packet::is_known_return_mode(packet.tail.return_mode)) {
+      throw std::runtime_error("Unknown return mode");
+    }
+
+    if (!get_packet_time_offsets(packet, offsets)) {
+      throw std::runtime_error("Unsupported combination of operating modes");
+    }
+  }
 };
 
 }  // namespace nebula::drivers
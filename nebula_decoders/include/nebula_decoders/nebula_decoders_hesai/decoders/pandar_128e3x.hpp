@@ -17,6 +17,8 @@
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_sensor.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 namespace nebula::drivers
@@ -73,6 +75,10 @@ struct Packet128E3X : public PacketBase<2, 128, 2, 100>
   FunctionalSafety fs;
   Tail128E3X tail;
 
+  /// @brief Offset of the tail CRC from the start of `tail`, behind the optional `udp_sequence`
+  /// and IMU fields. The CRC covers all bytes from the start of `tail` up to itself.
+  static constexpr size_t tail_crc_offset = sizeof(Tail128E3X) + 26;
+
   /* Ignored optional fields */
 
   // uint8_t cyber_security[32];
@@ -84,7 +90,7 @@ struct Packet128E3X : public PacketBase<2, 128, 2, 100>
 
 class Pandar128E3X : public HesaiSensor<hesai_packet::Packet128E3X>
 {
-private:
+protected:
   enum OperationalState { HIGH_RESOLUTION = 0, SHUTDOWN = 1, STANDARD = 2, ENERGY_SAVING = 3 };
 
   static constexpr int hires_as0_far_offset_ns[128] = {
@@ -216,52 +222,70 @@ private:
     -1,    -1, 33109, -1, -1, -1,   -1,    -1,    5201,  -1, -1, 30974, -1, -1, -1,
     -1,    -1, 34634, -1, -1, 1541, -1,    29319};
 
+  static constexpr float max_near_field_distance_m = 2.85f;
+
+  /// @brief Channel offset tables, indexed by [is_hires_mode][azimuth_state][is_nearfield].
+  /// Combinations the sensor does not support are `nullptr`.
+  static constexpr const int * channel_offsets_ns[2][4][2] = {
+    {{standard_as0_far_offset_ns, standard_as0_near_offset_ns},
+     {standard_as1_far_offset_ns, standard_as1_near_offset_ns},
+     {nullptr, nullptr},
+     {nullptr, nullptr}},
+    {{hires_as0_far_offset_ns, hires_as0_near_offset_ns},
+     {hires_as1_far_offset_ns, hires_as1_near_offset_ns},
+     {hires_as2_far_offset_ns, hires_as2_near_offset_ns},
+     {hires_as3_far_offset_ns, hires_as3_near_offset_ns}}};
+
+  /// @brief Point time offsets relative to the packet, indexed by
+  /// [(n_returns - 1) * 2 + is_hires_mode][azimuth_state][is_nearfield][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts * 2, 4, 2>::generate(
+      [](size_t mode, size_t azimuth_state, size_t field, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode / 2) + 1;
+        int block_offset_ns = 3148 - 27778 * 2 * (2 - block_id - 1) / n_returns;
+
+        const int * channel_offsets = channel_offsets_ns[mode % 2][azimuth_state][field];
+        int channel_offset_ns = channel_offsets ? channel_offsets[channel_id] : 0;
+
+        return block_offset_ns + channel_offset_ns;
+      });
+
 public:
   static constexpr float min_range = 0.1;
   static constexpr float max_range = 230.0;
   static constexpr size_t max_scan_buffer_points = 691200;
+  static constexpr bool first_last_reversed = true;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
     auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = 3148 - 27778 * 2 * (2 - block_id - 1) / n_returns;
-
-    int channel_offset_ns = 0;
     bool is_hires_mode = packet.tail.operational_state == OperationalState::HIGH_RESOLUTION;
-    bool is_nearfield = (hesai_packet::get_dis_unit(packet) *
-                         packet.body.blocks[block_id].units[channel_id].distance) <= 2.85f;
-    auto azimuth_state = packet.tail.get_azimuth_state(block_id);
-
-    if (is_hires_mode && azimuth_state == 0 && !is_nearfield)
-      channel_offset_ns = hires_as0_far_offset_ns[channel_id];
-    else if (is_hires_mode && azimuth_state == 0 && is_nearfield)
-      channel_offset_ns = hires_as0_near_offset_ns[channel_id];
-    else if (is_hires_mode && azimuth_state == 1 && !is_nearfield)
-      channel_offset_ns = hires_as1_far_offset_ns[channel_id];
-    else if (is_hires_mode && azimuth_state == 1 && is_nearfield)
-      channel_offset_ns = hires_as1_near_offset_ns[channel_id];
-    else if (is_hires_mode && azimuth_state == 2 && !is_nearfield)
-      channel_offset_ns = hires_as2_far_offset_ns[channel_id];
-    else if (is_hires_mode && azimuth_state == 2 && is_nearfield)
-      channel_offset_ns = hires_as2_near_offset_ns[channel_id];
-    else if (is_hires_mode && azimuth_state == 3 && !is_nearfield)
-      channel_offset_ns = hires_as3_far_offset_ns[channel_id];
-    else if (is_hires_mode && azimuth_state == 3 && is_nearfield)
-      channel_offset_ns = hires_as3_near_offset_ns[channel_id];
-    else if (!is_hires_mode && azimuth_state == 0 && !is_nearfield)
-      channel_offset_ns = standard_as0_far_offset_ns[channel_id];
-    else if (!is_hires_mode && azimuth_state == 0 && is_nearfield)
-      channel_offset_ns = standard_as0_near_offset_ns[channel_id];
-    else if (!is_hires_mode && azimuth_state == 1 && !is_nearfield)
-      channel_offset_ns = standard_as1_far_offset_ns[channel_id];
-    else if (!is_hires_mode && azimuth_state == 1 && is_nearfield)
-      channel_offset_ns = standard_as1_near_offset_ns[channel_id];
-    else
-      throw std::runtime_error(
-        "Invalid combination of operational state and azimuth state and nearfield firing");
-
-    return block_offset_ns + channel_offset_ns;
+    size_t mode = (n_returns - 1) * 2 + is_hires_mode;
+
+    for (size_t block_id = 0; block_id < packet_t::n_blocks; ++block_id) {
+      auto azimuth_state = packet.tail.get_azimuth_state(block_id);
+      if (!channel_offsets_ns[is_hires_mode][azimuth_state][0]) {
+        return false;
+      }
+
+      offsets.far_field[block_id] = &firing_time_offsets_.at(mode, azimuth_state, 0, block_id);
+      offsets.near_field[block_id] = &firing_time_offsets_.at(mode, azimuth_state, 1, block_id);
+    }
+
+    // Units are fired in the near field sequence if their distance is at most 2.85 m. Find the
+    // largest raw distance for which that is the case, instead of converting every unit's
+    // distance.
+    const double dis_unit = hesai_packet::get_dis_unit(packet);
+    auto max_distance =
+      static_cast<uint32_t>(std::min(max_near_field_distance_m / dis_unit, 65535.));
+    while (max_distance < 65535 && dis_unit * (max_distance + 1) <= max_near_field_distance_m) {
+      ++max_distance;
+    }
+    while (max_distance > 0 && dis_unit * max_distance > max_near_field_distance_m) {
+      --max_distance;
+    }
+    offsets.max_near_field_distance = max_distance;
+    return true;
   }
 
   ReturnType get_return_type(
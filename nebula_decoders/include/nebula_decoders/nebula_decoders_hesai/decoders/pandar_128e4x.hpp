@@ -40,7 +40,7 @@ using Packet128E4X = Packet128E3X;
 // (clouds do not sync to ToS but ToS+.052s)
 class Pandar128E4X : public HesaiSensor<hesai_packet::Packet128E4X>
 {
-private:
+protected:
   enum OperationalState { HIGH_RESOLUTION = 0, STANDARD = 1 };
 
   static constexpr int firing_time_offset_static_ns[128] = {
@@ -79,37 +79,53 @@ private:
     21980, 15446, 8912,  2378,  -1,    -1,    -1,    -1,    15446, 21980, 2378,  8912,  -1,
     -1,    -1,    -1,    21980, 15446, 8912,  2378,  -1,    -1,    -1,    -1};
 
+  /// @brief Point time offsets relative to the packet, indexed by
+  /// [(n_returns - 1) * 2 + is_hires_mode][azimuth_state][0][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts * 2, 2>::generate(
+      [](size_t mode, size_t azimuth_state, size_t, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode / 2) + 1;
+        bool is_hires_mode = mode % 2 == 1;
+
+        int block_offset_ns = 0;
+        if (n_returns == 1) {
+          block_offset_ns = -27778 * 2 * (2 - block_id - 1);
+        } else {
+          block_offset_ns = 0;
+        }
+
+        int channel_offset_ns = 0;
+        if (!is_hires_mode) {
+          channel_offset_ns = firing_time_offset_static_ns[channel_id];
+        } else {
+          if (azimuth_state == 0) {
+            channel_offset_ns = firing_time_offset_as0_ns[channel_id];
+          } else /* azimuth_state == 1 */ {
+            channel_offset_ns = firing_time_offset_as1_ns[channel_id];
+          }
+        }
+
+        return block_offset_ns + 43346 + channel_offset_ns;
+      });
+
 public:
   static constexpr float min_range = 0.1;
   static constexpr float max_range = 230.0;
   static constexpr size_t max_scan_buffer_points = 691200;
+  static constexpr bool first_last_reversed = true;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
     auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = 0;
-    if (n_returns == 1) {
-      block_offset_ns = -27778 * 2 * (2 - block_id - 1);
-    } else {
-      block_offset_ns = 0;
-    }
-
-    int channel_offset_ns = 0;
     bool is_hires_mode = packet.tail.operational_state == OperationalState::HIGH_RESOLUTION;
-    auto azimuth_state = packet.tail.get_azimuth_state(block_id);
-
-    if (!is_hires_mode) {
-      channel_offset_ns = firing_time_offset_static_ns[channel_id];
-    } else {
-      if (azimuth_state == 0) {
-        channel_offset_ns = firing_time_offset_as0_ns[channel_id];
-      } else /* azimuth_state == 1 */ {
-        channel_offset_ns = firing_time_offset_as1_ns[channel_id];
-      }
+    size_t mode = (n_returns - 1) * 2 + is_hires_mode;
+    for (size_t block_id = 0; block_id < packet_t::n_blocks; ++block_id) {
+      size_t azimuth_state = packet.tail.get_azimuth_state(block_id) == 0 ? 0 : 1;
+      offsets.far_field[block_id] = &firing_time_offsets_.at(mode, azimuth_state, 0, block_id);
     }
-
-    return block_offset_ns + 43346 + channel_offset_ns;
+    offsets.near_field = offsets.far_field;
+    offsets.max_near_field_distance = 0;
+    return true;
   }
 
   ReturnType get_return_type(
@@ -63,24 +63,30 @@ inline double get_dis_unit<Packet40P>(const Packet40P & /* packet */)
 
 class Pandar40 : public HesaiSensor<hesai_packet::Packet40P>
 {
-private:
+protected:
   static constexpr int firing_time_offset_ns_[40] = {
     -42220, -28470, -16040, -3620,  -45490, -31740, -47460, -54670, -20620, -33710,
     -40910, -8190,  -20620, -27160, -50730, -8190,  -14740, -36980, -45490, -52700,
     -23890, -31740, -38950, -11470, -18650, -25190, -48760, -6230,  -12770, -35010,
     -21920, -9500,  -43520, -29770, -17350, -4920,  -42220, -28470, -16040, -3620};
 
+  /// @brief Point time offsets relative to the packet, indexed by [n_returns - 1][0][0][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts>::generate(
+      [](size_t mode, size_t, size_t, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode) + 1;
+        int block_offset_ns = -28580 - 55560 * ((10 - block_id - 1) / n_returns);
+        return block_offset_ns + firing_time_offset_ns_[channel_id];
+      });
+
 public:
   static constexpr float min_range = 0.3f;
   static constexpr float max_range = 200.f;
   static constexpr size_t max_scan_buffer_points = 144000;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
-    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = -28580 - 55560 * ((10 - block_id - 1) / n_returns);
-    return block_offset_ns + firing_time_offset_ns_[channel_id];
+    return select_offsets_by_return_count(firing_time_offsets_, packet, offsets);
   }
 };
 
@@ -41,7 +41,7 @@ struct Packet64 : public PacketBase<6, 64, 2, 100>
 
 class Pandar64 : public HesaiSensor<hesai_packet::Packet64>
 {
-private:
+protected:
   static constexpr int firing_time_offset_ns[64] = {
     -23180, -21876, -20572, -19268, -17964, -16660, -11444, -46796, -7532,  -36956, -50732,
     -54668, -40892, -44828, -31052, -34988, -48764, -52700, -38924, -42860, -29084, -33020,
@@ -50,17 +50,23 @@ private:
     -4924,  -21876, -14052, -17964, -8836,  -19268, -3620,  -20572, -12748, -16660, -7532,
     -11444, -6228,  -15356, -10140, -4924,  -3620,  -14052, -8836,  -12748};
 
+  /// @brief Point time offsets relative to the packet, indexed by [n_returns - 1][0][0][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts>::generate(
+      [](size_t mode, size_t, size_t, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode) + 1;
+        int block_offset_ns = -42580 - 55560 * ((6 - block_id - 1) / n_returns);
+        return block_offset_ns + firing_time_offset_ns[channel_id];
+      });
+
 public:
   static constexpr float min_range = 0.3f;
   static constexpr float max_range = 200.f;
   static constexpr size_t max_scan_buffer_points = 230400;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
-    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = -42580 - 55560 * ((6 - block_id - 1) / n_returns);
-    return block_offset_ns + firing_time_offset_ns[channel_id];
+    return select_offsets_by_return_count(firing_time_offsets_, packet, offsets);
   }
 };
 
@@ -51,6 +51,10 @@ struct PacketAT128E2X : public PacketBase<2, 128, 2, 100 * 256>
   uint32_t crc_body;
   TailAT128E2X tail;
 
+  /// @brief Offset of the tail CRC from the start of `tail`, behind the optional `udp_sequence`.
+  /// The CRC covers all bytes from the start of `tail` up to itself.
+  static constexpr size_t tail_crc_offset = sizeof(TailAT128E2X) + sizeof(uint32_t);
+
   /* Ignored optional fields */
 
   // uint8_t cyber_security[32];
@@ -63,7 +67,7 @@ struct PacketAT128E2X : public PacketBase<2, 128, 2, 100 * 256>
 class PandarAT128
 : public HesaiSensor<hesai_packet::PacketAT128E2X, AngleCorrectionType::CORRECTION>
 {
-private:
+protected:
   static constexpr int firing_time_offset_ns[128] = {
     0,     0,     8240,  4112,  4144,  8240,  0,     0,     12424, 4144,  4112,  8264,  12376,
     12376, 8264,  12424, 0,     0,     4112,  8240,  4144,  0,     0,     4144,  12424, 8264,
@@ -76,23 +80,29 @@ private:
     4112,  4144,  8240,  8240,  8264,  12376, 12376, 12424, 4112,  4144,  0,     0,     0,
     0,     0,     12424, 8264,  8240,  4144,  8264,  8240,  12376, 12376, 8264};
 
+  /// @brief Point time offsets relative to the packet, indexed by [n_returns - 1][0][0][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts>::generate(
+      [](size_t mode, size_t, size_t, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode) + 1;
+        int block_offset_ns = 0;
+        if (n_returns == 1) {
+          block_offset_ns = -9249 - 41666 * (2 - block_id);
+        } else {
+          block_offset_ns = -9249 - 41666;
+        }
+
+        return block_offset_ns + firing_time_offset_ns[channel_id];
+      });
+
 public:
   static constexpr float min_range = 1.f;
   static constexpr float max_range = 180.0f;
   static constexpr size_t max_scan_buffer_points = 307200;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
-    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = 0;
-    if (n_returns == 1) {
-      block_offset_ns = -9249 - 41666 * (2 - block_id);
-    } else {
-      block_offset_ns = -9249 - 41666;
-    }
-
-    return block_offset_ns + firing_time_offset_ns[channel_id];
+    return select_offsets_by_return_count(firing_time_offsets_, packet, offsets);
   }
 };
 
@@ -51,6 +51,10 @@ struct PacketQT128C2X : public PacketBase<2, 128, 2, 100>
   FunctionalSafety fs;
   TailQT128C2X tail;
 
+  /// @brief Offset of the tail CRC from the start of `tail`, behind the optional `udp_sequence`.
+  /// The CRC covers all bytes from the start of `tail` up to itself.
+  static constexpr size_t tail_crc_offset = sizeof(TailQT128C2X) + sizeof(uint32_t);
+
   /* Ignored optional fields */
 
   // uint8_t cyber_security[32];
@@ -62,7 +66,7 @@ struct PacketQT128C2X : public PacketBase<2, 128, 2, 100>
 
 class PandarQT128 : public HesaiSensor<hesai_packet::PacketQT128C2X>
 {
-private:
+protected:
   // Channels 0-31 (starting at 0) do not fire, delay set to 0
   static constexpr int loop1[128] = {
     0,     0,     0,     0,     0,     0,     0,     0,     0,      0,     0,     0,     0,
@@ -89,25 +93,40 @@ private:
     33136, 58480, 7792,  83824, 86992,  10960, 61648, 36304, 39472, 64816, 14128, 90160, 93328,
     17296, 67984, 42640, 45808, 71152,  20464, 96496, 99664, 23632, 74320, 48976};
 
+  /// @brief Point time offsets relative to the packet, indexed by
+  /// [(n_returns - 1) * 2 + (mode_flag & 0x01)][0][0][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts * 2>::generate(
+      [](size_t mode, size_t, size_t, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode / 2) + 1;
+        bool is_loop1_mode = mode % 2 == 1;
+        int block_offset_ns = 9000 + 111110 * (2 - block_id - 1) / n_returns;
+
+        int channel_offset_ns = 0;
+        if (n_returns == 1) {
+          channel_offset_ns = block_id % 2 == 0 ? loop1[channel_id] : loop2[channel_id];
+        } else {
+          channel_offset_ns = is_loop1_mode ? loop1[channel_id] : loop2[channel_id];
+        }
+
+        return block_offset_ns + channel_offset_ns;
+      });
+
 public:
   static constexpr float min_range = 0.05;
   static constexpr float max_range = 50.0;
   static constexpr size_t max_scan_buffer_points = 172800;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
     auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = 9000 + 111110 * (2 - block_id - 1) / n_returns;
-
-    int channel_offset_ns = 0;
-    if (n_returns == 1) {
-      channel_offset_ns = block_id % 2 == 0 ? loop1[channel_id] : loop2[channel_id];
-    } else {
-      channel_offset_ns = packet.tail.mode_flag & 0x01 ? loop1[channel_id] : loop2[channel_id];
+    size_t mode = (n_returns - 1) * 2 + (packet.tail.mode_flag & 0x01);
+    for (size_t block_id = 0; block_id < packet_t::n_blocks; ++block_id) {
+      offsets.far_field[block_id] = &firing_time_offsets_.at(mode, 0, 0, block_id);
     }
-
-    return block_offset_ns + channel_offset_ns;
+    offsets.near_field = offsets.far_field;
+    offsets.max_near_field_distance = 0;
+    return true;
   }
 };
 
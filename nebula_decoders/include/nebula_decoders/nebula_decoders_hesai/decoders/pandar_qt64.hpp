@@ -50,7 +50,7 @@ struct PacketQT64 : public PacketBase<4, 64, 2, 100>
 
 class PandarQT64 : public HesaiSensor<hesai_packet::PacketQT64>
 {
-private:
+protected:
   static constexpr int firing_time_offset_ns[64] = {
     12310,  14370,  16430,  18490,  20540,  22600,  24660,  26710,  29160,  31220,  33280,
     35340,  37390,  39450,  41500,  43560,  46610,  48670,  50730,  52780,  54840,  56900,
@@ -59,17 +59,23 @@ private:
     105980, 108040, 110100, 112150, 115200, 117260, 119320, 121380, 123430, 125490, 127540,
     12960,  132050, 134110, 136170, 138220, 140280, 142340, 144390, 146450};
 
+  /// @brief Point time offsets relative to the packet, indexed by [n_returns - 1][0][0][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts>::generate(
+      [](size_t mode, size_t, size_t, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode) + 1;
+        int block_offset_ns = 25710 + (500000 * (block_id / n_returns)) / 3;
+        return block_offset_ns + firing_time_offset_ns[channel_id];
+      });
+
 public:
   static constexpr float min_range = 0.1f;
   static constexpr float max_range = 60.f;
   static constexpr size_t max_scan_buffer_points = 76800;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
-    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = 25710 + (500000 * (block_id / n_returns)) / 3;
-    return block_offset_ns + firing_time_offset_ns[channel_id];
+    return select_offsets_by_return_count(firing_time_offsets_, packet, offsets);
   }
 };
 
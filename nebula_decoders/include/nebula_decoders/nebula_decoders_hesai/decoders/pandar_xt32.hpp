@@ -52,18 +52,26 @@ struct PacketXT32 : public PacketBase<8, 32, 2, 100>
 
 class PandarXT32 : public HesaiSensor<hesai_packet::PacketXT32>
 {
+private:
+  /// @brief Point time offsets relative to the packet, indexed by [n_returns - 1][0][0][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts>::generate(
+      [](size_t mode, size_t, size_t, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode) + 1;
+        int block_offset_ns = 5632 - 50000 * ((8 - block_id - 1) / n_returns);
+        int channel_offset_ns = 368 + 1512 * channel_id;
+        return block_offset_ns + channel_offset_ns;
+      });
+
 public:
   static constexpr float min_range = 0.05f;
   static constexpr float max_range = 120.0f;
   static constexpr size_t max_scan_buffer_points = 256000;
+  static constexpr bool first_last_reversed = true;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
-    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = 5632 - 50000 * ((8 - block_id - 1) / n_returns);
-    int channel_offset_ns = 368 + 1512 * channel_id;
-    return block_offset_ns + channel_offset_ns;
+    return select_offsets_by_return_count(firing_time_offsets_, packet, offsets);
   }
 
   ReturnType get_return_type(
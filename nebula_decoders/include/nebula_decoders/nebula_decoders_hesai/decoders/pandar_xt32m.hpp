@@ -42,28 +42,35 @@ struct PacketXT32M2X : public PacketBase<6, 32, 3, 100>
 
 class PandarXT32M : public HesaiSensor<hesai_packet::PacketXT32M2X>
 {
+private:
+  /// @brief Point time offsets relative to the packet, indexed by [n_returns - 1][0][0][block]
+  static constexpr auto firing_time_offsets_ =
+    firing_time_offset_table_t<n_return_counts>::generate(
+      [](size_t mode, size_t, size_t, uint32_t block_id, uint32_t channel_id) {
+        int n_returns = static_cast<int>(mode) + 1;
+        int block_offset_ns = 0;
+        if (n_returns < 3) {
+          block_offset_ns = 5632 - 50000 * ((8 - block_id - 1) / n_returns);
+        } else /* n_returns == 3 */ {
+          block_offset_ns = 5632 - 50000 * ((6 - block_id - 1) / 3);
+        }
+
+        if (channel_id >= 16) {
+          channel_id -= 16;
+        }
+        int channel_offset_ns = 368 + 2888 * channel_id;
+
+        return block_offset_ns + channel_offset_ns;
+      });
+
 public:
   static constexpr float min_range = 0.5f;
   static constexpr float max_range = 300.0f;
   static constexpr size_t max_scan_buffer_points = 384000;
 
-  int get_packet_relative_point_time_offset(
-    uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
+  bool get_packet_time_offsets(const packet_t & packet, PacketTimeOffsets & offsets) override
   {
-    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
-    int block_offset_ns = 0;
-    if (n_returns < 3) {
-      block_offset_ns = 5632 - 50000 * ((8 - block_id - 1) / n_returns);
-    } else /* n_returns == 3 */ {
-      block_offset_ns = 5632 - 50000 * ((6 - block_id - 1) / 3);
-    }
-
-    if (channel_id >= 16) {
-      channel_id -= 16;
-    }
-    int channel_offset_ns = 368 + 2888 * channel_id;
-
-    return block_offset_ns + channel_offset_ns;
+    return select_offsets_by_return_count(firing_time_offsets_, packet, offsets);
   }
 };
 
@@ -0,0 +1,103 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+/// @brief Vectorized kernels converting a whole block of units to points at once.
+///
+/// The kernels are implemented for SSE4.1 and AVX2, with a scalar fallback. The best instruction
+/// set supported by the CPU is selected at runtime, so the library does not have to be compiled
+/// for a specific target. All implementations yield bit-identical results.
+namespace nebula::drivers::point_conversion
+{
+
+enum class SimdLevel : uint8_t { SCALAR, SSE4_1, AVX2 };
+
+inline std::string to_string(SimdLevel level)
+{
+  switch (level) {
+    case SimdLevel::SCALAR:
+      return "scalar";
+    case SimdLevel::SSE4_1:
+      return "SSE4.1";
+    case SimdLevel::AVX2:
+      return "AVX2";
+    default:
+      return "unknown";
+  }
+}
+
+/// @brief The best instruction set supported by both the CPU and this build
+SimdLevel get_max_supported_simd_level();
+
+/// @brief The instruction set currently used by the kernels
+SimdLevel get_simd_level();
+
+/// @brief Select the instruction set used by the kernels, e.g. for testing or benchmarking. Levels
+/// not supported by the CPU are clamped to the maximum supported one.
+/// @return The level that is in use after the call
+SimdLevel set_simd_level(SimdLevel level);
+
+/// @brief Scale raw distances to meters and check them against the valid range.
+///
+/// The scaling is done in double precision and rounded to float, exactly like
+/// `static_cast<float>(raw_distance * dis_unit)`.
+///
+/// @param raw_distances The raw distance values of `n` units
+/// @param n The number of units
+/// @param dis_unit The distance unit of the raw values in meters
+/// @param min_range The smallest valid distance in meters (inclusive)
+/// @param max_range The largest valid distance in meters (inclusive)
+/// @param distances Output: the `n` distances in meters
+/// @param valid Output: for each unit, 1 if its raw distance is non-zero and its distance is within
+/// [min_range, max_range], 0 otherwise
+void scale_distances(
+  const uint16_t * raw_distances, size_t n, double dis_unit, float min_range, float max_range,
+  float * distances, uint8_t * valid);
+
+/// @brief Convert `n` points from spherical to cartesian coordinates:
+/// `x = (d * cos_el) * sin_az`, `y = (d * cos_el) * cos_az`, `z = d * sin_el`
+void project_to_cartesian(
+  const float * distances, const float * cos_elevation, const float * sin_elevation,
+  const float * cos_azimuth, const float * sin_azimuth, size_t n, float * x, float * y, float * z);
+
+/// @brief The smallest float `f` with `f >= value`. For any float `d`, `d < value` is equivalent
+/// to `d < float_ceil(value)`, which allows range checks against double limits in float lanes.
+inline float float_ceil(double value)
+{
+  auto result = static_cast<float>(value);
+  if (static_cast<double>(result) < value) {
+    result = std::nextafter(result, std::numeric_limits<float>::infinity());
+  }
+  return result;
+}
+
+/// @brief The largest float `f` with `f <= value`. For any float `d`, `value < d` is equivalent to
+/// `float_floor(value) < d`.
+inline float float_floor(double value)
+{
+  auto result = static_cast<float>(value);
+  if (static_cast<double>(result) > value) {
+    result = std::nextafter(result, -std::numeric_limits<float>::infinity());
+  }
+  return result;
+}
+
+}  // namespace nebula::drivers::point_conversion
@@ -18,6 +18,7 @@
 #include "nebula_common/hesai/hesai_common.hpp"
 #include "nebula_common/nebula_status.hpp"
 #include "nebula_common/point_types.hpp"
+#include "nebula_common/util/span.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_scan_decoder.hpp"
 
 #include <pcl_conversions/pcl_conversions.h>
@@ -64,11 +65,57 @@ public:
   Status set_calibration_configuration(
     const HesaiCalibrationConfigurationBase & calibration_configuration);
 
+  /// @brief Convert raw packet to pointcloud. The packet is decoded in place, without copying.
+  /// @param packet Packet to convert
+  /// @return Tuple of pointcloud and timestamp
+  std::tuple<drivers::NebulaPointCloudPtr, double> parse_cloud_packet(
+    util::span<const uint8_t> packet);
+
   /// @brief Convert raw packet to pointcloud
   /// @param packet Packet to convert
   /// @return Tuple of pointcloud and timestamp
   std::tuple<drivers::NebulaPointCloudPtr, double> parse_cloud_packet(
     const std::vector<uint8_t> & packet);
+
+  /// @brief Convert a batch of raw packets to pointclouds, with the same result as passing each to
+  /// `parse_cloud_packet` in order. The packets are decoded in place, without copying.
+  /// @param packets Packets to convert
+  /// @param unpacked The completed scans (with their sequence statistics and point fields) and, if
+  /// `sector_angle` is set, sectors are appended to this
+  void parse_cloud_packets(
+    util::span<const util::span<const uint8_t>> packets, UnpackedPackets & unpacked);
+
+  /// @brief Complete the scan in progress as is, without waiting for the packets that would
+  /// complete it
+  /// @return Tuple of the incomplete pointcloud and timestamp, or an empty tuple if no points have
+  /// been decoded since the last scan was completed
+  std::tuple<drivers::NebulaPointCloudPtr, double> flush_scan();
+
+  /// @brief Get the decoder's CRC validation counters
+  /// @return The counters, all zero if the driver is not initialized
+  PacketIntegrityCounters get_packet_integrity_counters();
+
+  /// @brief Get the UDP sequence statistics of the packets of the last completed scan
+  /// @return The statistics, all zero if the driver is not initialized
+  PacketSequenceStats get_scan_sequence_stats();
+
+  /// @brief Get the sectors completed by the last parsed packet, if `sector_angle` is set
+  /// @return A tuple of point cloud and timestamp in seconds per sector, empty if the driver is not
+  /// initialized
+  std::vector<std::tuple<drivers::NebulaPointCloudPtr, double>> get_sectors();
+
+  /// @brief Set the current velocity of the sensor, used for deskewing if `deskew` is set
+  /// @param twist The velocity of the sensor in the sensor frame
+  void set_sensor_twist(const SensorTwist & twist);
+
+  /// @brief Set the point fields that the consumers of subsequent scans read, see
+  /// `HesaiScanDecoder::set_point_fields`
+  /// @param fields The fields to decode
+  void set_point_fields(PointFieldMask fields);
+
+  /// @brief Get the fields that were decoded for all points of the last completed scan
+  /// @return The fields, none if the driver is not initialized
+  PointFieldMask get_scan_point_fields();
 };
 
 }  // namespace nebula::drivers
@@ -15,10 +15,13 @@
 #pragma once
 
 #include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_decoders/nebula_decoders_common/azimuth_trig_table.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/decoders/angle_corrector.hpp"
 
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <optional>
 
 namespace nebula::drivers
 {
@@ -27,20 +30,16 @@ template <size_t ChannelN, size_t AngleUnit>
 class AngleCorrectorCalibrationBased : public AngleCorrector
 {
 private:
-  static constexpr size_t max_azimuth = 360 * AngleUnit;
-
   std::array<float, ChannelN> elevation_angle_rad_{};
-  std::array<float, ChannelN> azimuth_offset_rad_{};
-  std::array<float, max_azimuth> block_azimuth_rad_{};
 
   std::array<float, ChannelN> elevation_cos_{};
   std::array<float, ChannelN> elevation_sin_{};
-  std::array<std::array<float, ChannelN>, max_azimuth> azimuth_cos_{};
-  std::array<std::array<float, ChannelN>, max_azimuth> azimuth_sin_{};
+  std::optional<AzimuthTrigTable<ChannelN, AngleUnit>> azimuth_trig_table_;
 
 public:
   explicit AngleCorrectorCalibrationBased(
-    const std::shared_ptr<const RobosenseCalibrationConfiguration> & sensor_calibration)
+    const std::shared_ptr<const RobosenseCalibrationConfiguration> & sensor_calibration,
+    bool use_compact_trig_tables = false)
   : AngleCorrector(sensor_calibration)
   {
     if (sensor_calibration == nullptr) {
@@ -48,41 +47,35 @@ public:
         "Cannot instantiate AngleCorrectorCalibrationBased without calibration data");
     }
 
+    std::array<float, ChannelN> azimuth_offset_rad{};
+
     for (size_t channel_id = 0; channel_id < ChannelN; ++channel_id) {
       const auto correction = sensor_calibration->get_correction(channel_id);
       float elevation_angle_deg = correction.elevation;
       float azimuth_offset_deg = correction.azimuth;
 
       elevation_angle_rad_[channel_id] = deg2rad(elevation_angle_deg);
-      azimuth_offset_rad_[channel_id] = deg2rad(azimuth_offset_deg);
+      azimuth_offset_rad[channel_id] = deg2rad(azimuth_offset_deg);
 
       elevation_cos_[channel_id] = cosf(elevation_angle_rad_[channel_id]);
       elevation_sin_[channel_id] = sinf(elevation_angle_rad_[channel_id]);
     }
 
-    for (size_t block_azimuth = 0; block_azimuth < max_azimuth; block_azimuth++) {
-      block_azimuth_rad_[block_azimuth] = deg2rad(block_azimuth / static_cast<double>(AngleUnit));
-
-      for (size_t channel_id = 0; channel_id < ChannelN; ++channel_id) {
-        float precision_azimuth =
-          block_azimuth_rad_[block_azimuth] + azimuth_offset_rad_[channel_id];
-
-        azimuth_cos_[block_azimuth][channel_id] = cosf(precision_azimuth);
-        azimuth_sin_[block_azimuth][channel_id] = sinf(precision_azimuth);
-      }
-    }
+    azimuth_trig_table_.emplace(azimuth_offset_rad, use_compact_trig_tables);
   }
 
   CorrectedAngleData get_corrected_angle_data(uint32_t block_azimuth, uint32_t channel_id) override
   {
-    float azimuth_rad = block_azimuth_rad_[block_azimuth] + azimuth_offset_rad_[channel_id];
+    float azimuth_rad = azimuth_trig_table_->get_block_azimuth_rad(block_azimuth) +
+                        azimuth_trig_table_->get_azimuth_offset_rad(channel_id);
     float elevation_rad = elevation_angle_rad_[channel_id];
+    SinCos azimuth_sin_cos = azimuth_trig_table_->get_sin_cos(block_azimuth, channel_id);
 
     return {
       azimuth_rad,
       elevation_rad,
-      azimuth_sin_[block_azimuth][channel_id],
-      azimuth_cos_[block_azimuth][channel_id],
+      azimuth_sin_cos.sin,
+      azimuth_sin_cos.cos,
       elevation_sin_[channel_id],
       elevation_cos_[channel_id],
       sensor_calibration_->calibration[channel_id].channel};
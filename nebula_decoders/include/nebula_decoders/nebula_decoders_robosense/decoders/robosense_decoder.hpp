@@ -15,13 +15,18 @@
 #pragma once
 
 #include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_common/util/span.hpp"
+#include "nebula_decoders/nebula_decoders_common/rigid_transform.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/decoders/robosense_packet.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/decoders/robosense_scan_decoder.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -40,13 +45,17 @@ protected:
   /// @brief Decodes azimuth/elevation angles given calibration/correction data
   typename SensorT::angle_corrector_t angle_corrector_;
 
+  /// @brief The transform from the sensor frame to the output frame, if they differ
+  std::optional<RigidTransform> output_transform_;
+
   /// @brief The point cloud new points get added to
   NebulaPointCloudPtr decode_pc_;
   /// @brief The point cloud that is returned when a scan is complete
   NebulaPointCloudPtr output_pc_;
 
-  /// @brief The last decoded packet
-  typename SensorT::packet_t packet_;
+  /// @brief The packet currently being decoded. Points into the buffer passed to `unpack` and is
+  /// only valid during that call.
+  const typename SensorT::packet_t * packet_ = nullptr;
   /// @brief The last azimuth processed
   int last_phase_;
   /// @brief The timestamp of the last completed scan in nanoseconds
@@ -58,23 +67,29 @@ protected:
 
   rclcpp::Logger logger_;
 
-  /// @brief Validates and parses MsopPacket. Currently only checks size, not checksums etc.
+  /// @brief Validates and parses MsopPacket. Currently only checks size and alignment, not
+  /// checksums etc. The packet is not copied but viewed in place.
   /// @param msop_packet The incoming MsopPacket
   /// @return Whether the packet was parsed successfully
-  bool parse_packet(const std::vector<uint8_t> & msop_packet)
+  bool parse_packet(util::span<const uint8_t> msop_packet)
   {
-    if (msop_packet.size() < sizeof(typename SensorT::packet_t)) {
+    using packet_t = typename SensorT::packet_t;
+    static_assert(std::is_trivially_copyable_v<packet_t>);
+
+    if (msop_packet.size() < sizeof(packet_t)) {
       RCLCPP_ERROR_STREAM(
-        logger_, "Packet size mismatch: " << msop_packet.size() << " | Expected at least: "
-                                          << sizeof(typename SensorT::packet_t));
+        logger_, "Packet size mismatch: " << msop_packet.size()
+                                          << " | Expected at least: " << sizeof(packet_t));
       return false;
     }
-    if (std::memcpy(&packet_, msop_packet.data(), sizeof(typename SensorT::packet_t))) {
-      return true;
+
+    if (reinterpret_cast<std::uintptr_t>(msop_packet.data()) % alignof(packet_t) != 0) {
+      RCLCPP_ERROR(logger_, "Packet buffer is misaligned");
+      return false;
     }
 
-    RCLCPP_ERROR(logger_, "Packet memcopy failed");
-    return false;
+    packet_ = reinterpret_cast<const packet_t *>(msop_packet.data());
+    return true;
   }
 
   /// @brief Converts a group of returns (i.e. 1 for single return, 2 for dual return, etc.) to
@@ -83,8 +98,8 @@ protected:
   /// @param n_blocks The number of returns in the group
   void convert_returns(size_t start_block_id, size_t n_blocks)
   {
-    uint64_t packet_timestamp_ns = robosense_packet::get_timestamp_ns(packet_);
-    uint32_t raw_azimuth = packet_.body.blocks[start_block_id].get_azimuth();
+    uint64_t packet_timestamp_ns = robosense_packet::get_timestamp_ns(*packet_);
+    uint32_t raw_azimuth = packet_->body.blocks[start_block_id].get_azimuth();
 
     std::vector<const typename SensorT::packet_t::body_t::block_t::unit_t *> return_units;
 
@@ -94,7 +109,7 @@ protected:
       return_units.clear();
       for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
         return_units.push_back(
-          &packet_.body.blocks[block_offset + start_block_id].units[channel_id]);
+          &packet_->body.blocks[block_offset + start_block_id].units[channel_id]);
       }
 
       for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
@@ -158,6 +173,9 @@ protected:
         point.x = xyDistance * corrected_angle_data.cos_azimuth;
         point.y = -xyDistance * corrected_angle_data.sin_azimuth;
         point.z = distance * corrected_angle_data.sin_elevation;
+        if (output_transform_) {
+          output_transform_->apply(point.x, point.y, point.z);
+        }
 
         // The driver wrapper converts to degrees, expects radians
         point.azimuth = corrected_angle_data.azimuth_rad;
@@ -181,7 +199,7 @@ protected:
   /// @return The distance in meters
   float get_distance(const typename SensorT::packet_t::body_t::block_t::unit_t & unit)
   {
-    return unit.distance.value() * robosense_packet::get_dis_unit(packet_);
+    return unit.distance.value() * robosense_packet::get_dis_unit(*packet_);
   }
 
   /// @brief Get timestamp of point in nanoseconds, relative to scan timestamp. Includes firing time
@@ -207,7 +225,8 @@ public:
     const std::shared_ptr<const RobosenseSensorConfiguration> & sensor_configuration,
     const std::shared_ptr<const RobosenseCalibrationConfiguration> & calibration_configuration)
   : sensor_configuration_(sensor_configuration),
-    angle_corrector_(calibration_configuration),
+    angle_corrector_(calibration_configuration, sensor_configuration_->use_compact_trig_tables),
+    output_transform_(get_output_transform(*sensor_configuration_)),
     logger_(rclcpp::get_logger("RobosenseDecoder"))
   {
     logger_.set_level(rclcpp::Logger::Level::Debug);
@@ -220,14 +239,14 @@ public:
     output_pc_->reserve(SensorT::max_scan_buffer_points);
   }
 
-  int unpack(const std::vector<uint8_t> & msop_packet) override
+  int unpack(util::span<const uint8_t> msop_packet) override
   {
     if (!parse_packet(msop_packet)) {
       return -1;
     }
 
     if (decode_scan_timestamp_ns_ == 0) {
-      decode_scan_timestamp_ns_ = robosense_packet::get_timestamp_ns(packet_);
+      decode_scan_timestamp_ns_ = robosense_packet::get_timestamp_ns(*packet_);
     }
 
     if (has_scanned_) {
@@ -243,7 +262,7 @@ public:
     for (size_t block_id = 0; block_id < SensorT::packet_t::n_blocks; block_id += n_returns) {
       current_azimuth =
         (360 * SensorT::packet_t::degree_subdivisions +
-         packet_.body.blocks[block_id].get_azimuth() -
+         packet_->body.blocks[block_id].get_azimuth() -
          static_cast<int>(
            sensor_configuration_->scan_phase * SensorT::packet_t::degree_subdivisions)) %
         (360 * SensorT::packet_t::degree_subdivisions);
@@ -259,7 +278,7 @@ public:
         // calculated as the packet timestamp plus the lowest time offset of any point in the
         // remainder of the packet
         decode_scan_timestamp_ns_ =
-          robosense_packet::get_timestamp_ns(packet_) +
+          robosense_packet::get_timestamp_ns(*packet_) +
           sensor_.get_earliest_point_time_offset_for_block(block_id, sensor_configuration_);
       }
 
@@ -15,9 +15,10 @@
 #pragma once
 
 #include "nebula_common/point_types.hpp"
+#include "nebula_common/util/span.hpp"
 
+#include <cstdint>
 #include <tuple>
-#include <vector>
 
 namespace nebula::drivers
 {
@@ -33,10 +34,11 @@ public:
   virtual ~RobosenseScanDecoder() = default;
   RobosenseScanDecoder() = default;
 
-  /// @brief Parses RobosensePacket and add its points to the point cloud
+  /// @brief Parses RobosensePacket and add its points to the point cloud. The packet is decoded in
+  /// place and not referenced after the call returns.
   /// @param msop_packet The incoming MsopPacket
   /// @return The last azimuth processed
-  virtual int unpack(const std::vector<uint8_t> & msop_packet) = 0;
+  virtual int unpack(util::span<const uint8_t> msop_packet) = 0;
 
   /// @brief Indicates whether one full scan is ready
   /// @return Whether a scan is ready
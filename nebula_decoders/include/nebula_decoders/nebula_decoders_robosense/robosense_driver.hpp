@@ -18,6 +18,7 @@
 #include "nebula_common/nebula_status.hpp"
 #include "nebula_common/point_types.hpp"
 #include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_common/util/span.hpp"
 #include "nebula_decoders/nebula_decoders_common/nebula_driver_base.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/decoders/robosense_scan_decoder.hpp"
 
@@ -60,8 +61,14 @@ public:
   Status set_calibration_configuration(
     const CalibrationConfigurationBase & calibration_configuration) override;
 
-  /// @brief Convert RobosenseScan message to point cloud
-  /// @param robosense_scan Message
+  /// @brief Convert MSOP packet to point cloud. The packet is decoded in place, without copying.
+  /// @param packet The MSOP packet
+  /// @return tuple of Point cloud and timestamp
+  std::tuple<drivers::NebulaPointCloudPtr, double> parse_cloud_packet(
+    util::span<const uint8_t> packet);
+
+  /// @brief Convert MSOP packet to point cloud
+  /// @param packet The MSOP packet
   /// @return tuple of Point cloud and timestamp
   std::tuple<drivers::NebulaPointCloudPtr, double> parse_cloud_packet(
     const std::vector<uint8_t> & packet);
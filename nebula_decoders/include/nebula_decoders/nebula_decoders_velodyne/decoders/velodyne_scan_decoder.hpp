@@ -16,8 +16,10 @@
 #define NEBULA_WS_VELODYNE_SCAN_DECODER_HPP
 
 #include <nebula_common/point_types.hpp>
+#include <nebula_common/util/span.hpp>
 #include <nebula_common/velodyne/velodyne_calibration_decoder.hpp>
 #include <nebula_common/velodyne/velodyne_common.hpp>
+#include <nebula_decoders/nebula_decoders_common/rigid_transform.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <velodyne_msgs/msg/velodyne_packet.hpp>
@@ -28,10 +30,12 @@
 #include <angles/angles.h>
 #include <pcl/point_cloud.h>
 
+#include <array>
 #include <cerrno>
 #include <cmath>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -166,7 +170,7 @@ protected:
   /// @param packet_seconds The packet's timestamp in seconds, including the sub-second part
   /// @param phase The sensor's scan phase used for scan cutting
   void check_and_handle_scan_complete(
-    const std::vector<uint8_t> & packet, double packet_seconds, const uint32_t phase)
+    util::span<const uint8_t> packet, double packet_seconds, const uint32_t phase)
   {
     if (has_scanned_) {
       processed_packets_ = 0;
@@ -208,6 +212,52 @@ protected:
   /// @brief Calibration for this decoder
   std::shared_ptr<const drivers::VelodyneCalibrationConfiguration> calibration_configuration_;
 
+  /// @brief The transform from the sensor frame to the output frame, if they differ
+  std::optional<RigidTransform> output_transform_;
+  /// @brief Output transform only: the horizontal unit vector (cos, -sin, 0) of each azimuth,
+  /// rotated into the output frame. With the rotation folded into this table, a point is projected
+  /// and transformed with about as many operations as it takes to project it alone.
+  std::vector<std::array<float, 3>> output_azimuth_vectors_;
+
+  /// @brief Set up `output_transform_` and `output_azimuth_vectors_` from the sensor configuration
+  /// @param cos_rot_table, sin_rot_table The cosine/sine of each azimuth in 0.01 degree units
+  void init_output_transform(const float * cos_rot_table, const float * sin_rot_table)
+  {
+    output_transform_ = get_output_transform(*sensor_configuration_);
+    if (!output_transform_) {
+      return;
+    }
+
+    output_azimuth_vectors_.resize(g_rotation_max_units);
+    for (size_t i = 0; i < output_azimuth_vectors_.size(); ++i) {
+      float x = cos_rot_table[i];
+      float y = -sin_rot_table[i];
+      float z = 0;
+      // Only rotate, the translation is added per point
+      RigidTransform rotation = *output_transform_;
+      rotation.translation = {};
+      rotation.apply(x, y, z);
+      output_azimuth_vectors_[i] = {x, y, z};
+    }
+  }
+
+  /// @brief Output transform only: compute the coordinates of a point in the output frame from the
+  /// folded azimuth table
+  /// @param azimuth The azimuth in 0.01 degree units
+  /// @param xy_distance The distance of the point in the xy plane of the sensor
+  /// @param z_sensor The z coordinate of the point in the sensor frame
+  /// @param x, y, z (out) The coordinates of the point in the output frame
+  void project_to_output_frame(
+    uint16_t azimuth, float xy_distance, float z_sensor, float & x, float & y, float & z) const
+  {
+    const auto & horizontal = output_azimuth_vectors_[azimuth];
+    const auto & r = output_transform_->rotation;
+    const auto & t = output_transform_->translation;
+    x = xy_distance * horizontal[0] + z_sensor * r[2] + t[0];
+    y = xy_distance * horizontal[1] + z_sensor * r[5] + t[1];
+    z = xy_distance * horizontal[2] + z_sensor * r[8] + t[2];
+  }
+
 public:
   VelodyneScanDecoder(VelodyneScanDecoder && c) = delete;
   VelodyneScanDecoder & operator=(VelodyneScanDecoder && c) = delete;
@@ -217,9 +267,11 @@ public:
   virtual ~VelodyneScanDecoder() = default;
   VelodyneScanDecoder() = default;
 
-  /// @brief Virtual function for parsing and shaping VelodynePacket
-  /// @param pandar_packet
-  virtual void unpack(const std::vector<uint8_t> & packet, double packet_seconds) = 0;
+  /// @brief Virtual function for parsing and shaping VelodynePacket. The packet is decoded in place
+  /// and has to be at least `sizeof(raw_packet_t)` bytes long and suitably aligned.
+  /// @param packet The packet buffer
+  /// @param packet_seconds The packet's timestamp in seconds, including the sub-second part
+  virtual void unpack(util::span<const uint8_t> packet, double packet_seconds) = 0;
   /// @brief Virtual function for parsing VelodynePacket based on packet structure
   /// @param pandar_packet
   /// @return Resulting flag
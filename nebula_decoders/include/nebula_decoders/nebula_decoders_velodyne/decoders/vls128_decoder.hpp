@@ -39,7 +39,7 @@ public:
       calibration_configuration);
   /// @brief Parsing and shaping VelodynePacket
   /// @param velodyne_packet
-  void unpack(const std::vector<uint8_t> & packet, double packet_seconds) override;
+  void unpack(util::span<const uint8_t> packet, double packet_seconds) override;
   /// @brief Calculation of points in each packet
   /// @return # of points
   int points_per_packet() override;
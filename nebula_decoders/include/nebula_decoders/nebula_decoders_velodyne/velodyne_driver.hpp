@@ -18,6 +18,7 @@
 #include "nebula_common/nebula_common.hpp"
 #include "nebula_common/nebula_status.hpp"
 #include "nebula_common/point_types.hpp"
+#include "nebula_common/util/span.hpp"
 #include "nebula_common/velodyne/velodyne_common.hpp"
 #include "nebula_decoders/nebula_decoders_common/nebula_driver_base.hpp"
 #include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_scan_decoder.hpp"
@@ -65,8 +66,17 @@ public:
   /// @return Current status
   Status get_status();
 
-  /// @brief Convert VelodyneScan message to point cloud
-  /// @param velodyne_scan Message
+  /// @brief Convert Velodyne packet to point cloud. The packet is decoded in place, without
+  /// copying.
+  /// @param packet The packet
+  /// @param packet_seconds The packet's timestamp in seconds
+  /// @return tuple of Point cloud and timestamp
+  std::tuple<drivers::NebulaPointCloudPtr, double> parse_cloud_packet(
+    util::span<const uint8_t> packet, double packet_seconds);
+
+  /// @brief Convert Velodyne packet to point cloud
+  /// @param packet The packet
+  /// @param packet_seconds The packet's timestamp in seconds
   /// @return tuple of Point cloud and timestamp
   std::tuple<drivers::NebulaPointCloudPtr, double> parse_cloud_packet(
     const std::vector<uint8_t> & packet, double packet_seconds);
@@ -0,0 +1,108 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "nebula_decoders/nebula_decoders_common/crc32.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NEBULA_CRC32_X86
+#include <immintrin.h>
+#endif
+
+namespace nebula::drivers::crc32
+{
+namespace
+{
+
+/// @brief x^n mod P for the given (non-reflected) polynomial P
+constexpr uint32_t x_pow_mod(uint32_t n, uint32_t polynomial)
+{
+  uint32_t result = 1;
+  for (uint32_t i = 0; i < n; ++i) {
+    result = (result & 0x80000000U) ? (result << 1) ^ polynomial : result << 1;
+  }
+  return result;
+}
+
+#ifdef NEBULA_CRC32_X86
+
+// The data is processed as a polynomial over GF(2) with the first bit being the highest
+// coefficient. An accumulator A of 128 bits is kept. For every further 16 bytes D, A * x^128 + D
+// is reduced to 128 bits again by replacing x^192 and x^128 with their (32-bit) residues mod P:
+//   A * x^128 + D = A_hi * x^192 + A_lo * x^128 + D
+//                 = A_hi * (x^192 mod P) + A_lo * (x^128 mod P) + D  (mod P)
+// This does not change the CRC, which is finally computed from the 16 bytes of A.
+constexpr uint64_t k_fold_hi = x_pow_mod(192, mpeg2_polynomial);
+constexpr uint64_t k_fold_lo = x_pow_mod(128, mpeg2_polynomial);
+
+/// @brief Reverse the byte order of a 128-bit register, so that bit i of the register is the
+/// coefficient of x^i
+__attribute__((target("ssse3"))) inline __m128i byte_reverse(__m128i value)
+{
+  return _mm_shuffle_epi8(
+    value, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+__attribute__((target("ssse3"))) inline __m128i load_reversed(const uint8_t * data)
+{
+  return byte_reverse(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)));
+}
+
+__attribute__((target("pclmul,ssse3"))) uint32_t mpeg2_pclmul(
+  const uint8_t * data, size_t size, uint32_t crc)
+{
+  if (size < 16) return mpeg2_bytewise(data, size, crc);
+
+  const __m128i k_fold = _mm_set_epi64x(k_fold_hi, k_fold_lo);
+
+  // The CRC register's initial value is equivalent to XOR-ing it into the first 32 bits of data
+  __m128i acc = _mm_xor_si128(load_reversed(data), _mm_set_epi32(static_cast<int>(crc), 0, 0, 0));
+  data += 16;
+  size -= 16;
+
+  for (; size >= 16; data += 16, size -= 16) {
+    __m128i hi = _mm_clmulepi64_si128(acc, k_fold, 0x11);
+    __m128i lo = _mm_clmulepi64_si128(acc, k_fold, 0x00);
+    acc = _mm_xor_si128(_mm_xor_si128(hi, lo), load_reversed(data));
+  }
+
+  alignas(16) uint8_t acc_bytes[16];
+  _mm_store_si128(reinterpret_cast<__m128i *>(acc_bytes), byte_reverse(acc));
+
+  crc = mpeg2_bytewise(acc_bytes, sizeof(acc_bytes), 0);
+  return mpeg2_bytewise(data, size, crc);
+}
+
+#endif
+
+using mpeg2_fn_t = uint32_t (*)(const uint8_t *, size_t, uint32_t);
+
+mpeg2_fn_t detect_mpeg2_implementation()
+{
+#ifdef NEBULA_CRC32_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3")) return &mpeg2_pclmul;
+#endif
+  return &mpeg2_slice_by_8;
+}
+
+mpeg2_fn_t get_mpeg2_implementation()
+{
+  static const mpeg2_fn_t implementation = detect_mpeg2_implementation();
+  return implementation;
+}
+
+}  // namespace
+
+uint32_t mpeg2(const uint8_t * data, size_t size, uint32_t crc)
+{
+  return get_mpeg2_implementation()(data, size, crc);
+}
+
+bool is_mpeg2_accelerated()
+{
+  return get_mpeg2_implementation() != &mpeg2_slice_by_8;
+}
+
+}  // namespace nebula::drivers::crc32
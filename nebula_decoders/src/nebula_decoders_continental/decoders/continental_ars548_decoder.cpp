@@ -63,10 +63,9 @@ Status ContinentalARS548Decoder::register_packets_callback(
   return Status::OK;
 }
 
-bool ContinentalARS548Decoder::process_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+bool ContinentalARS548Decoder::process_packet(const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
-  const auto & data = packet_msg->data;
+  const auto & data = packet_msg.data;
 
   if (data.size() < sizeof(HeaderPacket)) {
     return false;
@@ -86,13 +85,13 @@ bool ContinentalARS548Decoder::process_packet(
       return false;
     }
 
-    parse_detections_list_packet(*packet_msg);
+    parse_detections_list_packet(packet_msg);
   } else if (header.method_id.value() == object_list_method_id) {
     if (data.size() != object_list_udp_payload || header.length.value() != object_list_pdu_length) {
       return false;
     }
 
-    parse_objects_list_packet(*packet_msg);
+    parse_objects_list_packet(packet_msg);
   } else if (header.method_id.value() == sensor_status_method_id) {
     if (
       data.size() != sensor_status_udp_payload ||
@@ -100,14 +99,14 @@ bool ContinentalARS548Decoder::process_packet(
       return false;
     }
 
-    parse_sensor_status_packet(*packet_msg);
+    parse_sensor_status_packet(packet_msg);
   }
 
   // Some messages are not parsed but are still sent to the user (e.g., filters)
   if (nebula_packets_callback_) {
     auto packets_msg = std::make_unique<nebula_msgs::msg::NebulaPackets>();
-    packets_msg->packets.emplace_back(std::move(*packet_msg));
-    packets_msg->header.stamp = packet_msg->stamp;
+    packets_msg->packets.emplace_back(packet_msg);
+    packets_msg->header.stamp = packet_msg.stamp;
     packets_msg->header.frame_id = config_ptr_->frame_id;
     nebula_packets_callback_(std::move(packets_msg));
   }
@@ -92,76 +92,75 @@ Status ContinentalSRR520Decoder::register_packets_callback(
   return Status::OK;
 }
 
-bool ContinentalSRR520Decoder::process_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+bool ContinentalSRR520Decoder::process_packet(const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
-  const uint32_t can_message_id = (static_cast<uint32_t>(packet_msg->data[0]) << 24) |
-                                  (static_cast<uint32_t>(packet_msg->data[1]) << 16) |
-                                  (static_cast<uint32_t>(packet_msg->data[2]) << 8) |
-                                  static_cast<uint32_t>(packet_msg->data[3]);
+  const uint32_t can_message_id = (static_cast<uint32_t>(packet_msg.data[0]) << 24) |
+                                  (static_cast<uint32_t>(packet_msg.data[1]) << 16) |
+                                  (static_cast<uint32_t>(packet_msg.data[2]) << 8) |
+                                  static_cast<uint32_t>(packet_msg.data[3]);
 
-  std::size_t payload_size = packet_msg->data.size() - 4;
+  std::size_t payload_size = packet_msg.data.size() - 4;
 
   if (can_message_id == rdi_near_header_can_message_id) {
     if (payload_size != rdi_near_header_packet_size) {
       print_error("rdi_near_header_can_message_id message with invalid size");
       return false;
     }
-    process_near_header_packet(std::move(packet_msg));
+    process_near_header_packet(packet_msg);
   } else if (can_message_id == rdi_near_element_can_message_id) {
     if (payload_size != rdi_near_element_packet_size) {
       print_error("rdi_near_element_can_message_id message with invalid size");
       return false;
     }
 
-    process_near_element_packet(std::move(packet_msg));
+    process_near_element_packet(packet_msg);
   } else if (can_message_id == rdi_hrr_header_can_message_id) {
     if (payload_size != rdi_hrr_header_packet_size) {
       print_error("rdi_hrr_header_can_message_id message with invalid size");
       return false;
     }
-    process_hrr_header_packet(std::move(packet_msg));
+    process_hrr_header_packet(packet_msg);
   } else if (can_message_id == rdi_hrr_element_can_message_id) {
     if (payload_size != rdi_hrr_element_packet_size) {
       print_error("rdi_hrr_element_can_message_id message with invalid size");
       return false;
     }
 
-    process_hrr_element_packet(std::move(packet_msg));
+    process_hrr_element_packet(packet_msg);
   } else if (can_message_id == object_header_can_message_id) {
     if (payload_size != object_header_packet_size) {
       print_error("object_header_can_message_id message with invalid size");
       return false;
     }
-    process_object_header_packet(std::move(packet_msg));
+    process_object_header_packet(packet_msg);
   } else if (can_message_id == object_can_message_id) {
     if (payload_size != object_packet_size) {
       print_error("object_element_can_message_id message with invalid size");
       return false;
     }
 
-    process_object_element_packet(std::move(packet_msg));
+    process_object_element_packet(packet_msg);
   } else if (can_message_id == crc_list_can_message_id) {
     if (payload_size != crc_list_packet_size) {
       print_error("crc_list_can_message_id message with invalid size");
       return false;
     }
 
-    process_crc_list_packet(std::move(packet_msg));
+    process_crc_list_packet(packet_msg);
   } else if (can_message_id == status_can_message_id) {
     if (payload_size != status_packet_size) {
       print_error("crc_list_can_message_id message with invalid size");
       return false;
     }
 
-    process_sensor_status_packet(std::move(packet_msg));
+    process_sensor_status_packet(packet_msg);
   } else if (can_message_id == sync_follow_up_can_message_id) {
     if (payload_size != sync_follow_up_can_packet_size) {
       print_error("sync_follow_up_can_message_id message with invalid size");
       return false;
     }
 
-    process_sync_follow_up_packet(std::move(packet_msg));
+    process_sync_follow_up_packet(packet_msg);
   } else if (
     can_message_id != veh_dyn_can_message_id && can_message_id != sensor_config_can_message_id) {
     print_error("Unrecognized message ID=" + std::to_string(can_message_id));
@@ -172,7 +171,7 @@ bool ContinentalSRR520Decoder::process_packet(
 }
 
 void ContinentalSRR520Decoder::process_near_header_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   constexpr float v_ambiguous_resolution = 0.003051851f;
   constexpr float v_ambiguous_min_value = -100.f;
@@ -182,10 +181,10 @@ void ContinentalSRR520Decoder::process_near_header_packet(
 
   static_assert(sizeof(ScanHeaderPacket) == rdi_near_header_packet_size);
   static_assert(sizeof(DetectionPacket) == rdi_near_element_packet_size);
-  assert(packet_msg->data.size() == rdi_near_header_packet_size + 4);
+  assert(packet_msg.data.size() == rdi_near_header_packet_size + 4);
 
   std::memcpy(
-    &rdi_near_header_packet_, packet_msg->data.data() + 4 * sizeof(uint8_t),
+    &rdi_near_header_packet_, packet_msg.data.data() + 4 * sizeof(uint8_t),
     sizeof(ScanHeaderPacket));
 
   assert(
@@ -200,10 +199,10 @@ void ContinentalSRR520Decoder::process_near_header_packet(
     near_detection_list_ptr_->header.stamp.nanosec =
       rdi_near_header_packet_.u_global_time_stamp_nsec.value();
   } else {
-    near_detection_list_ptr_->header.stamp = packet_msg->stamp;
+    near_detection_list_ptr_->header.stamp = packet_msg.stamp;
   }
 
-  rdi_near_packets_ptr_->header.stamp = packet_msg->stamp;
+  rdi_near_packets_ptr_->header.stamp = packet_msg.stamp;
   rdi_near_packets_ptr_->header.frame_id = sensor_configuration_->frame_id;
 
   near_detection_list_ptr_->internal_time_stamp_usec = rdi_near_header_packet_.u_time_stamp.value();
@@ -220,11 +219,11 @@ void ContinentalSRR520Decoder::process_near_header_packet(
   near_detection_list_ptr_->detections.reserve(
     rdi_near_header_packet_.u_number_of_detections.value());
 
-  rdi_near_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  rdi_near_packets_ptr_->packets.emplace_back(packet_msg);
 }
 
 void ContinentalSRR520Decoder::process_near_element_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   constexpr auto range_resolution = 0.024420024;
   constexpr auto azimuth_resolution = 0.006159986;
@@ -249,16 +248,16 @@ void ContinentalSRR520Decoder::process_near_element_packet(
   if (
     near_detection_list_ptr_->detections.size() >=
     rdi_near_header_packet_.u_number_of_detections.value()) {
-    rdi_near_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+    rdi_near_packets_ptr_->packets.emplace_back(packet_msg);
     return;
   }
 
   DetectionPacket detection_packet;
   std::memcpy(
-    &detection_packet, packet_msg->data.data() + 4 * sizeof(uint8_t), sizeof(DetectionPacket));
+    &detection_packet, packet_msg.data.data() + 4 * sizeof(uint8_t), sizeof(DetectionPacket));
 
   static_assert(sizeof(DetectionPacket) == rdi_near_element_packet_size);
-  assert(packet_msg->data.size() == rdi_near_element_packet_size + 4);
+  assert(packet_msg.data.size() == rdi_near_element_packet_size + 4);
   assert(rdi_near_header_packet_.u_sequence_counter == detection_packet.u_sequence_counter);
   assert(
     rdi_near_packets_ptr_->packets.size() ==
@@ -304,11 +303,11 @@ void ContinentalSRR520Decoder::process_near_element_packet(
     parsed_detections++;
   }
 
-  rdi_near_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  rdi_near_packets_ptr_->packets.emplace_back(packet_msg);
 }
 
 void ContinentalSRR520Decoder::process_hrr_header_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   constexpr float V_AMBIGUOUS_RESOLUTION = 0.003051851f;
   constexpr float V_AMBIGUOUS_MIN_VALUE = -100.f;
@@ -317,10 +316,10 @@ void ContinentalSRR520Decoder::process_hrr_header_packet(
   first_rdi_hrr_packet_ = false;
 
   static_assert(sizeof(ScanHeaderPacket) == rdi_hrr_header_packet_size);
-  assert(packet_msg->data.size() == rdi_hrr_header_packet_size + 4);
+  assert(packet_msg.data.size() == rdi_hrr_header_packet_size + 4);
 
   std::memcpy(
-    &rdi_hrr_header_packet_, packet_msg->data.data() + 4 * sizeof(uint8_t),
+    &rdi_hrr_header_packet_, packet_msg.data.data() + 4 * sizeof(uint8_t),
     sizeof(ScanHeaderPacket));
 
   assert(
@@ -335,10 +334,10 @@ void ContinentalSRR520Decoder::process_hrr_header_packet(
     hrr_detection_list_ptr_->header.stamp.nanosec =
       rdi_hrr_header_packet_.u_global_time_stamp_nsec.value();
   } else {
-    hrr_detection_list_ptr_->header.stamp = packet_msg->stamp;
+    hrr_detection_list_ptr_->header.stamp = packet_msg.stamp;
   }
 
-  rdi_hrr_packets_ptr_->header.stamp = packet_msg->stamp;
+  rdi_hrr_packets_ptr_->header.stamp = packet_msg.stamp;
   rdi_hrr_packets_ptr_->header.frame_id = sensor_configuration_->frame_id;
 
   hrr_detection_list_ptr_->internal_time_stamp_usec = rdi_hrr_header_packet_.u_time_stamp.value();
@@ -355,11 +354,11 @@ void ContinentalSRR520Decoder::process_hrr_header_packet(
   hrr_detection_list_ptr_->detections.reserve(
     rdi_hrr_header_packet_.u_number_of_detections.value());
 
-  rdi_hrr_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  rdi_hrr_packets_ptr_->packets.emplace_back(packet_msg);
 }
 
 void ContinentalSRR520Decoder::process_hrr_element_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   constexpr auto RANGE_RESOLUTION = 0.024420024;
   constexpr auto AZIMUTH_RESOLUTION = 0.006159986;
@@ -384,16 +383,16 @@ void ContinentalSRR520Decoder::process_hrr_element_packet(
   if (
     hrr_detection_list_ptr_->detections.size() >=
     rdi_hrr_header_packet_.u_number_of_detections.value()) {
-    rdi_hrr_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+    rdi_hrr_packets_ptr_->packets.emplace_back(packet_msg);
     return;
   }
 
   DetectionPacket detection_packet;
   std::memcpy(
-    &detection_packet, packet_msg->data.data() + 4 * sizeof(uint8_t), sizeof(DetectionPacket));
+    &detection_packet, packet_msg.data.data() + 4 * sizeof(uint8_t), sizeof(DetectionPacket));
 
   static_assert(sizeof(DetectionPacket) == rdi_hrr_element_packet_size);
-  assert(packet_msg->data.size() == rdi_hrr_element_packet_size + 4);
+  assert(packet_msg.data.size() == rdi_hrr_element_packet_size + 4);
   assert(rdi_hrr_header_packet_.u_sequence_counter == detection_packet.u_sequence_counter);
   assert(
     rdi_hrr_packets_ptr_->packets.size() ==
@@ -439,11 +438,11 @@ void ContinentalSRR520Decoder::process_hrr_element_packet(
     parsed_detections++;
   }
 
-  rdi_hrr_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  rdi_hrr_packets_ptr_->packets.emplace_back(packet_msg);
 }
 
 void ContinentalSRR520Decoder::process_object_header_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   constexpr auto VX_RESOLUTION = 0.003051851;
   constexpr auto VX_MIN_VALUE = -100.f;
@@ -453,10 +452,10 @@ void ContinentalSRR520Decoder::process_object_header_packet(
   first_object_packet_ = false;
 
   static_assert(sizeof(ObjectHeaderPacket) == object_header_packet_size);
-  assert(packet_msg->data.size() == object_header_packet_size + 4);
+  assert(packet_msg.data.size() == object_header_packet_size + 4);
 
   std::memcpy(
-    &object_header_packet_, packet_msg->data.data() + 4 * sizeof(uint8_t),
+    &object_header_packet_, packet_msg.data.data() + 4 * sizeof(uint8_t),
     sizeof(ObjectHeaderPacket));
 
   assert(
@@ -469,10 +468,10 @@ void ContinentalSRR520Decoder::process_object_header_packet(
     object_list_ptr_->header.stamp.sec = object_header_packet_.u_global_time_stamp_sec.value();
     object_list_ptr_->header.stamp.nanosec = object_header_packet_.u_global_time_stamp_nsec.value();
   } else {
-    object_list_ptr_->header.stamp = packet_msg->stamp;
+    object_list_ptr_->header.stamp = packet_msg.stamp;
   }
 
-  object_packets_ptr_->header.stamp = packet_msg->stamp;
+  object_packets_ptr_->header.stamp = packet_msg.stamp;
   object_packets_ptr_->header.frame_id = sensor_configuration_->base_frame;
 
   object_list_ptr_->internal_time_stamp_usec = object_header_packet_.u_time_stamp.value();
@@ -488,11 +487,11 @@ void ContinentalSRR520Decoder::process_object_header_packet(
 
   object_list_ptr_->objects.reserve(object_header_packet_.u_number_of_objects);
 
-  object_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  object_packets_ptr_->packets.emplace_back(packet_msg);
 }
 
 void ContinentalSRR520Decoder::process_object_element_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   constexpr auto DIST_RESOLUTION = 0.009155553;
   constexpr auto V_ABS_RESOLUTION = 0.009156391;
@@ -519,15 +518,15 @@ void ContinentalSRR520Decoder::process_object_element_packet(
   }
 
   if (object_list_ptr_->objects.size() >= object_header_packet_.u_number_of_objects) {
-    object_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+    object_packets_ptr_->packets.emplace_back(packet_msg);
     return;
   }
 
   ObjectPacket object_packet;
-  std::memcpy(&object_packet, packet_msg->data.data() + 4 * sizeof(uint8_t), sizeof(ObjectPacket));
+  std::memcpy(&object_packet, packet_msg.data.data() + 4 * sizeof(uint8_t), sizeof(ObjectPacket));
 
   static_assert(sizeof(ObjectPacket) == object_packet_size);
-  assert(packet_msg->data.size() == object_packet_size + 4);
+  assert(packet_msg.data.size() == object_packet_size + 4);
   assert(object_header_packet_.u_sequence_counter == object_packet.u_sequence_counter);
   assert(
     object_packets_ptr_->packets.size() ==
@@ -638,27 +637,27 @@ void ContinentalSRR520Decoder::process_object_element_packet(
     object_list_ptr_->objects.push_back(object_msg);
   }
 
-  object_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  object_packets_ptr_->packets.emplace_back(packet_msg);
 }
 
 void ContinentalSRR520Decoder::process_crc_list_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
-  const auto crc_id = packet_msg->data[4];  // first 4 bits are the can id
+  const auto crc_id = packet_msg.data[4];  // first 4 bits are the can id
 
   if (crc_id == near_crc_id) {
-    process_near_crc_list_packet(std::move(packet_msg));
+    process_near_crc_list_packet(packet_msg);
   } else if (crc_id == hrr_crc_id) {
-    process_hrrcrc_list_packet(std::move(packet_msg));  // cspell: ignore HRRCRC
+    process_hrrcrc_list_packet(packet_msg);  // cspell: ignore HRRCRC
   } else if (crc_id == object_crc_id) {
-    process_object_crc_list_packet(std::move(packet_msg));
+    process_object_crc_list_packet(packet_msg);
   } else {
     print_error(std::string("Unrecognized CRC id=") + std::to_string(crc_id));
   }
 }
 
 void ContinentalSRR520Decoder::process_near_crc_list_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   if (rdi_near_packets_ptr_->packets.size() != rdi_near_packet_num + 1) {
     if (!first_rdi_near_packet_) {
@@ -672,7 +671,7 @@ void ContinentalSRR520Decoder::process_near_crc_list_packet(
   }
 
   uint16_t transmitted_crc =
-    (static_cast<uint16_t>(packet_msg->data[5]) << 8) | packet_msg->data[6];
+    (static_cast<uint16_t>(packet_msg.data[5]) << 8) | packet_msg.data[6];
   uint16_t computed_crc =
     crc16_packets(rdi_near_packets_ptr_->packets.begin(), rdi_near_packets_ptr_->packets.end(), 4);
 
@@ -686,7 +685,7 @@ void ContinentalSRR520Decoder::process_near_crc_list_packet(
     return;
   }
 
-  rdi_near_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  rdi_near_packets_ptr_->packets.emplace_back(packet_msg);
 
   if (near_detection_list_callback_) {
     near_detection_list_callback_(std::move(near_detection_list_ptr_));
@@ -702,7 +701,7 @@ void ContinentalSRR520Decoder::process_near_crc_list_packet(
 }
 
 void ContinentalSRR520Decoder::process_hrrcrc_list_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   if (rdi_hrr_packets_ptr_->packets.size() != rdi_hrr_packet_num + 1) {
     if (!first_rdi_hrr_packet_) {
@@ -716,7 +715,7 @@ void ContinentalSRR520Decoder::process_hrrcrc_list_packet(
   }
 
   uint16_t transmitted_crc =
-    (static_cast<uint16_t>(packet_msg->data[5]) << 8) | packet_msg->data[6];
+    (static_cast<uint16_t>(packet_msg.data[5]) << 8) | packet_msg.data[6];
   uint16_t computed_crc =
     crc16_packets(rdi_hrr_packets_ptr_->packets.begin(), rdi_hrr_packets_ptr_->packets.end(), 4);
 
@@ -729,7 +728,7 @@ void ContinentalSRR520Decoder::process_hrrcrc_list_packet(
     return;
   }
 
-  rdi_hrr_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  rdi_hrr_packets_ptr_->packets.emplace_back(packet_msg);
 
   if (hrr_detection_list_callback_) {
     hrr_detection_list_callback_(std::move(hrr_detection_list_ptr_));
@@ -745,7 +744,7 @@ void ContinentalSRR520Decoder::process_hrrcrc_list_packet(
 }
 
 void ContinentalSRR520Decoder::process_object_crc_list_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   if (object_packets_ptr_->packets.size() != object_packet_num + 1) {
     if (!first_object_packet_) {
@@ -758,7 +757,7 @@ void ContinentalSRR520Decoder::process_object_crc_list_packet(
   }
 
   uint16_t transmitted_crc =
-    (static_cast<uint16_t>(packet_msg->data[5]) << 8) | packet_msg->data[6];
+    (static_cast<uint16_t>(packet_msg.data[5]) << 8) | packet_msg.data[6];
   uint16_t computed_crc =
     crc16_packets(object_packets_ptr_->packets.begin(), object_packets_ptr_->packets.end(), 4);
 
@@ -771,7 +770,7 @@ void ContinentalSRR520Decoder::process_object_crc_list_packet(
     return;
   }
 
-  object_packets_ptr_->packets.emplace_back(std::move(*packet_msg));
+  object_packets_ptr_->packets.emplace_back(packet_msg);
 
   if (object_list_callback_) {
     object_list_callback_(std::move(object_list_ptr_));
@@ -786,7 +785,7 @@ void ContinentalSRR520Decoder::process_object_crc_list_packet(
 }
 
 void ContinentalSRR520Decoder::process_sensor_status_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   static_assert(sizeof(StatusPacket) == status_packet_size);
 
@@ -797,12 +796,12 @@ void ContinentalSRR520Decoder::process_sensor_status_packet(
   constexpr auto status_angle_std_resolution = 1.52593e-05;
 
   StatusPacket status_packet;
-  std::memcpy(&status_packet, packet_msg->data.data() + 4 * sizeof(uint8_t), sizeof(status_packet));
+  std::memcpy(&status_packet, packet_msg.data.data() + 4 * sizeof(uint8_t), sizeof(status_packet));
 
   auto diagnostic_array_msg_ptr = std::make_unique<diagnostic_msgs::msg::DiagnosticArray>();
 
   diagnostic_array_msg_ptr->header.frame_id = sensor_configuration_->frame_id;
-  diagnostic_array_msg_ptr->header.stamp = packet_msg->stamp;
+  diagnostic_array_msg_ptr->header.stamp = packet_msg.stamp;
   diagnostic_array_msg_ptr->status.resize(1);
 
   auto & diagnostic_status = diagnostic_array_msg_ptr->status.front();
@@ -1128,7 +1127,7 @@ void ContinentalSRR520Decoder::process_sensor_status_packet(
     status_angle_resolution * status_packet.u_aln_current_delta.value() + status_angle_min_value);
   diagnostic_values.push_back(key_value);
 
-  uint16_t computed_crc = crc16_packet(packet_msg->data.begin() + 4, packet_msg->data.end() - 3);
+  uint16_t computed_crc = crc16_packet(packet_msg.data.begin() + 4, packet_msg.data.end() - 3);
   key_value.key = "crc_check";
   key_value.value =
     std::to_string(status_packet.u_crc.value()) + "|" + std::to_string(computed_crc);
@@ -1143,9 +1142,9 @@ void ContinentalSRR520Decoder::process_sensor_status_packet(
   }
 
   auto nebula_packets = std::make_unique<nebula_msgs::msg::NebulaPackets>();
-  nebula_packets->header.stamp = packet_msg->stamp;
+  nebula_packets->header.stamp = packet_msg.stamp;
   nebula_packets->header.frame_id = sensor_configuration_->frame_id;
-  nebula_packets->packets.emplace_back(std::move(*packet_msg));
+  nebula_packets->packets.emplace_back(packet_msg);
 
   if (nebula_packets_callback_) {
     nebula_packets_callback_(std::move(nebula_packets));
@@ -1153,16 +1152,16 @@ void ContinentalSRR520Decoder::process_sensor_status_packet(
 }
 
 void ContinentalSRR520Decoder::process_sync_follow_up_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   if (sync_follow_up_callback_) {
-    sync_follow_up_callback_(packet_msg->stamp);
+    sync_follow_up_callback_(packet_msg.stamp);
   }
 
   auto nebula_packets = std::make_unique<nebula_msgs::msg::NebulaPackets>();
-  nebula_packets->header.stamp = packet_msg->stamp;
+  nebula_packets->header.stamp = packet_msg.stamp;
   nebula_packets->header.frame_id = sensor_configuration_->frame_id;
-  nebula_packets->packets.emplace_back(std::move(*packet_msg));
+  nebula_packets->packets.emplace_back(packet_msg);
 
   if (nebula_packets_callback_) {
     nebula_packets_callback_(std::move(nebula_packets));
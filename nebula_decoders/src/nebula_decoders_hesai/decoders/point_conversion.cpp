@@ -0,0 +1,254 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "nebula_decoders/nebula_decoders_hesai/decoders/point_conversion.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NEBULA_POINT_CONVERSION_X86
+#include <immintrin.h>
+#endif
+
+namespace nebula::drivers::point_conversion
+{
+namespace
+{
+
+// ---------------------------------------------------------------------------------------------
+// Scalar
+// ---------------------------------------------------------------------------------------------
+
+void scale_distances_scalar(
+  const uint16_t * raw_distances, size_t n, double dis_unit, float min_range, float max_range,
+  float * distances, uint8_t * valid)
+{
+  for (size_t i = 0; i < n; ++i) {
+    auto distance = static_cast<float>(raw_distances[i] * dis_unit);
+    distances[i] = distance;
+    valid[i] = raw_distances[i] != 0 && min_range <= distance && distance <= max_range;
+  }
+}
+
+void project_to_cartesian_scalar(
+  const float * distances, const float * cos_elevation, const float * sin_elevation,
+  const float * cos_azimuth, const float * sin_azimuth, size_t n, float * x, float * y, float * z)
+{
+  for (size_t i = 0; i < n; ++i) {
+    float xy_distance = distances[i] * cos_elevation[i];
+    x[i] = xy_distance * sin_azimuth[i];
+    y[i] = xy_distance * cos_azimuth[i];
+    z[i] = distances[i] * sin_elevation[i];
+  }
+}
+
+#ifdef NEBULA_POINT_CONVERSION_X86
+
+// ---------------------------------------------------------------------------------------------
+// SSE4.1
+// ---------------------------------------------------------------------------------------------
+
+__attribute__((target("sse4.1"))) void scale_distances_sse41(
+  const uint16_t * raw_distances, size_t n, double dis_unit, float min_range, float max_range,
+  float * distances, uint8_t * valid)
+{
+  const __m128d dis_unit_v = _mm_set1_pd(dis_unit);
+  const __m128 min_range_v = _mm_set1_ps(min_range);
+  const __m128 max_range_v = _mm_set1_ps(max_range);
+  const __m128i zero = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i raw =
+      _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(raw_distances + i)));
+
+    // Scale in double precision, then round to float like the scalar path
+    __m128 lo = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(raw), dis_unit_v));
+    __m128 hi =
+      _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(raw, raw)), dis_unit_v));
+    __m128 distance = _mm_movelh_ps(lo, hi);
+    _mm_storeu_ps(distances + i, distance);
+
+    __m128 in_range =
+      _mm_and_ps(_mm_cmpge_ps(distance, min_range_v), _mm_cmple_ps(distance, max_range_v));
+    __m128 is_zero = _mm_castsi128_ps(_mm_cmpeq_epi32(raw, zero));
+    int mask = _mm_movemask_ps(_mm_andnot_ps(is_zero, in_range));
+
+    for (size_t j = 0; j < 4; ++j) {
+      valid[i + j] = (mask >> j) & 1;
+    }
+  }
+
+  scale_distances_scalar(
+    raw_distances + i, n - i, dis_unit, min_range, max_range, distances + i, valid + i);
+}
+
+__attribute__((target("sse4.1"))) void project_to_cartesian_sse41(
+  const float * distances, const float * cos_elevation, const float * sin_elevation,
+  const float * cos_azimuth, const float * sin_azimuth, size_t n, float * x, float * y, float * z)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 distance = _mm_loadu_ps(distances + i);
+    __m128 xy_distance = _mm_mul_ps(distance, _mm_loadu_ps(cos_elevation + i));
+    _mm_storeu_ps(x + i, _mm_mul_ps(xy_distance, _mm_loadu_ps(sin_azimuth + i)));
+    _mm_storeu_ps(y + i, _mm_mul_ps(xy_distance, _mm_loadu_ps(cos_azimuth + i)));
+    _mm_storeu_ps(z + i, _mm_mul_ps(distance, _mm_loadu_ps(sin_elevation + i)));
+  }
+
+  project_to_cartesian_scalar(
+    distances + i, cos_elevation + i, sin_elevation + i, cos_azimuth + i, sin_azimuth + i, n - i,
+    x + i, y + i, z + i);
+}
+
+// ---------------------------------------------------------------------------------------------
+// AVX2
+// ---------------------------------------------------------------------------------------------
+
+__attribute__((target("avx2"))) void scale_distances_avx2(
+  const uint16_t * raw_distances, size_t n, double dis_unit, float min_range, float max_range,
+  float * distances, uint8_t * valid)
+{
+  const __m256d dis_unit_v = _mm256_set1_pd(dis_unit);
+  const __m256 min_range_v = _mm256_set1_ps(min_range);
+  const __m256 max_range_v = _mm256_set1_ps(max_range);
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i raw_u16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(raw_distances + i));
+    __m256i raw = _mm256_cvtepu16_epi32(raw_u16);
+
+    // Scale in double precision, then round to float like the scalar path
+    __m128 lo = _mm256_cvtpd_ps(
+      _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(raw)), dis_unit_v));
+    __m128 hi = _mm256_cvtpd_ps(
+      _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(raw, 1)), dis_unit_v));
+    __m256 distance = _mm256_set_m128(hi, lo);
+    _mm256_storeu_ps(distances + i, distance);
+
+    __m256 in_range = _mm256_and_ps(
+      _mm256_cmp_ps(distance, min_range_v, _CMP_GE_OQ),
+      _mm256_cmp_ps(distance, max_range_v, _CMP_LE_OQ));
+    int in_range_mask = _mm256_movemask_ps(in_range);
+    int zero_mask = _mm256_movemask_ps(
+      _mm256_castsi256_ps(_mm256_cmpeq_epi32(raw, _mm256_setzero_si256())));
+    int mask = in_range_mask & ~zero_mask;
+
+    for (size_t j = 0; j < 8; ++j) {
+      valid[i + j] = (mask >> j) & 1;
+    }
+  }
+
+  scale_distances_scalar(
+    raw_distances + i, n - i, dis_unit, min_range, max_range, distances + i, valid + i);
+}
+
+__attribute__((target("avx2"))) void project_to_cartesian_avx2(
+  const float * distances, const float * cos_elevation, const float * sin_elevation,
+  const float * cos_azimuth, const float * sin_azimuth, size_t n, float * x, float * y, float * z)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 distance = _mm256_loadu_ps(distances + i);
+    __m256 xy_distance = _mm256_mul_ps(distance, _mm256_loadu_ps(cos_elevation + i));
+    _mm256_storeu_ps(x + i, _mm256_mul_ps(xy_distance, _mm256_loadu_ps(sin_azimuth + i)));
+    _mm256_storeu_ps(y + i, _mm256_mul_ps(xy_distance, _mm256_loadu_ps(cos_azimuth + i)));
+    _mm256_storeu_ps(z + i, _mm256_mul_ps(distance, _mm256_loadu_ps(sin_elevation + i)));
+  }
+
+  project_to_cartesian_sse41(
+    distances + i, cos_elevation + i, sin_elevation + i, cos_azimuth + i, sin_azimuth + i, n - i,
+    x + i, y + i, z + i);
+}
+
+#endif  // NEBULA_POINT_CONVERSION_X86
+
+struct Kernels
+{
+  SimdLevel level;
+  decltype(&scale_distances_scalar) scale_distances;
+  decltype(&project_to_cartesian_scalar) project_to_cartesian;
+};
+
+const Kernels g_scalar_kernels{
+  SimdLevel::SCALAR, &scale_distances_scalar, &project_to_cartesian_scalar};
+
+#ifdef NEBULA_POINT_CONVERSION_X86
+const Kernels g_sse41_kernels{
+  SimdLevel::SSE4_1, &scale_distances_sse41, &project_to_cartesian_sse41};
+const Kernels g_avx2_kernels{SimdLevel::AVX2, &scale_distances_avx2, &project_to_cartesian_avx2};
+#endif
+
+const Kernels * get_kernels_for_level(SimdLevel level)
+{
+  switch (level) {
+#ifdef NEBULA_POINT_CONVERSION_X86
+    case SimdLevel::AVX2:
+      return &g_avx2_kernels;
+    case SimdLevel::SSE4_1:
+      return &g_sse41_kernels;
+#endif
+    default:
+      return &g_scalar_kernels;
+  }
+}
+
+SimdLevel detect_simd_level()
+{
+#ifdef NEBULA_POINT_CONVERSION_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+  if (__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE4_1;
+#endif
+  return SimdLevel::SCALAR;
+}
+
+std::atomic<const Kernels *> & active_kernels()
+{
+  static std::atomic<const Kernels *> kernels{get_kernels_for_level(detect_simd_level())};
+  return kernels;
+}
+
+}  // namespace
+
+SimdLevel get_max_supported_simd_level()
+{
+  static const SimdLevel max_level = detect_simd_level();
+  return max_level;
+}
+
+SimdLevel get_simd_level()
+{
+  return active_kernels().load(std::memory_order_relaxed)->level;
+}
+
+SimdLevel set_simd_level(SimdLevel level)
+{
+  if (level > get_max_supported_simd_level()) {
+    level = get_max_supported_simd_level();
+  }
+
+  active_kernels().store(get_kernels_for_level(level), std::memory_order_relaxed);
+  return get_simd_level();
+}
+
+void scale_distances(
+  const uint16_t * raw_distances, size_t n, double dis_unit, float min_range, float max_range,
+  float * distances, uint8_t * valid)
+{
+  active_kernels().load(std::memory_order_relaxed)
+    ->scale_distances(raw_distances, n, dis_unit, min_range, max_range, distances, valid);
+}
+
+void project_to_cartesian(
+  const float * distances, const float * cos_elevation, const float * sin_elevation,
+  const float * cos_azimuth, const float * sin_azimuth, size_t n, float * x, float * y, float * z)
+{
+  active_kernels()
+    .load(std::memory_order_relaxed)
+    ->project_to_cartesian(
+      distances, cos_elevation, sin_elevation, cos_azimuth, sin_azimuth, n, x, y, z);
+}
+
+}  // namespace nebula::drivers::point_conversion
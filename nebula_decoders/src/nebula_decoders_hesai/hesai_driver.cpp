@@ -74,7 +74,7 @@ std::shared_ptr<HesaiScanDecoder> HesaiDriver::initialize_decoder(
 }
 
 std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::parse_cloud_packet(
-  const std::vector<uint8_t> & packet)
+  util::span<const uint8_t> packet)
 {
   std::tuple<drivers::NebulaPointCloudPtr, double> pointcloud;
   auto logger = rclcpp::get_logger("HesaiDriver");
@@ -84,8 +84,9 @@ std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::parse_cloud_packet
     return pointcloud;
   }
 
-  scan_decoder_->unpack(packet);
-  if (scan_decoder_->has_scanned()) {
+  // A malformed packet does not reset the state of the previous one, which may have completed a
+  // scan that has already been returned
+  if (scan_decoder_->unpack(packet) >= 0 && scan_decoder_->has_scanned()) {
     pointcloud = scan_decoder_->get_pointcloud();
   }
 
@@ -99,6 +100,32 @@ std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::parse_cloud_packet
   return pointcloud;
 }
 
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::parse_cloud_packet(
+  const std::vector<uint8_t> & packet)
+{
+  return parse_cloud_packet(util::span<const uint8_t>(packet));
+}
+
+void HesaiDriver::parse_cloud_packets(
+  util::span<const util::span<const uint8_t>> packets, UnpackedPackets & unpacked)
+{
+  if (driver_status_ != nebula::Status::OK) {
+    RCLCPP_ERROR(rclcpp::get_logger("HesaiDriver"), "Driver not OK.");
+    return;
+  }
+
+  scan_decoder_->unpack(packets, unpacked);
+}
+
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::flush_scan()
+{
+  if (driver_status_ != nebula::Status::OK || !scan_decoder_->flush_scan()) {
+    return {};
+  }
+
+  return scan_decoder_->get_pointcloud();
+}
+
 Status HesaiDriver::set_calibration_configuration(
   const HesaiCalibrationConfigurationBase & calibration_configuration)
 {
@@ -112,4 +139,58 @@ Status HesaiDriver::get_status()
   return driver_status_;
 }
 
+PacketIntegrityCounters HesaiDriver::get_packet_integrity_counters()
+{
+  if (!scan_decoder_) {
+    return {};
+  }
+
+  return scan_decoder_->get_packet_integrity_counters();
+}
+
+PacketSequenceStats HesaiDriver::get_scan_sequence_stats()
+{
+  if (!scan_decoder_) {
+    return {};
+  }
+
+  return scan_decoder_->get_scan_sequence_stats();
+}
+
+std::vector<std::tuple<drivers::NebulaPointCloudPtr, double>> HesaiDriver::get_sectors()
+{
+  if (!scan_decoder_) {
+    return {};
+  }
+
+  return scan_decoder_->get_sectors();
+}
+
+void HesaiDriver::set_sensor_twist(const SensorTwist & twist)
+{
+  if (!scan_decoder_) {
+    return;
+  }
+
+  scan_decoder_->set_sensor_twist(twist);
+}
+
+void HesaiDriver::set_point_fields(PointFieldMask fields)
+{
+  if (!scan_decoder_) {
+    return;
+  }
+
+  scan_decoder_->set_point_fields(fields);
+}
+
+PointFieldMask HesaiDriver::get_scan_point_fields()
+{
+  if (!scan_decoder_) {
+    return 0;
+  }
+
+  return scan_decoder_->get_scan_point_fields();
+}
+
 }  // namespace nebula::drivers
@@ -52,7 +52,7 @@ Status RobosenseDriver::set_calibration_configuration(
 }
 
 std::tuple<drivers::NebulaPointCloudPtr, double> RobosenseDriver::parse_cloud_packet(
-  const std::vector<uint8_t> & packet)
+  util::span<const uint8_t> packet)
 {
   std::tuple<drivers::NebulaPointCloudPtr, double> pointcloud;
   auto logger = rclcpp::get_logger("RobosenseDriver");
@@ -70,4 +70,10 @@ std::tuple<drivers::NebulaPointCloudPtr, double> RobosenseDriver::parse_cloud_pa
   return pointcloud;
 }
 
+std::tuple<drivers::NebulaPointCloudPtr, double> RobosenseDriver::parse_cloud_packet(
+  const std::vector<uint8_t> & packet)
+{
+  return parse_cloud_packet(util::span<const uint8_t>(packet));
+}
+
 }  // namespace nebula::drivers
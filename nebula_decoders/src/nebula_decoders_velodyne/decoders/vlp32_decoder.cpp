@@ -31,6 +31,9 @@ Vlp32Decoder::Vlp32Decoder(
     cos_rot_table_[rot_index] = cosf(rotation);
     sin_rot_table_[rot_index] = sinf(rotation);
   }
+  // The distance corrections of this model do not factor into azimuth and elevation terms, so the
+  // output transform is applied to each point instead of being folded into the azimuth table
+  output_transform_ = get_output_transform(*sensor_configuration_);
   phase_ = (uint16_t)round(sensor_configuration_->scan_phase * 100);
 
   timing_offsets_.resize(12);
@@ -131,7 +134,7 @@ void Vlp32Decoder::reset_overflow(double time_stamp)
   overflow_pc_->points.reserve(max_pts_);
 }
 
-void Vlp32Decoder::unpack(const std::vector<uint8_t> & packet, double packet_seconds)
+void Vlp32Decoder::unpack(util::span<const uint8_t> packet, double packet_seconds)
 {
   check_and_handle_scan_complete(packet, packet_seconds, phase_);
 
@@ -303,9 +306,12 @@ void Vlp32Decoder::unpack(const std::vector<uint8_t> & packet, double packet_sec
           z = distance_y * sin_vert_angle + vert_offset * cos_vert_angle;
 
           /** Use standard ROS coordinate system (right-hand rule) */
-          const float x_coord = y;
-          const float y_coord = -x;
-          const float z_coord = z;
+          float x_coord = y;
+          float y_coord = -x;
+          float z_coord = z;
+          if (output_transform_) {
+            output_transform_->apply(x_coord, y_coord, z_coord);
+          }
 
           /** Intensity Calculation */
           const float min_intensity = corrections.min_intensity;
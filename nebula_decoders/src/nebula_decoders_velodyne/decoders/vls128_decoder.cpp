@@ -31,6 +31,7 @@ Vls128Decoder::Vls128Decoder(
     cos_rot_table_[rot_index] = cosf(rotation);
     sin_rot_table_[rot_index] = sinf(rotation);
   }
+  init_output_transform(cos_rot_table_, sin_rot_table_);
 
   phase_ = (uint16_t)round(sensor_configuration_->scan_phase * 100);
 
@@ -134,7 +135,7 @@ void Vls128Decoder::reset_overflow(double time_stamp)
   overflow_pc_->points.reserve(max_pts_);
 }
 
-void Vls128Decoder::unpack(const std::vector<uint8_t> & packet, double packet_seconds)
+void Vls128Decoder::unpack(util::span<const uint8_t> packet, double packet_seconds)
 {
   check_and_handle_scan_complete(packet, packet_seconds, phase_);
 
@@ -278,9 +279,16 @@ void Vls128Decoder::unpack(const std::vector<uint8_t> & packet, double packet_se
               const float xy_distance = distance * cos_vert_angle;
 
               // Use standard ROS coordinate system (right-hand rule).
-              const float x_coord = xy_distance * cos_rot_angle;     // velodyne y
-              const float y_coord = -(xy_distance * sin_rot_angle);  // velodyne x
-              const float z_coord = distance * sin_vert_angle;       // velodyne z
+              float x_coord;
+              float y_coord;
+              float z_coord = distance * sin_vert_angle;  // velodyne z
+              if (output_transform_) {
+                project_to_output_frame(
+                  azimuth_corrected, xy_distance, z_coord, x_coord, y_coord, z_coord);
+              } else {
+                x_coord = xy_distance * cos_rot_angle;     // velodyne y
+                y_coord = -(xy_distance * sin_rot_angle);  // velodyne x
+              }
               const uint8_t intensity = current_block.data[k + 2];
               last_block_timestamp_ = block_timestamp;
               double point_time_offset =
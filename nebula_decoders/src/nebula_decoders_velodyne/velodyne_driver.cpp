@@ -48,7 +48,7 @@ Status VelodyneDriver::set_calibration_configuration(
 }
 
 std::tuple<drivers::NebulaPointCloudPtr, double> VelodyneDriver::parse_cloud_packet(
-  const std::vector<uint8_t> & packet, double packet_seconds)
+  util::span<const uint8_t> packet, double packet_seconds)
 {
   std::tuple<drivers::NebulaPointCloudPtr, double> pointcloud;
 
@@ -58,6 +58,21 @@ std::tuple<drivers::NebulaPointCloudPtr, double> VelodyneDriver::parse_cloud_pac
     return pointcloud;
   }
 
+  // The decoders view the packet in place as a `raw_packet_t`
+  if (packet.size() < sizeof(raw_packet_t)) {
+    auto logger = rclcpp::get_logger("VelodyneDriver");
+    RCLCPP_ERROR_STREAM(
+      logger, "Packet size mismatch: " << packet.size()
+                                       << " | Expected at least: " << sizeof(raw_packet_t));
+    return pointcloud;
+  }
+
+  if (reinterpret_cast<std::uintptr_t>(packet.data()) % alignof(raw_packet_t) != 0) {
+    auto logger = rclcpp::get_logger("VelodyneDriver");
+    RCLCPP_ERROR(logger, "Packet buffer is misaligned");
+    return pointcloud;
+  }
+
   scan_decoder_->unpack(packet, packet_seconds);
   if (scan_decoder_->has_scanned()) {
     pointcloud = scan_decoder_->get_pointcloud();
@@ -65,6 +80,13 @@ std::tuple<drivers::NebulaPointCloudPtr, double> VelodyneDriver::parse_cloud_pac
 
   return pointcloud;
 }
+
+std::tuple<drivers::NebulaPointCloudPtr, double> VelodyneDriver::parse_cloud_packet(
+  const std::vector<uint8_t> & packet, double packet_seconds)
+{
+  return parse_cloud_packet(util::span<const uint8_t>(packet), packet_seconds);
+}
+
 Status VelodyneDriver::get_status()
 {
   return driver_status_;
@@ -209,7 +209,7 @@ Status HesaiRosOfflineExtractSample::read_bag()
 
     for (auto & pkt : extracted_msg.packets) {
       auto pointcloud_ts = driver_ptr_->parse_cloud_packet(
-        std::vector<uint8_t>(pkt.data.begin(), std::next(pkt.data.begin(), pkt.size)));
+        nebula::util::span<const uint8_t>(pkt.data.data(), pkt.size));
       auto pointcloud = std::get<0>(pointcloud_ts);
 
       if (!pointcloud) {
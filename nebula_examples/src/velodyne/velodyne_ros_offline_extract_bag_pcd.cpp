@@ -344,9 +344,7 @@ Status VelodyneRosOfflineExtractBag::read_bag()
         //          std::make_shared<velodyne_msgs::msg::VelodyneScan>(extracted_msg));
 
         for (auto & pkt : extracted_msg.packets) {
-          auto pointcloud_ts = driver_ptr_->parse_cloud_packet(
-            std::vector<uint8_t>(pkt.data.begin(), std::next(pkt.data.begin(), pkt.data.size())),
-            pkt.stamp.sec);
+          auto pointcloud_ts = driver_ptr_->parse_cloud_packet(pkt.data, pkt.stamp.sec);
           auto pointcloud = std::get<0>(pointcloud_ts);
 
           if (!pointcloud) {
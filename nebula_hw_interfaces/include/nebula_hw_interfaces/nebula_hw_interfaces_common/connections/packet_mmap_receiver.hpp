@@ -0,0 +1,449 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/reactor.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/udp_receiver.hpp"
+
+#include <nebula_common/util/span.hpp>
+
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nebula::drivers::connections
+{
+
+/// @brief Counters of a `PacketMmapReceiver`. `n_packets / n_blocks` is the average batch size.
+struct PacketMmapReceiverStats
+{
+  uint64_t n_packets;
+  uint64_t n_blocks;
+  uint64_t n_truncated;
+  /// @brief Packets the kernel dropped because the ring was full
+  uint64_t n_dropped;
+};
+
+/// @brief Receives the UDP datagrams of one sensor from a memory-mapped `AF_PACKET` ring
+/// (`TPACKET_V3`) instead of a UDP socket. The kernel copies matching packets straight into the
+/// ring, which is shared with this process, and hands them over in blocks of many packets. Payloads
+/// are passed to the callback as views into the ring, without any copy or system call per packet.
+///
+/// Only the sensor's packets are captured: a BPF filter matches the sender address and
+/// destination port. IP fragments are not reassembled and are dropped. Packets are stamped with the
+/// time the kernel received them.
+///
+/// A block is handed over once it is full or `block_timeout_ms` after its first packet, so smaller
+/// blocks lower the latency and larger ones the overhead.
+///
+/// Requires `CAP_NET_RAW`. Usage: construct, `bind`, then `subscribe`. Setup errors are thrown as
+/// `std::runtime_error`.
+class PacketMmapReceiver
+{
+public:
+  /// @brief Called once per datagram, in order, on the receiving thread. The payload is only valid
+  /// during the call.
+  using callback_t =
+    std::function<void(util::span<const uint8_t> payload, const UdpPacketMetadata & metadata)>;
+
+  /// @param block_size The size of each ring block in bytes, a multiple of the page size
+  /// @param n_blocks The number of blocks in the ring
+  /// @param block_timeout_ms The longest time a block with packets in it is held back
+  explicit PacketMmapReceiver(
+    size_t block_size = 1 << 16, size_t n_blocks = 64, uint32_t block_timeout_ms = 1)
+  : block_size_(block_size), n_blocks_(n_blocks)
+  {
+    const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    if (block_size == 0 || block_size % page_size != 0 || n_blocks == 0) {
+      throw std::runtime_error("PacketMmapReceiver needs a non-zero number of page-sized blocks");
+    }
+
+    // Protocol 0 receives nothing until `bind`, after the filter has been attached
+    fd_ = ::socket(AF_PACKET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+      throw_errno("Could not create packet socket (CAP_NET_RAW is required)");
+    }
+
+    try {
+      int version = TPACKET_V3;
+      set_option(SOL_PACKET, PACKET_VERSION, &version, sizeof(version), "Could not use TPACKET_V3");
+
+      tpacket_req3 request{};
+      request.tp_block_size = block_size_;
+      request.tp_block_nr = n_blocks_;
+      request.tp_frame_size = frame_size;
+      request.tp_frame_nr = block_size_ / frame_size * n_blocks_;
+      request.tp_retire_blk_tov = block_timeout_ms;
+      set_option(SOL_PACKET, PACKET_RX_RING, &request, sizeof(request), "Could not set up ring");
+
+      void * ring = ::mmap(
+        nullptr, block_size_ * n_blocks_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, fd_, 0);
+      if (ring == MAP_FAILED) {
+        // Locking the ring into memory fails without CAP_IPC_LOCK or a high enough memlock limit
+        ring = ::mmap(nullptr, block_size_ * n_blocks_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+      }
+      if (ring == MAP_FAILED) {
+        throw_errno("Could not map ring");
+      }
+      ring_ = static_cast<uint8_t *>(ring);
+    } catch (const std::runtime_error &) {
+      ::close(fd_);
+      throw;
+    }
+  }
+
+  PacketMmapReceiver(const PacketMmapReceiver &) = delete;
+  PacketMmapReceiver & operator=(const PacketMmapReceiver &) = delete;
+
+  ~PacketMmapReceiver()
+  {
+    if (reactor_) {
+      reactor_->remove(fd_);
+    }
+    running_ = false;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    ::munmap(ring_, block_size_ * n_blocks_);
+    ::close(fd_);
+    if (sink_fd_ >= 0) {
+      ::close(sink_fd_);
+    }
+  }
+
+  /// @brief Capture the datagrams sent from `sender_ip` (any sender if empty) to `port`, received
+  /// on the interface that has the address `host_ip`, or on all interfaces if none has it (e.g.
+  /// for broadcast or wildcard addresses). Multicast groups are not joined.
+  ///
+  /// The kernel still passes the captured packets on to the UDP stack. A socket bound to
+  /// `host_ip:port` that discards everything is opened, if possible, so that the sensor is not sent
+  /// "port unreachable" errors.
+  void bind(const std::string & host_ip, const std::string & sender_ip, uint16_t port)
+  {
+    std::optional<in_addr> sender_address;
+    if (!sender_ip.empty()) {
+      sender_address = parse_ip(sender_ip);
+    }
+    in_addr host_address = parse_ip(host_ip);
+
+    auto filter = make_filter(sender_address, port);
+    sock_fprog program{static_cast<uint16_t>(filter.size()), filter.data()};
+    set_option(
+      SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program), "Could not attach packet filter");
+
+    sockaddr_ll address{};
+    address.sll_family = AF_PACKET;
+    address.sll_protocol = htons(ETH_P_IP);
+    address.sll_ifindex = static_cast<int>(find_interface(host_address));
+    if (::bind(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+      throw_errno("Could not bind packet socket");
+    }
+
+    open_sink(host_address, port);
+  }
+
+  /// @brief Start receiving and call `callback` for each datagram. Can only be called once.
+  /// @param reactor If given, the ring is read on the reactor's threads instead of a thread of this
+  /// receiver
+  void subscribe(callback_t callback, std::shared_ptr<Reactor> reactor = nullptr)
+  {
+    if (thread_.joinable() || reactor_) {
+      throw std::runtime_error("PacketMmapReceiver is already receiving");
+    }
+
+    callback_ = std::move(callback);
+    if (reactor) {
+      // The socket is readable while the kernel has handed over blocks that were not returned yet
+      reactor->add(fd_, [this]() { process_ready_blocks(); });
+      reactor_ = std::move(reactor);
+      return;
+    }
+
+    running_ = true;
+    thread_ = std::thread([this]() {
+      while (running_) {
+        if (process_ready_blocks() == 0) {
+          pollfd poll_fd{fd_, POLLIN | POLLERR, 0};
+          ::poll(&poll_fd, 1, stop_poll_interval_ms);
+        }
+      }
+    });
+  }
+
+  [[nodiscard]] PacketMmapReceiverStats get_stats()
+  {
+    // The kernel resets its counters on every read
+    std::lock_guard lock(mtx_dropped_);
+    tpacket_stats_v3 kernel_stats{};
+    socklen_t length = sizeof(kernel_stats);
+    if (::getsockopt(fd_, SOL_PACKET, PACKET_STATISTICS, &kernel_stats, &length) == 0) {
+      n_dropped_ += kernel_stats.tp_drops;
+    }
+
+    return {
+      n_packets_.load(std::memory_order_relaxed),
+      n_blocks_received_.load(std::memory_order_relaxed),
+      n_truncated_.load(std::memory_order_relaxed), n_dropped_};
+  }
+
+private:
+  static constexpr int stop_poll_interval_ms = 100;
+  /// @brief Only used to size the ring, `TPACKET_V3` packs packets into blocks regardless
+  static constexpr uint32_t frame_size = 2048;
+  static constexpr uint32_t udp_header_size = 8;
+
+  [[noreturn]] static void throw_errno(const std::string & message)
+  {
+    throw std::runtime_error(message + ": " + std::strerror(errno));
+  }
+
+  void set_option(int level, int option, const void * value, socklen_t size, const char * message)
+  {
+    if (::setsockopt(fd_, level, option, value, size) < 0) {
+      throw_errno(message);
+    }
+  }
+
+  static in_addr parse_ip(const std::string & ip)
+  {
+    in_addr address{};
+    if (::inet_pton(AF_INET, ip.c_str(), &address) != 1) {
+      throw std::runtime_error("Invalid IPv4 address: '" + ip + "'");
+    }
+    return address;
+  }
+
+  /// @brief The index of the interface with the given address, or 0 (all interfaces) if there is
+  /// none
+  static unsigned int find_interface(in_addr host_address)
+  {
+    ifaddrs * interfaces = nullptr;
+    if (::getifaddrs(&interfaces) < 0) {
+      throw_errno("Could not list network interfaces");
+    }
+
+    unsigned int index = 0;
+    for (ifaddrs * interface = interfaces; interface; interface = interface->ifa_next) {
+      if (!interface->ifa_addr || interface->ifa_addr->sa_family != AF_INET) {
+        continue;
+      }
+      const auto * address = reinterpret_cast<const sockaddr_in *>(interface->ifa_addr);
+      if (address->sin_addr.s_addr == host_address.s_addr) {
+        index = ::if_nametoindex(interface->ifa_name);
+        break;
+      }
+    }
+
+    ::freeifaddrs(interfaces);
+    return index;
+  }
+
+  static sock_filter statement(uint16_t code, uint32_t k) { return {code, 0, 0, k}; }
+
+  static sock_filter jump(uint16_t code, uint32_t k, uint8_t jt, uint8_t jf)
+  {
+    return {code, jt, jf, k};
+  }
+
+  /// @brief A classic BPF program accepting unfragmented UDP/IPv4 packets from `sender_address` (if
+  /// set) to `port`. With `SOCK_DGRAM`, offsets are relative to the IP header.
+  static std::vector<sock_filter> make_filter(std::optional<in_addr> sender_address, uint16_t port)
+  {
+    std::vector<sock_filter> filter;
+    std::vector<size_t> jumps_to_drop;
+    auto jump_unless_equal = [&](uint32_t value) {
+      jumps_to_drop.push_back(filter.size());
+      filter.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, value, 0, 0));
+    };
+
+    // Packets sent by this host are seen on their way out when capturing on all interfaces
+    filter.push_back(statement(BPF_LD | BPF_B | BPF_ABS, SKF_AD_OFF + SKF_AD_PKTTYPE));
+    filter.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, PACKET_OUTGOING, 0, 1));
+    filter.push_back(statement(BPF_RET | BPF_K, 0));
+
+    filter.push_back(statement(BPF_LD | BPF_B | BPF_ABS, 9));  // Protocol
+    jump_unless_equal(IPPROTO_UDP);
+
+    // "More fragments" flag and fragment offset
+    filter.push_back(statement(BPF_LD | BPF_H | BPF_ABS, 6));
+    filter.push_back(jump(BPF_JMP | BPF_JSET | BPF_K, 0x3fff, 0, 1));
+    filter.push_back(statement(BPF_RET | BPF_K, 0));
+
+    if (sender_address) {
+      filter.push_back(statement(BPF_LD | BPF_W | BPF_ABS, 12));  // Source address
+      jump_unless_equal(ntohl(sender_address->s_addr));
+    }
+
+    filter.push_back(statement(BPF_LDX | BPF_B | BPF_MSH, 0));  // IP header length
+    filter.push_back(statement(BPF_LD | BPF_H | BPF_IND, 2));   // Destination port
+    jump_unless_equal(port);
+
+    filter.push_back(statement(BPF_RET | BPF_K, 0xffff));
+    const size_t drop_index = filter.size();
+    filter.push_back(statement(BPF_RET | BPF_K, 0));
+
+    for (size_t index : jumps_to_drop) {
+      filter[index].jf = static_cast<uint8_t>(drop_index - index - 1);
+    }
+    return filter;
+  }
+
+  /// @brief Bind a UDP socket that drops everything it receives to the port (best effort)
+  void open_sink(in_addr host_address, uint16_t port)
+  {
+    sink_fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (sink_fd_ < 0) {
+      return;
+    }
+
+    sock_filter drop_all = statement(BPF_RET | BPF_K, 0);
+    sock_fprog program{1, &drop_all};
+    int reuse = 1;
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr = host_address;
+    if (
+      ::setsockopt(sink_fd_, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) < 0 ||
+      ::setsockopt(sink_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0 ||
+      ::bind(sink_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+      ::close(sink_fd_);
+      sink_fd_ = -1;
+    }
+  }
+
+  static uint64_t now_ns()
+  {
+    timespec now{};
+    ::clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+  }
+
+  /// @brief Process the blocks the kernel has handed over, in ring order, and return them
+  /// @return The number of blocks processed
+  size_t process_ready_blocks()
+  {
+    size_t n_processed = 0;
+    while (n_processed < n_blocks_) {
+      auto * block = reinterpret_cast<tpacket_block_desc *>(ring_ + block_index_ * block_size_);
+      if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+        break;
+      }
+
+      process_block(*block);
+
+      // Return the block to the kernel
+      __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+      block_index_ = (block_index_ + 1) % n_blocks_;
+      ++n_processed;
+    }
+    return n_processed;
+  }
+
+  void process_block(const tpacket_block_desc & block)
+  {
+    const auto * block_start = reinterpret_cast<const uint8_t *>(&block);
+    const uint32_t n_packets = block.hdr.bh1.num_pkts;
+    const auto * header =
+      reinterpret_cast<const tpacket3_hdr *>(block_start + block.hdr.bh1.offset_to_first_pkt);
+
+    n_blocks_received_.fetch_add(1, std::memory_order_relaxed);
+    n_packets_.fetch_add(n_packets, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < n_packets; ++i) {
+      process_packet(*header);
+      header = reinterpret_cast<const tpacket3_hdr *>(
+        reinterpret_cast<const uint8_t *>(header) + header->tp_next_offset);
+    }
+  }
+
+  void process_packet(const tpacket3_hdr & header)
+  {
+    const auto * ip = reinterpret_cast<const uint8_t *>(&header) + header.tp_net;
+    const size_t captured = header.tp_snaplen;
+    const size_t ip_header_size = (ip[0] & 0x0f) * 4;
+    if (captured < ip_header_size + udp_header_size) {
+      return;
+    }
+
+    const uint8_t * udp = ip + ip_header_size;
+    const size_t udp_length = (udp[4] << 8) | udp[5];
+    if (udp_length < udp_header_size) {
+      return;
+    }
+
+    const size_t payload_size = udp_length - udp_header_size;
+    const size_t payload_captured = captured - ip_header_size - udp_header_size;
+
+    UdpPacketMetadata metadata{};
+    metadata.receive_time_ns =
+      header.tp_sec ? static_cast<uint64_t>(header.tp_sec) * 1'000'000'000 + header.tp_nsec
+                    : now_ns();
+    std::memcpy(&metadata.sender_ip, ip + 12, sizeof(metadata.sender_ip));
+    metadata.truncated = payload_captured < payload_size;
+    if (metadata.truncated) {
+      n_truncated_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Frames shorter than the Ethernet minimum are padded, so go by the UDP length
+    callback_({udp + udp_header_size, std::min(payload_size, payload_captured)}, metadata);
+  }
+
+  int fd_{-1};
+  int sink_fd_{-1};
+  size_t block_size_;
+  size_t n_blocks_;
+  uint8_t * ring_{nullptr};
+  /// @brief The next block to be handed over by the kernel
+  size_t block_index_{0};
+
+  callback_t callback_;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  std::shared_ptr<Reactor> reactor_;
+
+  std::atomic<uint64_t> n_packets_{0};
+  std::atomic<uint64_t> n_blocks_received_{0};
+  std::atomic<uint64_t> n_truncated_{0};
+  std::mutex mtx_dropped_;
+  uint64_t n_dropped_{0};
+};
+
+}  // namespace nebula::drivers::connections
@@ -0,0 +1,239 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nebula::drivers::connections
+{
+
+/// @brief Waits for any number of sockets to become readable with one `epoll` instance and runs
+/// their handlers on a small pool of threads, instead of each socket blocking a thread of its own.
+///
+/// A socket's handler never runs on two threads at once, so packets of one socket are still
+/// handled in order. Handlers should read what is available without blocking and return.
+///
+/// Errors are thrown as `std::runtime_error`.
+class Reactor
+{
+public:
+  using handler_t = std::function<void()>;
+
+  /// @param n_threads The number of threads running handlers
+  /// @param cpus If not empty, thread `i` is pinned to CPU `cpus[i % cpus.size()]`
+  explicit Reactor(size_t n_threads = 1, std::vector<int> cpus = {})
+  : n_threads_(n_threads), cpus_(std::move(cpus))
+  {
+    if (n_threads == 0) {
+      throw std::runtime_error("Reactor needs at least one thread");
+    }
+
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+      throw_errno("Could not create epoll instance");
+    }
+
+    running_ = true;
+    for (size_t i = 0; i < n_threads; ++i) {
+      threads_.emplace_back([this]() { run(); });
+      if (cpus_.empty()) {
+        continue;
+      }
+
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      const int cpu = cpus_[i % cpus_.size()];
+      if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &cpu_set);
+      }
+      int result =
+        pthread_setaffinity_np(threads_.back().native_handle(), sizeof(cpu_set), &cpu_set);
+      if (result != 0) {
+        stop();
+        ::close(epoll_fd_);
+        throw std::runtime_error(
+          "Could not pin reactor thread to CPU " + std::to_string(cpu) + ": " +
+          std::strerror(result));
+      }
+    }
+  }
+
+  Reactor(const Reactor &) = delete;
+  Reactor & operator=(const Reactor &) = delete;
+
+  ~Reactor()
+  {
+    stop();
+    ::close(epoll_fd_);
+  }
+
+  /// @brief The reactor shared by all hardware interfaces of this process that are given one. It
+  /// is created with the given configuration by the first caller, later callers get the same
+  /// instance (check `n_threads` and `cpus`) as long as it is in use.
+  static std::shared_ptr<Reactor> get_process_wide(size_t n_threads, const std::vector<int> & cpus)
+  {
+    // Function-local statics of inline functions are unique per process, even across the shared
+    // libraries of different components
+    static std::mutex mtx;
+    static std::weak_ptr<Reactor> instance;
+
+    std::lock_guard lock(mtx);
+    auto reactor = instance.lock();
+    if (!reactor) {
+      reactor = std::make_shared<Reactor>(n_threads, cpus);
+      instance = reactor;
+    }
+    return reactor;
+  }
+
+  /// @brief Run `handler` whenever `fd` is readable. The file descriptor has to stay open until it
+  /// is removed.
+  void add(int fd, handler_t handler)
+  {
+    auto entry = std::make_shared<Entry>();
+    entry->fd = fd;
+    entry->handler = std::move(handler);
+
+    std::lock_guard lock(mtx_entries_);
+    const uint64_t id = next_id_++;
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.u64 = id;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+      throw_errno("Could not add socket to reactor");
+    }
+    entries_.emplace(id, std::move(entry));
+  }
+
+  /// @brief Stop watching `fd`. When this returns, its handler is not running and will not be
+  /// called again. Must not be called from the handler itself.
+  void remove(int fd)
+  {
+    std::shared_ptr<Entry> entry;
+    {
+      std::lock_guard lock(mtx_entries_);
+      for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->second->fd == fd) {
+          entry = it->second;
+          entries_.erase(it);
+          break;
+        }
+      }
+    }
+    if (!entry) {
+      return;
+    }
+
+    // Wait for a handler call that is in progress
+    std::lock_guard lock(entry->mtx_running);
+    entry->removed = true;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  }
+
+  [[nodiscard]] size_t n_threads() const { return n_threads_; }
+  [[nodiscard]] const std::vector<int> & cpus() const { return cpus_; }
+
+private:
+  static constexpr int stop_poll_interval_ms = 100;
+  /// @brief Events taken per `epoll_wait`. Few, so that ready sockets spread over the threads.
+  static constexpr int max_events = 4;
+
+  struct Entry
+  {
+    int fd;
+    handler_t handler;
+    std::mutex mtx_running;
+    bool removed{false};
+  };
+
+  [[noreturn]] static void throw_errno(const std::string & message)
+  {
+    throw std::runtime_error(message + ": " + std::strerror(errno));
+  }
+
+  void stop()
+  {
+    running_ = false;
+    for (auto & thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  }
+
+  void run()
+  {
+    std::array<epoll_event, max_events> events{};
+
+    while (running_) {
+      int n_events = ::epoll_wait(epoll_fd_, events.data(), max_events, stop_poll_interval_ms);
+      for (int i = 0; i < n_events; ++i) {
+        std::shared_ptr<Entry> entry;
+        {
+          std::lock_guard lock(mtx_entries_);
+          auto it = entries_.find(events[i].data.u64);
+          if (it == entries_.end()) {
+            continue;
+          }
+          entry = it->second;
+        }
+
+        std::lock_guard lock(entry->mtx_running);
+        if (entry->removed) {
+          continue;
+        }
+        entry->handler();
+
+        // Re-arm the socket, which reports it right away if more data has arrived meanwhile
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.u64 = events[i].data.u64;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, entry->fd, &event);
+      }
+    }
+  }
+
+  int epoll_fd_{-1};
+  size_t n_threads_;
+  std::vector<int> cpus_;
+
+  std::mutex mtx_entries_;
+  std::map<uint64_t, std::shared_ptr<Entry>> entries_;
+  uint64_t next_id_{0};
+
+  std::atomic<bool> running_{false};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace nebula::drivers::connections
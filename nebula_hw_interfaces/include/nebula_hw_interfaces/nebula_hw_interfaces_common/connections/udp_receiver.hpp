@@ -0,0 +1,354 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/reactor.hpp"
+
+#include <nebula_common/util/span.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nebula::drivers::connections
+{
+
+/// @brief Metadata of a datagram received by `UdpReceiver`
+struct UdpPacketMetadata
+{
+  /// @brief When the datagram was received by the kernel, in ns since the epoch (system clock). If
+  /// the kernel did not provide a timestamp, the time after the receive call returned is used.
+  uint64_t receive_time_ns;
+  /// @brief The IPv4 address of the sender
+  in_addr sender_ip;
+  /// @brief Whether the datagram was larger than `max_packet_size` and has been cut off
+  bool truncated;
+};
+
+/// @brief Counters of a `UdpReceiver`. `n_packets / n_syscalls` is the average batch size.
+struct UdpReceiverStats
+{
+  uint64_t n_packets;
+  uint64_t n_syscalls;
+  uint64_t n_truncated;
+  uint64_t n_errors;
+};
+
+/// @brief Receives UDP datagrams on a thread of its own (or on the threads of a shared `Reactor`),
+/// reading up to `batch_size` of them per `recvmmsg` call into one buffer allocated up front. Each
+/// datagram is stamped with the time the kernel received it (`SO_TIMESTAMPNS`), so stamps do not
+/// depend on when the thread is scheduled.
+///
+/// Usage: construct, optionally `set_receive_buffer_size`, `bind` or `bind_multicast`, then
+/// `subscribe`. Setup errors are thrown as `std::runtime_error`.
+class UdpReceiver
+{
+public:
+  /// @brief Called once per datagram, in order, on the receiving thread. The packet points into the
+  /// receive buffer, which is overwritten by the next batch, so it is only valid during the call.
+  using callback_t =
+    std::function<void(util::span<const uint8_t> packet, const UdpPacketMetadata & metadata)>;
+
+  /// @param max_packet_size The most bytes received per datagram. Longer datagrams are truncated.
+  /// @param batch_size The most datagrams read per system call
+  explicit UdpReceiver(size_t max_packet_size = 1500, size_t batch_size = 64)
+  : max_packet_size_(max_packet_size),
+    slot_size_(
+      (max_packet_size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+      alignof(std::max_align_t)),
+    buffer_(slot_size_ * batch_size),
+    iovecs_(batch_size),
+    senders_(batch_size),
+    controls_(batch_size),
+    headers_(batch_size)
+  {
+    if (max_packet_size == 0 || batch_size == 0) {
+      throw std::runtime_error("UdpReceiver needs a non-zero packet and batch size");
+    }
+
+    fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+      throw_errno("Could not create UDP socket");
+    }
+
+    try {
+      set_option(SOL_SOCKET, SO_REUSEADDR, 1, "Could not set SO_REUSEADDR");
+      set_option(SOL_SOCKET, SO_TIMESTAMPNS, 1, "Could not enable receive timestamps");
+
+      // Wake up regularly so that the receiving thread notices when it is stopped
+      timeval timeout{0, stop_poll_interval_us};
+      if (::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
+        throw_errno("Could not set receive timeout");
+      }
+    } catch (const std::runtime_error &) {
+      ::close(fd_);
+      throw;
+    }
+
+    // The addresses are fixed, only the lengths and flags are reset for every batch
+    for (size_t i = 0; i < batch_size; ++i) {
+      iovecs_[i] = {buffer_.data() + i * slot_size_, max_packet_size_};
+
+      msghdr & header = headers_[i].msg_hdr;
+      header.msg_name = &senders_[i];
+      header.msg_iov = &iovecs_[i];
+      header.msg_iovlen = 1;
+      header.msg_control = controls_[i].data();
+    }
+  }
+
+  UdpReceiver(const UdpReceiver &) = delete;
+  UdpReceiver & operator=(const UdpReceiver &) = delete;
+
+  ~UdpReceiver()
+  {
+    if (reactor_) {
+      reactor_->remove(fd_);
+    }
+    running_ = false;
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    ::close(fd_);
+  }
+
+  /// @brief Set the kernel receive buffer size, which has to bridge scheduling and processing
+  /// delays
+  /// @return Whether the buffer is at least `n_bytes` large now. Linux limits the size to
+  /// net.core.rmem_max.
+  bool set_receive_buffer_size(size_t n_bytes)
+  {
+    int requested = static_cast<int>(n_bytes);
+    if (::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &requested, sizeof(requested)) < 0) {
+      return false;
+    }
+
+    // Linux reports (and allocates) twice the requested size to account for bookkeeping overhead
+    int actual = 0;
+    socklen_t length = sizeof(actual);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &actual, &length) < 0) {
+      return false;
+    }
+    return static_cast<size_t>(actual) >= n_bytes;
+  }
+
+  /// @brief Receive unicast and broadcast datagrams sent to `host_ip:port`
+  void bind(const std::string & host_ip, uint16_t port)
+  {
+    sockaddr_in address = make_address(host_ip, port);
+    if (::bind(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+      throw_errno("Could not bind to " + host_ip + ":" + std::to_string(port));
+    }
+  }
+
+  /// @brief Receive datagrams sent to the multicast group `multicast_ip:port` on the interface with
+  /// address `host_ip`
+  void bind_multicast(const std::string & multicast_ip, const std::string & host_ip, uint16_t port)
+  {
+    bind(multicast_ip, port);
+
+    ip_mreq membership{};
+    membership.imr_multiaddr = make_address(multicast_ip, 0).sin_addr;
+    membership.imr_interface = make_address(host_ip, 0).sin_addr;
+    if (::setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0) {
+      throw_errno("Could not join multicast group " + multicast_ip);
+    }
+  }
+
+  /// @brief Start receiving and call `callback` for each datagram. Can only be called once.
+  /// @param reactor If given, datagrams are received on the reactor's threads instead of a thread
+  /// of this receiver
+  void subscribe(callback_t callback, std::shared_ptr<Reactor> reactor = nullptr)
+  {
+    if (thread_.joinable() || reactor_) {
+      throw std::runtime_error("UdpReceiver is already receiving");
+    }
+
+    callback_ = std::move(callback);
+    if (reactor) {
+      reactor->add(fd_, [this]() { receive_available(); });
+      reactor_ = std::move(reactor);
+      return;
+    }
+
+    running_ = true;
+    thread_ = std::thread([this]() {
+      while (running_) {
+        // Block until at least one datagram is available, then take all that are (up to the batch
+        // size) without waiting for more
+        receive_batch(MSG_WAITFORONE);
+      }
+    });
+  }
+
+  [[nodiscard]] UdpReceiverStats get_stats() const
+  {
+    return {
+      n_packets_.load(std::memory_order_relaxed), n_syscalls_.load(std::memory_order_relaxed),
+      n_truncated_.load(std::memory_order_relaxed), n_errors_.load(std::memory_order_relaxed)};
+  }
+
+private:
+  static constexpr int stop_poll_interval_us = 100'000;
+  /// @brief The most batches read per reactor wakeup, so that other sockets get their turn
+  static constexpr size_t max_batches_per_wakeup = 4;
+
+  /// @brief Room for one `SCM_TIMESTAMPNS` control message
+  using control_buffer_t = std::array<char, CMSG_SPACE(sizeof(timespec))>;
+
+  static sockaddr_in make_address(const std::string & ip, uint16_t port)
+  {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (::inet_pton(AF_INET, ip.c_str(), &address.sin_addr) != 1) {
+      throw std::runtime_error("Invalid IPv4 address: '" + ip + "'");
+    }
+    return address;
+  }
+
+  [[noreturn]] static void throw_errno(const std::string & message)
+  {
+    throw std::runtime_error(message + ": " + std::strerror(errno));
+  }
+
+  void set_option(int level, int option, int value, const char * error_message)
+  {
+    if (::setsockopt(fd_, level, option, &value, sizeof(value)) < 0) {
+      throw_errno(error_message);
+    }
+  }
+
+  static uint64_t now_ns()
+  {
+    timespec now{};
+    ::clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+  }
+
+  /// @brief The kernel receive timestamp of a datagram, or 0 if there is none
+  static uint64_t get_kernel_timestamp_ns(msghdr & header)
+  {
+    for (cmsghdr * control = CMSG_FIRSTHDR(&header); control;
+         control = CMSG_NXTHDR(&header, control)) {
+      if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS) {
+        timespec stamp{};
+        std::memcpy(&stamp, CMSG_DATA(control), sizeof(stamp));
+        return static_cast<uint64_t>(stamp.tv_sec) * 1'000'000'000 + stamp.tv_nsec;
+      }
+    }
+    return 0;
+  }
+
+  /// @brief Read the datagrams that are available without blocking
+  void receive_available()
+  {
+    for (size_t i = 0; i < max_batches_per_wakeup; ++i) {
+      if (receive_batch(MSG_DONTWAIT) < static_cast<int>(headers_.size())) {
+        break;
+      }
+    }
+  }
+
+  /// @brief Read one batch of datagrams and call the callback for each
+  /// @return The number of datagrams read, or -1 if there was none or an error
+  int receive_batch(int flags)
+  {
+    const size_t batch_size = headers_.size();
+
+    // The kernel overwrites the lengths and flags of the previous batch
+    for (size_t i = 0; i < batch_size; ++i) {
+      msghdr & header = headers_[i].msg_hdr;
+      header.msg_namelen = sizeof(sockaddr_in);
+      header.msg_controllen = controls_[i].size();
+      header.msg_flags = 0;
+    }
+
+    int n_received = ::recvmmsg(fd_, headers_.data(), batch_size, flags, nullptr);
+    if (n_received < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        n_errors_.fetch_add(1, std::memory_order_relaxed);
+      }
+      return -1;
+    }
+
+    n_syscalls_.fetch_add(1, std::memory_order_relaxed);
+    n_packets_.fetch_add(n_received, std::memory_order_relaxed);
+    const uint64_t fallback_time_ns = now_ns();
+
+    for (int i = 0; i < n_received; ++i) {
+      msghdr & header = headers_[i].msg_hdr;
+      UdpPacketMetadata metadata{};
+      metadata.receive_time_ns = get_kernel_timestamp_ns(header);
+      if (metadata.receive_time_ns == 0) {
+        metadata.receive_time_ns = fallback_time_ns;
+      }
+      metadata.sender_ip = senders_[i].sin_addr;
+      metadata.truncated = (header.msg_flags & MSG_TRUNC) != 0;
+      if (metadata.truncated) {
+        n_truncated_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      const size_t packet_size = std::min<size_t>(headers_[i].msg_len, max_packet_size_);
+      callback_({buffer_.data() + i * slot_size_, packet_size}, metadata);
+    }
+    return n_received;
+  }
+
+  int fd_{-1};
+  size_t max_packet_size_;
+  /// @brief The distance between the datagrams in `buffer_`, rounded up so that each datagram is
+  /// aligned like allocated memory and can be viewed in place as a packet struct
+  size_t slot_size_;
+
+  /// @brief The datagrams of a batch, one slot of `slot_size_` bytes each. Never reallocated, so
+  /// receiving does not allocate or initialize any memory.
+  std::vector<uint8_t> buffer_;
+  /// @brief One I/O vector, sender address and control buffer per datagram of a batch
+  std::vector<iovec> iovecs_;
+  std::vector<sockaddr_in> senders_;
+  std::vector<control_buffer_t> controls_;
+  std::vector<mmsghdr> headers_;
+
+  callback_t callback_;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  std::shared_ptr<Reactor> reactor_;
+
+  std::atomic<uint64_t> n_packets_{0};
+  std::atomic<uint64_t> n_syscalls_{0};
+  std::atomic<uint64_t> n_truncated_{0};
+  std::atomic<uint64_t> n_errors_{0};
+};
+
+}  // namespace nebula::drivers::connections
@@ -15,10 +15,13 @@
 #ifndef NEBULA_CONTINENTAL_ARS548_HW_INTERFACE_H
 #define NEBULA_CONTINENTAL_ARS548_HW_INTERFACE_H
 
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/reactor.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/udp_receiver.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_common/nebula_hw_interface_base.hpp"
 
 #include <boost_udp_driver/udp_driver.hpp>
 #include <nebula_common/continental/continental_ars548.hpp>
+#include <nebula_common/util/span.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <nebula_msgs/msg/nebula_packet.hpp>
@@ -51,10 +54,17 @@ public:
     std::shared_ptr<const ContinentalARS548SensorConfiguration> sensor_configuration);
 
   /// @brief Registering callback
-  /// @param callback Callback function
+  /// @param callback Callback function, called for each packet from the sensor. The packet is only
+  /// valid during the call.
   /// @return Resulting status
   Status register_packet_callback(
-    std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPacket>)> packet_callback);
+    std::function<void(util::span<const uint8_t>, const connections::UdpPacketMetadata &)>
+      packet_callback);
+
+  /// @brief Receive packets on the threads of a reactor shared with other sensors instead of a
+  /// thread of this interface. Has to be called before `sensor_interface_start`.
+  /// @param reactor The reactor, or nullptr to receive on a thread of this interface
+  void set_reactor(std::shared_ptr<connections::Reactor> reactor);
 
   /// @brief Set the sensor mounting parameters
   /// @param longitudinal_autosar Desired longitudinal value in autosar coordinates
@@ -149,19 +159,30 @@ private:
 
   /// @brief Callback function to receive the Cloud Packet data from the UDP Driver
   /// @param buffer Buffer containing the data received from the UDP socket
+  /// @param metadata Receive time and sender of the packet
   void receive_sensor_packet_callback_with_sender(
-    std::vector<uint8_t> & buffer, const std::string & sender_ip);
+    util::span<const uint8_t> buffer, const connections::UdpPacketMetadata & metadata);
 
   /// @brief Callback function to receive the Cloud Packet data from the UDP Driver
   /// @param buffer Buffer containing the data received from the UDP socket
-  void receive_sensor_packet_callback(std::vector<uint8_t> & buffer);
+  /// @param metadata Receive time and sender of the packet
+  void receive_sensor_packet_callback(
+    util::span<const uint8_t> buffer, const connections::UdpPacketMetadata & metadata);
 
   std::unique_ptr<::drivers::common::IoContext> sensor_io_context_ptr_;
+  /// @brief Only used to send configuration packets, data is received by `sensor_udp_receiver_`
   std::unique_ptr<::drivers::udp_driver::UdpDriver> sensor_udp_driver_ptr_;
+  /// @brief Packets from other senders in the multicast group are ignored
+  in_addr sensor_ip_address_{};
   std::shared_ptr<const ContinentalARS548SensorConfiguration> config_ptr_;
-  std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPacket>)> packet_callback_;
+  std::function<void(util::span<const uint8_t>, const connections::UdpPacketMetadata &)>
+    packet_callback_;
 
   std::shared_ptr<rclcpp::Logger> parent_node_logger_ptr_;
+  std::shared_ptr<connections::Reactor> reactor_;
+
+  /// @brief Declared last so that its thread is stopped before the members it uses are gone
+  std::unique_ptr<connections::UdpReceiver> sensor_udp_receiver_;
 };
 }  // namespace nebula::drivers::continental_ars548
 
@@ -56,10 +56,10 @@ public:
       new_config_ptr);
 
   /// @brief Registering callback
-  /// @param callback Callback function
+  /// @param callback Callback function. The packet is only valid during the call.
   /// @return Resulting status
   Status register_packet_callback(
-    std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPacket>)> packet_callback);
+    std::function<void(const nebula_msgs::msg::NebulaPacket &)> packet_callback);
 
   /// @brief Sensor synchronization routine
   void sensor_sync();
@@ -125,8 +125,7 @@ private:
   std::unique_ptr<std::thread> receiver_thread_ptr_;
 
   std::shared_ptr<const ContinentalSRR520SensorConfiguration> config_ptr_;
-  std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPacket> buffer)>
-    nebula_packet_callback_;
+  std::function<void(const nebula_msgs::msg::NebulaPacket & packet_msg)> nebula_packet_callback_;
 
   std::mutex receiver_mutex_;
   bool sensor_interface_active_{};
@@ -28,10 +28,13 @@
 #endif
 #include "boost_tcp_driver/http_client_driver.hpp"
 #include "boost_tcp_driver/tcp_driver.hpp"
-#include "boost_udp_driver/udp_driver.hpp"
 #include "nebula_common/hesai/hesai_common.hpp"
 #include "nebula_common/hesai/hesai_status.hpp"
 #include "nebula_common/util/expected.hpp"
+#include "nebula_common/util/span.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/packet_mmap_receiver.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/reactor.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/udp_receiver.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_hesai/hesai_cmd_response.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -109,6 +112,11 @@ const uint16_t MTU_SIZE = 1500;
 /// pointcloud worth of OT128 packets (currently the highest data rate sensor supported).
 const size_t UDP_SOCKET_BUFFER_SIZE = MTU_SIZE * 3600;
 
+/// @brief The block size of the packet capture ring used instead of the socket with the
+/// `packet_mmap` receive backend. The ring has as many blocks as needed to be as large as
+/// `UDP_SOCKET_BUFFER_SIZE`. A 64 KiB block holds about 50 packets.
+const size_t PACKET_MMAP_BLOCK_SIZE = 1 << 16;
+
 // Time interval between Announce messages, in units of log seconds (default: 1)
 const int PTP_LOG_ANNOUNCE_INTERVAL = 1;
 // Time interval between Sync messages, in units of log seconds (default: 1)
@@ -133,12 +141,14 @@ private:
 
   using ptc_cmd_result_t = nebula::util::expected<std::vector<uint8_t>, ptc_error_t>;
 
-  std::unique_ptr<::drivers::common::IoContext> cloud_io_context_;
   std::shared_ptr<boost::asio::io_context> m_owned_ctx;
-  std::unique_ptr<::drivers::udp_driver::UdpDriver> cloud_udp_driver_;
+  std::unique_ptr<connections::UdpReceiver> cloud_udp_receiver_;
+  std::unique_ptr<connections::PacketMmapReceiver> cloud_packet_mmap_receiver_;
+  std::shared_ptr<connections::Reactor> reactor_;
   std::shared_ptr<::drivers::tcp_driver::TcpDriver> tcp_driver_;
   std::shared_ptr<const HesaiSensorConfiguration> sensor_configuration_;
-  std::function<void(std::vector<uint8_t> & buffer)>
+  std::function<void(
+    util::span<const uint8_t> packet, const connections::UdpPacketMetadata & metadata)>
     cloud_packet_callback_; /**This function pointer is called when the scan is complete*/
 
   std::mutex mtx_inflight_tcp_request_;
@@ -212,9 +222,11 @@ public:
   /// @return Parsed property_tree
   boost::property_tree::ptree ParseJson(const std::string & str);
 
-  /// @brief Callback function to receive the Cloud Packet data from the UDP Driver
-  /// @param buffer Buffer containing the data received from the UDP socket
-  void ReceiveSensorPacketCallback(std::vector<uint8_t> & buffer);
+  /// @brief Callback function to receive the Cloud Packet data from the UDP receiver
+  /// @param packet The received packet, only valid during the call
+  /// @param metadata The kernel receive time and other metadata of the packet
+  void ReceiveSensorPacketCallback(
+    util::span<const uint8_t> packet, const connections::UdpPacketMetadata & metadata);
   /// @brief Starting the interface that handles UDP streams
   /// @return Resulting status
   Status SensorInterfaceStart();
@@ -235,9 +247,16 @@ public:
   Status SetSensorConfiguration(
     std::shared_ptr<const SensorConfigurationBase> sensor_configuration);
   /// @brief Registering callback for PandarScan
-  /// @param scan_callback Callback function
-  /// @return Resulting status
-  Status RegisterScanCallback(std::function<void(std::vector<uint8_t> &)> scan_callback);
+  /// @param scan_callback Callback function, called on the UDP receiver thread. The packet is only
+  /// valid during the call (with the `packet_mmap` backend, it is part of the capture ring).
+  /// @return Resulting status
+  Status RegisterScanCallback(
+    std::function<void(util::span<const uint8_t>, const connections::UdpPacketMetadata &)>
+      scan_callback);
+  /// @brief Receive packets on the threads of a reactor shared with other sensors instead of a
+  /// thread of this interface. Has to be called before `SensorInterfaceStart`.
+  /// @param reactor The reactor, or nullptr to receive on a thread of this interface
+  void SetReactor(std::shared_ptr<connections::Reactor> reactor);
   /// @brief Getting data with PTC_COMMAND_GET_LIDAR_CALIBRATION
   /// @return Resulting status
   std::string GetLidarCalibrationString();
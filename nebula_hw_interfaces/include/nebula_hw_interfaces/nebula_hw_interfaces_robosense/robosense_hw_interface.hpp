@@ -25,8 +25,11 @@
 #define BOOST_ALLOW_DEPRECATED_HEADERS
 #endif
 
-#include <boost_udp_driver/udp_driver.hpp>
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/reactor.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/udp_receiver.hpp"
+
 #include <nebula_common/robosense/robosense_common.hpp>
+#include <nebula_common/util/span.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <memory>
@@ -45,15 +48,16 @@ constexpr uint16_t bpearl_info_packet_size = 1248;
 class RobosenseHwInterface
 {
 private:
-  std::unique_ptr<::drivers::common::IoContext> cloud_io_context_;
-  std::unique_ptr<::drivers::common::IoContext> info_io_context_;
-  std::unique_ptr<::drivers::udp_driver::UdpDriver> cloud_udp_driver_;
-  std::unique_ptr<::drivers::udp_driver::UdpDriver> info_udp_driver_;
   std::shared_ptr<const RobosenseSensorConfiguration> sensor_configuration_;
-  std::function<void(std::vector<uint8_t> & buffer)>
+  std::function<void(util::span<const uint8_t> buffer, const connections::UdpPacketMetadata &)>
     scan_reception_callback_; /**This function pointer is called when the scan is complete*/
   std::function<void(std::vector<uint8_t> & buffer)>
     info_reception_callback_; /**This function pointer is called when DIFOP packet is received*/
+  std::shared_ptr<connections::Reactor> reactor_;
+  /// @brief Declared after the callbacks so that their threads are stopped before the callbacks
+  /// are gone
+  std::unique_ptr<connections::UdpReceiver> cloud_udp_receiver_;
+  std::unique_ptr<connections::UdpReceiver> info_udp_receiver_;
   std::shared_ptr<rclcpp::Logger> parent_node_logger_;
 
   /// @brief Printing the string to RCLCPP_INFO_STREAM
@@ -69,8 +73,11 @@ public:
   RobosenseHwInterface();
 
   /// @brief Callback function to receive the Cloud Packet data from the UDP Driver
-  /// @param buffer Buffer containing the data received from the UDP socket
-  void receive_sensor_packet_callback(std::vector<uint8_t> & buffer);
+  /// @param buffer Buffer containing the data received from the UDP socket, only valid during the
+  /// call
+  /// @param metadata Receive time and sender of the packet
+  void receive_sensor_packet_callback(
+    util::span<const uint8_t> buffer, const connections::UdpPacketMetadata & metadata);
 
   /// @brief Callback function to receive the Info Packet data from the UDP Driver
   /// @param buffer Buffer containing the data received from the UDP socket
@@ -93,13 +100,20 @@ public:
   /// @brief Registering callback for RobosenseScan
   /// @param scan_callback Callback function
   /// @return Resulting status
-  Status register_scan_callback(std::function<void(std::vector<uint8_t> &)> scan_callback);
+  Status register_scan_callback(
+    std::function<void(util::span<const uint8_t>, const connections::UdpPacketMetadata &)>
+      scan_callback);
 
   /// @brief Registering callback for RobosensePacket
   /// @param scan_callback Callback function
   /// @return Resulting status
   Status register_info_callback(std::function<void(std::vector<uint8_t> &)> info_callback);
 
+  /// @brief Receive packets on the threads of a reactor shared with other sensors instead of
+  /// threads of this interface. Has to be called before the interfaces are started.
+  /// @param reactor The reactor, or nullptr to receive on threads of this interface
+  void set_reactor(std::shared_ptr<connections::Reactor> reactor);
+
   /// @brief Setting rclcpp::Logger
   /// @param node Logger
   void set_logger(std::shared_ptr<rclcpp::Logger> logger);
@@ -26,10 +26,12 @@
 #define BOOST_ALLOW_DEPRECATED_HEADERS
 #endif
 
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/reactor.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/connections/udp_receiver.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_common/nebula_hw_interface_base.hpp"
 
 #include <boost_tcp_driver/http_client_driver.hpp>
-#include <boost_udp_driver/udp_driver.hpp>
+#include <nebula_common/util/span.hpp>
 #include <nebula_common/velodyne/velodyne_common.hpp>
 #include <nebula_common/velodyne/velodyne_status.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -47,11 +49,12 @@ namespace nebula::drivers
 class VelodyneHwInterface
 {
 private:
-  std::unique_ptr<::drivers::common::IoContext> cloud_io_context_;
-  std::unique_ptr<::drivers::udp_driver::UdpDriver> cloud_udp_driver_;
   std::shared_ptr<const VelodyneSensorConfiguration> sensor_configuration_;
-  std::function<void(std::vector<uint8_t> &)>
+  std::function<void(util::span<const uint8_t>, const connections::UdpPacketMetadata &)>
     cloud_packet_callback_; /**This function pointer is called when the scan is complete*/
+  std::shared_ptr<connections::Reactor> reactor_;
+  /// @brief Declared after the callback so that its thread is stopped before the callback is gone
+  std::unique_ptr<connections::UdpReceiver> cloud_udp_receiver_;
 
   std::shared_ptr<boost::asio::io_context> boost_ctx_;
   std::unique_ptr<::drivers::tcp_driver::HttpClientDriver> http_client_driver_;
@@ -110,8 +113,11 @@ public:
   VelodyneHwInterface();
 
   /// @brief Callback function to receive the Cloud Packet data from the UDP Driver
-  /// @param buffer Buffer containing the data received from the UDP socket
-  void receive_sensor_packet_callback(std::vector<uint8_t> & buffer);
+  /// @param buffer Buffer containing the data received from the UDP socket, only valid during the
+  /// call
+  /// @param metadata Receive time and sender of the packet
+  void receive_sensor_packet_callback(
+    util::span<const uint8_t> buffer, const connections::UdpPacketMetadata & metadata);
   /// @brief Starting the interface that handles UDP streams
   /// @return Resulting status
   Status sensor_interface_start();
@@ -140,7 +146,13 @@ public:
   /// @brief Registering callback for PandarScan
   /// @param scan_callback Callback function
   /// @return Resulting status
-  Status register_scan_callback(std::function<void(std::vector<uint8_t> & packet)> scan_callback);
+  Status register_scan_callback(
+    std::function<void(util::span<const uint8_t> packet, const connections::UdpPacketMetadata &)>
+      scan_callback);
+  /// @brief Receive packets on the threads of a reactor shared with other sensors instead of a
+  /// thread of this interface. Has to be called before `sensor_interface_start`.
+  /// @param reactor The reactor, or nullptr to receive on a thread of this interface
+  void set_reactor(std::shared_ptr<connections::Reactor> reactor);
 
   /// @brief Parsing JSON string to property_tree
   /// @param str JSON string
@@ -17,6 +17,10 @@
 
 #include <nebula_common/continental/continental_ars548.hpp>
 
+#include <arpa/inet.h>
+
+#include <stdexcept>
+
 namespace nebula::drivers::continental_ars548
 {
 ContinentalARS548HwInterface::ContinentalARS548HwInterface()
@@ -35,15 +39,20 @@ Status ContinentalARS548HwInterface::set_sensor_configuration(
 Status ContinentalARS548HwInterface::sensor_interface_start()
 {
   try {
-    sensor_udp_driver_ptr_->init_receiver(
-      config_ptr_->multicast_ip, config_ptr_->data_port, config_ptr_->host_ip,
-      config_ptr_->data_port, 2 << 16);
-    sensor_udp_driver_ptr_->receiver()->setMulticast(true);
-    sensor_udp_driver_ptr_->receiver()->open();
-    sensor_udp_driver_ptr_->receiver()->bind();
-    sensor_udp_driver_ptr_->receiver()->asyncReceiveWithSender(std::bind(
-      &ContinentalARS548HwInterface::receive_sensor_packet_callback_with_sender, this,
-      std::placeholders::_1, std::placeholders::_2));
+    if (inet_pton(AF_INET, config_ptr_->sensor_ip.c_str(), &sensor_ip_address_) != 1) {
+      throw std::runtime_error("Invalid sensor IP: " + config_ptr_->sensor_ip);
+    }
+
+    // Detection lists are IP-fragmented datagrams of several tens of kB, so allow the largest
+    // possible UDP datagram
+    sensor_udp_receiver_ = std::make_unique<connections::UdpReceiver>(65535, 8);
+    sensor_udp_receiver_->bind_multicast(
+      config_ptr_->multicast_ip, config_ptr_->host_ip, config_ptr_->data_port);
+    sensor_udp_receiver_->subscribe(
+      std::bind(
+        &ContinentalARS548HwInterface::receive_sensor_packet_callback_with_sender, this,
+        std::placeholders::_1, std::placeholders::_2),
+      reactor_);
 
     sensor_udp_driver_ptr_->init_sender(
       config_ptr_->sensor_ip, config_ptr_->configuration_sensor_port, config_ptr_->host_ip,
@@ -64,36 +73,34 @@ Status ContinentalARS548HwInterface::sensor_interface_start()
 }
 
 Status ContinentalARS548HwInterface::register_packet_callback(
-  std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPacket>)> packet_callback)
+  std::function<void(util::span<const uint8_t>, const connections::UdpPacketMetadata &)>
+    packet_callback)
 {
   packet_callback_ = std::move(packet_callback);
   return Status::OK;
 }
 
+void ContinentalARS548HwInterface::set_reactor(std::shared_ptr<connections::Reactor> reactor)
+{
+  reactor_ = std::move(reactor);
+}
+
 void ContinentalARS548HwInterface::receive_sensor_packet_callback_with_sender(
-  std::vector<uint8_t> & buffer, const std::string & sender_ip)
+  util::span<const uint8_t> buffer, const connections::UdpPacketMetadata & metadata)
 {
-  if (sender_ip == config_ptr_->sensor_ip) {
-    receive_sensor_packet_callback(buffer);
+  if (metadata.sender_ip.s_addr == sensor_ip_address_.s_addr) {
+    receive_sensor_packet_callback(buffer, metadata);
   }
 }
-void ContinentalARS548HwInterface::receive_sensor_packet_callback(std::vector<uint8_t> & buffer)
+void ContinentalARS548HwInterface::receive_sensor_packet_callback(
+  util::span<const uint8_t> buffer, const connections::UdpPacketMetadata & metadata)
 {
   if (buffer.size() < sizeof(HeaderPacket)) {
     print_error("Unrecognized packet. Too short");
     return;
   }
 
-  const auto now = std::chrono::high_resolution_clock::now();
-  const auto timestamp_ns =
-    std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
-
-  auto msg_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>();
-  msg_ptr->stamp.sec = static_cast<int>(timestamp_ns / 1'000'000'000);
-  msg_ptr->stamp.nanosec = static_cast<int>(timestamp_ns % 1'000'000'000);
-  msg_ptr->data.swap(buffer);
-
-  packet_callback_(std::move(msg_ptr));
+  packet_callback_(buffer, metadata);
 }
 
 Status ContinentalARS548HwInterface::sensor_interface_stop()
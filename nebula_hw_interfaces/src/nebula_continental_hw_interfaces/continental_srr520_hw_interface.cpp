@@ -86,9 +86,10 @@ void ContinentalSRR520HwInterface::receive_loop()
   std::chrono::nanoseconds receiver_timeout_nsec;
   bool use_bus_time;
 
-  while (true) {
-    auto packet_msg_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>();
+  // Reused for every frame so that receiving does not allocate. The callback copies what it keeps.
+  nebula_msgs::msg::NebulaPacket packet_msg;
 
+  while (true) {
     {
       std::lock_guard lock(receiver_mutex_);
       receiver_timeout_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(
@@ -101,21 +102,21 @@ void ContinentalSRR520HwInterface::receive_loop()
     }
 
     try {
-      packet_msg_ptr->data.resize(68);  // 64 bytes of data + 4 bytes of ID
+      packet_msg.data.resize(68);  // 64 bytes of data + 4 bytes of ID
       receive_id = can_receiver_ptr_->receive_fd(
-        packet_msg_ptr->data.data() + 4 * sizeof(uint8_t), receiver_timeout_nsec);
+        packet_msg.data.data() + 4 * sizeof(uint8_t), receiver_timeout_nsec);
     } catch (const std::exception & ex) {
       print_error(std::string("Error receiving CAN FD message: ") + ex.what());
       continue;
     }
 
-    packet_msg_ptr->data.resize(receive_id.length() + 4);
+    packet_msg.data.resize(receive_id.length() + 4);
 
     uint32_t id = receive_id.identifier();
-    packet_msg_ptr->data[0] = (id & 0xFF000000) >> 24;
-    packet_msg_ptr->data[1] = (id & 0x00FF0000) >> 16;
-    packet_msg_ptr->data[2] = (id & 0x0000FF00) >> 8;
-    packet_msg_ptr->data[3] = (id & 0x000000FF) >> 0;
+    packet_msg.data[0] = (id & 0xFF000000) >> 24;
+    packet_msg.data[1] = (id & 0x00FF0000) >> 16;
+    packet_msg.data[2] = (id & 0x0000FF00) >> 8;
+    packet_msg.data[3] = (id & 0x000000FF) >> 0;
 
     int64_t stamp = use_bus_time
                       ? static_cast<int64_t>(receive_id.get_bus_time() * 1000U)
@@ -123,20 +124,20 @@ void ContinentalSRR520HwInterface::receive_loop()
                                                 std::chrono::system_clock::now().time_since_epoch())
                                                 .count());
 
-    packet_msg_ptr->stamp.sec = stamp / 1'000'000'000;
-    packet_msg_ptr->stamp.nanosec = stamp % 1'000'000'000;
+    packet_msg.stamp.sec = stamp / 1'000'000'000;
+    packet_msg.stamp.nanosec = stamp % 1'000'000'000;
 
     if (receive_id.frame_type() == ::drivers::socketcan::FrameType::ERROR) {
       print_error("CAN FD message is an error frame");
       continue;
     }
 
-    nebula_packet_callback_(std::move(packet_msg_ptr));
+    nebula_packet_callback_(packet_msg);
   }
 }
 
 Status ContinentalSRR520HwInterface::register_packet_callback(
-  std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPacket>)> callback)
+  std::function<void(const nebula_msgs::msg::NebulaPacket &)> callback)
 {
   nebula_packet_callback_ = std::move(callback);
   return Status::OK;
@@ -23,15 +23,16 @@
 namespace nebula::drivers
 {
 HesaiHwInterface::HesaiHwInterface()
-: cloud_io_context_{new ::drivers::common::IoContext(1)},
-  m_owned_ctx{new boost::asio::io_context(1)},
-  cloud_udp_driver_{new ::drivers::udp_driver::UdpDriver(*cloud_io_context_)},
+: m_owned_ctx{new boost::asio::io_context(1)},
   tcp_driver_{new ::drivers::tcp_driver::TcpDriver(m_owned_ctx)}
 {
 }
 
 HesaiHwInterface::~HesaiHwInterface()
 {
+  // Stop the receiving thread before the callback it calls is destroyed
+  cloud_udp_receiver_.reset();
+  cloud_packet_mmap_receiver_.reset();
   FinalizeTcpDriver();
 }
 
@@ -150,24 +151,26 @@ Status HesaiHwInterface::SensorInterfaceStart()
 {
   try {
     std::cout << "Starting UDP server on: " << *sensor_configuration_ << std::endl;
-    if (sensor_configuration_->multicast_ip.empty()) {
-      cloud_udp_driver_->init_receiver(
-        sensor_configuration_->host_ip, sensor_configuration_->data_port);
-    } else {
-      cloud_udp_driver_->init_receiver(
-        sensor_configuration_->multicast_ip, sensor_configuration_->data_port,
-        sensor_configuration_->host_ip, sensor_configuration_->data_port);
-      cloud_udp_driver_->receiver()->setMulticast(true);
+    if (sensor_configuration_->receive_backend == ReceiveBackend::PACKET_MMAP) {
+      cloud_packet_mmap_receiver_ = std::make_unique<connections::PacketMmapReceiver>(
+        PACKET_MMAP_BLOCK_SIZE, UDP_SOCKET_BUFFER_SIZE / PACKET_MMAP_BLOCK_SIZE + 1);
+      cloud_packet_mmap_receiver_->bind(
+        sensor_configuration_->host_ip, sensor_configuration_->sensor_ip,
+        sensor_configuration_->data_port);
+      cloud_packet_mmap_receiver_->subscribe(
+        std::bind(
+          &HesaiHwInterface::ReceiveSensorPacketCallback, this, std::placeholders::_1,
+          std::placeholders::_2),
+        reactor_);
+      return Status::OK;
     }
-#ifdef WITH_DEBUG_STDOUT_HESAI_HW_INTERFACE
-    PrintError("init ok");
-#endif
-    cloud_udp_driver_->receiver()->open();
+
+    cloud_udp_receiver_ = std::make_unique<connections::UdpReceiver>(MTU_SIZE);
 #ifdef WITH_DEBUG_STDOUT_HESAI_HW_INTERFACE
     PrintError("open ok");
 #endif
 
-    bool success = cloud_udp_driver_->receiver()->setKernelBufferSize(UDP_SOCKET_BUFFER_SIZE);
+    bool success = cloud_udp_receiver_->set_receive_buffer_size(UDP_SOCKET_BUFFER_SIZE);
     if (!success) {
       PrintError(
         "Could not set receive buffer size. Try increasing net.core.rmem_max to " +
@@ -175,13 +178,22 @@ Status HesaiHwInterface::SensorInterfaceStart()
       return Status::ERROR_1;
     }
 
-    cloud_udp_driver_->receiver()->bind();
+    if (sensor_configuration_->multicast_ip.empty()) {
+      cloud_udp_receiver_->bind(sensor_configuration_->host_ip, sensor_configuration_->data_port);
+    } else {
+      cloud_udp_receiver_->bind_multicast(
+        sensor_configuration_->multicast_ip, sensor_configuration_->host_ip,
+        sensor_configuration_->data_port);
+    }
 #ifdef WITH_DEBUG_STDOUT_HESAI_HW_INTERFACE
     PrintError("bind ok");
 #endif
 
-    cloud_udp_driver_->receiver()->asyncReceive(
-      std::bind(&HesaiHwInterface::ReceiveSensorPacketCallback, this, std::placeholders::_1));
+    cloud_udp_receiver_->subscribe(
+      std::bind(
+        &HesaiHwInterface::ReceiveSensorPacketCallback, this, std::placeholders::_1,
+        std::placeholders::_2),
+      reactor_);
 #ifdef WITH_DEBUG_STDOUT_HESAI_HW_INTERFACE
     PrintError("async receive set");
 #endif
@@ -195,15 +207,22 @@ Status HesaiHwInterface::SensorInterfaceStart()
 }
 
 Status HesaiHwInterface::RegisterScanCallback(
-  std::function<void(std::vector<uint8_t> &)> scan_callback)
+  std::function<void(util::span<const uint8_t>, const connections::UdpPacketMetadata &)>
+    scan_callback)
 {
   cloud_packet_callback_ = std::move(scan_callback);
   return Status::OK;
 }
 
-void HesaiHwInterface::ReceiveSensorPacketCallback(std::vector<uint8_t> & buffer)
+void HesaiHwInterface::SetReactor(std::shared_ptr<connections::Reactor> reactor)
+{
+  reactor_ = std::move(reactor);
+}
+
+void HesaiHwInterface::ReceiveSensorPacketCallback(
+  util::span<const uint8_t> packet, const connections::UdpPacketMetadata & metadata)
 {
-  cloud_packet_callback_(buffer);
+  cloud_packet_callback_(packet, metadata);
 }
 Status HesaiHwInterface::SensorInterfaceStop()
 {
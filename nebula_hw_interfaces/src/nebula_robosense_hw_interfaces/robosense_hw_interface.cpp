@@ -3,21 +3,16 @@
 #include "nebula_hw_interfaces/nebula_hw_interfaces_robosense/robosense_hw_interface.hpp"
 namespace nebula::drivers
 {
-RobosenseHwInterface::RobosenseHwInterface()
-: cloud_io_context_(new ::drivers::common::IoContext(1)),
-  info_io_context_(new ::drivers::common::IoContext(1)),
-  cloud_udp_driver_(new ::drivers::udp_driver::UdpDriver(*cloud_io_context_)),
-  info_udp_driver_(new ::drivers::udp_driver::UdpDriver(*info_io_context_))
-{
-}
+RobosenseHwInterface::RobosenseHwInterface() = default;
 
-void RobosenseHwInterface::receive_sensor_packet_callback(std::vector<uint8_t> & buffer)
+void RobosenseHwInterface::receive_sensor_packet_callback(
+  util::span<const uint8_t> buffer, const connections::UdpPacketMetadata & metadata)
 {
   if (!scan_reception_callback_) {
     return;
   }
 
-  scan_reception_callback_(buffer);
+  scan_reception_callback_(buffer, metadata);
 }
 
 void RobosenseHwInterface::receive_info_packet_callback(std::vector<uint8_t> & buffer)
@@ -33,13 +28,14 @@ Status RobosenseHwInterface::sensor_interface_start()
 {
   try {
     std::cout << "Starting UDP server for data packets on: " << *sensor_configuration_ << std::endl;
-    cloud_udp_driver_->init_receiver(
-      sensor_configuration_->host_ip, sensor_configuration_->data_port);
-    cloud_udp_driver_->receiver()->open();
-    cloud_udp_driver_->receiver()->bind();
-
-    cloud_udp_driver_->receiver()->asyncReceive(std::bind(
-      &RobosenseHwInterface::receive_sensor_packet_callback, this, std::placeholders::_1));
+    cloud_udp_receiver_ = std::make_unique<connections::UdpReceiver>();
+    cloud_udp_receiver_->bind(sensor_configuration_->host_ip, sensor_configuration_->data_port);
+
+    cloud_udp_receiver_->subscribe(
+      std::bind(
+        &RobosenseHwInterface::receive_sensor_packet_callback, this, std::placeholders::_1,
+        std::placeholders::_2),
+      reactor_);
   } catch (const std::exception & ex) {
     Status status = Status::UDP_CONNECTION_ERROR;
     std::cerr << status << sensor_configuration_->sensor_ip << ","
@@ -56,13 +52,17 @@ Status RobosenseHwInterface::info_interface_start()
     print_info(
       "Starting UDP server for info packets on: " + sensor_configuration_->sensor_ip + ": " +
       std::to_string(sensor_configuration_->gnss_port));
-    info_udp_driver_->init_receiver(
-      sensor_configuration_->host_ip, sensor_configuration_->gnss_port);
-    info_udp_driver_->receiver()->open();
-    info_udp_driver_->receiver()->bind();
-
-    info_udp_driver_->receiver()->asyncReceive(
-      std::bind(&RobosenseHwInterface::receive_info_packet_callback, this, std::placeholders::_1));
+    // DIFOP packets arrive about once per second, batching them would not gain anything
+    info_udp_receiver_ = std::make_unique<connections::UdpReceiver>(1500, 1);
+    info_udp_receiver_->bind(sensor_configuration_->host_ip, sensor_configuration_->gnss_port);
+
+    info_udp_receiver_->subscribe(
+      [this](util::span<const uint8_t> packet, const connections::UdpPacketMetadata &) {
+        // The packet is only valid during the call. Copying it is negligible at this rate.
+        std::vector<uint8_t> buffer(packet.begin(), packet.end());
+        receive_info_packet_callback(buffer);
+      },
+      reactor_);
   } catch (const std::exception & ex) {
     Status status = Status::UDP_CONNECTION_ERROR;
     std::cerr << status << sensor_configuration_->sensor_ip << ","
@@ -88,7 +88,8 @@ Status RobosenseHwInterface::set_sensor_configuration(
 }
 
 Status RobosenseHwInterface::register_scan_callback(
-  std::function<void(std::vector<uint8_t> &)> scan_callback)
+  std::function<void(util::span<const uint8_t>, const connections::UdpPacketMetadata &)>
+    scan_callback)
 {
   scan_reception_callback_ = std::move(scan_callback);
   return Status::OK;
@@ -101,6 +102,11 @@ Status RobosenseHwInterface::register_info_callback(
   return Status::OK;
 }
 
+void RobosenseHwInterface::set_reactor(std::shared_ptr<connections::Reactor> reactor)
+{
+  reactor_ = std::move(reactor);
+}
+
 void RobosenseHwInterface::print_debug(std::string debug)
 {
   if (parent_node_logger_) {
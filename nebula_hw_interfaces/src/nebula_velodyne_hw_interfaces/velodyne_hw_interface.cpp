@@ -5,9 +5,7 @@
 namespace nebula::drivers
 {
 VelodyneHwInterface::VelodyneHwInterface()
-: cloud_io_context_{new ::drivers::common::IoContext(1)},
-  cloud_udp_driver_{new ::drivers::udp_driver::UdpDriver(*cloud_io_context_)},
-  boost_ctx_{new boost::asio::io_context()},
+: boost_ctx_{new boost::asio::io_context()},
   http_client_driver_{new ::drivers::tcp_driver::HttpClientDriver(boost_ctx_)}
 {
 }
@@ -57,12 +55,13 @@ Status VelodyneHwInterface::set_sensor_configuration(
 Status VelodyneHwInterface::sensor_interface_start()
 {
   try {
-    cloud_udp_driver_->init_receiver(
-      sensor_configuration_->host_ip, sensor_configuration_->data_port);
-    cloud_udp_driver_->receiver()->open();
-    cloud_udp_driver_->receiver()->bind();
-    cloud_udp_driver_->receiver()->asyncReceive(
-      std::bind(&VelodyneHwInterface::receive_sensor_packet_callback, this, std::placeholders::_1));
+    cloud_udp_receiver_ = std::make_unique<connections::UdpReceiver>();
+    cloud_udp_receiver_->bind(sensor_configuration_->host_ip, sensor_configuration_->data_port);
+    cloud_udp_receiver_->subscribe(
+      std::bind(
+        &VelodyneHwInterface::receive_sensor_packet_callback, this, std::placeholders::_1,
+        std::placeholders::_2),
+      reactor_);
   } catch (const std::exception & ex) {
     Status status = Status::UDP_CONNECTION_ERROR;
     std::cerr << status << sensor_configuration_->sensor_ip << ","
@@ -73,19 +72,26 @@ Status VelodyneHwInterface::sensor_interface_start()
 }
 
 Status VelodyneHwInterface::register_scan_callback(
-  std::function<void(std::vector<uint8_t> & packet)> scan_callback)
+  std::function<void(util::span<const uint8_t> packet, const connections::UdpPacketMetadata &)>
+    scan_callback)
 {
   cloud_packet_callback_ = std::move(scan_callback);
   return Status::OK;
 }
 
-void VelodyneHwInterface::receive_sensor_packet_callback(std::vector<uint8_t> & buffer)
+void VelodyneHwInterface::set_reactor(std::shared_ptr<connections::Reactor> reactor)
+{
+  reactor_ = std::move(reactor);
+}
+
+void VelodyneHwInterface::receive_sensor_packet_callback(
+  util::span<const uint8_t> buffer, const connections::UdpPacketMetadata & metadata)
 {
   if (!cloud_packet_callback_) {
     return;
   }
 
-  cloud_packet_callback_(buffer);
+  cloud_packet_callback_(buffer, metadata);
 }
 Status VelodyneHwInterface::sensor_interface_stop()
 {
@@ -0,0 +1,36 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nebula_common/util/expected.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/connections/reactor.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <memory>
+#include <string>
+
+namespace nebula::ros
+{
+
+/// @brief Declare the `io_threads` and `io_cpus` parameters and get the I/O reactor they configure.
+/// All sensors of a process (e.g. the components of one container) share the same reactor, set up
+/// by the first sensor that asks for one.
+/// @param node The node to declare the parameters on
+/// @return The reactor, nullptr if `io_threads` is 0 (every socket is received on a thread of its
+/// own), or an error message
+util::expected<std::shared_ptr<drivers::connections::Reactor>, std::string>
+declare_and_get_io_reactor(rclcpp::Node & node);
+
+}  // namespace nebula::ros
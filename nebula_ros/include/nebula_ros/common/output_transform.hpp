@@ -0,0 +1,40 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nebula_common/util/expected.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nebula::ros
+{
+
+/// @brief Determine the pose of the sensor in the frame points are output in, which the decoders
+/// apply to the points while decoding
+/// @param node The node to look up TF with
+/// @param frame_id The sensor frame
+/// @param output_frame The frame to output points in. If empty or equal to `frame_id`, points are
+/// output in the sensor frame.
+/// @param output_extrinsic The pose of `frame_id` in `output_frame` as "x, y, z, roll, pitch, yaw"
+/// in meters and radians. If empty, it is looked up in TF once.
+/// @return The pose as [x, y, z, roll, pitch, yaw], empty if points are output in the sensor
+/// frame, or an error message
+util::expected<std::vector<double>, std::string> get_output_transform(
+  rclcpp::Node & node, const std::string & frame_id, const std::string & output_frame,
+  const std::string & output_extrinsic);
+
+}  // namespace nebula::ros
@@ -0,0 +1,73 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nebula_common/point_types.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/msg/point_field.hpp>
+
+#include <vector>
+
+namespace nebula::ros
+{
+
+/// @brief The messages to serialize a scan into. Layouts whose message is null are skipped, so
+/// only the layouts that currently have subscribers have to be requested.
+struct PointCloudMessages
+{
+  /// @brief The `NebulaPoint` fields that each layout is serialized from
+  static constexpr drivers::PointFieldMask nebula_points_fields = drivers::point_field::all;
+  static constexpr drivers::PointFieldMask aw_points_fields =
+    drivers::point_field::xyz | drivers::point_field::intensity | drivers::point_field::channel;
+  static constexpr drivers::PointFieldMask aw_points_ex_fields =
+    aw_points_fields | drivers::point_field::azimuth | drivers::point_field::distance |
+    drivers::point_field::time_stamp;
+
+  /// @brief `PointXYZIRCAEDT` (the decoders' native point type)
+  sensor_msgs::msg::PointCloud2 * nebula_points{};
+  /// @brief `PointXYZIR`
+  sensor_msgs::msg::PointCloud2 * aw_points{};
+  /// @brief `PointXYZIRADT`
+  sensor_msgs::msg::PointCloud2 * aw_points_ex{};
+};
+
+/// @brief The fields of the `PointXYZIRCAEDT` layout, as written by `pcl::toROSMsg`
+const std::vector<sensor_msgs::msg::PointField> & point_xyzircaedt_fields();
+
+/// @brief The fields of the `PointXYZIR` layout, as written by `pcl::toROSMsg`
+const std::vector<sensor_msgs::msg::PointField> & point_xyzir_fields();
+
+/// @brief The fields of the `PointXYZIRADT` layout, as written by `pcl::toROSMsg`
+const std::vector<sensor_msgs::msg::PointField> & point_xyziradt_fields();
+
+/// @brief Serialize a scan into all requested layouts in a single pass over its points.
+///
+/// The resulting messages are byte-identical to converting the cloud with
+/// `convert_point_xyzircaedt_to_point_xyz*` and then serializing it with `pcl::toROSMsg`, but no
+/// intermediate clouds are built. The headers' stamp and frame ID are left to the caller.
+///
+/// Clouds that are not dense (e.g. organized clouds with empty cells) keep their layout in the
+/// native format, while the Autoware formats, which are unorganized and dense, only contain the
+/// points with finite coordinates.
+/// @param pointcloud The scan to serialize
+/// @param scan_timestamp_s The scan timestamp, which the `PointXYZIRADT` point timestamps are
+/// relative to
+/// @param messages (out) The messages to write the requested layouts to
+void serialize_point_cloud(
+  const drivers::NebulaPointCloud & pointcloud, double scan_timestamp_s,
+  const PointCloudMessages & messages);
+
+}  // namespace nebula::ros
@@ -0,0 +1,277 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// @brief A bounded queue between exactly one producer thread and one consumer thread.
+///
+/// Values are moved into a ring of slots that is allocated once on construction, or written to the
+/// slots in place with `claim` and read in place with `peek`. Pushing and popping only touch the
+/// slot and the two indices, which are on separate cache lines. A thread that has to wait (the
+/// consumer on an empty queue, a blocking producer on a full one) spins briefly and then sleeps on
+/// a futex, which the other side only has to wake if it is sleeping.
+///
+/// Drop-in replacement for `MtQueue` wherever there is a single producer and a single consumer.
+template <typename T>
+class SpscQueue
+{
+public:
+  explicit SpscQueue(size_t capacity)
+  : capacity_(capacity), mask_(round_up_to_power_of_two(capacity) - 1), slots_(mask_ + 1)
+  {
+  }
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue & operator=(const SpscQueue &) = delete;
+
+  /// @brief Producer only: push `value` if the queue is not full
+  /// @return Whether the value was pushed. If not, it is counted in `n_dropped()`.
+  bool try_push(T && value)
+  {
+    T * slot = try_claim();
+    if (!slot) {
+      return false;
+    }
+
+    *slot = std::move(value);
+    commit();
+    return true;
+  }
+
+  /// @brief Producer only: push `value`, waiting for the consumer if the queue is full
+  void push(T && value)
+  {
+    claim() = std::move(value);
+    commit();
+  }
+
+  /// @brief Producer only: the slot the next value has to be written to in place. It still holds
+  /// a value that was popped or released before, so its buffers can be reused instead of
+  /// allocating new ones. The consumer does not see the value before `commit()`.
+  /// @return The slot, or nullptr if the queue is full, which is counted in `n_dropped()`
+  T * try_claim()
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_cache_ >= capacity_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head - tail_cache_ >= capacity_) {
+        n_dropped_.store(
+          n_dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return nullptr;
+      }
+    }
+
+    return &slots_[head & mask_];
+  }
+
+  /// @brief Producer only: like `try_claim`, but waits for the consumer if the queue is full
+  T & claim()
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_cache_ >= capacity_) {
+      wait(producer_waiter_, [&]() {
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        return head - tail_cache_ < capacity_;
+      });
+    }
+
+    return slots_[head & mask_];
+  }
+
+  /// @brief Producer only: hand the value written to the claimed slot to the consumer
+  void commit()
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    head_.store(head + 1, std::memory_order_release);
+
+    // The size based on the cached tail can only be too large, so the consumer's index only has
+    // to be read if that might set a new high-water mark
+    const size_t high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+    if (head + 1 - tail_cache_ > high_water_mark) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head + 1 - tail_cache_ > high_water_mark) {
+        high_water_mark_.store(head + 1 - tail_cache_, std::memory_order_relaxed);
+      }
+    }
+
+    notify(consumer_waiter_);
+  }
+
+  /// @brief Consumer only: pop the oldest value, waiting for the producer if the queue is empty
+  T pop()
+  {
+    wait_for_values(1);
+    T value(std::move(peek(0)));
+    release(1);
+    return value;
+  }
+
+  /// @brief Consumer only: pop up to `max_n_values` of the oldest values and append them to
+  /// `values`, waiting for the producer if the queue is empty. Popping all values available at
+  /// once costs about as much as popping a single one.
+  /// @return The number of values popped, at least one
+  size_t pop_batch(std::vector<T> & values, size_t max_n_values)
+  {
+    const size_t n_values = wait_for_values(max_n_values);
+    for (size_t i = 0; i < n_values; ++i) {
+      values.emplace_back(std::move(peek(i)));
+    }
+    release(n_values);
+    return n_values;
+  }
+
+  /// @brief Consumer only: wait for the producer if the queue is empty, then make up to
+  /// `max_n_values` of the oldest values accessible in place through `peek` until they are
+  /// released
+  /// @return The number of accessible values, at least one
+  size_t wait_for_values(size_t max_n_values)
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    head_cache_ = head_.load(std::memory_order_acquire);
+    if (head_cache_ == tail) {
+      wait(consumer_waiter_, [&]() {
+        head_cache_ = head_.load(std::memory_order_acquire);
+        return head_cache_ != tail;
+      });
+    }
+
+    return std::min(head_cache_ - tail, std::max<size_t>(max_n_values, 1));
+  }
+
+  /// @brief Consumer only: the `i`-th oldest value, which has to be one made accessible by
+  /// `wait_for_values`
+  T & peek(size_t i) { return slots_[(tail_.load(std::memory_order_relaxed) + i) & mask_]; }
+
+  /// @brief Consumer only: return the `n_values` oldest values' slots to the producer, which
+  /// reuses them as they are
+  void release(size_t n_values)
+  {
+    tail_.store(tail_.load(std::memory_order_relaxed) + n_values, std::memory_order_release);
+    notify(producer_waiter_);
+  }
+
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  /// @brief The largest number of values that have been in the queue at once
+  [[nodiscard]] size_t high_water_mark() const
+  {
+    return high_water_mark_.load(std::memory_order_relaxed);
+  }
+
+  /// @brief The number of values that `try_push` could not push because the queue was full
+  [[nodiscard]] size_t n_dropped() const { return n_dropped_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr size_t cache_line_size = 64;
+
+  struct alignas(cache_line_size) Waiter
+  {
+    /// @brief The futex word, incremented on every wake-up
+    std::atomic<uint32_t> epoch{0};
+    std::atomic<bool> is_sleeping{false};
+  };
+
+  static size_t round_up_to_power_of_two(size_t n)
+  {
+    size_t result = 1;
+    while (result < n) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  /// @brief How often to check for the other side before sleeping. Long enough to cover the gap
+  /// between two packets of a busy sensor, short enough not to burn a core on an idle one. With a
+  /// single core, spinning only delays the other side.
+  static int n_spins()
+  {
+    static const int n = std::thread::hardware_concurrency() > 1 ? 2048 : 0;
+    return n;
+  }
+
+  static void cpu_relax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+  }
+
+  /// @brief Block until `ready()` returns true. `ready` has to check for a change that the other
+  /// side makes visible before calling `notify(waiter)`.
+  template <typename Predicate>
+  static void wait(Waiter & waiter, Predicate && ready)
+  {
+    for (int i = 0; i < n_spins(); ++i) {
+      if (ready()) {
+        return;
+      }
+      cpu_relax();
+    }
+
+    while (true) {
+      const uint32_t epoch = waiter.epoch.load(std::memory_order_acquire);
+      waiter.is_sleeping.store(true, std::memory_order_relaxed);
+      // Pairs with the fence in `notify`: either the other side sees `is_sleeping` and wakes this
+      // thread, or `ready()` sees its change
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (ready()) {
+        break;
+      }
+      // Returns right away if `epoch` has changed since it was read
+      syscall(SYS_futex, &waiter.epoch, FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+    }
+    waiter.is_sleeping.store(false, std::memory_order_relaxed);
+  }
+
+  static void notify(Waiter & waiter)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!waiter.is_sleeping.load(std::memory_order_relaxed)) {
+      return;
+    }
+    waiter.epoch.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, &waiter.epoch, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+  }
+
+  // Written by the producer only
+  alignas(cache_line_size) std::atomic<size_t> head_{0};
+  size_t tail_cache_{0};
+  std::atomic<size_t> high_water_mark_{0};
+  std::atomic<size_t> n_dropped_{0};
+
+  // Written by the consumer only
+  alignas(cache_line_size) std::atomic<size_t> tail_{0};
+  size_t head_cache_{0};
+
+  Waiter consumer_waiter_;
+  Waiter producer_waiter_;
+
+  alignas(cache_line_size) const size_t capacity_;
+  const size_t mask_;
+  std::vector<T> slots_;
+};
@@ -51,7 +51,7 @@ public:
       const nebula::drivers::continental_ars548::ContinentalARS548SensorConfiguration> & config,
     bool launch_hw);
 
-  void process_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   void on_config_change(
     const std::shared_ptr<
@@ -14,8 +14,8 @@
 
 #pragma once
 
-#include "nebula_ros/common/mt_queue.hpp"
 #include "nebula_ros/common/parameter_descriptors.hpp"
+#include "nebula_ros/common/spsc_queue.hpp"
 #include "nebula_ros/continental/continental_ars548_decoder_wrapper.hpp"
 #include "nebula_ros/continental/continental_ars548_hw_interface_wrapper.hpp"
 
@@ -56,7 +56,8 @@ public:
 
 private:
   /// @brief Callback from the hw interface's raw data
-  void receive_packet_callback(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg_ptr);
+  void receive_packet_callback(
+    util::span<const uint8_t> packet, const drivers::connections::UdpPacketMetadata & metadata);
 
   /// @brief Callback from replayed NebulaPackets
   void receive_packets_callback(std::unique_ptr<nebula_msgs::msg::NebulaPackets> packets_msg_ptr);
@@ -80,8 +81,9 @@ private:
   std::shared_ptr<const drivers::continental_ars548::ContinentalARS548SensorConfiguration>
     config_ptr_{};
 
-  /// @brief Stores received packets that have not been processed yet by the decoder thread
-  MtQueue<std::unique_ptr<nebula_msgs::msg::NebulaPacket>> packet_queue_;
+  /// @brief Stores received packets that have not been processed yet by the decoder thread. Packets
+  /// are copied into the slots in place and decoded from there, so the slots' buffers are reused.
+  SpscQueue<nebula_msgs::msg::NebulaPacket> packet_queue_;
   /// @brief Thread to isolate decoding from receiving
   std::thread decoder_thread_;
 
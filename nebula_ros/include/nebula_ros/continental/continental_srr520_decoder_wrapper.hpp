@@ -52,7 +52,7 @@ public:
       config,
     std::shared_ptr<drivers::continental_srr520::ContinentalSRR520HwInterface> hw_interface_ptr);
 
-  void process_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  void process_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   void on_config_change(
     const std::shared_ptr<
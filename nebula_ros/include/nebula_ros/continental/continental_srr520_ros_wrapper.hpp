@@ -14,8 +14,8 @@
 
 #pragma once
 
-#include "nebula_ros/common/mt_queue.hpp"
 #include "nebula_ros/common/parameter_descriptors.hpp"
+#include "nebula_ros/common/spsc_queue.hpp"
 #include "nebula_ros/continental/continental_srr520_decoder_wrapper.hpp"
 #include "nebula_ros/continental/continental_srr520_hw_interface_wrapper.hpp"
 
@@ -54,7 +54,7 @@ public:
 
 private:
   /// @brief Callback from the hw interface's raw data
-  void receive_packet_callback(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg_ptr);
+  void receive_packet_callback(const nebula_msgs::msg::NebulaPacket & packet_msg);
 
   /// @brief Callback from replayed NebulaPackets
   void receive_packets_callback(
@@ -79,8 +79,9 @@ private:
   std::shared_ptr<const drivers::continental_srr520::ContinentalSRR520SensorConfiguration>
     config_ptr_{};
 
-  /// @brief Stores received packets that have not been processed yet by the decoder thread
-  MtQueue<std::unique_ptr<nebula_msgs::msg::NebulaPacket>> packet_queue_;
+  /// @brief Stores received packets that have not been processed yet by the decoder thread. Packets
+  /// are copied into the slots in place and decoded from there, so the slots' buffers are reused.
+  SpscQueue<nebula_msgs::msg::NebulaPacket> packet_queue_;
   /// @brief Thread to isolate decoding from receiving
   std::thread decoder_thread_;
 
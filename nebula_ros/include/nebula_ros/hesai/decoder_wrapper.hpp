@@ -16,17 +16,33 @@
 
 #include "nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_hesai/hesai_hw_interface.hpp"
+#include "nebula_ros/common/mt_queue.hpp"
 #include "nebula_ros/common/watchdog_timer.hpp"
 
+#include <diagnostic_updater/diagnostic_updater.hpp>
 #include <nebula_common/hesai/hesai_common.hpp>
 #include <nebula_common/nebula_common.hpp>
+#include <nebula_common/util/span.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <tf2/LinearMath/Transform.h>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
 
+#include <builtin_interfaces/msg/time.hpp>
+#include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
 #include <nebula_msgs/msg/nebula_packet.hpp>
 #include <pandar_msgs/msg/pandar_scan.hpp>
+#include <sensor_msgs/msg/imu.hpp>
 
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace nebula::ros
 {
@@ -39,7 +55,20 @@ public:
     const std::shared_ptr<const nebula::drivers::HesaiCalibrationConfigurationBase> & calibration,
     bool publish_packets);
 
-  void process_cloud_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  ~HesaiDecoderWrapper();
+
+  /// @brief Decode a batch of packets in order and publish the scans and sectors they complete.
+  /// The driver is locked and the subscriptions are checked once per batch instead of per packet.
+  /// @param packet_msgs The packets, which are not referenced after the call returns
+  void process_cloud_packets(
+    const std::vector<const nebula_msgs::msg::NebulaPacket *> & packet_msgs);
+
+  /// @brief Decode a single packet on the calling thread and publish the scans and sectors it
+  /// completes. Used in `inline_decode` mode, where packets are not copied into a `NebulaPacket`.
+  /// @param packet The packet data, which is not referenced after the call returns
+  /// @param stamp The time the packet was received
+  void process_cloud_packet(
+    util::span<const uint8_t> packet, const builtin_interfaces::msg::Time & stamp);
 
   void on_config_change(
     const std::shared_ptr<const nebula::drivers::HesaiSensorConfiguration> & new_config);
@@ -51,9 +80,85 @@ public:
   nebula::Status status();
 
 private:
+  /// @brief A completed scan waiting to be published
+  struct QueuedScan
+  {
+    nebula::drivers::NebulaPointCloudPtr pointcloud;
+    double timestamp_s;
+    /// @brief The fields that were decoded for the scan
+    drivers::PointFieldMask point_fields;
+    /// @brief When the packet completing the scan was received from the sensor, if it was
+    std::optional<std::chrono::system_clock::time_point> receive_time;
+    /// @brief The frame of the configuration the scan was decoded with
+    std::string frame_id;
+  };
+
+  /// @brief Decode the packets in `packet_spans_` (received at `packet_stamps_`) and publish the
+  /// scans and sectors they complete
+  void process_packet_spans();
+
+  /// @brief Convert a completed scan to all subscribed output formats and publish it. Runs on
+  /// `publish_thread_`.
+  /// @param point_fields The fields that were decoded for the scan. Formats needing other fields
+  /// are skipped, which only happens for a scan or two after they gained subscribers.
+  void publish_pointcloud(
+    const nebula::drivers::NebulaPointCloudPtr & pointcloud, double scan_timestamp_s,
+    drivers::PointFieldMask point_fields, const std::string & frame_id);
+
+  /// @brief Hand a completed scan to the publish thread, or drop it if that cannot keep up
+  void queue_scan(QueuedScan scan);
+
+  /// @brief Scan deadline only: publish the scan in progress as is if it has not been completed
+  /// within `scan_deadline_ms` of its expected end. Runs on `scan_deadline_timer_`.
+  void check_scan_deadline();
+
+  /// @brief Convert a sector of a scan to the nebula point format and publish it. Runs on the
+  /// decoding thread.
+  void publish_sector(
+    const nebula::drivers::NebulaPointCloudPtr & sector, double sector_timestamp_s,
+    const std::string & frame_id);
+
   void publish_cloud(
     std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-    const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher);
+    const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher,
+    const std::string & frame_id);
+
+  /// @brief The frame points are output in with the current configuration. `mtx_driver_ptr_` has
+  /// to be held, as the configuration is replaced on parameter changes.
+  std::string get_output_frame_id() const;
+
+  /// @brief Get the point fields read by the output formats that currently have subscribers
+  drivers::PointFieldMask get_subscribed_point_fields() const;
+
+  /// @brief Deskew only: update the linear (and, without IMU, angular) velocity of the sensor
+  void on_twist(const geometry_msgs::msg::TwistWithCovarianceStamped::SharedPtr msg);
+
+  /// @brief Deskew only: update the angular velocity of the sensor
+  void on_imu(const sensor_msgs::msg::Imu::SharedPtr msg);
+
+  /// @brief Deskew only: get the pose of the sensor in the given frame, looking it up in TF on
+  /// first use. Extrinsics are assumed to be static. Guarded by `mtx_ego_motion_`.
+  /// @return The pose, or nullopt if there is no transform (yet)
+  std::optional<tf2::Transform> lookup_sensor_pose(const std::string & frame_id);
+
+  /// @brief Deskew only: hand the current ego motion to the driver. Guarded by `mtx_ego_motion_`.
+  void update_sensor_twist();
+
+  /// @brief Report the decoder's CRC validation counters. Warns if packets have been rejected since
+  /// the last report.
+  void check_packet_integrity(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
+
+  /// @brief Report the UDP sequence statistics of the scans completed since the last report. Warns
+  /// if packets have been lost on the way from the sensor.
+  void check_packet_sequence(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
+
+  /// @brief Scan deadline only: report the number of scans published incomplete since the last
+  /// report. Warns if there were any.
+  void check_scan_deadline_misses(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
+
+  /// @brief Live sensor only: report the latency from receiving the last packet of a scan to
+  /// publishing the scan, for the scans published since the last report
+  void check_scan_latency(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
 
   /// @brief Convert seconds to chrono::nanoseconds
   /// @param seconds
@@ -73,14 +178,68 @@ private:
 
   std::shared_ptr<drivers::HesaiDriver> driver_ptr_{};
   std::mutex mtx_driver_ptr_;
+  /// @brief Deskew only: the sensor velocity last handed to the driver, restored when the driver is
+  /// re-created. Guarded by `mtx_driver_ptr_`.
+  drivers::SensorTwist sensor_twist_;
+  /// @brief The point fields last requested from the driver, restored when the driver is
+  /// re-created. Guarded by `mtx_driver_ptr_`.
+  drivers::PointFieldMask point_fields_ = drivers::point_field::all;
+
+  /// @brief Deskew only: the ego motion inputs and their state, all in the sensor frame
+  rclcpp::Subscription<geometry_msgs::msg::TwistWithCovarianceStamped>::SharedPtr twist_sub_{};
+  rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr imu_sub_{};
+  std::unique_ptr<tf2_ros::Buffer> tf_buffer_;
+  std::unique_ptr<tf2_ros::TransformListener> tf_listener_;
+  std::mutex mtx_ego_motion_;
+  /// @brief Sensor poses in the ego motion input frames, keyed by "<input frame> <sensor frame>"
+  std::unordered_map<std::string, tf2::Transform> sensor_poses_;
+  tf2::Vector3 linear_velocity_{0, 0, 0};
+  tf2::Vector3 angular_velocity_{0, 0, 0};
+  /// @brief The stamp of the last IMU message. Angular velocities from IMU take precedence over
+  /// those of the twist input while they are recent.
+  std::optional<rclcpp::Time> last_imu_stamp_;
+  /// @brief Resets the ego motion to standstill if no input arrives for too long
+  std::shared_ptr<WatchdogTimer> ego_motion_watchdog_;
 
   rclcpp::Publisher<pandar_msgs::msg::PandarScan>::SharedPtr packets_pub_{};
   pandar_msgs::msg::PandarScan::UniquePtr current_scan_msg_{};
 
+  /// @brief Buffers for `process_packet_spans`, kept to avoid reallocating them for every batch
+  std::vector<util::span<const uint8_t>> packet_spans_;
+  std::vector<builtin_interfaces::msg::Time> packet_stamps_;
+  drivers::UnpackedPackets unpacked_packets_;
+
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr nebula_points_pub_{};
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr aw_points_ex_pub_{};
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr aw_points_base_pub_{};
+  /// @brief Only created if `sector_angle` is set
+  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr sector_points_pub_{};
 
   std::shared_ptr<WatchdogTimer> cloud_watchdog_;
+
+  /// @brief Scan deadline only: checks whether the scan in progress is overdue
+  rclcpp::TimerBase::SharedPtr scan_deadline_timer_;
+  /// @brief Scan deadline only: when the last scan was completed (or found overdue without any
+  /// points to publish). Guarded by `mtx_driver_ptr_`.
+  std::chrono::steady_clock::time_point last_scan_time_;
+  /// @brief Scan deadline only: the number of scans published incomplete since the last
+  /// diagnostics report. Guarded by `mtx_driver_ptr_`.
+  uint64_t n_incomplete_scans_since_report_{0};
+
+  std::unique_ptr<diagnostic_updater::Updater> diagnostics_updater_;
+  uint64_t n_rejected_packets_reported_{0};
+  /// @brief Sum of the sequence statistics of all scans since the last diagnostics report. Guarded
+  /// by `mtx_driver_ptr_`.
+  drivers::PacketSequenceStats sequence_stats_since_report_;
+  /// @brief Live sensor only: the latencies of the scans published since the last diagnostics
+  /// report, in milliseconds
+  std::vector<double> scan_latencies_ms_;
+  std::mutex mtx_scan_latencies_;
+
+  /// @brief Completed scans waiting to be published. Sized such that the queued scans and the one
+  /// being published never exhaust the decoder's point cloud pool. Not an `SpscQueue`, as the scan
+  /// deadline timer pushes scans, too.
+  MtQueue<QueuedScan> cloud_queue_;
+  std::thread publish_thread_;
 };
 }  // namespace nebula::ros
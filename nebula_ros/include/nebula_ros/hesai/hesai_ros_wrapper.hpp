@@ -17,7 +17,7 @@
 #include "nebula_common/hesai/hesai_common.hpp"
 #include "nebula_common/nebula_common.hpp"
 #include "nebula_common/nebula_status.hpp"
-#include "nebula_ros/common/mt_queue.hpp"
+#include "nebula_ros/common/spsc_queue.hpp"
 #include "nebula_ros/hesai/decoder_wrapper.hpp"
 #include "nebula_ros/hesai/hw_interface_wrapper.hpp"
 #include "nebula_ros/hesai/hw_monitor_wrapper.hpp"
@@ -26,6 +26,7 @@
 #include <rclcpp/rclcpp.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 
+#include <builtin_interfaces/msg/time.hpp>
 #include <nebula_msgs/msg/nebula_packet.hpp>
 #include <pandar_msgs/msg/pandar_scan.hpp>
 
@@ -62,7 +63,8 @@ public:
   Status stream_start();
 
 private:
-  void receive_cloud_packet_callback(std::vector<uint8_t> & packet);
+  void receive_cloud_packet_callback(
+    util::span<const uint8_t> packet, const drivers::connections::UdpPacketMetadata & metadata);
 
   void receive_scan_message_callback(std::unique_ptr<pandar_msgs::msg::PandarScan> scan_msg);
 
@@ -98,9 +100,19 @@ private:
 
   std::shared_ptr<const nebula::drivers::HesaiSensorConfiguration> sensor_cfg_ptr_{};
 
-  /// @brief Stores received packets that have not been processed yet by the decoder thread
-  MtQueue<std::unique_ptr<nebula_msgs::msg::NebulaPacket>> packet_queue_;
-  /// @brief Thread to isolate decoding from receiving
+  /// @brief The most packets the decoder thread takes from `packet_queue_` at once. Bounds how
+  /// long the decoder is locked for a batch.
+  static constexpr size_t max_packet_batch_size = 128;
+
+  /// @brief Decode packets on the thread receiving them instead of handing them to
+  /// `decoder_thread_`. Saves a copy and a thread handoff per packet, but packets arriving while
+  /// the decoder is busy can only be buffered by the socket.
+  bool inline_decode_;
+
+  /// @brief Stores received packets that have not been processed yet by the decoder thread. Packets
+  /// are copied into the slots in place and decoded from there, so the slots' buffers are reused.
+  SpscQueue<nebula_msgs::msg::NebulaPacket> packet_queue_;
+  /// @brief Thread to isolate decoding from receiving. Not started with `inline_decode_`.
   std::thread decoder_thread_;
 
   rclcpp::Subscription<pandar_msgs::msg::PandarScan>::SharedPtr packets_sub_{};
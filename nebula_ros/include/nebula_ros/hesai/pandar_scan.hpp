@@ -0,0 +1,38 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nebula_common/util/span.hpp>
+
+#include <pandar_msgs/msg/pandar_packet.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace nebula::ros
+{
+
+/// @brief Get the bytes that were received for a packet recorded in a `PandarScan`.
+///
+/// The message's `data` is a fixed-size array that is zero-padded behind the `size` received bytes.
+/// The padding must not be decoded, as the decoders would read it as the optional fields behind
+/// the packet tail (UDP sequence number, tail CRC) that the sensor did not send.
+inline util::span<const uint8_t> get_received_bytes(const pandar_msgs::msg::PandarPacket & packet)
+{
+  return {packet.data.data(), std::min<size_t>(packet.size, packet.data.size())};
+}
+
+}  // namespace nebula::ros
@@ -28,6 +28,8 @@
 
 #include <chrono>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace nebula::ros
 {
@@ -41,7 +43,12 @@ public:
     const std::shared_ptr<const nebula::drivers::RobosenseSensorConfiguration> & config,
     const std::shared_ptr<const nebula::drivers::RobosenseCalibrationConfiguration> & calibration);
 
-  void process_cloud_packet(std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg);
+  /// @brief Decode a batch of packets in order and publish the scans they complete. The driver is
+  /// locked and the subscriptions are checked once per batch (or per completed scan) instead of
+  /// once per packet.
+  /// @param packet_msgs The packets, which are not referenced after the call returns
+  void process_cloud_packets(
+    const std::vector<const nebula_msgs::msg::NebulaPacket *> & packet_msgs);
 
   void on_config_change(
     const std::shared_ptr<const nebula::drivers::RobosenseSensorConfiguration> & new_config);
@@ -49,9 +56,19 @@ public:
   nebula::Status status();
 
 private:
+  /// @brief Append a packet to the scan message that is published for recording
+  void record_packet(const nebula_msgs::msg::NebulaPacket & packet_msg);
+
+  /// @brief Publish the recorded packets and convert a completed scan to all subscribed output
+  /// formats. Has to run before the driver decodes the next packet, as the driver reuses the cloud.
+  void publish_scan(
+    const drivers::NebulaPointCloud & pointcloud, double scan_timestamp_s,
+    const std::string & frame_id);
+
   void publish_cloud(
     std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-    const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher);
+    const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher,
+    const std::string & frame_id);
 
   /// @brief Convert seconds to chrono::nanoseconds
   /// @param seconds
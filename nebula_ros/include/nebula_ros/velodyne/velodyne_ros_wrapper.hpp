@@ -14,8 +14,8 @@
 
 #pragma once
 
-#include "nebula_ros/common/mt_queue.hpp"
 #include "nebula_ros/common/parameter_descriptors.hpp"
+#include "nebula_ros/common/spsc_queue.hpp"
 #include "nebula_ros/velodyne/decoder_wrapper.hpp"
 #include "nebula_ros/velodyne/hw_interface_wrapper.hpp"
 #include "nebula_ros/velodyne/hw_monitor_wrapper.hpp"
@@ -24,6 +24,7 @@
 #include <boost_tcp_driver/tcp_driver.hpp>
 #include <nebula_common/nebula_common.hpp>
 #include <nebula_common/nebula_status.hpp>
+#include <nebula_common/util/span.hpp>
 #include <nebula_common/velodyne/velodyne_common.hpp>
 #include <nebula_hw_interfaces/nebula_hw_interfaces_velodyne/velodyne_hw_interface.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -63,7 +64,8 @@ public:
   Status stream_start();
 
 private:
-  void receive_cloud_packet_callback(std::vector<uint8_t> & packet);
+  void receive_cloud_packet_callback(
+    util::span<const uint8_t> packet, const drivers::connections::UdpPacketMetadata & metadata);
 
   void receive_scan_message_callback(std::unique_ptr<velodyne_msgs::msg::VelodyneScan> scan_msg);
 
@@ -82,8 +84,13 @@ private:
 
   std::shared_ptr<const nebula::drivers::VelodyneSensorConfiguration> sensor_cfg_ptr_{};
 
-  /// @brief Stores received packets that have not been processed yet by the decoder thread
-  MtQueue<std::unique_ptr<nebula_msgs::msg::NebulaPacket>> packet_queue_;
+  /// @brief The most packets the decoder thread takes from `packet_queue_` at once. Bounds how
+  /// long the decoder is locked for a batch.
+  static constexpr size_t max_packet_batch_size = 128;
+
+  /// @brief Stores received packets that have not been processed yet by the decoder thread. Packets
+  /// are copied into the slots in place and decoded from there, so the slots' buffers are reused.
+  SpscQueue<nebula_msgs::msg::NebulaPacket> packet_queue_;
   /// @brief Thread to isolate decoding from receiving
   std::thread decoder_thread_;
 
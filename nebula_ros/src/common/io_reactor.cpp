@@ -0,0 +1,61 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "nebula_ros/common/io_reactor.hpp"
+
+#include "nebula_ros/common/parameter_descriptors.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace nebula::ros
+{
+
+util::expected<std::shared_ptr<drivers::connections::Reactor>, std::string>
+declare_and_get_io_reactor(rclcpp::Node & node)
+{
+  auto n_threads = node.declare_parameter<uint16_t>("io_threads", param_read_only());
+  auto cpu_list = node.declare_parameter<std::string>("io_cpus", param_read_only());
+
+  if (n_threads == 0) {
+    if (!cpu_list.empty()) {
+      return std::string("io_cpus is set but io_threads is 0");
+    }
+    return std::shared_ptr<drivers::connections::Reactor>{};
+  }
+
+  std::replace(cpu_list.begin(), cpu_list.end(), ',', ' ');
+  std::istringstream stream(cpu_list);
+  std::vector<int> cpus;
+  int cpu{};
+  while (stream >> cpu) {
+    cpus.push_back(cpu);
+  }
+  if (!stream.eof()) {
+    return std::string("io_cpus has to be a comma-separated list of CPU indices");
+  }
+
+  std::shared_ptr<drivers::connections::Reactor> reactor;
+  try {
+    reactor = drivers::connections::Reactor::get_process_wide(n_threads, cpus);
+  } catch (const std::runtime_error & e) {
+    return std::string(e.what());
+  }
+
+  if (reactor->n_threads() != n_threads || reactor->cpus() != cpus) {
+    RCLCPP_WARN(
+      node.get_logger(),
+      "Another sensor in this process has already set up the I/O reactor with %zu threads, "
+      "io_threads and io_cpus are ignored",
+      reactor->n_threads());
+  } else {
+    RCLCPP_INFO(node.get_logger(), "Receiving packets on a shared I/O reactor");
+  }
+  return reactor;
+}
+
+}  // namespace nebula::ros
@@ -0,0 +1,86 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "nebula_ros/common/output_transform.hpp"
+
+#include <tf2/LinearMath/Matrix3x3.h>
+#include <tf2/LinearMath/Quaternion.h>
+#include <tf2/exceptions.h>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
+
+#include <geometry_msgs/msg/transform_stamped.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace nebula::ros
+{
+
+namespace
+{
+
+/// @brief How long to wait for the transform to become available in TF at startup
+constexpr double g_tf_timeout_s = 5.;
+
+}  // namespace
+
+util::expected<std::vector<double>, std::string> get_output_transform(
+  rclcpp::Node & node, const std::string & frame_id, const std::string & output_frame,
+  const std::string & output_extrinsic)
+{
+  if (output_frame.empty() || output_frame == frame_id) {
+    if (!output_extrinsic.empty()) {
+      return std::string("output_extrinsic is set but output_frame is not");
+    }
+    return std::vector<double>{};
+  }
+
+  if (!output_extrinsic.empty()) {
+    std::string list = output_extrinsic;
+    std::replace(list.begin(), list.end(), ',', ' ');
+    std::istringstream stream(list);
+
+    std::vector<double> pose;
+    double value{};
+    while (stream >> value) {
+      pose.push_back(value);
+    }
+
+    bool all_finite =
+      std::all_of(pose.begin(), pose.end(), [](double v) { return std::isfinite(v); });
+    if (!stream.eof() || pose.size() != 6 || !all_finite) {
+      return std::string("output_extrinsic needs 6 values (x, y, z, roll, pitch, yaw)");
+    }
+    return pose;
+  }
+
+  auto tf_buffer = std::make_unique<tf2_ros::Buffer>(node.get_clock());
+  auto tf_listener = std::make_unique<tf2_ros::TransformListener>(*tf_buffer);
+
+  geometry_msgs::msg::TransformStamped output_to_sensor_tf;
+  try {
+    output_to_sensor_tf = tf_buffer->lookupTransform(
+      output_frame, frame_id, rclcpp::Time(0), rclcpp::Duration::from_seconds(g_tf_timeout_s));
+  } catch (tf2::TransformException & ex) {
+    return "Could not obtain the transform from " + output_frame + " to " + frame_id + " (" +
+           ex.what() + ")";
+  }
+
+  const auto & translation = output_to_sensor_tf.transform.translation;
+  const auto & quat = output_to_sensor_tf.transform.rotation;
+  double roll{};
+  double pitch{};
+  double yaw{};
+  tf2::Matrix3x3(tf2::Quaternion(quat.x, quat.y, quat.z, quat.w)).getRPY(roll, pitch, yaw);
+
+  RCLCPP_INFO(
+    node.get_logger(), "Outputting points in %s, using the transform from TF",
+    output_frame.c_str());
+  return std::vector<double>{translation.x, translation.y, translation.z, roll, pitch, yaw};
+}
+
+}  // namespace nebula::ros
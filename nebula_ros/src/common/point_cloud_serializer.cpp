@@ -0,0 +1,182 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "nebula_ros/common/point_cloud_serializer.hpp"
+
+#include <nebula_common/nebula_common.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace nebula::ros
+{
+
+namespace
+{
+
+using sensor_msgs::msg::PointField;
+
+PointField make_field(const std::string & name, size_t offset, uint8_t datatype)
+{
+  PointField field;
+  field.name = name;
+  field.offset = static_cast<uint32_t>(offset);
+  field.datatype = datatype;
+  field.count = 1;
+  return field;
+}
+
+/// @brief Prepare the header fields and data buffer of `msg` for `n_points` points of the given
+/// layout. Returns a pointer to the start of the data buffer.
+uint8_t * init_message(
+  sensor_msgs::msg::PointCloud2 & msg, const std::vector<PointField> & fields, size_t point_step,
+  uint32_t width, uint32_t height, bool is_dense)
+{
+  msg.height = height;
+  msg.width = width;
+  msg.fields = fields;
+  msg.is_bigendian = false;
+  msg.point_step = static_cast<uint32_t>(point_step);
+  msg.row_step = static_cast<uint32_t>(point_step) * width;
+  msg.is_dense = is_dense;
+  msg.data.resize(point_step * width * height);
+  return msg.data.data();
+}
+
+}  // namespace
+
+const std::vector<PointField> & point_xyzircaedt_fields()
+{
+  using drivers::PointXYZIRCAEDT;
+  static const std::vector<PointField> fields{
+    make_field("x", offsetof(PointXYZIRCAEDT, x), PointField::FLOAT32),
+    make_field("y", offsetof(PointXYZIRCAEDT, y), PointField::FLOAT32),
+    make_field("z", offsetof(PointXYZIRCAEDT, z), PointField::FLOAT32),
+    make_field("intensity", offsetof(PointXYZIRCAEDT, intensity), PointField::UINT8),
+    make_field("return_type", offsetof(PointXYZIRCAEDT, return_type), PointField::UINT8),
+    make_field("channel", offsetof(PointXYZIRCAEDT, channel), PointField::UINT16),
+    make_field("azimuth", offsetof(PointXYZIRCAEDT, azimuth), PointField::FLOAT32),
+    make_field("elevation", offsetof(PointXYZIRCAEDT, elevation), PointField::FLOAT32),
+    make_field("distance", offsetof(PointXYZIRCAEDT, distance), PointField::FLOAT32),
+    make_field("time_stamp", offsetof(PointXYZIRCAEDT, time_stamp), PointField::UINT32)};
+  return fields;
+}
+
+const std::vector<PointField> & point_xyzir_fields()
+{
+  using drivers::PointXYZIR;
+  static const std::vector<PointField> fields{
+    make_field("x", offsetof(PointXYZIR, x), PointField::FLOAT32),
+    make_field("y", offsetof(PointXYZIR, y), PointField::FLOAT32),
+    make_field("z", offsetof(PointXYZIR, z), PointField::FLOAT32),
+    make_field("intensity", offsetof(PointXYZIR, intensity), PointField::FLOAT32),
+    make_field("ring", offsetof(PointXYZIR, ring), PointField::UINT16)};
+  return fields;
+}
+
+const std::vector<PointField> & point_xyziradt_fields()
+{
+  using drivers::PointXYZIRADT;
+  static const std::vector<PointField> fields{
+    make_field("x", offsetof(PointXYZIRADT, x), PointField::FLOAT32),
+    make_field("y", offsetof(PointXYZIRADT, y), PointField::FLOAT32),
+    make_field("z", offsetof(PointXYZIRADT, z), PointField::FLOAT32),
+    make_field("intensity", offsetof(PointXYZIRADT, intensity), PointField::FLOAT32),
+    make_field("ring", offsetof(PointXYZIRADT, ring), PointField::UINT16),
+    make_field("azimuth", offsetof(PointXYZIRADT, azimuth), PointField::FLOAT32),
+    make_field("distance", offsetof(PointXYZIRADT, distance), PointField::FLOAT32),
+    make_field("return_type", offsetof(PointXYZIRADT, return_type), PointField::UINT8),
+    make_field("time_stamp", offsetof(PointXYZIRADT, time_stamp), PointField::FLOAT64)};
+  return fields;
+}
+
+void serialize_point_cloud(
+  const drivers::NebulaPointCloud & pointcloud, double scan_timestamp_s,
+  const PointCloudMessages & messages)
+{
+  const auto n_points = static_cast<uint32_t>(pointcloud.points.size());
+
+  uint8_t * nebula_out = nullptr;
+  uint8_t * xyzir_out = nullptr;
+  uint8_t * xyziradt_out = nullptr;
+
+  if (messages.nebula_points) {
+    // Like `pcl::toROSMsg`, treat clouds without dimensions (e.g. cleared ones) as unorganized
+    const bool has_dimensions = pointcloud.width != 0 || pointcloud.height != 0;
+    nebula_out = init_message(
+      *messages.nebula_points, point_xyzircaedt_fields(), sizeof(drivers::PointXYZIRCAEDT),
+      has_dimensions ? pointcloud.width : n_points, has_dimensions ? pointcloud.height : 1,
+      pointcloud.is_dense);
+  }
+  // The converted Autoware clouds are always unorganized and dense. For clouds that are not dense
+  // (i.e. organized clouds with empty cells), they are sized for all points and shrunk to the
+  // valid ones afterwards.
+  if (messages.aw_points) {
+    xyzir_out = init_message(
+      *messages.aw_points, point_xyzir_fields(), sizeof(drivers::PointXYZIR), n_points, 1, true);
+  }
+  if (messages.aw_points_ex) {
+    xyziradt_out = init_message(
+      *messages.aw_points_ex, point_xyziradt_fields(), sizeof(drivers::PointXYZIRADT), n_points,
+      1, true);
+  }
+
+  if (!nebula_out && !xyzir_out && !xyziradt_out) return;
+
+  // Points are assembled in zero-initialized structs and copied as a whole, so that padding bytes
+  // are zero just like in the clouds serialized by `pcl::toROSMsg`
+  drivers::PointXYZIR xyzir{};
+  drivers::PointXYZIRADT xyziradt{};
+
+  const bool skip_invalid = !pointcloud.is_dense;
+  uint32_t n_valid_points = 0;
+
+  for (const auto & p : pointcloud.points) {
+    if (nebula_out) {
+      std::memcpy(nebula_out, &p, sizeof(p));
+      nebula_out += sizeof(p);
+    }
+
+    if (skip_invalid && !std::isfinite(p.x)) {
+      continue;
+    }
+    ++n_valid_points;
+
+    if (xyzir_out) {
+      xyzir.x = p.x;
+      xyzir.y = p.y;
+      xyzir.z = p.z;
+      xyzir.intensity = p.intensity;
+      xyzir.ring = p.channel;
+      std::memcpy(xyzir_out, &xyzir, sizeof(xyzir));
+      xyzir_out += sizeof(xyzir);
+    }
+
+    if (xyziradt_out) {
+      xyziradt.x = p.x;
+      xyziradt.y = p.y;
+      xyziradt.z = p.z;
+      xyziradt.intensity = p.intensity;
+      xyziradt.ring = p.channel;
+      xyziradt.azimuth = drivers::rad2deg(p.azimuth) * 100.0;
+      xyziradt.distance = p.distance;
+      xyziradt.time_stamp = scan_timestamp_s + static_cast<double>(p.time_stamp) * 1e-9;
+      std::memcpy(xyziradt_out, &xyziradt, sizeof(xyziradt));
+      xyziradt_out += sizeof(xyziradt);
+    }
+  }
+
+  if (n_valid_points != n_points) {
+    for (auto * msg : {messages.aw_points, messages.aw_points_ex}) {
+      if (!msg) continue;
+      msg->width = n_valid_points;
+      msg->row_step = msg->point_step * n_valid_points;
+      msg->data.resize(msg->row_step);
+    }
+  }
+}
+
+}  // namespace nebula::ros
@@ -116,9 +116,9 @@ void ContinentalARS548DecoderWrapper::on_config_change(
 }
 
 void ContinentalARS548DecoderWrapper::process_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
-  driver_ptr_->process_packet(std::move(packet_msg));
+  driver_ptr_->process_packet(packet_msg);
 
   watchdog_->update();
 }
@@ -14,6 +14,8 @@
 
 #include "nebula_ros/continental/continental_ars548_ros_wrapper.hpp"
 
+#include "nebula_ros/common/io_reactor.hpp"
+
 #pragma clang diagnostic ignored "-Wbitwise-instead-of-logical"
 
 namespace nebula::ros
@@ -41,6 +43,11 @@ ContinentalARS548RosWrapper::ContinentalARS548RosWrapper(const rclcpp::NodeOptio
 
   if (launch_hw_) {
     hw_interface_wrapper_.emplace(this, config_ptr_);
+    auto io_reactor = declare_and_get_io_reactor(*this);
+    if (!io_reactor.has_value()) {
+      throw std::runtime_error("Invalid I/O reactor configuration: " + io_reactor.error());
+    }
+    hw_interface_wrapper_->hw_interface()->set_reactor(io_reactor.value());
   }
 
   decoder_wrapper_.emplace(this, config_ptr_, launch_hw_);
@@ -49,13 +56,16 @@ ContinentalARS548RosWrapper::ContinentalARS548RosWrapper(const rclcpp::NodeOptio
 
   decoder_thread_ = std::thread([this]() {
     while (true) {
-      decoder_wrapper_->process_packet(packet_queue_.pop());
+      packet_queue_.wait_for_values(1);
+      decoder_wrapper_->process_packet(packet_queue_.peek(0));
+      packet_queue_.release(1);
     }
   });
 
   if (launch_hw_) {
     hw_interface_wrapper_->hw_interface()->register_packet_callback(std::bind(
-      &ContinentalARS548RosWrapper::receive_packet_callback, this, std::placeholders::_1));
+      &ContinentalARS548RosWrapper::receive_packet_callback, this, std::placeholders::_1,
+      std::placeholders::_2));
     stream_start();
   } else {
     packets_sub_ = create_subscription<nebula_msgs::msg::NebulaPackets>(
@@ -144,24 +154,35 @@ void ContinentalARS548RosWrapper::receive_packets_callback(
   }
 
   for (auto & packet : packets_msg_ptr->packets) {
-    auto nebula_packet_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>();
-    nebula_packet_ptr->stamp = packet.stamp;
-    nebula_packet_ptr->data = std::move(packet.data);
-
-    packet_queue_.push(std::move(nebula_packet_ptr));
+    auto & nebula_packet = packet_queue_.claim();
+    nebula_packet.stamp = packet.stamp;
+    nebula_packet.data.assign(packet.data.begin(), packet.data.end());
+    packet_queue_.commit();
   }
 }
 
 void ContinentalARS548RosWrapper::receive_packet_callback(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> msg_ptr)
+  util::span<const uint8_t> packet, const drivers::connections::UdpPacketMetadata & metadata)
 {
   if (!decoder_wrapper_ || decoder_wrapper_->status() != Status::OK) {
     return;
   }
 
-  if (!packet_queue_.try_push(std::move(msg_ptr))) {
-    RCLCPP_ERROR_THROTTLE(get_logger(), *get_clock(), 500, "Packet(s) dropped");
+  const uint64_t timestamp_ns = metadata.receive_time_ns;
+
+  // The packet is copied into a queue slot, whose buffer has the capacity of the packets before it
+  auto * msg = packet_queue_.try_claim();
+  if (!msg) {
+    RCLCPP_ERROR_THROTTLE(
+      get_logger(), *get_clock(), 500, "Packet(s) dropped (%zu in total)",
+      packet_queue_.n_dropped());
+    return;
   }
+
+  msg->stamp.sec = static_cast<int>(timestamp_ns / 1'000'000'000);
+  msg->stamp.nanosec = static_cast<int>(timestamp_ns % 1'000'000'000);
+  msg->data.assign(packet.begin(), packet.end());
+  packet_queue_.commit();
 }
 
 Status ContinentalARS548RosWrapper::get_status()
@@ -134,9 +134,9 @@ void ContinentalSRR520DecoderWrapper::on_config_change(
 }
 
 void ContinentalSRR520DecoderWrapper::process_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
-  driver_ptr_->process_packet(std::move(packet_msg));
+  driver_ptr_->process_packet(packet_msg);
 
   watchdog_->update();
 }
@@ -50,7 +50,9 @@ ContinentalSRR520RosWrapper::ContinentalSRR520RosWrapper(const rclcpp::NodeOptio
 
   decoder_thread_ = std::thread([this]() {
     while (true) {
-      decoder_wrapper_->process_packet(packet_queue_.pop());
+      packet_queue_.wait_for_values(1);
+      decoder_wrapper_->process_packet(packet_queue_.peek(0));
+      packet_queue_.release(1);
     }
   });
 
@@ -136,24 +138,32 @@ void ContinentalSRR520RosWrapper::receive_packets_callback(
   }
 
   for (auto & packet : packets_msg->packets) {
-    auto nebula_packet_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>();
-    nebula_packet_ptr->stamp = packet.stamp;
-    nebula_packet_ptr->data = std::move(packet.data);
-
-    packet_queue_.push(std::move(nebula_packet_ptr));
+    auto & nebula_packet = packet_queue_.claim();
+    nebula_packet.stamp = packet.stamp;
+    nebula_packet.data.assign(packet.data.begin(), packet.data.end());
+    packet_queue_.commit();
   }
 }
 
 void ContinentalSRR520RosWrapper::receive_packet_callback(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> msg_ptr)
+  const nebula_msgs::msg::NebulaPacket & packet_msg)
 {
   if (!decoder_wrapper_ || decoder_wrapper_->status() != Status::OK) {
     return;
   }
 
-  if (!packet_queue_.try_push(std::move(msg_ptr))) {
-    RCLCPP_ERROR_THROTTLE(get_logger(), *get_clock(), 500, "Packet(s) dropped");
+  // The packet is copied into a queue slot, whose buffer has the capacity of the packets before it
+  auto * msg = packet_queue_.try_claim();
+  if (!msg) {
+    RCLCPP_ERROR_THROTTLE(
+      get_logger(), *get_clock(), 500, "Packet(s) dropped (%zu in total)",
+      packet_queue_.n_dropped());
+    return;
   }
+
+  msg->stamp = packet_msg.stamp;
+  msg->data.assign(packet_msg.data.begin(), packet_msg.data.end());
+  packet_queue_.commit();
 }
 
 Status ContinentalSRR520RosWrapper::get_status()
@@ -2,11 +2,22 @@
 
 #include "nebula_ros/hesai/decoder_wrapper.hpp"
 
+#include "nebula_ros/common/point_cloud_serializer.hpp"
+
 #include <nebula_common/hesai/hesai_common.hpp>
 #include <rclcpp/logging.hpp>
 #include <rclcpp/time.hpp>
+#include <tf2/exceptions.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #pragma clang diagnostic ignored "-Wbitwise-instead-of-logical"
 namespace nebula::ros
@@ -14,6 +25,23 @@ namespace nebula::ros
 
 using namespace std::chrono_literals;  // NOLINT(build/namespaces)
 
+namespace
+{
+bool has_subscribers(
+  const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher)
+{
+  return publisher->get_subscription_count() > 0 ||
+         publisher->get_intra_process_subscription_count() > 0;
+}
+
+std::chrono::system_clock::time_point to_time_point(const builtin_interfaces::msg::Time & stamp)
+{
+  return std::chrono::system_clock::time_point(
+    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+      std::chrono::seconds(stamp.sec) + std::chrono::nanoseconds(stamp.nanosec)));
+}
+}  // namespace
+
 HesaiDecoderWrapper::HesaiDecoderWrapper(
   rclcpp::Node * const parent_node,
   const std::shared_ptr<const nebula::drivers::HesaiSensorConfiguration> & config,
@@ -23,7 +51,8 @@ HesaiDecoderWrapper::HesaiDecoderWrapper(
   logger_(parent_node->get_logger().get_child("HesaiDecoder")),
   parent_node_(*parent_node),
   sensor_cfg_(config),
-  calibration_cfg_ptr_(calibration)
+  calibration_cfg_ptr_(calibration),
+  cloud_queue_(std::max<size_t>(config->point_cloud_pool_size, 4) - 3)
 {
   if (!sensor_cfg_) {
     throw std::runtime_error("HesaiDecoderWrapper cannot be instantiated without a valid config!");
@@ -63,6 +92,36 @@ HesaiDecoderWrapper::HesaiDecoderWrapper(
     parent_node->create_publisher<sensor_msgs::msg::PointCloud2>("aw_points", pointcloud_qos);
   aw_points_ex_pub_ =
     parent_node->create_publisher<sensor_msgs::msg::PointCloud2>("aw_points_ex", pointcloud_qos);
+  if (config->sector_angle > 0) {
+    sector_points_pub_ = parent_node->create_publisher<sensor_msgs::msg::PointCloud2>(
+      "pandar_points_sector", pointcloud_qos);
+  }
+
+  if (config->deskew) {
+    tf_buffer_ = std::make_unique<tf2_ros::Buffer>(parent_node->get_clock());
+    tf_listener_ = std::make_unique<tf2_ros::TransformListener>(*tf_buffer_);
+    twist_sub_ = parent_node->create_subscription<geometry_msgs::msg::TwistWithCovarianceStamped>(
+      "twist_input", rclcpp::QoS{10},
+      std::bind(&HesaiDecoderWrapper::on_twist, this, std::placeholders::_1));
+    imu_sub_ = parent_node->create_subscription<sensor_msgs::msg::Imu>(
+      "imu_input", rclcpp::SensorDataQoS(),
+      std::bind(&HesaiDecoderWrapper::on_imu, this, std::placeholders::_1));
+
+    ego_motion_watchdog_ =
+      std::make_shared<WatchdogTimer>(*parent_node, 1'000'000us, [this, parent_node](bool ok) {
+        if (ok) return;
+        std::lock_guard lock(mtx_ego_motion_);
+        if (linear_velocity_.isZero() && angular_velocity_.isZero()) return;
+        RCLCPP_WARN_THROTTLE(
+          logger_, *parent_node->get_clock(), 5000,
+          "No twist or IMU input received for 1 s, not deskewing until it resumes");
+        linear_velocity_.setZero();
+        angular_velocity_.setZero();
+        last_imu_stamp_.reset();
+        update_sensor_twist();
+      });
+    ego_motion_watchdog_->update();
+  }
 
   RCLCPP_INFO_STREAM(logger_, ". Wrapper=" << status_);
 
@@ -72,6 +131,56 @@ HesaiDecoderWrapper::HesaiDecoderWrapper(
       RCLCPP_WARN_THROTTLE(
         logger_, *parent_node->get_clock(), 5000, "Missed pointcloud output deadline");
     });
+
+  diagnostics_updater_ = std::make_unique<diagnostic_updater::Updater>(parent_node);
+  diagnostics_updater_->setHardwareID(
+    drivers::sensor_model_to_string(config->sensor_model) + ": " + config->frame_id);
+  diagnostics_updater_->add(
+    "hesai_packet_sequence", this, &HesaiDecoderWrapper::check_packet_sequence);
+
+  // Packets from the sensor are stamped on reception, those replayed from a bag are not
+  if (publish_packets) {
+    diagnostics_updater_->add("hesai_scan_latency", this, &HesaiDecoderWrapper::check_scan_latency);
+  }
+
+  if (config->scan_deadline_ms > 0) {
+    last_scan_time_ = std::chrono::steady_clock::now();
+    // Check often enough that scans are published at most a quarter of the deadline late
+    scan_deadline_timer_ = parent_node->create_wall_timer(
+      std::chrono::milliseconds(std::max(config->scan_deadline_ms / 4, 1)),
+      std::bind(&HesaiDecoderWrapper::check_scan_deadline, this));
+    diagnostics_updater_->add(
+      "hesai_scan_deadline", this, &HesaiDecoderWrapper::check_scan_deadline_misses);
+  }
+
+  if (config->validate_packet_crcs) {
+    diagnostics_updater_->add(
+      "hesai_packet_integrity", this, &HesaiDecoderWrapper::check_packet_integrity);
+  }
+
+  // Converting and publishing a scan takes a significant amount of time. Do it on a separate thread
+  // so that decoding of the next scan can continue in the meantime
+  publish_thread_ = std::thread([this]() {
+    while (true) {
+      auto scan = cloud_queue_.pop();
+      if (!scan.pointcloud) return;
+      publish_pointcloud(scan.pointcloud, scan.timestamp_s, scan.point_fields, scan.frame_id);
+
+      if (scan.receive_time) {
+        const std::chrono::duration<double, std::milli> latency =
+          std::chrono::system_clock::now() - *scan.receive_time;
+        std::lock_guard lock(mtx_scan_latencies_);
+        scan_latencies_ms_.push_back(latency.count());
+      }
+    }
+  });
+}
+
+HesaiDecoderWrapper::~HesaiDecoderWrapper()
+{
+  // An empty cloud signals the publish thread to stop
+  cloud_queue_.push({nullptr, 0., 0, std::nullopt, ""});
+  publish_thread_.join();
 }
 
 void HesaiDecoderWrapper::on_config_change(
@@ -79,6 +188,8 @@ void HesaiDecoderWrapper::on_config_change(
 {
   std::lock_guard lock(mtx_driver_ptr_);
   auto new_driver = std::make_shared<drivers::HesaiDriver>(new_config, calibration_cfg_ptr_);
+  new_driver->set_sensor_twist(sensor_twist_);
+  new_driver->set_point_fields(point_fields_);
   driver_ptr_ = new_driver;
   sensor_cfg_ = new_config;
 }
@@ -88,97 +199,451 @@ void HesaiDecoderWrapper::on_calibration_change(
 {
   std::lock_guard lock(mtx_driver_ptr_);
   auto new_driver = std::make_shared<drivers::HesaiDriver>(sensor_cfg_, new_calibration);
+  new_driver->set_sensor_twist(sensor_twist_);
+  new_driver->set_point_fields(point_fields_);
   driver_ptr_ = new_driver;
   calibration_cfg_ptr_ = new_calibration;
 }
 
+void HesaiDecoderWrapper::process_cloud_packets(
+  const std::vector<const nebula_msgs::msg::NebulaPacket *> & packet_msgs)
+{
+  packet_spans_.clear();
+  packet_stamps_.clear();
+  for (const auto * packet_msg : packet_msgs) {
+    packet_spans_.emplace_back(packet_msg->data);
+    packet_stamps_.push_back(packet_msg->stamp);
+  }
+
+  process_packet_spans();
+}
+
 void HesaiDecoderWrapper::process_cloud_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+  util::span<const uint8_t> packet, const builtin_interfaces::msg::Time & stamp)
 {
+  packet_spans_.assign(1, packet);
+  packet_stamps_.assign(1, stamp);
+  process_packet_spans();
+}
+
+void HesaiDecoderWrapper::process_packet_spans()
+{
+  unpacked_packets_.clear();
+  // Scans and sectors are published in the frame of the configuration they were decoded with
+  std::string frame_id;
+  {
+    std::lock_guard lock(mtx_driver_ptr_);
+    driver_ptr_->parse_cloud_packets(packet_spans_, unpacked_packets_);
+    for (const auto & scan : unpacked_packets_.scans) {
+      sequence_stats_since_report_ += scan.sequence_stats;
+    }
+
+    if (!unpacked_packets_.scans.empty() || !unpacked_packets_.sectors.empty()) {
+      frame_id = get_output_frame_id();
+    }
+
+    if (!unpacked_packets_.scans.empty()) {
+      last_scan_time_ = std::chrono::steady_clock::now();
+
+      // Subscriptions are checked once per batch that completes a scan, so that the decoder only
+      // computes the point fields that are actually published
+      point_fields_ = get_subscribed_point_fields();
+      driver_ptr_->set_point_fields(point_fields_);
+    }
+  }
+
+  // Sectors are small and published right away, as their whole point is low latency
+  if (sector_points_pub_) {
+    for (const auto & [sector, sector_timestamp_s] : unpacked_packets_.sectors) {
+      publish_sector(sector, sector_timestamp_s, frame_id);
+    }
+  }
+
   // Accumulate packets for recording only if someone is subscribed to the topic (for performance)
-  if (
+  const bool record_packets =
     packets_pub_ && (packets_pub_->get_subscription_count() > 0 ||
-                     packets_pub_->get_intra_process_subscription_count() > 0)) {
-    if (current_scan_msg_->packets.size() == 0) {
-      current_scan_msg_->header.stamp = packet_msg->stamp;
+                     packets_pub_->get_intra_process_subscription_count() > 0);
+
+  // A pointcloud is only emitted when a scan completes (e.g. 3599 packets do not emit, the 3600th
+  // emits one). If pointclouds are not emitted for too long (e.g. when decoder settings are wrong
+  // or no packets come in), the `cloud_watchdog_` is not updated and logs a warning automatically.
+  auto next_scan = unpacked_packets_.scans.begin();
+  for (size_t i = 0; i < packet_spans_.size(); ++i) {
+    if (record_packets) {
+      const auto & packet = packet_spans_[i];
+      if (current_scan_msg_->packets.size() == 0) {
+        current_scan_msg_->header.stamp = packet_stamps_[i];
+      }
+
+      pandar_msgs::msg::PandarPacket pandar_packet_msg{};
+      pandar_packet_msg.stamp = packet_stamps_[i];
+      pandar_packet_msg.size = packet.size();
+      std::copy(packet.begin(), packet.end(), pandar_packet_msg.data.begin());
+      current_scan_msg_->packets.emplace_back(std::move(pandar_packet_msg));
     }
 
-    pandar_msgs::msg::PandarPacket pandar_packet_msg{};
-    pandar_packet_msg.stamp = packet_msg->stamp;
-    pandar_packet_msg.size = packet_msg->data.size();
-    std::copy(packet_msg->data.begin(), packet_msg->data.end(), pandar_packet_msg.data.begin());
-    current_scan_msg_->packets.emplace_back(std::move(pandar_packet_msg));
+    for (; next_scan != unpacked_packets_.scans.end() && next_scan->packet_index == i;
+         ++next_scan) {
+      // Publish scan message only if it has been written to
+      if (current_scan_msg_ && !current_scan_msg_->packets.empty()) {
+        packets_pub_->publish(std::move(current_scan_msg_));
+        current_scan_msg_ = std::make_unique<pandar_msgs::msg::PandarScan>();
+      }
+
+      // Only packets from the sensor are stamped on reception
+      std::optional<std::chrono::system_clock::time_point> receive_time;
+      if (packets_pub_) {
+        receive_time = to_time_point(packet_stamps_[i]);
+      }
+      queue_scan(
+        {next_scan->pointcloud, next_scan->timestamp_s, next_scan->point_fields, receive_time,
+         frame_id});
+    }
+  }
+
+  // Release the scans, so that the clouds go back to their pool once they have been published
+  unpacked_packets_.clear();
+}
+
+void HesaiDecoderWrapper::queue_scan(QueuedScan scan)
+{
+  cloud_watchdog_->update();
+
+  // The pointcloud is not touched by the decoder anymore and is returned to its pool once the
+  // publish thread is done with it. If the publish thread cannot keep up, drop the scan instead of
+  // stalling the decoder
+  if (!cloud_queue_.try_push(std::move(scan))) {
+    RCLCPP_WARN_THROTTLE(
+      logger_, *parent_node_.get_clock(), 1000,
+      "Point cloud publishing cannot keep up, dropping scan");
   }
+}
 
+void HesaiDecoderWrapper::check_scan_deadline()
+{
+  const auto now = std::chrono::steady_clock::now();
   std::tuple<nebula::drivers::NebulaPointCloudPtr, double> pointcloud_ts{};
-  nebula::drivers::NebulaPointCloudPtr pointcloud = nullptr;
+  drivers::PointFieldMask point_fields = 0;
+  std::vector<std::tuple<nebula::drivers::NebulaPointCloudPtr, double>> sectors;
+  std::string frame_id;
   {
     std::lock_guard lock(mtx_driver_ptr_);
-    pointcloud_ts = driver_ptr_->parse_cloud_packet(packet_msg->data);
-    pointcloud = std::get<0>(pointcloud_ts);
+    const auto rotation_period =
+      std::chrono::microseconds(60'000'000 / std::max<uint16_t>(sensor_cfg_->rotation_speed, 1));
+    const auto deadline = std::chrono::milliseconds(sensor_cfg_->scan_deadline_ms);
+    if (now < last_scan_time_ + rotation_period + deadline) {
+      return;
+    }
+
+    // Even if nothing has been decoded (e.g. the sensor is not sending), wait for another rotation
+    // and deadline before checking again
+    last_scan_time_ = now;
+    pointcloud_ts = driver_ptr_->flush_scan();
+    if (!std::get<0>(pointcloud_ts)) {
+      return;
+    }
+
+    sequence_stats_since_report_ += driver_ptr_->get_scan_sequence_stats();
+    point_fields = driver_ptr_->get_scan_point_fields();
+    ++n_incomplete_scans_since_report_;
+    if (sector_points_pub_) {
+      sectors = driver_ptr_->get_sectors();
+    }
+    frame_id = get_output_frame_id();
   }
 
-  // A pointcloud is only emitted when a scan completes (e.g. 3599 packets do not emit, the 3600th
-  // emits one)
-  if (pointcloud == nullptr) {
-    // Since this ends the function early, the `cloud_watchdog_` will not be updated.
-    // Thus, if pointclouds are not emitted for too long (e.g. when decoder settings are wrong or no
-    // packets come in), the watchdog will log a warning automatically
-    return;
+  RCLCPP_WARN_THROTTLE(
+    logger_, *parent_node_.get_clock(), 1000,
+    "Scan not completed within scan_deadline_ms, publishing it incomplete");
+
+  for (const auto & [sector, sector_timestamp_s] : sectors) {
+    publish_sector(sector, sector_timestamp_s, frame_id);
   }
 
-  cloud_watchdog_->update();
+  // The packets received for the scan are published along with those of the next one, as
+  // `current_scan_msg_` belongs to the packet receiving thread
+  queue_scan(
+    {std::get<0>(pointcloud_ts), std::get<1>(pointcloud_ts), point_fields, std::nullopt,
+     std::move(frame_id)});
+}
 
-  // Publish scan message only if it has been written to
-  if (current_scan_msg_ && !current_scan_msg_->packets.empty()) {
-    packets_pub_->publish(std::move(current_scan_msg_));
-    current_scan_msg_ = std::make_unique<pandar_msgs::msg::PandarScan>();
+drivers::PointFieldMask HesaiDecoderWrapper::get_subscribed_point_fields() const
+{
+  drivers::PointFieldMask point_fields = 0;
+  if (has_subscribers(nebula_points_pub_)) {
+    point_fields |= PointCloudMessages::nebula_points_fields;
+  }
+  if (has_subscribers(aw_points_base_pub_)) {
+    point_fields |= PointCloudMessages::aw_points_fields;
   }
+  if (has_subscribers(aw_points_ex_pub_)) {
+    point_fields |= PointCloudMessages::aw_points_ex_fields;
+  }
+  return point_fields;
+}
 
-  if (
-    nebula_points_pub_->get_subscription_count() > 0 ||
-    nebula_points_pub_->get_intra_process_subscription_count() > 0) {
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*pointcloud, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(seconds_to_chrono_nano_seconds(std::get<1>(pointcloud_ts)).count());
-    publish_cloud(std::move(ros_pc_msg_ptr), nebula_points_pub_);
+void HesaiDecoderWrapper::publish_pointcloud(
+  const nebula::drivers::NebulaPointCloudPtr & pointcloud, double scan_timestamp_s,
+  drivers::PointFieldMask point_fields, const std::string & frame_id)
+{
+  auto can_publish = [point_fields](const auto & publisher, drivers::PointFieldMask fields) {
+    return has_subscribers(publisher) && (fields & ~point_fields) == 0;
+  };
+
+  // Only serialize the layouts that are subscribed to, all of them in one pass over the points
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> nebula_points_msg;
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> aw_points_msg;
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> aw_points_ex_msg;
+  if (can_publish(nebula_points_pub_, PointCloudMessages::nebula_points_fields)) {
+    nebula_points_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
   }
-  if (
-    aw_points_base_pub_->get_subscription_count() > 0 ||
-    aw_points_base_pub_->get_intra_process_subscription_count() > 0) {
-    const auto autoware_cloud_xyzi =
-      nebula::drivers::convert_point_xyzircaedt_to_point_xyzir(pointcloud);
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*autoware_cloud_xyzi, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(seconds_to_chrono_nano_seconds(std::get<1>(pointcloud_ts)).count());
-    publish_cloud(std::move(ros_pc_msg_ptr), aw_points_base_pub_);
+  if (can_publish(aw_points_base_pub_, PointCloudMessages::aw_points_fields)) {
+    aw_points_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  }
+  if (can_publish(aw_points_ex_pub_, PointCloudMessages::aw_points_ex_fields)) {
+    aw_points_ex_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  }
+
+  serialize_point_cloud(
+    *pointcloud, scan_timestamp_s,
+    {nebula_points_msg.get(), aw_points_msg.get(), aw_points_ex_msg.get()});
+
+  const auto stamp = rclcpp::Time(seconds_to_chrono_nano_seconds(scan_timestamp_s).count());
+  if (nebula_points_msg) {
+    nebula_points_msg->header.stamp = stamp;
+    publish_cloud(std::move(nebula_points_msg), nebula_points_pub_, frame_id);
+  }
+  if (aw_points_msg) {
+    aw_points_msg->header.stamp = stamp;
+    publish_cloud(std::move(aw_points_msg), aw_points_base_pub_, frame_id);
   }
+  if (aw_points_ex_msg) {
+    aw_points_ex_msg->header.stamp = stamp;
+    publish_cloud(std::move(aw_points_ex_msg), aw_points_ex_pub_, frame_id);
+  }
+}
+
+void HesaiDecoderWrapper::publish_sector(
+  const nebula::drivers::NebulaPointCloudPtr & sector, double sector_timestamp_s,
+  const std::string & frame_id)
+{
   if (
-    aw_points_ex_pub_->get_subscription_count() > 0 ||
-    aw_points_ex_pub_->get_intra_process_subscription_count() > 0) {
-    const auto autoware_ex_cloud = nebula::drivers::convert_point_xyzircaedt_to_point_xyziradt(
-      pointcloud, std::get<1>(pointcloud_ts));
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*autoware_ex_cloud, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(seconds_to_chrono_nano_seconds(std::get<1>(pointcloud_ts)).count());
-    publish_cloud(std::move(ros_pc_msg_ptr), aw_points_ex_pub_);
+    sector_points_pub_->get_subscription_count() == 0 &&
+    sector_points_pub_->get_intra_process_subscription_count() == 0) {
+    return;
   }
+
+  auto sector_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  serialize_point_cloud(*sector, sector_timestamp_s, {sector_msg.get(), nullptr, nullptr});
+  sector_msg->header.stamp =
+    rclcpp::Time(seconds_to_chrono_nano_seconds(sector_timestamp_s).count());
+  publish_cloud(std::move(sector_msg), sector_points_pub_, frame_id);
 }
 
 void HesaiDecoderWrapper::publish_cloud(
   std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-  const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher)
+  const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher,
+  const std::string & frame_id)
 {
   if (pointcloud->header.stamp.sec < 0) {
     RCLCPP_WARN_STREAM(logger_, "Timestamp error, verify clock source.");
   }
-  pointcloud->header.frame_id = sensor_cfg_->frame_id;
+  pointcloud->header.frame_id = frame_id;
   publisher->publish(std::move(pointcloud));
 }
 
+std::string HesaiDecoderWrapper::get_output_frame_id() const
+{
+  return sensor_cfg_->output_frame.empty() ? sensor_cfg_->frame_id : sensor_cfg_->output_frame;
+}
+
+void HesaiDecoderWrapper::on_twist(
+  const geometry_msgs::msg::TwistWithCovarianceStamped::SharedPtr msg)
+{
+  std::lock_guard lock(mtx_ego_motion_);
+  auto sensor_pose = lookup_sensor_pose(msg->header.frame_id);
+  if (!sensor_pose) {
+    return;
+  }
+
+  const auto & twist = msg->twist.twist;
+  tf2::Vector3 linear(twist.linear.x, twist.linear.y, twist.linear.z);
+  tf2::Vector3 angular(twist.angular.x, twist.angular.y, twist.angular.z);
+
+  // The sensor is offset from the origin of the twist frame, so rotation adds to its velocity
+  const tf2::Matrix3x3 to_sensor = sensor_pose->getBasis().transpose();
+  linear_velocity_ = to_sensor * (linear + angular.cross(sensor_pose->getOrigin()));
+
+  constexpr double imu_timeout_s = 0.5;
+  bool has_recent_imu =
+    last_imu_stamp_ &&
+    std::abs((rclcpp::Time(msg->header.stamp) - *last_imu_stamp_).seconds()) < imu_timeout_s;
+  if (!has_recent_imu) {
+    angular_velocity_ = to_sensor * angular;
+  }
+
+  update_sensor_twist();
+  ego_motion_watchdog_->update();
+}
+
+void HesaiDecoderWrapper::on_imu(const sensor_msgs::msg::Imu::SharedPtr msg)
+{
+  std::lock_guard lock(mtx_ego_motion_);
+  auto sensor_pose = lookup_sensor_pose(msg->header.frame_id);
+  if (!sensor_pose) {
+    return;
+  }
+
+  const auto & angular = msg->angular_velocity;
+  angular_velocity_ =
+    sensor_pose->getBasis().transpose() * tf2::Vector3(angular.x, angular.y, angular.z);
+  last_imu_stamp_ = rclcpp::Time(msg->header.stamp);
+
+  update_sensor_twist();
+  ego_motion_watchdog_->update();
+}
+
+std::optional<tf2::Transform> HesaiDecoderWrapper::lookup_sensor_pose(const std::string & frame_id)
+{
+  const std::string & sensor_frame_id = sensor_cfg_->frame_id;
+  const std::string key = frame_id + " " + sensor_frame_id;
+  auto it = sensor_poses_.find(key);
+  if (it != sensor_poses_.end()) {
+    return it->second;
+  }
+
+  geometry_msgs::msg::TransformStamped sensor_tf;
+  try {
+    sensor_tf = tf_buffer_->lookupTransform(frame_id, sensor_frame_id, tf2::TimePointZero);
+  } catch (tf2::TransformException & ex) {
+    RCLCPP_WARN_THROTTLE(
+      logger_, *parent_node_.get_clock(), 5000,
+      "Cannot deskew, could not obtain the transform from %s to %s (%s)", frame_id.c_str(),
+      sensor_frame_id.c_str(), ex.what());
+    return std::nullopt;
+  }
+
+  const auto & rotation = sensor_tf.transform.rotation;
+  const auto & translation = sensor_tf.transform.translation;
+  tf2::Transform sensor_pose(
+    tf2::Quaternion(rotation.x, rotation.y, rotation.z, rotation.w),
+    tf2::Vector3(translation.x, translation.y, translation.z));
+  sensor_poses_.emplace(key, sensor_pose);
+  return sensor_pose;
+}
+
+void HesaiDecoderWrapper::update_sensor_twist()
+{
+  drivers::SensorTwist twist;
+  twist.linear = {linear_velocity_.x(), linear_velocity_.y(), linear_velocity_.z()};
+  twist.angular = {angular_velocity_.x(), angular_velocity_.y(), angular_velocity_.z()};
+
+  std::lock_guard lock(mtx_driver_ptr_);
+  sensor_twist_ = twist;
+  driver_ptr_->set_sensor_twist(twist);
+}
+
+void HesaiDecoderWrapper::check_packet_integrity(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  drivers::PacketIntegrityCounters counters;
+  {
+    std::lock_guard lock(mtx_driver_ptr_);
+    counters = driver_ptr_->get_packet_integrity_counters();
+  }
+
+  diagnostics.add("packets_checked", std::to_string(counters.n_packets_checked));
+  diagnostics.add("body_crc_errors", std::to_string(counters.n_body_crc_errors));
+  diagnostics.add(
+    "functional_safety_crc_errors", std::to_string(counters.n_functional_safety_crc_errors));
+  diagnostics.add("tail_crc_errors", std::to_string(counters.n_tail_crc_errors));
+
+  // The counters start from zero whenever the driver is re-created on a config change
+  uint64_t n_rejected = counters.get_n_rejected();
+  if (n_rejected > n_rejected_packets_reported_) {
+    diagnostics.summary(
+      diagnostic_msgs::msg::DiagnosticStatus::WARN,
+      std::to_string(n_rejected - n_rejected_packets_reported_) +
+        " packets dropped due to CRC errors");
+  } else {
+    diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "OK");
+  }
+  n_rejected_packets_reported_ = n_rejected;
+}
+
+void HesaiDecoderWrapper::check_packet_sequence(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  drivers::PacketSequenceStats stats;
+  {
+    std::lock_guard lock(mtx_driver_ptr_);
+    stats = sequence_stats_since_report_;
+    sequence_stats_since_report_ = {};
+  }
+
+  diagnostics.add("packets", std::to_string(stats.n_packets));
+  diagnostics.add("packets_lost", std::to_string(stats.n_lost));
+  diagnostics.add("packets_reordered", std::to_string(stats.n_reordered));
+  diagnostics.add("packets_duplicated", std::to_string(stats.n_duplicates));
+  diagnostics.add("sequence_resets", std::to_string(stats.n_resets));
+
+  if (stats.n_packets == 0) {
+    // The UDP sequence number is optional for most sensors and has to be enabled on the sensor
+    diagnostics.summary(
+      diagnostic_msgs::msg::DiagnosticStatus::OK, "No UDP sequence numbers received");
+  } else if (stats.n_lost > 0) {
+    diagnostics.summary(
+      diagnostic_msgs::msg::DiagnosticStatus::WARN,
+      std::to_string(stats.n_lost) + " packets lost on the network");
+  } else {
+    diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "OK");
+  }
+}
+
+void HesaiDecoderWrapper::check_scan_deadline_misses(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  uint64_t n_incomplete_scans = 0;
+  {
+    std::lock_guard lock(mtx_driver_ptr_);
+    n_incomplete_scans = n_incomplete_scans_since_report_;
+    n_incomplete_scans_since_report_ = 0;
+  }
+
+  diagnostics.add("incomplete_scans", std::to_string(n_incomplete_scans));
+
+  if (n_incomplete_scans > 0) {
+    diagnostics.summary(
+      diagnostic_msgs::msg::DiagnosticStatus::WARN,
+      std::to_string(n_incomplete_scans) + " scans published incomplete after scan_deadline_ms");
+  } else {
+    diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "OK");
+  }
+}
+
+void HesaiDecoderWrapper::check_scan_latency(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  std::vector<double> latencies_ms;
+  {
+    std::lock_guard lock(mtx_scan_latencies_);
+    latencies_ms.swap(scan_latencies_ms_);
+  }
+
+  diagnostics.add("scans", std::to_string(latencies_ms.size()));
+  if (latencies_ms.empty()) {
+    diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "No scans published");
+    return;
+  }
+
+  auto median = latencies_ms.begin() + latencies_ms.size() / 2;
+  std::nth_element(latencies_ms.begin(), median, latencies_ms.end());
+  diagnostics.add("median_latency_ms", std::to_string(*median));
+  diagnostics.add(
+    "max_latency_ms", std::to_string(*std::max_element(latencies_ms.begin(), latencies_ms.end())));
+  diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "OK");
+}
+
 nebula::Status HesaiDecoderWrapper::status()
 {
   std::lock_guard lock(mtx_driver_ptr_);
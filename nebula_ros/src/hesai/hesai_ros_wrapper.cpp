@@ -2,10 +2,14 @@
 
 #include "nebula_ros/hesai/hesai_ros_wrapper.hpp"
 
+#include "nebula_ros/common/io_reactor.hpp"
+#include "nebula_ros/common/output_transform.hpp"
 #include "nebula_ros/common/parameter_descriptors.hpp"
+#include "nebula_ros/hesai/pandar_scan.hpp"
 
 #include <nebula_common/hesai/hesai_common.hpp>
 #include <nebula_common/nebula_common.hpp>
+#include <nebula_common/point_filter_configuration.hpp>
 #include <nebula_decoders/nebula_decoders_common/angles.hpp>
 
 #include <cstdint>
@@ -14,6 +18,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #pragma clang diagnostic ignored "-Wbitwise-instead-of-logical"
 
@@ -41,6 +46,7 @@ HesaiRosWrapper::HesaiRosWrapper(const rclcpp::NodeOptions & options)
 
   launch_hw_ = declare_parameter<bool>("launch_hw", param_read_only());
   bool use_udp_only = declare_parameter<bool>("udp_only", param_read_only());
+  inline_decode_ = declare_parameter<bool>("inline_decode", param_read_only());
 
   if (use_udp_only) {
     RCLCPP_INFO_STREAM(
@@ -51,6 +57,11 @@ HesaiRosWrapper::HesaiRosWrapper(const rclcpp::NodeOptions & options)
 
   if (launch_hw_) {
     hw_interface_wrapper_.emplace(this, sensor_cfg_ptr_, use_udp_only);
+    auto io_reactor = declare_and_get_io_reactor(*this);
+    if (!io_reactor.has_value()) {
+      throw std::runtime_error("Invalid I/O reactor configuration: " + io_reactor.error());
+    }
+    hw_interface_wrapper_->hw_interface()->SetReactor(io_reactor.value());
     if (!use_udp_only) {  // hardware monitor requires TCP connection
       hw_monitor_wrapper_.emplace(this, hw_interface_wrapper_->hw_interface(), sensor_cfg_ptr_);
     }
@@ -80,15 +91,32 @@ HesaiRosWrapper::HesaiRosWrapper(const rclcpp::NodeOptions & options)
 
   RCLCPP_DEBUG(get_logger(), "Starting stream");
 
-  decoder_thread_ = std::thread([this]() {
-    while (true) {
-      decoder_wrapper_->process_cloud_packet(packet_queue_.pop());
-    }
-  });
+  if (inline_decode_) {
+    RCLCPP_INFO(
+      get_logger(), "Inline decoding is enabled. Packets are decoded on the receiving thread.");
+  } else {
+    // Decode all packets that have queued up (e.g. a burst delivered at once due to interrupt
+    // coalescing) in one batch, straight from the queue's slots
+    decoder_thread_ = std::thread([this]() {
+      std::vector<const nebula_msgs::msg::NebulaPacket *> packets;
+      packets.reserve(max_packet_batch_size);
+      while (true) {
+        const size_t n_packets = packet_queue_.wait_for_values(max_packet_batch_size);
+        for (size_t i = 0; i < n_packets; ++i) {
+          packets.push_back(&packet_queue_.peek(i));
+        }
+        decoder_wrapper_->process_cloud_packets(packets);
+        packets.clear();
+        packet_queue_.release(n_packets);
+      }
+    });
+  }
 
   if (launch_hw_) {
     hw_interface_wrapper_->hw_interface()->RegisterScanCallback(
-      std::bind(&HesaiRosWrapper::receive_cloud_packet_callback, this, std::placeholders::_1));
+      std::bind(
+        &HesaiRosWrapper::receive_cloud_packet_callback, this, std::placeholders::_1,
+        std::placeholders::_2));
     stream_start();
   } else {
     packets_sub_ = create_subscription<pandar_msgs::msg::PandarScan>(
@@ -120,6 +148,8 @@ nebula::Status HesaiRosWrapper::declare_and_get_sensor_config_params()
   config.multicast_ip = declare_parameter<std::string>("multicast_ip", param_read_only());
   config.data_port = declare_parameter<uint16_t>("data_port", param_read_only());
   config.gnss_port = declare_parameter<uint16_t>("gnss_port", param_read_only());
+  auto _receive_backend = declare_parameter<std::string>("receive_backend", param_read_only());
+  config.receive_backend = drivers::receive_backend_from_string(_receive_backend);
   config.frame_id = declare_parameter<std::string>("frame_id", param_read_write());
 
   {
@@ -175,6 +205,65 @@ nebula::Status HesaiRosWrapper::declare_and_get_sensor_config_params()
       declare_parameter<double>("dual_return_distance_threshold", descriptor);
   }
 
+  config.use_compact_trig_tables =
+    declare_parameter<bool>("use_compact_trig_tables", param_read_only());
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor = param_read_only();
+    descriptor.integer_range = int_range(4, 64, 1);
+    config.point_cloud_pool_size =
+      declare_parameter<uint16_t>("point_cloud_pool_size", descriptor);
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor = param_read_only();
+    descriptor.integer_range = int_range(1, 32, 1);
+    config.decoder_threads = declare_parameter<uint16_t>("decoder_threads", descriptor);
+  }
+  config.validate_packet_crcs = declare_parameter<bool>("validate_packet_crcs", param_read_only());
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor = param_read_only();
+    descriptor.integer_range = int_range(0, 36000, 1);
+    config.organized_cloud_columns =
+      declare_parameter<uint16_t>("organized_cloud_columns", descriptor);
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor = param_read_only();
+    descriptor.integer_range = int_range(0, 360, 1);
+    config.sector_angle = declare_parameter<uint16_t>("sector_angle", descriptor);
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor = param_read_only();
+    descriptor.integer_range = int_range(0, 1000, 1);
+    config.scan_deadline_ms = declare_parameter<uint16_t>("scan_deadline_ms", descriptor);
+  }
+
+  {
+    auto crop_box = declare_parameter<std::string>("crop_box", param_read_only());
+    auto mask_polygon = declare_parameter<std::string>("mask_polygon", param_read_only());
+    auto excluded_channels = declare_parameter<std::string>("excluded_channels", param_read_only());
+    auto kept_return_types = declare_parameter<std::string>("kept_return_types", param_read_only());
+    auto point_filter = drivers::point_filter_configuration_from_strings(
+      crop_box, mask_polygon, excluded_channels, kept_return_types);
+    if (!point_filter.has_value()) {
+      RCLCPP_ERROR_STREAM(get_logger(), "Invalid point filter: " << point_filter.error());
+      return Status::SENSOR_CONFIG_ERROR;
+    }
+    config.point_filter = point_filter.value();
+  }
+
+  config.deskew = declare_parameter<bool>("deskew", param_read_only());
+
+  config.output_frame = declare_parameter<std::string>("output_frame", param_read_only());
+  {
+    auto output_extrinsic = declare_parameter<std::string>("output_extrinsic", param_read_only());
+    auto output_transform =
+      get_output_transform(*this, config.frame_id, config.output_frame, output_extrinsic);
+    if (!output_transform.has_value()) {
+      RCLCPP_ERROR_STREAM(get_logger(), "Invalid output transform: " << output_transform.error());
+      return Status::SENSOR_CONFIG_ERROR;
+    }
+    config.output_transform = output_transform.value();
+  }
+
   std::string calibration_parameter_name = get_calibration_parameter_name(config.sensor_model);
   config.calibration_path =
     declare_parameter<std::string>(calibration_parameter_name, param_read_write());
@@ -238,6 +327,16 @@ Status HesaiRosWrapper::validate_and_set_config(
     RCLCPP_ERROR(get_logger(), "Invalid PTP Switch Type Provided. Please use 'tsn' or 'non_tsn'");
     return Status::SENSOR_CONFIG_ERROR;
   }
+  if (new_config->receive_backend == nebula::drivers::ReceiveBackend::UNKNOWN_BACKEND) {
+    RCLCPP_ERROR(get_logger(), "Invalid receive backend. Please use 'socket' or 'packet_mmap'");
+    return Status::SENSOR_CONFIG_ERROR;
+  }
+  if (
+    new_config->receive_backend == nebula::drivers::ReceiveBackend::PACKET_MMAP &&
+    !new_config->multicast_ip.empty()) {
+    RCLCPP_ERROR(get_logger(), "The 'packet_mmap' receive backend does not support multicast.");
+    return Status::SENSOR_CONFIG_ERROR;
+  }
   if (!drivers::angle_is_between<double>(
         new_config->cloud_min_angle, new_config->cloud_max_angle, new_config->cut_angle)) {
     RCLCPP_ERROR(get_logger(), "Cannot cut scan outside of the FoV.");
@@ -283,11 +382,16 @@ void HesaiRosWrapper::receive_scan_message_callback(
   }
 
   for (auto & pkt : scan_msg->packets) {
-    auto nebula_pkt_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>();
-    nebula_pkt_ptr->stamp = pkt.stamp;
-    std::copy(pkt.data.begin(), pkt.data.end(), std::back_inserter(nebula_pkt_ptr->data));
+    auto packet = get_received_bytes(pkt);
+    if (inline_decode_) {
+      decoder_wrapper_->process_cloud_packet(packet, pkt.stamp);
+      continue;
+    }
 
-    packet_queue_.push(std::move(nebula_pkt_ptr));
+    auto & nebula_pkt = packet_queue_.claim();
+    nebula_pkt.stamp = pkt.stamp;
+    nebula_pkt.data.assign(packet.begin(), packet.end());
+    packet_queue_.commit();
   }
 }
 
@@ -411,24 +515,41 @@ rcl_interfaces::msg::SetParametersResult HesaiRosWrapper::on_parameter_change(
   return rcl_interfaces::build<SetParametersResult>().successful(true).reason("");
 }
 
-void HesaiRosWrapper::receive_cloud_packet_callback(std::vector<uint8_t> & packet)
+void HesaiRosWrapper::receive_cloud_packet_callback(
+  util::span<const uint8_t> packet, const drivers::connections::UdpPacketMetadata & metadata)
 {
   if (!decoder_wrapper_ || decoder_wrapper_->status() != Status::OK) {
     return;
   }
 
-  const auto now = std::chrono::high_resolution_clock::now();
-  const auto timestamp_ns =
-    std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+  // Stamp with the time the kernel received the packet (system clock, which the decoder also
+  // measures the scan latency against) so that scheduling delays do not show up in stamps
+  const uint64_t timestamp_ns = metadata.receive_time_ns;
+
+  builtin_interfaces::msg::Time stamp;
+  stamp.sec = static_cast<int>(timestamp_ns / 1'000'000'000);
+  stamp.nanosec = static_cast<int>(timestamp_ns % 1'000'000'000);
 
-  auto msg_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>();
-  msg_ptr->stamp.sec = static_cast<int>(timestamp_ns / 1'000'000'000);
-  msg_ptr->stamp.nanosec = static_cast<int>(timestamp_ns % 1'000'000'000);
-  msg_ptr->data.swap(packet);
+  // The packet is decoded in place, which with the packet_mmap backend means straight from the
+  // capture ring
+  if (inline_decode_) {
+    decoder_wrapper_->process_cloud_packet(packet, stamp);
+    return;
+  }
 
-  if (!packet_queue_.try_push(std::move(msg_ptr))) {
-    RCLCPP_ERROR_THROTTLE(get_logger(), *get_clock(), 500, "Packet(s) dropped");
+  // The packet is only valid during this call (the receive buffer or ring block is reused), so it
+  // is copied into a queue slot, whose buffer has the capacity of the packets before it
+  auto * msg = packet_queue_.try_claim();
+  if (!msg) {
+    RCLCPP_ERROR_THROTTLE(
+      get_logger(), *get_clock(), 500, "Packet(s) dropped (%zu in total)",
+      packet_queue_.n_dropped());
+    return;
   }
+
+  msg->stamp = stamp;
+  msg->data.assign(packet.begin(), packet.end());
+  packet_queue_.commit();
 }
 
 std::string HesaiRosWrapper::get_calibration_parameter_name(drivers::SensorModel model) const
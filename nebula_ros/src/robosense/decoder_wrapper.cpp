@@ -2,6 +2,8 @@
 
 #include "nebula_ros/robosense/decoder_wrapper.hpp"
 
+#include "nebula_ros/common/point_cloud_serializer.hpp"
+
 namespace nebula::ros
 {
 
@@ -56,36 +58,68 @@ RobosenseDecoderWrapper::RobosenseDecoderWrapper(
   RCLCPP_INFO(logger_, "Initialized decoder wrapper.");
 }
 
-void RobosenseDecoderWrapper::process_cloud_packet(
-  std::unique_ptr<nebula_msgs::msg::NebulaPacket> packet_msg)
+void RobosenseDecoderWrapper::process_cloud_packets(
+  const std::vector<const nebula_msgs::msg::NebulaPacket *> & packet_msgs)
 {
   // Accumulate packets for recording only if someone is subscribed to the topic (for performance)
-  if (
+  const bool record_packets =
     hw_interface_ && (packets_pub_->get_subscription_count() > 0 ||
-                      packets_pub_->get_intra_process_subscription_count() > 0)) {
-    if (current_scan_msg_->packets.size() == 0) {
-      current_scan_msg_->header.stamp = packet_msg->stamp;
+                      packets_pub_->get_intra_process_subscription_count() > 0);
+
+  // The driver reuses its pointcloud for the next scan, so the packets are decoded in runs that end
+  // with the packet completing a scan, and that scan is published before the next run is decoded.
+  // The driver is locked once per run instead of once per packet.
+  size_t begin = 0;
+  while (begin < packet_msgs.size()) {
+    size_t end = begin;
+    nebula::drivers::NebulaPointCloudPtr pointcloud = nullptr;
+    double scan_timestamp_s = 0;
+    // Scans are published in the frame of the configuration they were decoded with
+    std::string frame_id;
+    {
+      std::lock_guard lock(mtx_driver_ptr_);
+      while (!pointcloud && end < packet_msgs.size()) {
+        const auto & packet_msg = *packet_msgs[end++];
+        std::tie(pointcloud, scan_timestamp_s) = driver_ptr_->parse_cloud_packet(packet_msg.data);
+      }
+
+      if (pointcloud) {
+        frame_id =
+          sensor_cfg_->output_frame.empty() ? sensor_cfg_->frame_id : sensor_cfg_->output_frame;
+      }
     }
 
-    robosense_msgs::msg::RobosensePacket robosense_packet_msg{};
-    robosense_packet_msg.stamp = packet_msg->stamp;
-    std::copy(packet_msg->data.begin(), packet_msg->data.end(), robosense_packet_msg.data.begin());
-    current_scan_msg_->packets.emplace_back(std::move(robosense_packet_msg));
-  }
-
-  std::tuple<nebula::drivers::NebulaPointCloudPtr, double> pointcloud_ts{};
-  nebula::drivers::NebulaPointCloudPtr pointcloud = nullptr;
+    if (record_packets) {
+      for (size_t i = begin; i < end; ++i) {
+        record_packet(*packet_msgs[i]);
+      }
+    }
+    begin = end;
 
-  {
-    std::lock_guard lock(mtx_driver_ptr_);
-    pointcloud_ts = driver_ptr_->parse_cloud_packet(packet_msg->data);
-    pointcloud = std::get<0>(pointcloud_ts);
+    if (pointcloud) {
+      publish_scan(*pointcloud, scan_timestamp_s, frame_id);
+    }
   }
+}
 
-  if (pointcloud == nullptr) {
-    return;
+void RobosenseDecoderWrapper::record_packet(const nebula_msgs::msg::NebulaPacket & packet_msg)
+{
+  if (current_scan_msg_->packets.size() == 0) {
+    current_scan_msg_->header.stamp = packet_msg.stamp;
   }
 
+  robosense_msgs::msg::RobosensePacket robosense_packet_msg{};
+  robosense_packet_msg.stamp = packet_msg.stamp;
+  std::copy(packet_msg.data.begin(), packet_msg.data.end(), robosense_packet_msg.data.begin());
+  current_scan_msg_->packets.emplace_back(std::move(robosense_packet_msg));
+}
+
+void RobosenseDecoderWrapper::publish_scan(
+  const drivers::NebulaPointCloud & pointcloud, double scan_timestamp_s,
+  const std::string & frame_id)
+{
+  // A pointcloud is only emitted when a scan completes. If pointclouds are not emitted for too
+  // long, the `cloud_watchdog_` is not updated and logs a warning automatically.
   cloud_watchdog_->update();
 
   // Publish scan message only if it has been written to
@@ -94,36 +128,41 @@ void RobosenseDecoderWrapper::process_cloud_packet(
     current_scan_msg_ = std::make_unique<robosense_msgs::msg::RobosenseScan>();
   }
 
-  if (
-    nebula_points_pub_->get_subscription_count() > 0 ||
-    nebula_points_pub_->get_intra_process_subscription_count() > 0) {
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*pointcloud, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(seconds_to_chrono_nano_seconds(std::get<1>(pointcloud_ts)).count());
-    publish_cloud(std::move(ros_pc_msg_ptr), nebula_points_pub_);
+  auto has_subscribers = [](const auto & publisher) {
+    return publisher->get_subscription_count() > 0 ||
+           publisher->get_intra_process_subscription_count() > 0;
+  };
+
+  // Only serialize the layouts that are subscribed to, all of them in one pass over the points
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> nebula_points_msg;
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> aw_points_msg;
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> aw_points_ex_msg;
+  if (has_subscribers(nebula_points_pub_)) {
+    nebula_points_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  }
+  if (has_subscribers(aw_points_base_pub_)) {
+    aw_points_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  }
+  if (has_subscribers(aw_points_ex_pub_)) {
+    aw_points_ex_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  }
+
+  serialize_point_cloud(
+    pointcloud, scan_timestamp_s,
+    {nebula_points_msg.get(), aw_points_msg.get(), aw_points_ex_msg.get()});
+
+  const auto stamp = rclcpp::Time(seconds_to_chrono_nano_seconds(scan_timestamp_s).count());
+  if (nebula_points_msg) {
+    nebula_points_msg->header.stamp = stamp;
+    publish_cloud(std::move(nebula_points_msg), nebula_points_pub_, frame_id);
   }
-  if (
-    aw_points_base_pub_->get_subscription_count() > 0 ||
-    aw_points_base_pub_->get_intra_process_subscription_count() > 0) {
-    const auto autoware_cloud_xyzi =
-      nebula::drivers::convert_point_xyzircaedt_to_point_xyzir(pointcloud);
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*autoware_cloud_xyzi, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(seconds_to_chrono_nano_seconds(std::get<1>(pointcloud_ts)).count());
-    publish_cloud(std::move(ros_pc_msg_ptr), aw_points_base_pub_);
+  if (aw_points_msg) {
+    aw_points_msg->header.stamp = stamp;
+    publish_cloud(std::move(aw_points_msg), aw_points_base_pub_, frame_id);
   }
-  if (
-    aw_points_ex_pub_->get_subscription_count() > 0 ||
-    aw_points_ex_pub_->get_intra_process_subscription_count() > 0) {
-    const auto autoware_ex_cloud = nebula::drivers::convert_point_xyzircaedt_to_point_xyziradt(
-      pointcloud, std::get<1>(pointcloud_ts));
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*autoware_ex_cloud, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(seconds_to_chrono_nano_seconds(std::get<1>(pointcloud_ts)).count());
-    publish_cloud(std::move(ros_pc_msg_ptr), aw_points_ex_pub_);
+  if (aw_points_ex_msg) {
+    aw_points_ex_msg->header.stamp = stamp;
+    publish_cloud(std::move(aw_points_ex_msg), aw_points_ex_pub_, frame_id);
   }
 }
 
@@ -145,13 +184,14 @@ nebula::Status RobosenseDecoderWrapper::status()
 
 void RobosenseDecoderWrapper::publish_cloud(
   std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-  const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher)
+  const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher,
+  const std::string & frame_id)
 {
   if (pointcloud->header.stamp.sec < 0) {
     RCLCPP_WARN_STREAM(logger_, "Timestamp error, verify clock source.");
     return;
   }
-  pointcloud->header.frame_id = sensor_cfg_->frame_id;
+  pointcloud->header.frame_id = frame_id;
   publisher->publish(std::move(pointcloud));
 }
 
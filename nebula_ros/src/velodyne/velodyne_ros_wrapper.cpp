@@ -2,6 +2,9 @@
 
 #include "nebula_ros/velodyne/velodyne_ros_wrapper.hpp"
 
+#include "nebula_ros/common/io_reactor.hpp"
+#include "nebula_ros/common/output_transform.hpp"
+
 #pragma clang diagnostic ignored "-Wbitwise-instead-of-logical"
 
 namespace nebula::ros
@@ -38,6 +41,11 @@ VelodyneRosWrapper::VelodyneRosWrapper(const rclcpp::NodeOptions & options)
 
   if (launch_hw_) {
     hw_interface_wrapper_.emplace(this, sensor_cfg_ptr_, use_udp_only);
+    auto io_reactor = declare_and_get_io_reactor(*this);
+    if (!io_reactor.has_value()) {
+      throw std::runtime_error("Invalid I/O reactor configuration: " + io_reactor.error());
+    }
+    hw_interface_wrapper_->hw_interface()->set_reactor(io_reactor.value());
     if (!use_udp_only) {  // hardware monitor requires HTTP connection
       hw_monitor_wrapper_.emplace(this, hw_interface_wrapper_->hw_interface(), sensor_cfg_ptr_);
     }
@@ -48,15 +56,26 @@ VelodyneRosWrapper::VelodyneRosWrapper(const rclcpp::NodeOptions & options)
 
   RCLCPP_DEBUG(get_logger(), "Starting stream");
 
+  // Decode all packets that have queued up in one batch, straight from the queue's slots
   decoder_thread_ = std::thread([this]() {
+    std::vector<const nebula_msgs::msg::NebulaPacket *> packets;
+    packets.reserve(max_packet_batch_size);
     while (true) {
-      decoder_wrapper_->process_cloud_packet(packet_queue_.pop());
+      const size_t n_packets = packet_queue_.wait_for_values(max_packet_batch_size);
+      for (size_t i = 0; i < n_packets; ++i) {
+        packets.push_back(&packet_queue_.peek(i));
+      }
+      decoder_wrapper_->process_cloud_packets(packets);
+      packets.clear();
+      packet_queue_.release(n_packets);
     }
   });
 
   if (launch_hw_) {
     hw_interface_wrapper_->hw_interface()->register_scan_callback(
-      std::bind(&VelodyneRosWrapper::receive_cloud_packet_callback, this, std::placeholders::_1));
+      std::bind(
+        &VelodyneRosWrapper::receive_cloud_packet_callback, this, std::placeholders::_1,
+        std::placeholders::_2));
     stream_start();
   } else {
     packets_sub_ = create_subscription<velodyne_msgs::msg::VelodyneScan>(
@@ -117,6 +136,18 @@ nebula::Status VelodyneRosWrapper::declare_and_get_sensor_config_params()
     config.cloud_max_angle = declare_parameter<uint16_t>("cloud_max_angle", descriptor);
   }
 
+  config.output_frame = declare_parameter<std::string>("output_frame", param_read_only());
+  {
+    auto output_extrinsic = declare_parameter<std::string>("output_extrinsic", param_read_only());
+    auto output_transform =
+      get_output_transform(*this, config.frame_id, config.output_frame, output_extrinsic);
+    if (!output_transform.has_value()) {
+      RCLCPP_ERROR_STREAM(get_logger(), "Invalid output transform: " << output_transform.error());
+      return Status::SENSOR_CONFIG_ERROR;
+    }
+    config.output_transform = output_transform.value();
+  }
+
   auto new_cfg_ptr = std::make_shared<const nebula::drivers::VelodyneSensorConfiguration>(config);
   return validate_and_set_config(new_cfg_ptr);
 }
@@ -160,11 +191,10 @@ void VelodyneRosWrapper::receive_scan_message_callback(
   }
 
   for (auto & pkt : scan_msg->packets) {
-    auto nebula_pkt_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>();
-    nebula_pkt_ptr->stamp = pkt.stamp;
-    std::copy(pkt.data.begin(), pkt.data.end(), std::back_inserter(nebula_pkt_ptr->data));
-
-    packet_queue_.push(std::move(nebula_pkt_ptr));
+    auto & nebula_pkt = packet_queue_.claim();
+    nebula_pkt.stamp = pkt.stamp;
+    nebula_pkt.data.assign(pkt.data.begin(), pkt.data.end());
+    packet_queue_.commit();
   }
 }
 
@@ -240,24 +270,28 @@ rcl_interfaces::msg::SetParametersResult VelodyneRosWrapper::on_parameter_change
   return rcl_interfaces::build<SetParametersResult>().successful(true).reason("");
 }
 
-void VelodyneRosWrapper::receive_cloud_packet_callback(std::vector<uint8_t> & packet)
+void VelodyneRosWrapper::receive_cloud_packet_callback(
+  util::span<const uint8_t> packet, const drivers::connections::UdpPacketMetadata & metadata)
 {
   if (!decoder_wrapper_ || decoder_wrapper_->status() != Status::OK) {
     return;
   }
 
-  const auto now = std::chrono::high_resolution_clock::now();
-  const auto timestamp_ns =
-    std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
-
-  auto msg_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>();
-  msg_ptr->stamp.sec = static_cast<int>(timestamp_ns / 1'000'000'000);
-  msg_ptr->stamp.nanosec = static_cast<int>(timestamp_ns % 1'000'000'000);
-  msg_ptr->data.swap(packet);
+  const uint64_t timestamp_ns = metadata.receive_time_ns;
 
-  if (!packet_queue_.try_push(std::move(msg_ptr))) {
-    RCLCPP_ERROR_THROTTLE(get_logger(), *get_clock(), 500, "Packet(s) dropped");
+  // The packet is copied into a queue slot, whose buffer has the capacity of the packets before it
+  auto * msg = packet_queue_.try_claim();
+  if (!msg) {
+    RCLCPP_ERROR_THROTTLE(
+      get_logger(), *get_clock(), 500, "Packet(s) dropped (%zu in total)",
+      packet_queue_.n_dropped());
+    return;
   }
+
+  msg->stamp.sec = static_cast<int>(timestamp_ns / 1'000'000'000);
+  msg->stamp.nanosec = static_cast<int>(timestamp_ns % 1'000'000'000);
+  msg->data.assign(packet.begin(), packet.end());
+  packet_queue_.commit();
 }
 
 RCLCPP_COMPONENTS_REGISTER_NODE(VelodyneRosWrapper)
@@ -0,0 +1,213 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/connections/packet_mmap_receiver.hpp>
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace nebula::test
+{
+
+using drivers::connections::PacketMmapReceiver;
+using drivers::connections::UdpPacketMetadata;
+
+constexpr uint16_t g_port = 57420;
+
+uint64_t now_ns()
+{
+  timespec now{};
+  clock_gettime(CLOCK_REALTIME, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+}
+
+/// @brief Replays `n_packets` datagrams of `packet_size` bytes to a port on localhost, from
+/// 127.0.0.1. The first bytes of each packet hold its index.
+void replay_packets(uint16_t port, uint32_t n_packets, size_t packet_size)
+{
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(fd, 0);
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  std::vector<uint8_t> packet(packet_size, 0xab);
+  for (uint32_t i = 0; i < n_packets; ++i) {
+    std::memcpy(packet.data(), &i, sizeof(i));
+    ASSERT_EQ(
+      sendto(
+        fd, packet.data(), packet.size(), 0, reinterpret_cast<sockaddr *>(&address),
+        sizeof(address)),
+      static_cast<ssize_t>(packet.size()));
+  }
+  close(fd);
+}
+
+/// @brief A receiver, or nullptr if packet sockets are not permitted
+std::unique_ptr<PacketMmapReceiver> make_receiver()
+{
+  try {
+    return std::make_unique<PacketMmapReceiver>();
+  } catch (const std::runtime_error &) {
+    return nullptr;
+  }
+}
+
+#define SKIP_WITHOUT_PACKET_SOCKETS(receiver)                              \
+  if (!(receiver)) {                                                       \
+    GTEST_SKIP() << "Packet sockets are not permitted (needs CAP_NET_RAW)"; \
+  }
+
+/// @brief Copies received packets and their metadata until `n_expected` have arrived
+struct Collector
+{
+  explicit Collector(size_t n_expected) : n_expected(n_expected) {}
+
+  void on_packet(util::span<const uint8_t> payload, const UdpPacketMetadata & metadata)
+  {
+    std::lock_guard lock(mtx);
+    packets.emplace_back(payload.begin(), payload.end());
+    metadata_list.push_back(metadata);
+    if (packets.size() >= n_expected) {
+      done.notify_all();
+    }
+  }
+
+  bool wait(std::chrono::milliseconds timeout = std::chrono::seconds(5))
+  {
+    std::unique_lock lock(mtx);
+    return done.wait_for(lock, timeout, [this]() { return packets.size() >= n_expected; });
+  }
+
+  size_t n_expected;
+  std::mutex mtx;
+  std::condition_variable done;
+  std::vector<std::vector<uint8_t>> packets;
+  std::vector<UdpPacketMetadata> metadata_list;
+};
+
+// Packets that have queued up in the ring are handed over in blocks, in order, with their UDP
+// payload and the time the kernel received them
+TEST(PacketMmapReceiverTest, TestReceive)
+{
+  constexpr uint32_t n_packets = 200;
+
+  auto receiver = make_receiver();
+  SKIP_WITHOUT_PACKET_SOCKETS(receiver);
+  receiver->bind("127.0.0.1", "127.0.0.1", g_port);
+
+  const uint64_t send_start_ns = now_ns();
+  replay_packets(g_port, n_packets, 1080);
+  const uint64_t send_end_ns = now_ns();
+  // Packets to other ports are not captured
+  replay_packets(g_port + 100, 10, 1080);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  Collector collector(n_packets);
+  receiver->subscribe([&](auto payload, const auto & metadata) {
+    collector.on_packet(payload, metadata);
+  });
+  ASSERT_TRUE(collector.wait());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::lock_guard lock(collector.mtx);
+  ASSERT_EQ(collector.packets.size(), n_packets);
+  for (uint32_t i = 0; i < n_packets; ++i) {
+    ASSERT_EQ(collector.packets[i].size(), 1080U);
+    uint32_t index = 0;
+    std::memcpy(&index, collector.packets[i].data(), sizeof(index));
+    EXPECT_EQ(index, i);
+    EXPECT_EQ(collector.packets[i].back(), 0xab);
+
+    const auto & metadata = collector.metadata_list[i];
+    EXPECT_FALSE(metadata.truncated);
+    EXPECT_EQ(metadata.sender_ip.s_addr, htonl(INADDR_LOOPBACK));
+    EXPECT_GE(metadata.receive_time_ns, send_start_ns);
+    EXPECT_LE(metadata.receive_time_ns, send_end_ns);
+  }
+
+  auto stats = receiver->get_stats();
+  EXPECT_EQ(stats.n_packets, n_packets);
+  EXPECT_LT(stats.n_blocks, n_packets / 10);
+  EXPECT_EQ(stats.n_dropped, 0U);
+}
+
+// Packets from other senders are not captured
+TEST(PacketMmapReceiverTest, TestSenderFilter)
+{
+  auto receiver = make_receiver();
+  SKIP_WITHOUT_PACKET_SOCKETS(receiver);
+  receiver->bind("127.0.0.1", "127.0.0.2", g_port + 1);
+
+  Collector collector(1);
+  receiver->subscribe([&](auto payload, const auto & metadata) {
+    collector.on_packet(payload, metadata);
+  });
+  replay_packets(g_port + 1, 10, 100);
+  EXPECT_FALSE(collector.wait(std::chrono::milliseconds(200)));
+}
+
+// The port is bound by a socket discarding all packets, so the sender does not get "port
+// unreachable" errors
+TEST(PacketMmapReceiverTest, TestNoPortUnreachable)
+{
+  auto receiver = make_receiver();
+  SKIP_WITHOUT_PACKET_SOCKETS(receiver);
+  receiver->bind("127.0.0.1", "", g_port + 2);
+
+  Collector collector(2);
+  receiver->subscribe([&](auto payload, const auto & metadata) {
+    collector.on_packet(payload, metadata);
+  });
+
+  // A connected UDP socket reports ICMP errors caused by earlier packets on later calls
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(fd, 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(g_port + 2);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)), 0);
+
+  uint8_t byte = 0;
+  EXPECT_EQ(send(fd, &byte, 1, 0), 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(send(fd, &byte, 1, 0), 1) << std::strerror(errno);
+  close(fd);
+
+  ASSERT_TRUE(collector.wait());
+  EXPECT_EQ(collector.packets[0].size(), 1U);
+}
+
+TEST(PacketMmapReceiverTest, TestInvalidAddress)
+{
+  auto receiver = make_receiver();
+  SKIP_WITHOUT_PACKET_SOCKETS(receiver);
+  EXPECT_THROW(receiver->bind("127.0.0.1", "not an ip", g_port + 3), std::runtime_error);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+// Copyright 2024 TIER IV, Inc.
+
+// Compares `MtQueue` and `SpscQueue` as the packet queue between the UDP receiver and the decoder
+// thread. Packets are pushed at fixed rates like those of a sensor (36k and 72k packets/s) and
+// unpaced, and the cost of a push, the handoff latency and the CPU time of the consumer are
+// reported.
+//
+// Usage: packet_queue_benchmark [seconds_per_run]
+
+#include <nebula_ros/common/mt_queue.hpp>
+#include <nebula_ros/common/spsc_queue.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace nebula::test
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Packet
+{
+  Clock::time_point enqueue_time;
+  std::vector<uint8_t> data;
+};
+
+using PacketPtr = std::unique_ptr<Packet>;
+
+double thread_cpu_time_ms()
+{
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+double percentile(std::vector<double> & values, double p)
+{
+  if (values.empty()) {
+    return 0;
+  }
+  auto it = values.begin() + static_cast<ptrdiff_t>(p * (values.size() - 1));
+  std::nth_element(values.begin(), it, values.end());
+  return *it;
+}
+
+/// @brief Push packets of `packet_size` bytes at `packets_per_s` (0: as fast as possible) for
+/// `seconds` and pop them on a second thread
+template <typename QueueT>
+void benchmark_queue(const char * name, double packets_per_s, double seconds)
+{
+  constexpr size_t packet_size = 1080;
+  const auto n_packets = static_cast<size_t>(packets_per_s > 0 ? packets_per_s * seconds : 2e6);
+
+  QueueT queue(3000);
+  std::vector<double> latencies_us;
+  latencies_us.reserve(n_packets);
+  double consumer_cpu_ms = 0;
+
+  std::thread consumer([&]() {
+    const double cpu_start_ms = thread_cpu_time_ms();
+    while (true) {
+      auto packet = queue.pop();
+      if (!packet) {
+        break;
+      }
+      latencies_us.push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - packet->enqueue_time).count());
+    }
+    consumer_cpu_ms = thread_cpu_time_ms() - cpu_start_ms;
+  });
+
+  // Packets are allocated up front so that only the queue operations are measured
+  std::vector<PacketPtr> packets(n_packets);
+  for (auto & packet : packets) {
+    packet = std::make_unique<Packet>();
+    packet->data.resize(packet_size);
+  }
+
+  std::vector<double> push_times_ns;
+  push_times_ns.reserve(n_packets);
+  size_t n_dropped = 0;
+  const auto start = Clock::now();
+  for (size_t i = 0; i < n_packets; ++i) {
+    if (packets_per_s > 0) {
+      const auto due = start + std::chrono::duration_cast<Clock::duration>(
+                                 std::chrono::duration<double>(i / packets_per_s));
+      while (Clock::now() < due) {
+        std::this_thread::yield();
+      }
+    }
+
+    const auto push_start = Clock::now();
+    packets[i]->enqueue_time = push_start;
+    if (!queue.try_push(std::move(packets[i]))) {
+      ++n_dropped;
+    }
+    push_times_ns.push_back(
+      std::chrono::duration<double, std::nano>(Clock::now() - push_start).count());
+  }
+  const double elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+  PacketPtr end = nullptr;
+  queue.push(std::move(end));
+  consumer.join();
+
+  std::printf(
+    "%-10s %7.0f pkt/s   push p50 %6.0f ns p99 %7.0f ns   latency p50 %7.1f us p99 %8.1f us   "
+    "consumer cpu %5.1f%%   dropped %zu\n",
+    name, n_packets / elapsed_s, percentile(push_times_ns, 0.5), percentile(push_times_ns, 0.99),
+    percentile(latencies_us, 0.5), percentile(latencies_us, 0.99),
+    consumer_cpu_ms / (elapsed_s * 10), n_dropped);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  namespace test = nebula::test;
+
+  double seconds = argc > 1 ? std::max(0.1, std::atof(argv[1])) : 3;
+
+  for (double packets_per_s : {36000., 72000., 0.}) {
+    if (packets_per_s > 0) {
+      std::printf("%.0f packets/s for %.1f s\n", packets_per_s, seconds);
+    } else {
+      std::printf("Unpaced, 2M packets\n");
+    }
+    test::benchmark_queue<MtQueue<test::PacketPtr>>("MtQueue", packets_per_s, seconds);
+    test::benchmark_queue<SpscQueue<test::PacketPtr>>("SpscQueue", packets_per_s, seconds);
+    std::printf("\n");
+  }
+
+  return 0;
+}
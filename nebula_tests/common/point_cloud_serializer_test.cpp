@@ -0,0 +1,175 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_common/nebula_common.hpp>
+#include <nebula_common/point_types.hpp>
+#include <nebula_ros/common/point_cloud_serializer.hpp>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+
+namespace nebula::test
+{
+
+using drivers::NebulaPoint;
+using drivers::NebulaPointCloud;
+using sensor_msgs::msg::PointCloud2;
+
+constexpr double g_scan_timestamp_s = 1718000000.123456;
+
+/// @brief An unorganized, dense cloud of points with random values in all fields
+NebulaPointCloud make_random_cloud(size_t n_points)
+{
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> coordinate(-200.f, 200.f);
+  std::uniform_real_distribution<float> angle(0.f, 6.28f);
+  std::uniform_int_distribution<uint32_t> integer(0, 100'000'000);
+
+  NebulaPointCloud cloud;
+  for (size_t i = 0; i < n_points; ++i) {
+    NebulaPoint & point = cloud.emplace_back();
+    point.x = coordinate(rng);
+    point.y = coordinate(rng);
+    point.z = coordinate(rng);
+    point.intensity = integer(rng) % 256;
+    point.return_type = integer(rng) % 16;
+    point.channel = integer(rng) % 128;
+    point.azimuth = angle(rng);
+    point.elevation = angle(rng) - 3.14f;
+    point.distance = std::abs(point.x);
+    point.time_stamp = integer(rng);
+  }
+
+  return cloud;
+}
+
+/// @brief Compare everything but the header, which `serialize_point_cloud` leaves to the caller
+void expect_same_message(const PointCloud2 & expected, const PointCloud2 & actual)
+{
+  EXPECT_EQ(actual.height, expected.height);
+  EXPECT_EQ(actual.width, expected.width);
+  ASSERT_EQ(actual.fields.size(), expected.fields.size());
+  for (size_t i = 0; i < expected.fields.size(); ++i) {
+    EXPECT_EQ(actual.fields[i].name, expected.fields[i].name);
+    EXPECT_EQ(actual.fields[i].offset, expected.fields[i].offset);
+    EXPECT_EQ(actual.fields[i].datatype, expected.fields[i].datatype);
+    EXPECT_EQ(actual.fields[i].count, expected.fields[i].count);
+  }
+  EXPECT_EQ(actual.is_bigendian, expected.is_bigendian);
+  EXPECT_EQ(actual.point_step, expected.point_step);
+  EXPECT_EQ(actual.row_step, expected.row_step);
+  EXPECT_EQ(actual.is_dense, expected.is_dense);
+  ASSERT_EQ(actual.data.size(), expected.data.size());
+  EXPECT_EQ(std::memcmp(actual.data.data(), expected.data.data(), expected.data.size()), 0);
+}
+
+/// @brief Serializing `cloud` has to give exactly the messages of converting it with
+/// `convert_point_xyzircaedt_to_point_xyz*` and serializing the result with `pcl::toROSMsg`. For
+/// clouds that are not dense, the Autoware layouts only contain the points with finite
+/// coordinates.
+void expect_matches_pcl(const NebulaPointCloud & cloud)
+{
+  PointCloud2 nebula_points;
+  PointCloud2 aw_points;
+  PointCloud2 aw_points_ex;
+  ros::serialize_point_cloud(
+    cloud, g_scan_timestamp_s, {&nebula_points, &aw_points, &aw_points_ex});
+
+  auto valid_cloud = std::make_shared<NebulaPointCloud>();
+  for (const auto & point : cloud.points) {
+    if (cloud.is_dense || std::isfinite(point.x)) {
+      valid_cloud->push_back(point);
+    }
+  }
+
+  PointCloud2 expected;
+
+  pcl::toROSMsg(cloud, expected);
+  expect_same_message(expected, nebula_points);
+
+  pcl::toROSMsg(*drivers::convert_point_xyzircaedt_to_point_xyzir(valid_cloud), expected);
+  expect_same_message(expected, aw_points);
+
+  pcl::toROSMsg(
+    *drivers::convert_point_xyzircaedt_to_point_xyziradt(valid_cloud, g_scan_timestamp_s),
+    expected);
+  expect_same_message(expected, aw_points_ex);
+}
+
+TEST(PointCloudSerializerTest, TestMatchesPcl)
+{
+  expect_matches_pcl(make_random_cloud(10000));
+}
+
+// An organized cloud keeps its layout and empty cells in the native format, while the Autoware
+// formats only contain the valid points
+TEST(PointCloudSerializerTest, TestOrganizedCloud)
+{
+  constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+  auto cloud = make_random_cloud(64 * 100);
+  cloud.width = 100;
+  cloud.height = 64;
+  cloud.is_dense = false;
+  for (size_t i = 0; i < cloud.points.size(); i += 3) {
+    auto & point = cloud.points[i];
+    point.x = nan;
+    point.y = nan;
+    point.z = nan;
+    point.distance = nan;
+  }
+
+  expect_matches_pcl(cloud);
+
+  PointCloud2 nebula_points;
+  PointCloud2 aw_points;
+  ros::serialize_point_cloud(cloud, g_scan_timestamp_s, {&nebula_points, &aw_points, nullptr});
+  EXPECT_EQ(nebula_points.width, 100U);
+  EXPECT_EQ(nebula_points.height, 64U);
+  EXPECT_FALSE(nebula_points.is_dense);
+  EXPECT_EQ(aw_points.width, 64U * 100 - (64 * 100 + 2) / 3);
+  EXPECT_EQ(aw_points.height, 1U);
+  EXPECT_TRUE(aw_points.is_dense);
+}
+
+// A cleared cloud has neither width nor height, which `pcl::toROSMsg` serializes as 0 x 1
+TEST(PointCloudSerializerTest, TestEmptyCloud)
+{
+  NebulaPointCloud cloud;
+  cloud.width = 0;
+  cloud.height = 0;
+  expect_matches_pcl(cloud);
+}
+
+// Layouts without a message are skipped, the others are the same as when serializing all of them
+TEST(PointCloudSerializerTest, TestRequestedLayoutsOnly)
+{
+  auto cloud = make_random_cloud(100);
+
+  PointCloud2 all_nebula_points;
+  PointCloud2 all_aw_points;
+  PointCloud2 all_aw_points_ex;
+  ros::serialize_point_cloud(
+    cloud, g_scan_timestamp_s, {&all_nebula_points, &all_aw_points, &all_aw_points_ex});
+
+  PointCloud2 aw_points_ex;
+  ros::serialize_point_cloud(cloud, g_scan_timestamp_s, {nullptr, nullptr, &aw_points_ex});
+  expect_same_message(all_aw_points_ex, aw_points_ex);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
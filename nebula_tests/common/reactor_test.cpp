@@ -0,0 +1,240 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_common/util/span.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/connections/packet_mmap_receiver.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/connections/reactor.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/connections/udp_receiver.hpp>
+
+#include <gtest/gtest.h>
+
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace nebula::test
+{
+
+using drivers::connections::PacketMmapReceiver;
+using drivers::connections::Reactor;
+using drivers::connections::UdpPacketMetadata;
+using drivers::connections::UdpReceiver;
+
+constexpr uint16_t g_port = 57430;
+
+/// @brief Sends `n_packets` datagrams of `packet_size` bytes to localhost. The first bytes of each
+/// packet hold its index.
+void send_packets(uint16_t port, uint32_t n_packets, size_t packet_size)
+{
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(fd, 0);
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  std::vector<uint8_t> packet(packet_size, 0xab);
+  for (uint32_t i = 0; i < n_packets; ++i) {
+    std::memcpy(packet.data(), &i, sizeof(i));
+    ASSERT_EQ(
+      sendto(
+        fd, packet.data(), packet.size(), 0, reinterpret_cast<sockaddr *>(&address),
+        sizeof(address)),
+      static_cast<ssize_t>(packet.size()));
+  }
+  close(fd);
+}
+
+/// @brief Records the index of each received packet and the thread it was received on, until
+/// `n_expected` have arrived
+struct Collector
+{
+  explicit Collector(size_t n_expected) : n_expected(n_expected) {}
+
+  void on_packet(util::span<const uint8_t> packet, const UdpPacketMetadata & /* metadata */)
+  {
+    uint32_t index = 0;
+    std::memcpy(&index, packet.data(), sizeof(index));
+
+    std::lock_guard lock(mtx);
+    indices.push_back(index);
+    thread_ids.insert(std::this_thread::get_id());
+    if (indices.size() >= n_expected) {
+      done.notify_all();
+    }
+  }
+
+  bool wait()
+  {
+    std::unique_lock lock(mtx);
+    return done.wait_for(
+      lock, std::chrono::seconds(5), [this]() { return indices.size() >= n_expected; });
+  }
+
+  size_t n_expected;
+  std::mutex mtx;
+  std::condition_variable done;
+  std::vector<uint32_t> indices;
+  std::set<std::thread::id> thread_ids;
+};
+
+// Several sockets share the reactor's single thread, and each still gets its packets in order
+TEST(ReactorTest, TestSharedThread)
+{
+  constexpr size_t n_receivers = 4;
+  constexpr uint32_t n_packets = 50;
+
+  auto reactor = std::make_shared<Reactor>(1);
+  std::vector<std::unique_ptr<UdpReceiver>> receivers;
+  std::vector<std::unique_ptr<Collector>> collectors;
+  for (size_t i = 0; i < n_receivers; ++i) {
+    receivers.push_back(std::make_unique<UdpReceiver>(1500, 8));
+    receivers.back()->bind("127.0.0.1", g_port + i);
+    collectors.push_back(std::make_unique<Collector>(n_packets));
+    receivers.back()->subscribe(
+      [collector = collectors.back().get()](auto packet, const auto & metadata) {
+        collector->on_packet(packet, metadata);
+      },
+      reactor);
+  }
+
+  for (size_t i = 0; i < n_receivers; ++i) {
+    send_packets(g_port + i, n_packets, 1000);
+  }
+
+  std::set<std::thread::id> thread_ids;
+  for (auto & collector : collectors) {
+    ASSERT_TRUE(collector->wait());
+    std::lock_guard lock(collector->mtx);
+    for (uint32_t i = 0; i < n_packets; ++i) {
+      EXPECT_EQ(collector->indices[i], i);
+    }
+    thread_ids.insert(collector->thread_ids.begin(), collector->thread_ids.end());
+  }
+  EXPECT_EQ(thread_ids.size(), 1U);
+  EXPECT_NE(*thread_ids.begin(), std::this_thread::get_id());
+}
+
+// Once a receiver is destroyed, its callback is not called anymore, while others keep receiving
+TEST(ReactorTest, TestRemove)
+{
+  auto reactor = std::make_shared<Reactor>(2);
+  std::atomic<uint32_t> n_removed_calls{0};
+
+  auto removed = std::make_unique<UdpReceiver>();
+  removed->bind("127.0.0.1", g_port + 10);
+  removed->subscribe([&](auto, const auto &) { ++n_removed_calls; }, reactor);
+
+  UdpReceiver kept;
+  kept.bind("127.0.0.1", g_port + 11);
+  Collector collector(20);
+  kept.subscribe(
+    [&](auto packet, const auto & metadata) { collector.on_packet(packet, metadata); }, reactor);
+
+  send_packets(g_port + 10, 10, 100);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(n_removed_calls, 10U);
+
+  removed.reset();
+  send_packets(g_port + 11, 20, 100);
+  ASSERT_TRUE(collector.wait());
+  EXPECT_EQ(n_removed_calls, 10U);
+}
+
+// Reactor threads only run on the given CPUs
+TEST(ReactorTest, TestAffinity)
+{
+  auto reactor = std::make_shared<Reactor>(1, std::vector<int>{0});
+  UdpReceiver receiver;
+  receiver.bind("127.0.0.1", g_port + 20);
+
+  std::mutex mtx;
+  std::condition_variable done;
+  bool received = false;
+  cpu_set_t affinity;
+  CPU_ZERO(&affinity);
+  receiver.subscribe(
+    [&](auto, const auto &) {
+      std::lock_guard lock(mtx);
+      pthread_getaffinity_np(pthread_self(), sizeof(affinity), &affinity);
+      received = true;
+      done.notify_all();
+    },
+    reactor);
+
+  send_packets(g_port + 20, 1, 100);
+  std::unique_lock lock(mtx);
+  ASSERT_TRUE(done.wait_for(lock, std::chrono::seconds(5), [&]() { return received; }));
+  EXPECT_EQ(CPU_COUNT(&affinity), 1);
+  EXPECT_TRUE(CPU_ISSET(0, &affinity));
+}
+
+TEST(ReactorTest, TestInvalidConfiguration)
+{
+  EXPECT_THROW(Reactor(0), std::runtime_error);
+  EXPECT_THROW(Reactor(1, {-1}), std::runtime_error);
+  EXPECT_THROW(Reactor(1, {CPU_SETSIZE}), std::runtime_error);
+}
+
+// All callers get the same reactor while it is in use, and the first caller's configuration
+TEST(ReactorTest, TestProcessWide)
+{
+  auto first = Reactor::get_process_wide(2, {});
+  auto second = Reactor::get_process_wide(1, {0});
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(second->n_threads(), 2U);
+
+  first.reset();
+  second.reset();
+  auto third = Reactor::get_process_wide(1, {0});
+  EXPECT_EQ(third->n_threads(), 1U);
+}
+
+// A packet ring can be read on the reactor as well
+TEST(ReactorTest, TestPacketMmapReceiver)
+{
+  std::unique_ptr<PacketMmapReceiver> receiver;
+  try {
+    receiver = std::make_unique<PacketMmapReceiver>();
+  } catch (const std::runtime_error &) {
+    GTEST_SKIP() << "Packet sockets are not permitted (needs CAP_NET_RAW)";
+  }
+  receiver->bind("127.0.0.1", "127.0.0.1", g_port + 30);
+
+  constexpr uint32_t n_packets = 200;
+  auto reactor = std::make_shared<Reactor>(1);
+  Collector collector(n_packets);
+  receiver->subscribe(
+    [&](auto payload, const auto & metadata) { collector.on_packet(payload, metadata); }, reactor);
+
+  send_packets(g_port + 30, n_packets, 1080);
+  ASSERT_TRUE(collector.wait());
+
+  std::lock_guard lock(collector.mtx);
+  for (uint32_t i = 0; i < n_packets; ++i) {
+    EXPECT_EQ(collector.indices[i], i);
+  }
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,214 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_ros/common/spsc_queue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace nebula::test
+{
+
+TEST(SpscQueueTest, TestBoundedFifo)
+{
+  // The capacity is not a power of two, so the ring has more slots than can be used
+  SpscQueue<std::unique_ptr<int>> queue(5);
+  EXPECT_EQ(queue.capacity(), 5U);
+
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 5; ++i) {
+      EXPECT_TRUE(queue.try_push(std::make_unique<int>(i)));
+    }
+    EXPECT_FALSE(queue.try_push(std::make_unique<int>(5)));
+    EXPECT_EQ(queue.n_dropped(), static_cast<size_t>(round + 1));
+    EXPECT_EQ(queue.high_water_mark(), 5U);
+
+    for (int i = 0; i < 5; ++i) {
+      auto value = queue.pop();
+      ASSERT_NE(value, nullptr);
+      EXPECT_EQ(*value, i);
+    }
+  }
+}
+
+TEST(SpscQueueTest, TestHighWaterMark)
+{
+  SpscQueue<int> queue(16);
+  for (int i = 0; i < 100; ++i) {
+    queue.push(int{i});
+    queue.push(int{i});
+    queue.pop();
+    queue.pop();
+  }
+  EXPECT_EQ(queue.high_water_mark(), 2U);
+  EXPECT_EQ(queue.n_dropped(), 0U);
+}
+
+// The consumer and a blocking producer have to be woken up whether they are spinning or sleeping
+TEST(SpscQueueTest, TestThreadedHandoff)
+{
+  constexpr size_t n_values = 200000;
+  SpscQueue<size_t> queue(8);
+
+  std::thread producer([&]() {
+    for (size_t i = 0; i < n_values; ++i) {
+      queue.push(size_t{i});
+      if (i % 50000 == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      }
+    }
+  });
+
+  for (size_t i = 0; i < n_values; ++i) {
+    ASSERT_EQ(queue.pop(), i);
+    if (i % 70000 == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+  producer.join();
+
+  EXPECT_EQ(queue.high_water_mark(), 8U);
+  EXPECT_EQ(queue.n_dropped(), 0U);
+}
+
+TEST(SpscQueueTest, TestPopBatch)
+{
+  SpscQueue<int> queue(8);
+  for (int i = 0; i < 5; ++i) {
+    queue.push(int{i});
+  }
+
+  std::vector<int> values;
+  EXPECT_EQ(queue.pop_batch(values, 3), 3U);
+  EXPECT_EQ(queue.pop_batch(values, 3), 2U);
+  EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4}));
+
+  // The ring wraps around in the middle of a batch
+  for (int i = 5; i < 12; ++i) {
+    queue.push(int{i});
+  }
+  values.clear();
+  EXPECT_EQ(queue.pop_batch(values, 100), 7U);
+  EXPECT_EQ(values, (std::vector<int>{5, 6, 7, 8, 9, 10, 11}));
+}
+
+TEST(SpscQueueTest, TestThreadedPopBatch)
+{
+  constexpr size_t n_values = 200000;
+  SpscQueue<size_t> queue(64);
+
+  std::thread producer([&]() {
+    for (size_t i = 0; i < n_values; ++i) {
+      queue.push(size_t{i});
+    }
+  });
+
+  std::vector<size_t> values;
+  while (values.size() < n_values) {
+    queue.pop_batch(values, 16);
+  }
+  producer.join();
+
+  for (size_t i = 0; i < n_values; ++i) {
+    ASSERT_EQ(values[i], i);
+  }
+}
+
+TEST(SpscQueueTest, TestThreadedDrops)
+{
+  constexpr size_t n_values = 200000;
+  SpscQueue<size_t> queue(4);
+
+  std::thread producer([&]() {
+    for (size_t i = 0; i < n_values; ++i) {
+      queue.try_push(size_t{i});
+    }
+    queue.push(size_t{n_values});
+  });
+
+  // Values arrive in order, with gaps where they were dropped
+  size_t n_received = 0;
+  size_t last_value = 0;
+  for (size_t value = queue.pop(); value != n_values; value = queue.pop()) {
+    if (n_received > 0) {
+      EXPECT_GT(value, last_value);
+    }
+    last_value = value;
+    ++n_received;
+  }
+  producer.join();
+
+  EXPECT_EQ(n_received + queue.n_dropped(), n_values);
+}
+
+// Values written and read in place keep the buffers of their slots, so that a full round through
+// the ring does not allocate
+TEST(SpscQueueTest, TestInPlace)
+{
+  SpscQueue<std::vector<int>> queue(4);
+  std::vector<const int *> buffers;
+
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      std::vector<int> * slot = queue.try_claim();
+      ASSERT_NE(slot, nullptr);
+      slot->assign(100, round * 4 + i);
+      if (round == 0) {
+        buffers.push_back(slot->data());
+      } else {
+        EXPECT_EQ(slot->data(), buffers[i]);
+      }
+      queue.commit();
+    }
+    EXPECT_EQ(queue.try_claim(), nullptr);
+    EXPECT_EQ(queue.n_dropped(), static_cast<size_t>(round + 1));
+
+    ASSERT_EQ(queue.wait_for_values(3), 3U);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(queue.peek(i).front(), round * 4 + i);
+    }
+    queue.release(3);
+    ASSERT_EQ(queue.wait_for_values(10), 1U);
+    EXPECT_EQ(queue.peek(0).front(), round * 4 + 3);
+    queue.release(1);
+  }
+}
+
+TEST(SpscQueueTest, TestThreadedInPlace)
+{
+  constexpr size_t n_values = 200000;
+  SpscQueue<std::vector<size_t>> queue(64);
+
+  std::thread producer([&]() {
+    for (size_t i = 0; i <= n_values; ++i) {
+      queue.claim().assign(3, i);
+      queue.commit();
+    }
+  });
+
+  size_t expected = 0;
+  while (expected <= n_values) {
+    const size_t n_available = queue.wait_for_values(16);
+    ASSERT_GE(n_available, 1U);
+    ASSERT_LE(n_available, 16U);
+    for (size_t i = 0; i < n_available; ++i) {
+      ASSERT_EQ(queue.peek(i), std::vector<size_t>(3, expected));
+      ++expected;
+    }
+    queue.release(n_available);
+  }
+  producer.join();
+  EXPECT_EQ(queue.n_dropped(), 0U);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
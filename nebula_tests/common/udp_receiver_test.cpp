@@ -0,0 +1,214 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_common/util/span.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/connections/udp_receiver.hpp>
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace nebula::test
+{
+
+using drivers::connections::UdpPacketMetadata;
+using drivers::connections::UdpReceiver;
+
+constexpr uint16_t g_port = 57410;
+
+uint64_t now_ns()
+{
+  timespec now{};
+  clock_gettime(CLOCK_REALTIME, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+}
+
+/// @brief Sends `n_packets` datagrams of `packet_size` bytes to localhost. The first bytes of each
+/// packet hold its index.
+void send_packets(uint16_t port, uint32_t n_packets, size_t packet_size)
+{
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(fd, 0);
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  std::vector<uint8_t> packet(packet_size, 0xab);
+  for (uint32_t i = 0; i < n_packets; ++i) {
+    std::memcpy(packet.data(), &i, sizeof(i));
+    ASSERT_EQ(
+      sendto(
+        fd, packet.data(), packet.size(), 0, reinterpret_cast<sockaddr *>(&address),
+        sizeof(address)),
+      static_cast<ssize_t>(packet.size()));
+  }
+  close(fd);
+}
+
+/// @brief Collects received packets and their metadata until `n_expected` have arrived
+struct Collector
+{
+  explicit Collector(size_t n_expected) : n_expected(n_expected) {}
+
+  void on_packet(util::span<const uint8_t> packet, const UdpPacketMetadata & metadata)
+  {
+    std::lock_guard lock(mtx);
+    packets.emplace_back(packet.begin(), packet.end());
+    metadata_list.push_back(metadata);
+    callback_times_ns.push_back(now_ns());
+    if (packets.size() >= n_expected) {
+      done.notify_all();
+    }
+  }
+
+  bool wait()
+  {
+    std::unique_lock lock(mtx);
+    return done.wait_for(
+      lock, std::chrono::seconds(5), [this]() { return packets.size() >= n_expected; });
+  }
+
+  size_t n_expected;
+  std::mutex mtx;
+  std::condition_variable done;
+  std::vector<std::vector<uint8_t>> packets;
+  std::vector<UdpPacketMetadata> metadata_list;
+  std::vector<uint64_t> callback_times_ns;
+};
+
+// Datagrams that have queued up in the socket are read in batches, in order, and stamped with the
+// time the kernel received them rather than when they were read
+TEST(UdpReceiverTest, TestBatchedReceive)
+{
+  // Few enough packets to fit into the default socket buffer
+  constexpr uint32_t n_packets = 50;
+  constexpr size_t batch_size = 16;
+
+  UdpReceiver receiver(1500, batch_size);
+  receiver.bind("127.0.0.1", g_port);
+
+  const uint64_t send_start_ns = now_ns();
+  send_packets(g_port, n_packets, 1080);
+  const uint64_t send_end_ns = now_ns();
+  // Let the packets queue up in the socket
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  Collector collector(n_packets);
+  // Taken right before the first receive call, so it is later than any kernel timestamp but
+  // earlier than any time the packets could have been read at
+  const uint64_t receive_start_ns = now_ns();
+  receiver.subscribe([&](auto packet, const auto & metadata) {
+    collector.on_packet(packet, metadata);
+  });
+  ASSERT_TRUE(collector.wait());
+
+  for (uint32_t i = 0; i < n_packets; ++i) {
+    ASSERT_EQ(collector.packets[i].size(), 1080U);
+    uint32_t index = 0;
+    std::memcpy(&index, collector.packets[i].data(), sizeof(index));
+    EXPECT_EQ(index, i);
+
+    const auto & metadata = collector.metadata_list[i];
+    EXPECT_FALSE(metadata.truncated);
+    EXPECT_EQ(metadata.sender_ip.s_addr, htonl(INADDR_LOOPBACK));
+    EXPECT_GE(metadata.receive_time_ns, send_start_ns);
+    EXPECT_LE(metadata.receive_time_ns, send_end_ns);
+    EXPECT_LT(metadata.receive_time_ns, receive_start_ns);
+    EXPECT_LE(receive_start_ns, collector.callback_times_ns[i]);
+    if (i > 0) {
+      EXPECT_GE(metadata.receive_time_ns, collector.metadata_list[i - 1].receive_time_ns);
+    }
+  }
+
+  // All packets were queued before receiving started, so each call reads a full batch. The kernel
+  // may split a batch where it appends datagrams to the socket, which at most doubles the calls.
+  const uint64_t n_full_batches = (n_packets + batch_size - 1) / batch_size;
+  auto stats = receiver.get_stats();
+  EXPECT_EQ(stats.n_packets, n_packets);
+  EXPECT_GE(stats.n_syscalls, n_full_batches);
+  EXPECT_LE(stats.n_syscalls, 2 * n_full_batches);
+  EXPECT_EQ(stats.n_errors, 0U);
+}
+
+// Datagrams longer than the buffers are cut off and flagged
+TEST(UdpReceiverTest, TestTruncation)
+{
+  UdpReceiver receiver(64, 4);
+  receiver.bind("127.0.0.1", g_port + 1);
+
+  Collector collector(2);
+  receiver.subscribe([&](auto packet, const auto & metadata) {
+    collector.on_packet(packet, metadata);
+  });
+  send_packets(g_port + 1, 1, 100);
+  send_packets(g_port + 1, 1, 64);
+  ASSERT_TRUE(collector.wait());
+
+  EXPECT_EQ(collector.packets[0].size(), 64U);
+  EXPECT_TRUE(collector.metadata_list[0].truncated);
+  EXPECT_EQ(collector.packets[1].size(), 64U);
+  EXPECT_FALSE(collector.metadata_list[1].truncated);
+  EXPECT_EQ(receiver.get_stats().n_truncated, 1U);
+}
+
+// Each datagram of a batch is passed in place, at an address aligned like allocated memory even if
+// the maximum packet size is odd, so that it can be viewed as a packet struct without copying
+TEST(UdpReceiverTest, TestAlignedInPlacePackets)
+{
+  constexpr uint32_t n_packets = 50;
+  UdpReceiver receiver(1001, 8);
+  receiver.bind("127.0.0.1", g_port + 2);
+
+  send_packets(g_port + 2, n_packets, 1000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  Collector collector(n_packets);
+  std::vector<uintptr_t> addresses;
+  receiver.subscribe([&](auto packet, const auto & metadata) {
+    addresses.push_back(reinterpret_cast<uintptr_t>(packet.data()));
+    collector.on_packet(packet, metadata);
+  });
+  ASSERT_TRUE(collector.wait());
+
+  for (uint32_t i = 0; i < n_packets; ++i) {
+    ASSERT_EQ(collector.packets[i].size(), 1000U);
+    uint32_t index = 0;
+    std::memcpy(&index, collector.packets[i].data(), sizeof(index));
+    EXPECT_EQ(index, i);
+    EXPECT_EQ(addresses[i] % alignof(std::max_align_t), 0U);
+  }
+
+  // The datagrams of a batch are in separate slots of one buffer, which is reused for every batch
+  const std::set<uintptr_t> slots(addresses.begin(), addresses.end());
+  EXPECT_GT(slots.size(), 1U);
+  EXPECT_LE(slots.size(), 8U);
+}
+
+TEST(UdpReceiverTest, TestInvalidAddress)
+{
+  UdpReceiver receiver;
+  EXPECT_THROW(receiver.bind("not an ip", g_port + 3), std::runtime_error);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
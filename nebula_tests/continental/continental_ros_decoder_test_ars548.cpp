@@ -219,9 +219,7 @@ void ContinentalRosDecoderTest::read_bag()
 
         ASSERT_EQ(1, extracted_msg.packets.size());
 
-        auto extracted_msg_ptr =
-          std::make_unique<nebula_msgs::msg::NebulaPacket>(extracted_msg.packets[0]);
-        driver_ptr_->process_packet(std::move(extracted_msg_ptr));
+        driver_ptr_->process_packet(extracted_msg.packets[0]);
       }
     }
   }
@@ -240,9 +240,8 @@ void ContinentalRosDecoderTest::read_bag()
         std::cout << "Found data in topic " << bag_message->topic_name << ": "
                   << bag_message->time_stamp << std::endl;
 
-        for (auto & packet_msg : extracted_msg.packets) {
-          auto extracted_msg_ptr = std::make_unique<nebula_msgs::msg::NebulaPacket>(packet_msg);
-          driver_ptr_->process_packet(std::move(extracted_msg_ptr));
+        for (const auto & packet_msg : extracted_msg.packets) {
+          driver_ptr_->process_packet(packet_msg);
         }
       }
     }
@@ -0,0 +1,158 @@
+// Copyright 2024 TIER IV, Inc.
+
+// Compares the full and compact trig tables of the angle correctors in terms of memory use,
+// construction time and lookup time per point.
+//
+// Usage: hesai_angle_corrector_benchmark [n_repetitions]
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_decoders/nebula_decoders_common/azimuth_trig_table.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_128e4x.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_64.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_at128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_qt128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename SensorT>
+void benchmark_sensor(const std::string & name, const std::string & calibration_file, int n_reps)
+{
+  using angle_corrector_t = typename SensorT::angle_corrector_t;
+  constexpr size_t n_channels = SensorT::packet_t::n_channels;
+  constexpr size_t angle_unit = SensorT::packet_t::degree_subdivisions;
+  constexpr uint32_t max_azimuth = 360 * angle_unit;
+
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/" + calibration_file;
+  if (calibration->load_from_file(calibration_path) != Status::OK) {
+    std::printf("%-14s could not load %s\n", name.c_str(), calibration_path.c_str());
+    return;
+  }
+
+  std::array<float, n_channels> azimuth_offset_rad{};
+  for (size_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+    azimuth_offset_rad[channel_id] = drivers::deg2rad(calibration->azimuth_offset_map[channel_id]);
+  }
+
+  // Sweep the azimuth like a rotating sensor does, visiting every channel at each block azimuth
+  std::vector<uint32_t> block_azimuths;
+  for (uint32_t block_azimuth = 0; block_azimuth < max_azimuth; block_azimuth += 10) {
+    block_azimuths.push_back(block_azimuth);
+  }
+
+  for (bool compact : {false, true}) {
+    double build_ms = 1e9;
+    double lookup_ns = 1e9;
+    size_t memory_bytes = 0;
+    float checksum = 0;
+
+    for (int rep = 0; rep < n_reps; ++rep) {
+      auto start = Clock::now();
+      angle_corrector_t angle_corrector(calibration, 0, 360, 0, compact);
+      build_ms = std::min(build_ms, elapsed_ms(start));
+
+      memory_bytes = drivers::AzimuthTrigTable<n_channels, angle_unit>(azimuth_offset_rad, compact)
+                       .get_memory_usage_bytes();
+
+      start = Clock::now();
+      for (uint32_t block_azimuth : block_azimuths) {
+        for (uint32_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+          auto angles = angle_corrector.get_corrected_angle_data(block_azimuth, channel_id);
+          checksum += angles.sin_azimuth + angles.cos_azimuth;
+        }
+      }
+      double n_points = static_cast<double>(block_azimuths.size() * n_channels);
+      lookup_ns = std::min(lookup_ns, elapsed_ms(start) * 1e6 / n_points);
+    }
+
+    std::printf(
+      "%-14s %-8s %10.1f kB %10.2f ms %8.2f ns/point   (checksum %.3f)\n", name.c_str(),
+      compact ? "compact" : "full", memory_bytes / 1024., build_ms, lookup_ns, checksum);
+  }
+}
+
+void benchmark_at128(int n_reps)
+{
+  using angle_corrector_t = drivers::PandarAT128::angle_corrector_t;
+  constexpr size_t n_channels = drivers::PandarAT128::packet_t::n_channels;
+  constexpr uint32_t max_azimuth = 360 * drivers::PandarAT128::packet_t::degree_subdivisions;
+
+  auto correction = std::make_shared<drivers::HesaiCorrection>();
+  auto correction_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarAT128.dat";
+  if (correction->load_from_file(correction_path) != Status::OK) {
+    std::printf("%-14s could not load %s\n", "PandarAT128", correction_path.c_str());
+    return;
+  }
+
+  // Sweep the FoV of all three mirrors in 0.1 deg steps
+  std::vector<uint32_t> block_azimuths;
+  for (uint32_t block_azimuth = 0; block_azimuth < max_azimuth; block_azimuth += 2560) {
+    block_azimuths.push_back(block_azimuth);
+  }
+
+  for (bool compact : {false, true}) {
+    double build_ms = 1e9;
+    double lookup_ns = 1e9;
+    size_t memory_bytes = 0;
+    float checksum = 0;
+
+    for (int rep = 0; rep < n_reps; ++rep) {
+      auto start = Clock::now();
+      auto angle_corrector = std::make_unique<angle_corrector_t>(correction, 30, 150, 150, compact);
+      build_ms = std::min(build_ms, elapsed_ms(start));
+      memory_bytes = angle_corrector->get_trig_table_memory_usage_bytes();
+
+      start = Clock::now();
+      for (uint32_t block_azimuth : block_azimuths) {
+        for (uint32_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+          auto angles = angle_corrector->get_corrected_angle_data(block_azimuth, channel_id);
+          checksum += angles.sin_azimuth + angles.cos_azimuth + angles.sin_elevation;
+        }
+      }
+      double n_points = static_cast<double>(block_azimuths.size() * n_channels);
+      lookup_ns = std::min(lookup_ns, elapsed_ms(start) * 1e6 / n_points);
+    }
+
+    std::printf(
+      "%-14s %-8s %10.1f kB %10.2f ms %8.2f ns/point   (checksum %.3f)\n", "PandarAT128",
+      compact ? "compact" : "full", memory_bytes / 1024., build_ms, lookup_ns, checksum);
+  }
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  int n_reps = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+  std::printf("%-14s %-8s %13s %13s %16s\n", "sensor", "tables", "memory", "build", "lookup");
+  nebula::test::benchmark_sensor<nebula::drivers::PandarXT32>(
+    "PandarXT32", "PandarXT32.csv", n_reps);
+  nebula::test::benchmark_sensor<nebula::drivers::Pandar64>("Pandar64", "Pandar64.csv", n_reps);
+  nebula::test::benchmark_sensor<nebula::drivers::PandarQT128>(
+    "PandarQT128", "PandarQT128.csv", n_reps);
+  nebula::test::benchmark_sensor<nebula::drivers::Pandar128E4X>(
+    "Pandar128E4X", "Pandar128E4X.csv", n_reps);
+  nebula::test::benchmark_at128(n_reps);
+
+  return 0;
+}
@@ -0,0 +1,221 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_decoders/nebula_decoders_common/azimuth_trig_table.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_128e4x.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_64.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_at128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_qt128.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+bool is_within_one_ulp(float actual, float expected)
+{
+  return actual == expected || actual == std::nextafter(expected, INFINITY) ||
+         actual == std::nextafter(expected, -INFINITY);
+}
+
+template <typename SensorT>
+void check_compact_trig_tables(const std::string & calibration_file)
+{
+  using angle_corrector_t = typename SensorT::angle_corrector_t;
+  constexpr uint32_t max_azimuth = 360 * SensorT::packet_t::degree_subdivisions;
+  constexpr uint32_t n_channels = SensorT::packet_t::n_channels;
+
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/" + calibration_file;
+  ASSERT_EQ(calibration->load_from_file(calibration_path), Status::OK);
+
+  angle_corrector_t full(calibration, 0, 360, 0, false);
+  angle_corrector_t compact(calibration, 0, 360, 0, true);
+
+  for (uint32_t block_azimuth = 0; block_azimuth < max_azimuth; ++block_azimuth) {
+    for (uint32_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+      auto expected = full.get_corrected_angle_data(block_azimuth, channel_id);
+      auto actual = compact.get_corrected_angle_data(block_azimuth, channel_id);
+
+      ASSERT_EQ(actual.azimuth_rad, expected.azimuth_rad);
+      ASSERT_EQ(actual.elevation_rad, expected.elevation_rad);
+      ASSERT_FLOAT_EQ(actual.sin_azimuth, expected.sin_azimuth);
+      ASSERT_FLOAT_EQ(actual.cos_azimuth, expected.cos_azimuth);
+      ASSERT_EQ(actual.sin_elevation, expected.sin_elevation);
+      ASSERT_EQ(actual.cos_elevation, expected.cos_elevation);
+    }
+  }
+}
+
+// Checks that the compact tables yield the same angles as the full ones, and azimuth sin/cos within
+// 1 ulp of the full tables' `sinf`/`cosf` values
+TEST(AngleCorrectorTest, TestCompactTrigTablesPandar64)
+{
+  check_compact_trig_tables<drivers::Pandar64>("Pandar64.csv");
+}
+
+TEST(AngleCorrectorTest, TestCompactTrigTablesPandarQT128)
+{
+  check_compact_trig_tables<drivers::PandarQT128>("PandarQT128.csv");
+}
+
+TEST(AngleCorrectorTest, TestCompactTrigTablesPandar128E4X)
+{
+  check_compact_trig_tables<drivers::Pandar128E4X>("Pandar128E4X.csv");
+}
+
+// Checks that the compact tables of the correction-based angle corrector yield the same angles as
+// its full tables, with sin/cos being within a few ulp of the values computed by `sinf`/`cosf`
+TEST(AngleCorrectorTest, TestCompactTrigTablesPandarAT128)
+{
+  using angle_corrector_t = drivers::PandarAT128::angle_corrector_t;
+  constexpr uint32_t max_azimuth = 360 * drivers::PandarAT128::packet_t::degree_subdivisions;
+  constexpr uint32_t n_channels = drivers::PandarAT128::packet_t::n_channels;
+
+  auto correction = std::make_shared<drivers::HesaiCorrection>();
+  auto correction_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarAT128.dat";
+  ASSERT_EQ(correction->load_from_file(correction_path), Status::OK);
+
+  angle_corrector_t full(correction, 30, 150, 150, false);
+  angle_corrector_t compact(correction, 30, 150, 150, true);
+
+  EXPECT_LT(
+    compact.get_trig_table_memory_usage_bytes() * 50, full.get_trig_table_memory_usage_bytes());
+
+  for (uint32_t block_azimuth = 0; block_azimuth < max_azimuth; block_azimuth += 97) {
+    for (uint32_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+      auto expected = full.get_corrected_angle_data(block_azimuth, channel_id);
+      auto actual = compact.get_corrected_angle_data(block_azimuth, channel_id);
+
+      ASSERT_EQ(actual.azimuth_rad, expected.azimuth_rad);
+      ASSERT_EQ(actual.elevation_rad, expected.elevation_rad);
+      ASSERT_FLOAT_EQ(actual.sin_azimuth, expected.sin_azimuth);
+      ASSERT_FLOAT_EQ(actual.cos_azimuth, expected.cos_azimuth);
+      ASSERT_FLOAT_EQ(actual.sin_elevation, expected.sin_elevation);
+      ASSERT_FLOAT_EQ(actual.cos_elevation, expected.cos_elevation);
+    }
+  }
+
+  // The scan cutting angles are found without any trigonometry and thus have to be the same
+  for (uint32_t azimuth = 0; azimuth < max_azimuth; azimuth += 101) {
+    uint32_t next_azimuth = (azimuth + 101) % max_azimuth;
+    ASSERT_EQ(
+      compact.passed_emit_angle(azimuth, next_azimuth),
+      full.passed_emit_angle(azimuth, next_azimuth));
+    ASSERT_EQ(
+      compact.passed_timestamp_reset_angle(azimuth, next_azimuth),
+      full.passed_timestamp_reset_angle(azimuth, next_azimuth));
+    ASSERT_EQ(
+      compact.is_inside_fov(azimuth, next_azimuth), full.is_inside_fov(azimuth, next_azimuth));
+    ASSERT_EQ(
+      compact.is_inside_overlap(azimuth, next_azimuth),
+      full.is_inside_overlap(azimuth, next_azimuth));
+  }
+}
+
+// Checks that the per-block adjustments of all channels match the per-channel ones, and that the
+// per-block angle cache yields the same angles regardless of the order they are requested in
+TEST(AngleCorrectorTest, TestAngleAdjustsPandarAT128)
+{
+  using angle_corrector_t = drivers::PandarAT128::angle_corrector_t;
+  constexpr uint32_t max_azimuth = 360 * drivers::PandarAT128::packet_t::degree_subdivisions;
+  constexpr uint32_t n_channels = drivers::PandarAT128::packet_t::n_channels;
+
+  auto correction = std::make_shared<drivers::HesaiCorrection>();
+  auto correction_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarAT128.dat";
+  ASSERT_EQ(correction->load_from_file(correction_path), Status::OK);
+
+  std::array<int8_t, n_channels> azimuth_adjusts{};
+  std::array<int8_t, n_channels> elevation_adjusts{};
+  for (uint32_t azimuth = 0; azimuth < max_azimuth; azimuth += 89) {
+    correction->get_angle_adjusts_v3(
+      azimuth, n_channels, azimuth_adjusts.data(), elevation_adjusts.data());
+    for (uint8_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+      ASSERT_EQ(
+        azimuth_adjusts[channel_id], correction->get_azimuth_adjust_v3(channel_id, azimuth));
+      ASSERT_EQ(
+        elevation_adjusts[channel_id], correction->get_elevation_adjust_v3(channel_id, azimuth));
+    }
+  }
+
+  angle_corrector_t angle_corrector(correction, 30, 150, 150);
+  std::array<uint32_t, 3> block_azimuths{1000, 4000000, 8000000};
+
+  // Request all channels of one block after the other, as the decoder does
+  std::vector<drivers::CorrectedAngleData> expected;
+  for (uint32_t block_azimuth : block_azimuths) {
+    for (uint32_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+      expected.push_back(angle_corrector.get_corrected_angle_data(block_azimuth, channel_id));
+    }
+  }
+
+  // Alternate between blocks for every request
+  for (uint32_t channel_id = 0; channel_id < n_channels; ++channel_id) {
+    for (size_t block_id = 0; block_id < block_azimuths.size(); ++block_id) {
+      auto actual = angle_corrector.get_corrected_angle_data(block_azimuths[block_id], channel_id);
+      const auto & expected_data = expected[block_id * n_channels + channel_id];
+      ASSERT_EQ(actual.azimuth_rad, expected_data.azimuth_rad);
+      ASSERT_EQ(actual.elevation_rad, expected_data.elevation_rad);
+      ASSERT_EQ(actual.sin_azimuth, expected_data.sin_azimuth);
+      ASSERT_EQ(actual.cos_azimuth, expected_data.cos_azimuth);
+      ASSERT_EQ(actual.sin_elevation, expected_data.sin_elevation);
+      ASSERT_EQ(actual.cos_elevation, expected_data.cos_elevation);
+    }
+  }
+}
+
+// Checks that the full table holds exactly the `sinf`/`cosf` values of the float angle, and that
+// the compact table's values differ from them by at most 1 ulp
+TEST(AngleCorrectorTest, TestAzimuthTrigTableFull)
+{
+  std::array<float, 4> azimuth_offset_rad{0.f, -0.0736f, 0.0218f, 1e-9f};
+  drivers::AzimuthTrigTable<4, 100> full(azimuth_offset_rad, false);
+  drivers::AzimuthTrigTable<4, 100> compact(azimuth_offset_rad, true);
+
+  for (uint32_t block_azimuth = 0; block_azimuth < 36000; ++block_azimuth) {
+    for (uint32_t channel_id = 0; channel_id < 4; ++channel_id) {
+      float angle_rad =
+        full.get_block_azimuth_rad(block_azimuth) + full.get_azimuth_offset_rad(channel_id);
+      auto sin_cos = full.get_sin_cos(block_azimuth, channel_id);
+      ASSERT_EQ(sin_cos.sin, sinf(angle_rad));
+      ASSERT_EQ(sin_cos.cos, cosf(angle_rad));
+
+      auto compact_sin_cos = compact.get_sin_cos(block_azimuth, channel_id);
+      ASSERT_TRUE(is_within_one_ulp(compact_sin_cos.sin, sin_cos.sin));
+      ASSERT_TRUE(is_within_one_ulp(compact_sin_cos.cos, sin_cos.cos));
+    }
+  }
+}
+
+// Checks that the compact table values are the correctly rounded sin/cos of the float angle
+TEST(AngleCorrectorTest, TestAzimuthTrigTableAccuracy)
+{
+  std::array<float, 4> azimuth_offset_rad{0.f, -0.0736f, 0.0218f, 1e-9f};
+  drivers::AzimuthTrigTable<4, 100> table(azimuth_offset_rad, true);
+
+  for (uint32_t block_azimuth = 0; block_azimuth < 36000; ++block_azimuth) {
+    for (uint32_t channel_id = 0; channel_id < 4; ++channel_id) {
+      float angle_rad =
+        table.get_block_azimuth_rad(block_azimuth) + table.get_azimuth_offset_rad(channel_id);
+      auto sin_cos = table.get_sin_cos(block_azimuth, channel_id);
+
+      ASSERT_FLOAT_EQ(sin_cos.sin, static_cast<float>(std::sin(static_cast<double>(angle_rad))));
+      ASSERT_FLOAT_EQ(sin_cos.cos, static_cast<float>(std::cos(static_cast<double>(angle_rad))));
+    }
+  }
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
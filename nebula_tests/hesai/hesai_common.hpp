@@ -18,13 +18,24 @@
 #include <nebula_common/hesai/hesai_common.hpp>
 #include <nebula_common/nebula_common.hpp>
 #include <nebula_common/nebula_status.hpp>
+#include <nebula_common/point_types.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
 #include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_scan_decoder.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp>
 #include <nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
 
 namespace nebula::test
 {
@@ -77,4 +88,172 @@ inline void print_pcd(nebula::drivers::NebulaPointCloudPtr pp)
   }
 }
 
+/// @brief The number of azimuths per rotation of the packets of `decode_synthetic_rotations`, one
+/// every 0.1 deg
+constexpr uint32_t g_synthetic_azimuths_per_rotation = 3600;
+
+/// @brief A PandarXT32 configuration decoding full rotations of the packets of
+/// `decode_synthetic_rotations`. Tests change the fields they are about.
+inline drivers::HesaiSensorConfiguration make_synthetic_config()
+{
+  drivers::HesaiSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::HESAI_PANDARXT32;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "hesai";
+  config.min_range = 0.1;
+  config.max_range = 300;
+  config.cloud_min_angle = 0;
+  config.cloud_max_angle = 360;
+  config.cut_angle = 0;
+  config.dual_return_distance_threshold = 0.1;
+  return config;
+}
+
+/// @brief Whether `decode_synthetic_rotations` generates dual return packets for `config`
+inline bool is_synthetic_dual_return(const drivers::HesaiSensorConfiguration & config)
+{
+  return config.return_mode != drivers::ReturnMode::SINGLE_STRONGEST;
+}
+
+/// @brief The number of packets per rotation `decode_synthetic_rotations` generates for `config`
+inline uint32_t synthetic_packets_per_rotation(const drivers::HesaiSensorConfiguration & config)
+{
+  constexpr uint32_t n_blocks = drivers::hesai_packet::PacketXT32::n_blocks;
+  const uint32_t azimuths_per_packet = is_synthetic_dual_return(config) ? n_blocks / 2 : n_blocks;
+  return g_synthetic_azimuths_per_rotation / azimuths_per_packet;
+}
+
+using synthetic_driver_callback_t = std::function<void(drivers::HesaiDriver & driver)>;
+using synthetic_packet_callback_t = std::function<void(
+  drivers::HesaiDriver & driver, uint32_t packet_id, const drivers::NebulaPointCloudPtr & scan,
+  double scan_timestamp_s)>;
+
+/// @brief Decodes `n_rotations` rotations of synthetic PandarXT32 packets, 100 ms each, with a
+/// driver for `config`. Single return configurations get SINGLE_STRONGEST packets, all others
+/// DUAL_LAST_STRONGEST ones, in which some last returns are identical to the strongest ones.
+/// @param on_start Called with the driver before the first packet, if set
+/// @param on_packet Called after each packet with the scan it completed, or nullptr
+inline void decode_synthetic_rotations(
+  const drivers::HesaiSensorConfiguration & config, const synthetic_packet_callback_t & on_packet,
+  uint32_t n_rotations = 3, const synthetic_driver_callback_t & on_start = {})
+{
+  namespace hesai_packet = drivers::hesai_packet;
+  using packet_t = hesai_packet::PacketXT32;
+  constexpr uint32_t azimuth_step = 36000 / g_synthetic_azimuths_per_rotation;
+
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarXT32.csv";
+  ASSERT_EQ(calibration->load_from_file(calibration_path), Status::OK);
+
+  drivers::HesaiDriver driver(
+    std::make_shared<const drivers::HesaiSensorConfiguration>(config), calibration);
+  ASSERT_EQ(driver.get_status(), Status::OK);
+  if (on_start) {
+    on_start(driver);
+  }
+
+  const bool dual_return = is_synthetic_dual_return(config);
+  const uint32_t packets_per_rotation = synthetic_packets_per_rotation(config);
+
+  std::vector<uint8_t> buffer(sizeof(packet_t));
+  auto & packet = *reinterpret_cast<packet_t *>(buffer.data());
+  packet.header.dis_unit = 4;
+  packet.tail.return_mode = dual_return ? hesai_packet::return_mode::DUAL_LAST_STRONGEST
+                                        : hesai_packet::return_mode::SINGLE_STRONGEST;
+  packet.tail.date_time.year = 124;
+  packet.tail.date_time.month = 1;
+  packet.tail.date_time.day = 1;
+
+  for (uint32_t packet_id = 0; packet_id < n_rotations * packets_per_rotation; ++packet_id) {
+    uint32_t azimuth = packet_id * (g_synthetic_azimuths_per_rotation / packets_per_rotation) *
+                       azimuth_step;
+    for (size_t block_id = 0; block_id < packet_t::n_blocks; ++block_id) {
+      auto & block = packet.body.blocks[block_id];
+      // Both blocks of a dual return group share their azimuth
+      block.azimuth = azimuth % 36000;
+      if (!dual_return || block_id % 2 == 1) {
+        azimuth += azimuth_step;
+      }
+      for (size_t channel = 0; channel < packet_t::n_channels; ++channel) {
+        block.units[channel].distance =
+          500 + (packet_id + channel * 7) % 1000 + (block_id % 2) * (channel % 3) * 100;
+        block.units[channel].reflectivity = channel;
+      }
+    }
+    packet.tail.timestamp = packet_id * (100000 / packets_per_rotation);
+
+    auto [pointcloud, timestamp_s] = driver.parse_cloud_packet(buffer);
+    on_packet(driver, packet_id, pointcloud, timestamp_s);
+  }
+}
+
+/// @brief The scans `decode_synthetic_rotations` completes
+inline std::vector<drivers::NebulaPointCloud> decode_synthetic_scans(
+  const drivers::HesaiSensorConfiguration & config,
+  const synthetic_driver_callback_t & on_start = {})
+{
+  std::vector<drivers::NebulaPointCloud> scans;
+  decode_synthetic_rotations(
+    config,
+    [&](auto &, uint32_t, const drivers::NebulaPointCloudPtr & scan, double) {
+      if (scan) {
+        scans.push_back(*scan);
+      }
+    },
+    3, on_start);
+  return scans;
+}
+
+inline void expect_same_points(
+  const drivers::NebulaPointCloud & expected, const drivers::NebulaPointCloud & actual)
+{
+  ASSERT_EQ(expected.width, actual.width);
+  ASSERT_EQ(expected.height, actual.height);
+  ASSERT_EQ(expected.points.size(), actual.points.size());
+  EXPECT_EQ(
+    std::memcmp(
+      expected.points.data(), actual.points.data(),
+      expected.points.size() * sizeof(drivers::NebulaPoint)),
+    0);
+}
+
+/// @brief Decoding `config` on worker threads has to give exactly the scans and sectors of
+/// sequential decoding
+inline void expect_parallel_matches_sequential(
+  drivers::HesaiSensorConfiguration config, const synthetic_driver_callback_t & on_start = {})
+{
+  using scan_t = std::tuple<drivers::NebulaPointCloud, double>;
+  auto decode = [&](uint16_t decoder_threads) {
+    config.decoder_threads = decoder_threads;
+    std::vector<scan_t> scans;
+    std::vector<scan_t> sectors;
+    decode_synthetic_rotations(
+      config,
+      [&](auto & driver, uint32_t, const drivers::NebulaPointCloudPtr & scan, double timestamp_s) {
+        for (const auto & [sector, sector_timestamp_s] : driver.get_sectors()) {
+          sectors.emplace_back(*sector, sector_timestamp_s);
+        }
+        if (scan) {
+          scans.emplace_back(*scan, timestamp_s);
+        }
+      },
+      3, on_start);
+    return std::tuple{scans, sectors};
+  };
+
+  auto [sequential_scans, sequential_sectors] = decode(1);
+  auto [parallel_scans, parallel_sectors] = decode(3);
+  ASSERT_GE(sequential_scans.size(), 2U);
+
+  for (const auto & [sequential, parallel] :
+       {std::tuple{&sequential_scans, &parallel_scans},
+        std::tuple{&sequential_sectors, &parallel_sectors}}) {
+    ASSERT_EQ(sequential->size(), parallel->size());
+    for (size_t i = 0; i < sequential->size(); ++i) {
+      EXPECT_EQ(std::get<1>((*sequential)[i]), std::get<1>((*parallel)[i]));
+      expect_same_points(std::get<0>((*sequential)[i]), std::get<0>((*parallel)[i]));
+    }
+  }
+}
+
 }  // namespace nebula::test
@@ -0,0 +1,174 @@
+// Copyright 2024 TIER IV, Inc.
+
+// Measures the time per packet spent in the decoder wrapper, i.e. the whole path of the decoder
+// thread including the driver lock, the subscription queries, packet recording and queueing the
+// completed scans for publishing. Packets are passed one at a time through `process_cloud_packet`
+// and in batches of different sizes through `process_cloud_packets`, the way bursts of packets that
+// have queued up are handled. With a narrow FoV, hardly any points are converted, which leaves the
+// fixed cost per packet.
+//
+// Usage: hesai_decoder_wrapper_benchmark [n_repetitions]
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp>
+#include <nebula_ros/hesai/decoder_wrapper.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <nebula_msgs/msg/nebula_packet.hpp>
+#include <pandar_msgs/msg/pandar_scan.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+using Clock = std::chrono::steady_clock;
+namespace hesai_packet = nebula::drivers::hesai_packet;
+
+using packet_t = hesai_packet::PacketXT32;
+constexpr uint32_t g_packets_per_rotation = 450;
+
+double elapsed_ms(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<nebula_msgs::msg::NebulaPacket> make_packets(size_t n_rotations)
+{
+  constexpr uint32_t azimuth_step = 36000 / (g_packets_per_rotation * packet_t::n_blocks);
+
+  packet_t raw{};
+  raw.header.dis_unit = 4;
+  raw.tail.return_mode = hesai_packet::return_mode::SINGLE_STRONGEST;
+  raw.tail.date_time.year = 124;
+  raw.tail.date_time.month = 1;
+  raw.tail.date_time.day = 1;
+
+  std::vector<nebula_msgs::msg::NebulaPacket> packets;
+  for (uint32_t packet_id = 0; packet_id < n_rotations * g_packets_per_rotation; ++packet_id) {
+    uint32_t azimuth = packet_id * packet_t::n_blocks * azimuth_step;
+    for (auto & block : raw.body.blocks) {
+      block.azimuth = azimuth % 36000;
+      azimuth += azimuth_step;
+      for (size_t channel = 0; channel < packet_t::n_channels; ++channel) {
+        block.units[channel].distance = 500 + (packet_id + channel) % 1000;
+        block.units[channel].reflectivity = channel;
+      }
+    }
+    raw.udp_sequence = packet_id;
+    raw.tail.timestamp = packet_id * 222;
+
+    nebula_msgs::msg::NebulaPacket packet;
+    packet.stamp.sec = 1 + packet_id / 4500;
+    packet.stamp.nanosec = (packet_id % 4500) * 222'000;
+    packet.data.resize(sizeof(packet_t));
+    std::memcpy(packet.data.data(), &raw, sizeof(packet_t));
+    packets.push_back(std::move(packet));
+  }
+
+  return packets;
+}
+
+/// @brief Pass all packets to a decoder wrapper one at a time (`batch_size` 0) or in batches of
+/// `batch_size`, and print the best time per packet over `n_reps` repetitions. The point cloud and,
+/// if `record_packets` is set, the packet topic are subscribed to, so that the wrapper publishes
+/// like it does in operation.
+void benchmark_batch_size(
+  const std::vector<nebula_msgs::msg::NebulaPacket> & packets, uint16_t cloud_max_angle,
+  bool record_packets, size_t batch_size, int n_reps)
+{
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarXT32.csv";
+  if (calibration->load_from_file(calibration_path) != Status::OK) {
+    std::fprintf(stderr, "Could not load %s\n", calibration_path.c_str());
+    std::exit(1);
+  }
+
+  drivers::HesaiSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::HESAI_PANDARXT32;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "hesai";
+  config.min_range = 0.1;
+  config.max_range = 300;
+  config.cloud_min_angle = 0;
+  config.cloud_max_angle = cloud_max_angle;
+  config.cut_angle = 0;
+  auto config_ptr = std::make_shared<const drivers::HesaiSensorConfiguration>(config);
+
+  auto node = std::make_shared<rclcpp::Node>(
+    "hesai_decoder_wrapper_benchmark", rclcpp::NodeOptions().use_intra_process_comms(true));
+  ros::HesaiDecoderWrapper decoder_wrapper(node.get(), config_ptr, calibration, record_packets);
+
+  auto points_sub = node->create_subscription<sensor_msgs::msg::PointCloud2>(
+    "pandar_points", rclcpp::SensorDataQoS(), [](sensor_msgs::msg::PointCloud2::UniquePtr) {});
+  rclcpp::Subscription<pandar_msgs::msg::PandarScan>::SharedPtr packets_sub;
+  if (record_packets) {
+    packets_sub = node->create_subscription<pandar_msgs::msg::PandarScan>(
+      "pandar_packets", rclcpp::SensorDataQoS(), [](pandar_msgs::msg::PandarScan::UniquePtr) {});
+  }
+
+  std::vector<const nebula_msgs::msg::NebulaPacket *> batch;
+  double best_ms = 1e9;
+  for (int rep = 0; rep < n_reps; ++rep) {
+    auto start = Clock::now();
+    if (batch_size == 0) {
+      for (const auto & packet : packets) {
+        decoder_wrapper.process_cloud_packet(packet.data, packet.stamp);
+      }
+    } else {
+      for (size_t begin = 0; begin < packets.size(); begin += batch_size) {
+        batch.clear();
+        for (size_t i = begin; i < std::min(begin + batch_size, packets.size()); ++i) {
+          batch.push_back(&packets[i]);
+        }
+        decoder_wrapper.process_cloud_packets(batch);
+      }
+    }
+    best_ms = std::min(best_ms, elapsed_ms(start));
+  }
+
+  char name[32];
+  if (batch_size == 0) {
+    std::snprintf(name, sizeof(name), "single packets");
+  } else {
+    std::snprintf(name, sizeof(name), "batches of %zu", batch_size);
+  }
+  std::printf("%-18s %8.0f ns/packet\n", name, best_ms * 1e6 / packets.size());
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  namespace test = nebula::test;
+
+  rclcpp::init(argc, argv);
+  int n_reps = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+  const auto packets = test::make_packets(20);
+  for (bool record_packets : {false, true}) {
+    for (uint16_t cloud_max_angle : {360, 1}) {
+      std::printf(
+        "PandarXT32, %zu packets, FoV 0-%u deg, packets %srecorded\n", packets.size(),
+        static_cast<unsigned>(cloud_max_angle), record_packets ? "" : "not ");
+      for (size_t batch_size : {0, 1, 16, 64, 128}) {
+        test::benchmark_batch_size(packets, cloud_max_angle, record_packets, batch_size, n_reps);
+      }
+      std::printf("\n");
+    }
+  }
+
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,179 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "hesai_common.hpp"
+
+#include <nebula_common/point_types.hpp>
+#include <nebula_decoders/nebula_decoders_common/rigid_transform.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace nebula::test
+{
+
+using drivers::NebulaPointCloud;
+using drivers::RigidTransform;
+using drivers::SensorTwist;
+
+std::array<float, 3> apply(const RigidTransform & transform, std::array<float, 3> point)
+{
+  transform.apply(point[0], point[1], point[2]);
+  return point;
+}
+
+void expect_near(const std::array<float, 3> & a, const std::array<float, 3> & b, float tolerance)
+{
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_NEAR(a[i], b[i], tolerance) << "at index " << i;
+  }
+}
+
+TEST(RigidTransformTest, TestTranslation)
+{
+  SensorTwist twist;
+  twist.linear = {10, -2, 1};
+  auto transform = RigidTransform::from_twist(twist, 0.1);
+  expect_near(apply(transform, {1, 2, 3}), {2, 1.8, 3.1}, 1e-6);
+}
+
+TEST(RigidTransformTest, TestRotation)
+{
+  // After a quarter turn counter-clockwise, a point in front of the sensor was to its right before
+  SensorTwist twist;
+  twist.angular = {0, 0, M_PI / 2};
+  auto transform = RigidTransform::from_twist(twist, 1);
+  expect_near(apply(transform, {1, 0, 0}), {0, 1, 0}, 1e-6);
+  expect_near(apply(transform.inverse(), {0, 1, 0}), {1, 0, 0}, 1e-6);
+}
+
+// The closed-form motion has to match integrating the twist in small steps
+TEST(RigidTransformTest, TestMatchesIntegration)
+{
+  SensorTwist twist;
+  twist.linear = {15, 0.5, -0.2};
+  twist.angular = {0.1, -0.2, 0.8};
+  constexpr double duration_s = 0.1;
+  constexpr size_t n_steps = 10000;
+
+  // Composing the motion of each step with the pose so far: pose = pose * step
+  auto step = RigidTransform::from_twist(twist, duration_s / n_steps);
+  std::array<double, 9> rotation{1, 0, 0, 0, 1, 0, 0, 0, 1};
+  std::array<double, 3> translation{0, 0, 0};
+  for (size_t i = 0; i < n_steps; ++i) {
+    auto step_translation = translation;
+    std::array<double, 9> step_rotation{};
+    for (size_t row = 0; row < 3; ++row) {
+      for (size_t col = 0; col < 3; ++col) {
+        step_translation[row] += rotation[row * 3 + col] * step.translation[col];
+        for (size_t k = 0; k < 3; ++k) {
+          step_rotation[row * 3 + col] += rotation[row * 3 + k] * step.rotation[k * 3 + col];
+        }
+      }
+    }
+    rotation = step_rotation;
+    translation = step_translation;
+  }
+
+  auto transform = RigidTransform::from_twist(twist, duration_s);
+  for (size_t i = 0; i < 9; ++i) {
+    EXPECT_NEAR(transform.rotation[i], rotation[i], 1e-4);
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_NEAR(transform.translation[i], translation[i], 1e-3);
+  }
+}
+
+std::vector<NebulaPointCloud> decode_rotations(
+  bool deskew, const std::optional<SensorTwist> & twist, bool use_generic_return_kernel = false)
+{
+  auto config = make_synthetic_config();
+  config.use_generic_return_kernel = use_generic_return_kernel;
+  config.deskew = deskew;
+  return decode_synthetic_scans(config, [&](auto & driver) {
+    if (twist) {
+      driver.set_sensor_twist(*twist);
+    }
+  });
+}
+
+TEST(DeskewTest, TestStandstillIsUnchanged)
+{
+  auto raw_clouds = decode_rotations(false, std::nullopt);
+  auto deskewed_clouds = decode_rotations(true, SensorTwist{});
+  ASSERT_EQ(raw_clouds.size(), deskewed_clouds.size());
+  ASSERT_GE(raw_clouds.size(), 2U);
+
+  for (size_t i = 0; i < raw_clouds.size(); ++i) {
+    ASSERT_EQ(raw_clouds[i].points.size(), deskewed_clouds[i].points.size());
+    for (size_t j = 0; j < raw_clouds[i].points.size(); ++j) {
+      const auto & raw = raw_clouds[i].points[j];
+      const auto & deskewed = deskewed_clouds[i].points[j];
+      EXPECT_FLOAT_EQ(raw.x, deskewed.x);
+      EXPECT_FLOAT_EQ(raw.y, deskewed.y);
+      EXPECT_FLOAT_EQ(raw.z, deskewed.z);
+    }
+  }
+}
+
+// Each point has to be moved by the sensor motion since the scan timestamp. The decoder uses the
+// time of the point's return group, which differs from the point's own time by up to about 50 us,
+// i.e. 1 mm at 20 m/s.
+TEST(DeskewTest, TestPointsAreMovedToScanStart)
+{
+  SensorTwist twist;
+  twist.linear = {20, 1, 0};
+  twist.angular = {0, 0.05, 0.5};
+
+  auto raw_clouds = decode_rotations(false, std::nullopt);
+  ASSERT_GE(raw_clouds.size(), 3U);
+  for (bool use_generic_return_kernel : {false, true}) {
+    auto deskewed_clouds = decode_rotations(true, twist, use_generic_return_kernel);
+    ASSERT_EQ(raw_clouds.size(), deskewed_clouds.size());
+
+    float max_correction = 0;
+    // The first two scans contain points decoded before the scan timestamp was known
+    for (size_t i = 2; i < raw_clouds.size(); ++i) {
+      ASSERT_EQ(raw_clouds[i].points.size(), deskewed_clouds[i].points.size());
+      for (size_t j = 0; j < raw_clouds[i].points.size(); ++j) {
+        const auto & raw = raw_clouds[i].points[j];
+        const auto & deskewed = deskewed_clouds[i].points[j];
+        EXPECT_EQ(raw.time_stamp, deskewed.time_stamp);
+        EXPECT_EQ(raw.azimuth, deskewed.azimuth);
+
+        auto motion = RigidTransform::from_twist(twist, raw.time_stamp * 1e-9);
+        expect_near(
+          apply(motion, {raw.x, raw.y, raw.z}), {deskewed.x, deskewed.y, deskewed.z}, 2e-3);
+        max_correction = std::max(max_correction, std::abs(deskewed.x - raw.x));
+      }
+    }
+
+    // At 20 m/s, the end of a 100 ms scan moves by about 2 m
+    EXPECT_GT(max_correction, 1.5);
+  }
+}
+
+TEST(DeskewTest, TestParallelMatchesSequential)
+{
+  SensorTwist twist;
+  twist.linear = {10, 0, 0};
+  twist.angular = {0, 0, -0.3};
+
+  auto config = make_synthetic_config();
+  config.deskew = true;
+  expect_parallel_matches_sequential(
+    config, [&](auto & driver) { driver.set_sensor_twist(twist); });
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
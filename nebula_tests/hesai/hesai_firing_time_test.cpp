@@ -0,0 +1,481 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_128e3x.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_128e4x.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_40.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_64.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_at128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_qt128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_qt64.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32m.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+namespace hesai_packet = nebula::drivers::hesai_packet;
+
+// The reference implementations below compute the time offset of each point on the fly, the way
+// the sensors did before their offsets were generated as tables
+
+struct Pandar40Reference : public drivers::Pandar40
+{
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = -28580 - 55560 * ((10 - block_id - 1) / n_returns);
+    return block_offset_ns + firing_time_offset_ns_[channel_id];
+  }
+};
+
+struct Pandar64Reference : public drivers::Pandar64
+{
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = -42580 - 55560 * ((6 - block_id - 1) / n_returns);
+    return block_offset_ns + firing_time_offset_ns[channel_id];
+  }
+};
+
+struct PandarQT64Reference : public drivers::PandarQT64
+{
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = 25710 + (500000 * (block_id / n_returns)) / 3;
+    return block_offset_ns + firing_time_offset_ns[channel_id];
+  }
+};
+
+struct PandarQT128Reference : public drivers::PandarQT128
+{
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = 9000 + 111110 * (2 - block_id - 1) / n_returns;
+
+    int channel_offset_ns = 0;
+    if (n_returns == 1) {
+      channel_offset_ns = block_id % 2 == 0 ? loop1[channel_id] : loop2[channel_id];
+    } else {
+      channel_offset_ns = packet.tail.mode_flag & 0x01 ? loop1[channel_id] : loop2[channel_id];
+    }
+
+    return block_offset_ns + channel_offset_ns;
+  }
+};
+
+struct PandarXT32Reference : public drivers::PandarXT32
+{
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = 5632 - 50000 * ((8 - block_id - 1) / n_returns);
+    int channel_offset_ns = 368 + 1512 * channel_id;
+    return block_offset_ns + channel_offset_ns;
+  }
+};
+
+struct PandarXT32MReference : public drivers::PandarXT32M
+{
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = 0;
+    if (n_returns < 3) {
+      block_offset_ns = 5632 - 50000 * ((8 - block_id - 1) / n_returns);
+    } else /* n_returns == 3 */ {
+      block_offset_ns = 5632 - 50000 * ((6 - block_id - 1) / 3);
+    }
+
+    if (channel_id >= 16) {
+      channel_id -= 16;
+    }
+    int channel_offset_ns = 368 + 2888 * channel_id;
+
+    return block_offset_ns + channel_offset_ns;
+  }
+};
+
+struct PandarAT128Reference : public drivers::PandarAT128
+{
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = 0;
+    if (n_returns == 1) {
+      block_offset_ns = -9249 - 41666 * (2 - block_id);
+    } else {
+      block_offset_ns = -9249 - 41666;
+    }
+
+    return block_offset_ns + firing_time_offset_ns[channel_id];
+  }
+};
+
+struct Pandar128E4XReference : public drivers::Pandar128E4X
+{
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = 0;
+    if (n_returns == 1) {
+      block_offset_ns = -27778 * 2 * (2 - block_id - 1);
+    } else {
+      block_offset_ns = 0;
+    }
+
+    int channel_offset_ns = 0;
+    bool is_hires_mode = packet.tail.operational_state == OperationalState::HIGH_RESOLUTION;
+    auto azimuth_state = packet.tail.get_azimuth_state(block_id);
+
+    if (!is_hires_mode) {
+      channel_offset_ns = firing_time_offset_static_ns[channel_id];
+    } else {
+      if (azimuth_state == 0) {
+        channel_offset_ns = firing_time_offset_as0_ns[channel_id];
+      } else /* azimuth_state == 1 */ {
+        channel_offset_ns = firing_time_offset_as1_ns[channel_id];
+      }
+    }
+
+    return block_offset_ns + 43346 + channel_offset_ns;
+  }
+};
+
+struct Pandar128E3XReference : public drivers::Pandar128E3X
+{
+  using drivers::Pandar128E3X::OperationalState;
+
+  /// @brief Whether the sensor fires the unit in the near field sequence
+  static bool is_near_field(uint32_t raw_distance, const packet_t & packet)
+  {
+    return hesai_packet::get_dis_unit(packet) * raw_distance <= 2.85f;
+  }
+
+  static int get_offset_ns(uint32_t block_id, uint32_t channel_id, const packet_t & packet)
+  {
+    auto n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+    int block_offset_ns = 3148 - 27778 * 2 * (2 - block_id - 1) / n_returns;
+
+    int channel_offset_ns = 0;
+    bool is_hires_mode = packet.tail.operational_state == OperationalState::HIGH_RESOLUTION;
+    bool is_nearfield =
+      is_near_field(packet.body.blocks[block_id].units[channel_id].distance, packet);
+    auto azimuth_state = packet.tail.get_azimuth_state(block_id);
+
+    if (is_hires_mode && azimuth_state == 0 && !is_nearfield)
+      channel_offset_ns = hires_as0_far_offset_ns[channel_id];
+    else if (is_hires_mode && azimuth_state == 0 && is_nearfield)
+      channel_offset_ns = hires_as0_near_offset_ns[channel_id];
+    else if (is_hires_mode && azimuth_state == 1 && !is_nearfield)
+      channel_offset_ns = hires_as1_far_offset_ns[channel_id];
+    else if (is_hires_mode && azimuth_state == 1 && is_nearfield)
+      channel_offset_ns = hires_as1_near_offset_ns[channel_id];
+    else if (is_hires_mode && azimuth_state == 2 && !is_nearfield)
+      channel_offset_ns = hires_as2_far_offset_ns[channel_id];
+    else if (is_hires_mode && azimuth_state == 2 && is_nearfield)
+      channel_offset_ns = hires_as2_near_offset_ns[channel_id];
+    else if (is_hires_mode && azimuth_state == 3 && !is_nearfield)
+      channel_offset_ns = hires_as3_far_offset_ns[channel_id];
+    else if (is_hires_mode && azimuth_state == 3 && is_nearfield)
+      channel_offset_ns = hires_as3_near_offset_ns[channel_id];
+    else if (!is_hires_mode && azimuth_state == 0 && !is_nearfield)
+      channel_offset_ns = standard_as0_far_offset_ns[channel_id];
+    else if (!is_hires_mode && azimuth_state == 0 && is_nearfield)
+      channel_offset_ns = standard_as0_near_offset_ns[channel_id];
+    else if (!is_hires_mode && azimuth_state == 1 && !is_nearfield)
+      channel_offset_ns = standard_as1_far_offset_ns[channel_id];
+    else if (!is_hires_mode && azimuth_state == 1 && is_nearfield)
+      channel_offset_ns = standard_as1_near_offset_ns[channel_id];
+    else
+      throw std::runtime_error(
+        "Invalid combination of operational state and azimuth state and nearfield firing");
+
+    return block_offset_ns + channel_offset_ns;
+  }
+};
+
+constexpr hesai_packet::return_mode::ReturnMode g_return_modes[] = {
+  hesai_packet::return_mode::SINGLE_FIRST,
+  hesai_packet::return_mode::SINGLE_SECOND,
+  hesai_packet::return_mode::SINGLE_STRONGEST,
+  hesai_packet::return_mode::SINGLE_LAST,
+  hesai_packet::return_mode::DUAL_LAST_STRONGEST,
+  hesai_packet::return_mode::DUAL_FIRST_SECOND,
+  hesai_packet::return_mode::DUAL_FIRST_LAST,
+  hesai_packet::return_mode::DUAL_FIRST_STRONGEST,
+  hesai_packet::return_mode::DUAL_STRONGEST_SECONDSTRONGEST,
+  hesai_packet::return_mode::TRIPLE_FIRST_LAST_STRONGEST};
+
+/// @brief The offsets selected for `packet` have to match the reference for every point, and the
+/// earliest offset of each return group has to be the lowest reference offset in it
+template <typename SensorT, typename ReferenceT>
+void expect_matches_reference(const typename SensorT::packet_t & packet)
+{
+  using packet_t = typename SensorT::packet_t;
+
+  SensorT sensor;
+  typename SensorT::PacketTimeOffsets offsets;
+  ASSERT_TRUE(sensor.get_packet_time_offsets(packet, offsets));
+
+  std::vector<int> block_min_offsets_ns(packet_t::n_blocks, 0x7FFFFFFF);
+  for (uint32_t block_id = 0; block_id < packet_t::n_blocks; ++block_id) {
+    const auto & units = packet.body.blocks[block_id].units;
+    for (uint32_t channel_id = 0; channel_id < packet_t::n_channels; ++channel_id) {
+      int expected_ns = ReferenceT::get_offset_ns(block_id, channel_id, packet);
+      ASSERT_EQ(offsets.get(block_id, channel_id, units[channel_id].distance), expected_ns)
+        << "return mode " << static_cast<int>(packet.tail.return_mode) << ", block " << block_id
+        << ", channel " << channel_id;
+      block_min_offsets_ns[block_id] = std::min(block_min_offsets_ns[block_id], expected_ns);
+    }
+  }
+
+  const uint32_t n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+  for (uint32_t block_id = 0; block_id + n_returns <= packet_t::n_blocks; block_id += n_returns) {
+    int expected_ns = *std::min_element(
+      block_min_offsets_ns.begin() + block_id, block_min_offsets_ns.begin() + block_id + n_returns);
+    EXPECT_EQ(
+      SensorT::get_earliest_point_time_offset_for_block(block_id, packet, offsets), expected_ns)
+      << "return mode " << static_cast<int>(packet.tail.return_mode) << ", block " << block_id;
+  }
+}
+
+/// @brief Check `packet` against the reference in all return modes, with random distances
+/// @param set_up Called with the packet to set sensor specific fields, if set
+template <typename SensorT, typename ReferenceT>
+void check_all_return_modes(
+  const std::function<void(typename SensorT::packet_t &)> & set_up = nullptr)
+{
+  using packet_t = typename SensorT::packet_t;
+
+  std::mt19937 rng(42);
+  std::vector<uint8_t> buffer(sizeof(packet_t));
+  auto & packet = *reinterpret_cast<packet_t *>(buffer.data());
+  for (auto & block : packet.body.blocks) {
+    for (auto & unit : block.units) {
+      unit.distance = rng() % 2000;
+    }
+  }
+
+  for (auto return_mode : g_return_modes) {
+    packet.tail.return_mode = return_mode;
+    if (set_up) {
+      set_up(packet);
+    }
+    expect_matches_reference<SensorT, ReferenceT>(packet);
+  }
+}
+
+TEST(FiringTimeTest, TestPandar40)
+{
+  check_all_return_modes<drivers::Pandar40, Pandar40Reference>();
+}
+
+TEST(FiringTimeTest, TestPandar64)
+{
+  check_all_return_modes<drivers::Pandar64, Pandar64Reference>();
+}
+
+TEST(FiringTimeTest, TestPandarQT64)
+{
+  check_all_return_modes<drivers::PandarQT64, PandarQT64Reference>();
+}
+
+TEST(FiringTimeTest, TestPandarQT128)
+{
+  for (uint8_t mode_flag : {0, 1, 2, 3}) {
+    check_all_return_modes<drivers::PandarQT128, PandarQT128Reference>(
+      [&](auto & packet) { packet.tail.mode_flag = mode_flag; });
+  }
+}
+
+TEST(FiringTimeTest, TestPandarXT32)
+{
+  check_all_return_modes<drivers::PandarXT32, PandarXT32Reference>();
+}
+
+TEST(FiringTimeTest, TestPandarXT32M)
+{
+  check_all_return_modes<drivers::PandarXT32M, PandarXT32MReference>();
+}
+
+TEST(FiringTimeTest, TestPandarAT128)
+{
+  check_all_return_modes<drivers::PandarAT128, PandarAT128Reference>();
+}
+
+// Azimuth states 2 and 3 are decoded like azimuth state 1
+TEST(FiringTimeTest, TestPandar128E4X)
+{
+  for (uint8_t operational_state : {0, 1}) {
+    for (uint16_t azimuth_state = 0; azimuth_state < 16; ++azimuth_state) {
+      check_all_return_modes<drivers::Pandar128E4X, Pandar128E4XReference>([&](auto & packet) {
+        packet.tail.operational_state = operational_state;
+        packet.tail.azimuth_state = azimuth_state << 12;
+      });
+    }
+  }
+}
+
+// In high resolution mode, all azimuth states are valid. In the other operational states, only
+// azimuth states 0 and 1 are. With a distance unit of 4 mm, units up to a raw distance of 712 are
+// fired in the near field.
+TEST(FiringTimeTest, TestPandar128E3X)
+{
+  using OperationalState = Pandar128E3XReference::OperationalState;
+
+  for (uint16_t azimuth_state = 0; azimuth_state < 16; ++azimuth_state) {
+    check_all_return_modes<drivers::Pandar128E3X, Pandar128E3XReference>([&](auto & packet) {
+      packet.header.dis_unit = 4;
+      packet.tail.operational_state = OperationalState::HIGH_RESOLUTION;
+      packet.tail.azimuth_state = azimuth_state << 12;
+    });
+  }
+
+  for (uint8_t operational_state :
+       {OperationalState::SHUTDOWN, OperationalState::STANDARD, OperationalState::ENERGY_SAVING}) {
+    for (uint16_t azimuth_state : {0b0000, 0b0001, 0b0100, 0b0101}) {
+      check_all_return_modes<drivers::Pandar128E3X, Pandar128E3XReference>([&](auto & packet) {
+        packet.header.dis_unit = 4;
+        packet.tail.operational_state = operational_state;
+        packet.tail.azimuth_state = azimuth_state << 12;
+      });
+    }
+  }
+}
+
+// Whether a unit is fired in the near field is decided on its raw distance. This has to match
+// converting the distance to meters for all distance units and raw distances.
+TEST(FiringTimeTest, TestPandar128E3XNearFieldThreshold)
+{
+  using packet_t = hesai_packet::Packet128E3X;
+
+  drivers::Pandar128E3X sensor;
+  packet_t packet{};
+  packet.tail.return_mode = hesai_packet::return_mode::SINGLE_STRONGEST;
+
+  for (int dis_unit = 0; dis_unit < 256; ++dis_unit) {
+    packet.header.dis_unit = dis_unit;
+
+    drivers::Pandar128E3X::PacketTimeOffsets offsets;
+    ASSERT_TRUE(sensor.get_packet_time_offsets(packet, offsets));
+    for (uint32_t raw_distance = 0; raw_distance <= 0xFFFF; ++raw_distance) {
+      ASSERT_EQ(
+        raw_distance <= offsets.max_near_field_distance,
+        Pandar128E3XReference::is_near_field(raw_distance, packet))
+        << "dis_unit " << dis_unit << ", raw distance " << raw_distance;
+    }
+  }
+}
+
+// Outside of high resolution mode, azimuth states 2 and 3 are invalid in any block
+TEST(FiringTimeTest, TestPandar128E3XInvalidAzimuthState)
+{
+  using packet_t = hesai_packet::Packet128E3X;
+  using OperationalState = Pandar128E3XReference::OperationalState;
+
+  drivers::Pandar128E3X sensor;
+  packet_t packet{};
+  packet.tail.return_mode = hesai_packet::return_mode::DUAL_LAST_STRONGEST;
+  packet.tail.operational_state = OperationalState::STANDARD;
+
+  for (uint16_t azimuth_state = 0; azimuth_state < 16; ++azimuth_state) {
+    packet.tail.azimuth_state = azimuth_state << 12;
+    const bool is_valid =
+      packet.tail.get_azimuth_state(0) < 2 && packet.tail.get_azimuth_state(1) < 2;
+
+    drivers::Pandar128E3X::PacketTimeOffsets offsets;
+    EXPECT_EQ(sensor.get_packet_time_offsets(packet, offsets), is_valid) << azimuth_state;
+    if (!is_valid) {
+      EXPECT_THROW(sensor.get_packet_relative_point_time_offset(0, 0, packet), std::runtime_error);
+    }
+  }
+}
+
+// Packets the sensor has no firing times for are rejected by the decoder instead of throwing, and
+// decoding continues with the next packet
+TEST(FiringTimeTest, TestDecoderRejectsUnsupportedModes)
+{
+  using packet_t = hesai_packet::Packet128E3X;
+  using OperationalState = Pandar128E3XReference::OperationalState;
+  constexpr uint32_t packets_per_rotation = 1800;
+  constexpr uint32_t azimuth_step = 36000 / (packets_per_rotation * packet_t::n_blocks);
+
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/Pandar128E4X.csv";
+  ASSERT_EQ(calibration->load_from_file(calibration_path), Status::OK);
+
+  drivers::HesaiSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::HESAI_PANDAR128_E3X;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "hesai";
+  config.min_range = 0.1;
+  config.max_range = 300;
+  config.cloud_min_angle = 0;
+  config.cloud_max_angle = 360;
+  config.cut_angle = 0;
+
+  drivers::HesaiDriver driver(
+    std::make_shared<const drivers::HesaiSensorConfiguration>(config), calibration);
+  ASSERT_EQ(driver.get_status(), Status::OK);
+
+  std::vector<uint8_t> buffer(sizeof(packet_t));
+  auto & packet = *reinterpret_cast<packet_t *>(buffer.data());
+  packet.header.dis_unit = 4;
+  for (auto & block : packet.body.blocks) {
+    for (auto & unit : block.units) {
+      unit.distance = 1000;
+    }
+  }
+
+  size_t n_scans = 0;
+  for (uint32_t packet_id = 0; packet_id < 3 * packets_per_rotation; ++packet_id) {
+    uint32_t azimuth = packet_id * packet_t::n_blocks * azimuth_step;
+    for (auto & block : packet.body.blocks) {
+      block.azimuth = azimuth % 36000;
+      azimuth += azimuth_step;
+    }
+    packet.tail.timestamp = packet_id * 56;
+
+    // Every 10th packet has azimuth state 2, which the standard mode does not have, every 10th but
+    // one an unknown return mode
+    packet.tail.return_mode = packet_id % 10 == 1 ? 0 : hesai_packet::return_mode::SINGLE_STRONGEST;
+    packet.tail.operational_state = OperationalState::STANDARD;
+    packet.tail.azimuth_state = packet_id % 10 == 0 ? 0b1000'0000'0000'0000 : 0;
+
+    drivers::NebulaPointCloudPtr pointcloud;
+    ASSERT_NO_THROW(pointcloud = std::get<0>(driver.parse_cloud_packet(buffer)));
+    if (pointcloud) {
+      EXPECT_GT(pointcloud->size(), 0U);
+      ++n_scans;
+    }
+  }
+
+  EXPECT_GE(n_scans, 2U);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,239 @@
+// Copyright 2024 TIER IV, Inc.
+
+// Compares the two ways the ROS wrapper decodes received packets: queued (the receiving thread
+// copies each packet into a slot of an `SpscQueue`, which the decoder thread decodes it from)
+// and inline (the receiving thread decodes the packet right away). Packets are received at fixed
+// rates, and the latency from receiving a packet to having decoded it, the latency from receiving
+// the last packet of a scan to having the scan, and the time the receiving thread is busy per
+// packet are reported.
+//
+// Usage: hesai_inline_decode_benchmark [n_rotations]
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_common/util/span.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp>
+#include <nebula_ros/common/spsc_queue.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nebula::test
+{
+
+using Clock = std::chrono::steady_clock;
+namespace hesai_packet = nebula::drivers::hesai_packet;
+
+using packet_t = hesai_packet::PacketXT32;
+constexpr uint32_t g_packets_per_rotation = 450;
+
+struct Packet
+{
+  Clock::time_point receive_time;
+  std::vector<uint8_t> data;
+  bool is_last{false};
+};
+
+struct Latencies
+{
+  std::vector<double> packet_us;
+  std::vector<double> scan_us;
+  std::vector<double> receive_us;
+};
+
+double elapsed_us(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+double percentile(std::vector<double> & values, double p)
+{
+  if (values.empty()) {
+    return 0;
+  }
+  auto it = values.begin() + static_cast<ptrdiff_t>(p * (values.size() - 1));
+  std::nth_element(values.begin(), it, values.end());
+  return *it;
+}
+
+std::vector<std::vector<uint8_t>> make_packets(size_t n_rotations)
+{
+  constexpr uint32_t azimuth_step = 36000 / (g_packets_per_rotation * packet_t::n_blocks);
+
+  std::vector<uint8_t> buffer(sizeof(packet_t));
+  auto & packet = *reinterpret_cast<packet_t *>(buffer.data());
+  packet.header.dis_unit = 4;
+  packet.tail.return_mode = hesai_packet::return_mode::SINGLE_STRONGEST;
+  packet.tail.date_time.year = 124;
+  packet.tail.date_time.month = 1;
+  packet.tail.date_time.day = 1;
+
+  std::vector<std::vector<uint8_t>> packets;
+  for (uint32_t packet_id = 0; packet_id < n_rotations * g_packets_per_rotation; ++packet_id) {
+    uint32_t azimuth = packet_id * packet_t::n_blocks * azimuth_step;
+    for (auto & block : packet.body.blocks) {
+      block.azimuth = azimuth % 36000;
+      azimuth += azimuth_step;
+      for (size_t channel = 0; channel < packet_t::n_channels; ++channel) {
+        block.units[channel].distance = 500 + (packet_id + channel) % 1000;
+        block.units[channel].reflectivity = channel;
+      }
+    }
+    packet.udp_sequence = packet_id;
+    packet.tail.timestamp = packet_id * 222;
+    packets.push_back(buffer);
+  }
+
+  return packets;
+}
+
+std::unique_ptr<drivers::HesaiDriver> make_driver()
+{
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarXT32.csv";
+  if (calibration->load_from_file(calibration_path) != Status::OK) {
+    std::fprintf(stderr, "Could not load %s\n", calibration_path.c_str());
+    std::exit(1);
+  }
+
+  drivers::HesaiSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::HESAI_PANDARXT32;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "hesai";
+  config.min_range = 0.1;
+  config.max_range = 300;
+  config.cloud_min_angle = 0;
+  config.cloud_max_angle = 360;
+  config.cut_angle = 0;
+
+  return std::make_unique<drivers::HesaiDriver>(
+    std::make_shared<const drivers::HesaiSensorConfiguration>(config), calibration);
+}
+
+/// @brief Receive all packets at `packets_per_s` and decode them either on the receiving thread or
+/// on a decoder thread fed through a queue
+Latencies benchmark_mode(
+  const std::vector<std::vector<uint8_t>> & packets, double packets_per_s, bool inline_decode)
+{
+  constexpr size_t max_batch_size = 128;
+
+  auto driver = make_driver();
+  std::mutex mtx_driver;
+  Latencies latencies;
+  latencies.packet_us.reserve(packets.size());
+  latencies.receive_us.reserve(packets.size());
+
+  SpscQueue<Packet> queue(3000);
+  std::thread decoder_thread;
+  if (!inline_decode) {
+    decoder_thread = std::thread([&]() {
+      std::vector<util::span<const uint8_t>> spans;
+      drivers::UnpackedPackets unpacked;
+      bool is_done = false;
+      while (!is_done) {
+        size_t n_packets = queue.wait_for_values(max_batch_size);
+        spans.clear();
+        for (size_t i = 0; i < n_packets; ++i) {
+          if (queue.peek(i).is_last) {
+            n_packets = i;
+            is_done = true;
+            break;
+          }
+          spans.emplace_back(queue.peek(i).data);
+        }
+
+        unpacked.clear();
+        {
+          std::lock_guard lock(mtx_driver);
+          driver->parse_cloud_packets(spans, unpacked);
+        }
+
+        for (size_t i = 0; i < n_packets; ++i) {
+          latencies.packet_us.push_back(elapsed_us(queue.peek(i).receive_time));
+        }
+        for (const auto & scan : unpacked.scans) {
+          latencies.scan_us.push_back(elapsed_us(queue.peek(scan.packet_index).receive_time));
+        }
+        queue.release(n_packets);
+      }
+    });
+  }
+
+  const auto start = Clock::now();
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const auto due = start + std::chrono::duration_cast<Clock::duration>(
+                               std::chrono::duration<double>(i / packets_per_s));
+    while (Clock::now() < due) {
+      std::this_thread::yield();
+    }
+
+    const auto receive_time = Clock::now();
+    if (inline_decode) {
+      std::lock_guard lock(mtx_driver);
+      auto [pointcloud, timestamp_s] = driver->parse_cloud_packet(packets[i]);
+      latencies.packet_us.push_back(elapsed_us(receive_time));
+      if (pointcloud) {
+        latencies.scan_us.push_back(elapsed_us(receive_time));
+      }
+    } else {
+      // The receive buffer is reused, so the packet is copied into a queue slot
+      auto * packet = queue.try_claim();
+      if (packet) {
+        packet->receive_time = receive_time;
+        packet->data.assign(packets[i].begin(), packets[i].end());
+        queue.commit();
+      }
+    }
+    latencies.receive_us.push_back(elapsed_us(receive_time));
+  }
+
+  if (!inline_decode) {
+    queue.claim().is_last = true;
+    queue.commit();
+    decoder_thread.join();
+    if (queue.n_dropped() > 0) {
+      std::printf("%zu packets dropped\n", queue.n_dropped());
+    }
+  }
+
+  return latencies;
+}
+
+void print_latencies(const char * name, Latencies latencies)
+{
+  std::printf(
+    "%-7s packet p50 %6.1f us p99 %7.1f us   scan p50 %6.1f us max %7.1f us   "
+    "receiver busy p50 %5.1f us p99 %6.1f us\n",
+    name, percentile(latencies.packet_us, 0.5), percentile(latencies.packet_us, 0.99),
+    percentile(latencies.scan_us, 0.5), percentile(latencies.scan_us, 1.),
+    percentile(latencies.receive_us, 0.5), percentile(latencies.receive_us, 0.99));
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  namespace test = nebula::test;
+
+  int n_rotations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+
+  const auto packets = test::make_packets(n_rotations);
+  for (double packets_per_s : {4500., 36000.}) {
+    std::printf("PandarXT32, %zu packets at %.0f packets/s\n", packets.size(), packets_per_s);
+    test::print_latencies("queued", test::benchmark_mode(packets, packets_per_s, false));
+    test::print_latencies("inline", test::benchmark_mode(packets, packets_per_s, true));
+    std::printf("\n");
+  }
+
+  return 0;
+}
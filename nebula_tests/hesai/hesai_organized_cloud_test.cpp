@@ -0,0 +1,221 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "hesai_common.hpp"
+
+#include <nebula_common/point_types.hpp>
+#include <nebula_decoders/nebula_decoders_common/organized_cloud_layout.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace nebula::test
+{
+
+using drivers::deg2rad;
+using drivers::NebulaPoint;
+using drivers::NebulaPointCloud;
+using drivers::OrganizedCloudLayout;
+
+TEST(OrganizedCloudLayoutTest, TestColumns)
+{
+  // Full circle, 1 column per degree
+  OrganizedCloudLayout full(4, 1, 360, 0, deg2rad(360.));
+  EXPECT_EQ(full.get_column(deg2rad(0.)), 0U);
+  EXPECT_EQ(full.get_column(deg2rad(0.5)), 0U);
+  EXPECT_EQ(full.get_column(deg2rad(1.5)), 1U);
+  EXPECT_EQ(full.get_column(deg2rad(359.5)), 359U);
+
+  // FoV across 0 deg, from 270 to 90 deg
+  OrganizedCloudLayout front(4, 1, 180, deg2rad(270.), deg2rad(90.));
+  EXPECT_EQ(front.get_column(deg2rad(270.5)), 0U);
+  EXPECT_EQ(front.get_column(deg2rad(0.5)), 90U);
+  EXPECT_EQ(front.get_column(deg2rad(89.5)), 179U);
+
+  // Outside of the FoV, clamped to the closer edge
+  EXPECT_EQ(front.get_column(deg2rad(100.)), 179U);
+  EXPECT_EQ(front.get_column(deg2rad(260.)), 0U);
+}
+
+TEST(OrganizedCloudLayoutTest, TestInsert)
+{
+  OrganizedCloudLayout layout(2, 1, 4, 0, 0);
+  NebulaPointCloud cloud;
+  cloud.emplace_back();
+  layout.reset(cloud);
+
+  ASSERT_EQ(cloud.points.size(), 8U);
+  EXPECT_EQ(cloud.width, 4U);
+  EXPECT_EQ(cloud.height, 2U);
+  EXPECT_FALSE(cloud.is_dense);
+  for (const auto & point : cloud.points) {
+    EXPECT_TRUE(OrganizedCloudLayout::is_empty(point));
+    EXPECT_TRUE(std::isnan(point.distance));
+  }
+
+  NebulaPoint point{};
+  point.channel = 1;
+  point.azimuth = deg2rad(100.);
+  point.distance = 1;
+  EXPECT_TRUE(layout.insert(cloud, point));
+  EXPECT_EQ(cloud.points[4 + 1].distance, 1);
+
+  // The first point in a cell is kept
+  point.distance = 2;
+  EXPECT_FALSE(layout.insert(cloud, point));
+  EXPECT_EQ(cloud.points[4 + 1].distance, 1);
+
+  // Channels without a row are dropped
+  point.channel = 2;
+  EXPECT_FALSE(layout.insert(cloud, point));
+}
+
+TEST(OrganizedCloudLayoutTest, TestInsertMultiReturn)
+{
+  OrganizedCloudLayout layout(2, 2, 4, 0, 0);
+  NebulaPointCloud cloud;
+  layout.reset(cloud);
+
+  ASSERT_EQ(cloud.points.size(), 16U);
+  EXPECT_EQ(cloud.width, 4U);
+  EXPECT_EQ(cloud.height, 4U);
+
+  // Each return of a channel has its own row, the rows of a return are contiguous
+  NebulaPoint point{};
+  point.channel = 1;
+  point.azimuth = deg2rad(100.);
+  point.distance = 1;
+  EXPECT_TRUE(layout.insert(cloud, point, 0));
+  point.distance = 2;
+  EXPECT_TRUE(layout.insert(cloud, point, 1));
+  EXPECT_EQ(cloud.points[1 * 4 + 1].distance, 1);
+  EXPECT_EQ(cloud.points[3 * 4 + 1].distance, 2);
+
+  // Returns without a row are dropped
+  EXPECT_FALSE(layout.insert(cloud, point, 2));
+}
+
+std::vector<NebulaPointCloud> decode_rotations(
+  uint16_t organized_cloud_columns,
+  drivers::ReturnMode return_mode = drivers::ReturnMode::SINGLE_STRONGEST)
+{
+  auto config = make_synthetic_config();
+  config.return_mode = return_mode;
+  config.organized_cloud_columns = organized_cloud_columns;
+  return decode_synthetic_scans(config);
+}
+
+// Every cell of the organized cloud has to hold the first point of the unorganized cloud that
+// falls into it, and cells without any points have to be empty
+TEST(OrganizedCloudTest, TestMatchesUnorganizedCloud)
+{
+  constexpr uint32_t n_columns = 1000;
+  auto unorganized_clouds = decode_rotations(0);
+  auto organized_clouds = decode_rotations(n_columns);
+  ASSERT_EQ(unorganized_clouds.size(), organized_clouds.size());
+  ASSERT_GE(unorganized_clouds.size(), 2U);
+
+  OrganizedCloudLayout layout(32, 1, n_columns, 0, 0);
+  for (size_t i = 0; i < unorganized_clouds.size(); ++i) {
+    const auto & unorganized = unorganized_clouds[i];
+    const auto & organized = organized_clouds[i];
+    ASSERT_EQ(organized.height, 32U);
+    ASSERT_EQ(organized.width, n_columns);
+    ASSERT_EQ(organized.points.size(), 32U * n_columns);
+
+    NebulaPointCloud expected;
+    layout.reset(expected);
+    for (const auto & point : unorganized.points) {
+      layout.insert(expected, point);
+    }
+
+    size_t n_filled = 0;
+    for (size_t cell = 0; cell < expected.points.size(); ++cell) {
+      const auto & expected_point = expected.points[cell];
+      const auto & point = organized.points[cell];
+      bool is_empty = OrganizedCloudLayout::is_empty(point);
+      ASSERT_EQ(is_empty, OrganizedCloudLayout::is_empty(expected_point));
+      if (is_empty) continue;
+
+      ++n_filled;
+      EXPECT_EQ(std::memcmp(&point, &expected_point, sizeof(point)), 0);
+      EXPECT_EQ(point.channel, cell / n_columns);
+    }
+
+    // The first scan is partial. The full ones have 3600 azimuths, so every cell gets a point.
+    if (i > 0) {
+      EXPECT_EQ(n_filled, 32U * n_columns);
+    }
+  }
+}
+
+// In dual return mode, the rows of the second returns follow the ones of the first returns, and
+// every return of the unorganized cloud has to be in the cell of its channel and return
+TEST(OrganizedCloudTest, TestDualReturn)
+{
+  constexpr uint32_t n_columns = 1000;
+  constexpr auto return_mode = drivers::ReturnMode::DUAL_LAST_STRONGEST;
+  auto unorganized_clouds = decode_rotations(0, return_mode);
+  auto organized_clouds = decode_rotations(n_columns, return_mode);
+  ASSERT_EQ(unorganized_clouds.size(), organized_clouds.size());
+  ASSERT_GE(unorganized_clouds.size(), 2U);
+
+  OrganizedCloudLayout layout(32, 2, n_columns, 0, 0);
+  for (size_t i = 0; i < unorganized_clouds.size(); ++i) {
+    const auto & organized = organized_clouds[i];
+    ASSERT_EQ(organized.height, 64U);
+    ASSERT_EQ(organized.width, n_columns);
+
+    // The first block of each return group holds the last return, the second the strongest one
+    NebulaPointCloud expected;
+    layout.reset(expected);
+    for (const auto & point : unorganized_clouds[i].points) {
+      auto return_type = static_cast<drivers::ReturnType>(point.return_type);
+      bool is_first_block = return_type == drivers::ReturnType::LAST ||
+                            return_type == drivers::ReturnType::LAST_STRONGEST;
+      layout.insert(expected, point, is_first_block ? 0 : 1);
+    }
+
+    std::array<size_t, 2> n_filled{};
+    for (size_t cell = 0; cell < expected.points.size(); ++cell) {
+      const auto & point = organized.points[cell];
+      bool is_empty = OrganizedCloudLayout::is_empty(point);
+      ASSERT_EQ(is_empty, OrganizedCloudLayout::is_empty(expected.points[cell]));
+      if (is_empty) continue;
+
+      size_t row = cell / n_columns;
+      ++n_filled[row / 32];
+      EXPECT_EQ(std::memcmp(&point, &expected.points[cell], sizeof(point)), 0);
+      EXPECT_EQ(point.channel, row % 32);
+    }
+
+    // In every third channel, both returns are identical and only the second one is kept
+    if (i > 0) {
+      EXPECT_EQ(n_filled[0], 21U * n_columns);
+      EXPECT_EQ(n_filled[1], 32U * n_columns);
+    }
+  }
+}
+
+TEST(OrganizedCloudTest, TestParallelMatchesSequential)
+{
+  auto config = make_synthetic_config();
+  config.organized_cloud_columns = 720;
+  expect_parallel_matches_sequential(config);
+
+  config.return_mode = drivers::ReturnMode::DUAL_LAST_STRONGEST;
+  expect_parallel_matches_sequential(config);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "hesai_common.hpp"
+
+#include <nebula_common/point_types.hpp>
+#include <nebula_decoders/nebula_decoders_common/rigid_transform.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace nebula::test
+{
+
+using drivers::NebulaPointCloud;
+using drivers::RigidTransform;
+using drivers::SensorTwist;
+
+const std::vector<double> g_sensor_pose{1.5, -0.2, 1.8, 0.02, -0.1, 1.2};
+
+std::array<float, 3> transform_point(
+  const RigidTransform & transform, std::array<float, 3> point)
+{
+  transform.apply(point[0], point[1], point[2]);
+  return point;
+}
+
+void expect_near(const std::array<float, 3> & a, const std::array<float, 3> & b, float tolerance)
+{
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_NEAR(a[i], b[i], tolerance) << "at index " << i;
+  }
+}
+
+TEST(RigidTransformTest, TestFromPose)
+{
+  // A sensor 1 m ahead of the origin, looking to the left
+  auto transform = RigidTransform::from_pose(1, 0, 0, 0, 0, M_PI / 2);
+  expect_near(transform_point(transform, {1, 0, 0}), {1, 1, 0}, 1e-6);
+  expect_near(transform_point(transform, {0, 1, 0}), {0, 0, 0}, 1e-6);
+
+  // Roll is applied first, then pitch, then yaw
+  auto rotation = RigidTransform::from_pose(0, 0, 0, M_PI / 2, M_PI / 2, 0);
+  expect_near(transform_point(rotation, {0, 1, 0}), {1, 0, 0}, 1e-6);
+}
+
+TEST(RigidTransformTest, TestComposition)
+{
+  auto a = RigidTransform::from_pose(1, 2, 3, 0.3, -0.2, 0.1);
+  auto b = RigidTransform::from_pose(-0.5, 0, 4, 0, 0.4, -1);
+  const std::array<float, 3> point{3, -1, 2};
+
+  expect_near(
+    transform_point(a * b, point), transform_point(a, transform_point(b, point)), 1e-5);
+  expect_near(transform_point(a * a.inverse(), point), point, 1e-5);
+}
+
+std::vector<NebulaPointCloud> decode_rotations(
+  const std::vector<double> & output_transform, const std::optional<SensorTwist> & twist,
+  bool use_generic_return_kernel = false)
+{
+  auto config = make_synthetic_config();
+  config.use_generic_return_kernel = use_generic_return_kernel;
+  config.deskew = twist.has_value();
+  config.output_frame = output_transform.empty() ? "" : "base_link";
+  config.output_transform = output_transform;
+  return decode_synthetic_scans(config, [&](auto & driver) {
+    if (twist) {
+      driver.set_sensor_twist(*twist);
+    }
+  });
+}
+
+// Transforming while decoding has to give the same points as transforming the decoded cloud
+TEST(OutputTransformTest, TestMatchesTransformingAfterwards)
+{
+  auto sensor_to_output = RigidTransform::from_pose(
+    g_sensor_pose[0], g_sensor_pose[1], g_sensor_pose[2], g_sensor_pose[3], g_sensor_pose[4],
+    g_sensor_pose[5]);
+
+  auto raw_clouds = decode_rotations({}, std::nullopt);
+  ASSERT_GE(raw_clouds.size(), 2U);
+  for (bool use_generic_return_kernel : {false, true}) {
+    auto transformed_clouds =
+      decode_rotations(g_sensor_pose, std::nullopt, use_generic_return_kernel);
+    ASSERT_EQ(raw_clouds.size(), transformed_clouds.size());
+
+    for (size_t i = 0; i < raw_clouds.size(); ++i) {
+      ASSERT_EQ(raw_clouds[i].points.size(), transformed_clouds[i].points.size());
+      for (size_t j = 0; j < raw_clouds[i].points.size(); ++j) {
+        const auto & raw = raw_clouds[i].points[j];
+        const auto & transformed = transformed_clouds[i].points[j];
+        EXPECT_EQ(raw.distance, transformed.distance);
+        EXPECT_EQ(raw.azimuth, transformed.azimuth);
+        expect_near(
+          transform_point(sensor_to_output, {raw.x, raw.y, raw.z}),
+          {transformed.x, transformed.y, transformed.z}, 1e-4);
+      }
+    }
+  }
+}
+
+// With deskew, points are first moved to the sensor pose at the scan timestamp, then to the output
+// frame. See the deskew test for the tolerance.
+TEST(OutputTransformTest, TestComposesWithDeskew)
+{
+  SensorTwist twist;
+  twist.linear = {15, 0, 0};
+  twist.angular = {0, 0, 0.4};
+  auto sensor_to_output = RigidTransform::from_pose(
+    g_sensor_pose[0], g_sensor_pose[1], g_sensor_pose[2], g_sensor_pose[3], g_sensor_pose[4],
+    g_sensor_pose[5]);
+
+  auto raw_clouds = decode_rotations({}, std::nullopt);
+  auto transformed_clouds = decode_rotations(g_sensor_pose, twist);
+  ASSERT_EQ(raw_clouds.size(), transformed_clouds.size());
+  ASSERT_GE(raw_clouds.size(), 3U);
+
+  // The first two scans contain points decoded before the scan timestamp was known
+  for (size_t i = 2; i < raw_clouds.size(); ++i) {
+    ASSERT_EQ(raw_clouds[i].points.size(), transformed_clouds[i].points.size());
+    for (size_t j = 0; j < raw_clouds[i].points.size(); ++j) {
+      const auto & raw = raw_clouds[i].points[j];
+      const auto & transformed = transformed_clouds[i].points[j];
+      auto motion = RigidTransform::from_twist(twist, raw.time_stamp * 1e-9);
+      expect_near(
+        transform_point(sensor_to_output * motion, {raw.x, raw.y, raw.z}),
+        {transformed.x, transformed.y, transformed.z}, 2e-3);
+    }
+  }
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
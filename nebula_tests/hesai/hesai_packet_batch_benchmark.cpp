@@ -0,0 +1,169 @@
+// Copyright 2024 TIER IV, Inc.
+
+// Measures the decoding time per packet when packets are passed to the driver one at a time, the
+// way the decoder wrapper used to (locking the driver and querying the sectors and scan metadata
+// per packet), and in batches of different sizes through `parse_cloud_packets`, the way bursts of
+// packets delivered at once are handled now. With a narrow FoV, hardly any points are converted,
+// which leaves the fixed cost per packet.
+//
+// Usage: hesai_packet_batch_benchmark [n_repetitions]
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_common/util/span.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+using Clock = std::chrono::steady_clock;
+namespace hesai_packet = nebula::drivers::hesai_packet;
+
+using packet_t = hesai_packet::PacketXT32;
+constexpr uint32_t g_packets_per_rotation = 450;
+
+double elapsed_ms(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<std::vector<uint8_t>> make_packets(size_t n_rotations)
+{
+  constexpr uint32_t azimuth_step = 36000 / (g_packets_per_rotation * packet_t::n_blocks);
+
+  std::vector<uint8_t> buffer(sizeof(packet_t));
+  auto & packet = *reinterpret_cast<packet_t *>(buffer.data());
+  packet.header.dis_unit = 4;
+  packet.tail.return_mode = hesai_packet::return_mode::SINGLE_STRONGEST;
+  packet.tail.date_time.year = 124;
+  packet.tail.date_time.month = 1;
+  packet.tail.date_time.day = 1;
+
+  std::vector<std::vector<uint8_t>> packets;
+  for (uint32_t packet_id = 0; packet_id < n_rotations * g_packets_per_rotation; ++packet_id) {
+    uint32_t azimuth = packet_id * packet_t::n_blocks * azimuth_step;
+    for (auto & block : packet.body.blocks) {
+      block.azimuth = azimuth % 36000;
+      azimuth += azimuth_step;
+      for (size_t channel = 0; channel < packet_t::n_channels; ++channel) {
+        block.units[channel].distance = 500 + (packet_id + channel) % 1000;
+        block.units[channel].reflectivity = channel;
+      }
+    }
+    packet.udp_sequence = packet_id;
+    packet.tail.timestamp = packet_id * 222;
+    packets.push_back(buffer);
+  }
+
+  return packets;
+}
+
+std::unique_ptr<drivers::HesaiDriver> make_driver(uint16_t cloud_max_angle)
+{
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarXT32.csv";
+  if (calibration->load_from_file(calibration_path) != Status::OK) {
+    std::fprintf(stderr, "Could not load %s\n", calibration_path.c_str());
+    std::exit(1);
+  }
+
+  drivers::HesaiSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::HESAI_PANDARXT32;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "hesai";
+  config.min_range = 0.1;
+  config.max_range = 300;
+  config.cloud_min_angle = 0;
+  config.cloud_max_angle = cloud_max_angle;
+  config.cut_angle = 0;
+
+  return std::make_unique<drivers::HesaiDriver>(
+    std::make_shared<const drivers::HesaiSensorConfiguration>(config), calibration);
+}
+
+/// @brief Decode all packets one at a time or in batches of `batch_size`, and print the best time
+/// per packet over `n_reps` repetitions
+void benchmark_batch_size(
+  const std::vector<std::vector<uint8_t>> & packets, uint16_t cloud_max_angle, size_t batch_size,
+  int n_reps)
+{
+  auto driver = make_driver(cloud_max_angle);
+  std::mutex mtx_driver;
+  drivers::UnpackedPackets unpacked;
+  std::vector<util::span<const uint8_t>> batch;
+  size_t n_scans = 0;
+
+  double best_ms = 1e9;
+  for (int rep = 0; rep < n_reps; ++rep) {
+    auto start = Clock::now();
+    if (batch_size == 0) {
+      for (const auto & packet : packets) {
+        std::lock_guard lock(mtx_driver);
+        auto [pointcloud, timestamp_s] = driver->parse_cloud_packet(packet);
+        if (pointcloud) {
+          driver->get_scan_sequence_stats();
+          driver->get_scan_point_fields();
+          ++n_scans;
+        }
+        driver->get_sectors();
+      }
+    } else {
+      for (size_t begin = 0; begin < packets.size(); begin += batch_size) {
+        batch.clear();
+        for (size_t i = begin; i < std::min(begin + batch_size, packets.size()); ++i) {
+          batch.emplace_back(packets[i]);
+        }
+
+        unpacked.clear();
+        std::lock_guard lock(mtx_driver);
+        driver->parse_cloud_packets(batch, unpacked);
+        n_scans += unpacked.scans.size();
+      }
+    }
+    best_ms = std::min(best_ms, elapsed_ms(start));
+  }
+
+  char name[32];
+  if (batch_size == 0) {
+    std::snprintf(name, sizeof(name), "single packets");
+  } else {
+    std::snprintf(name, sizeof(name), "batches of %zu", batch_size);
+  }
+  std::printf(
+    "%-18s %8.0f ns/packet   (%zu scans)\n", name, best_ms * 1e6 / packets.size(),
+    n_scans / n_reps);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  namespace test = nebula::test;
+
+  int n_reps = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+  const auto packets = test::make_packets(20);
+  for (uint16_t cloud_max_angle : {360, 1}) {
+    std::printf(
+      "PandarXT32, %zu packets, FoV 0-%u deg\n", packets.size(),
+      static_cast<unsigned>(cloud_max_angle));
+    for (size_t batch_size : {0, 1, 16, 64, 128}) {
+      test::benchmark_batch_size(packets, cloud_max_angle, batch_size, n_reps);
+    }
+    std::printf("\n");
+  }
+
+  return 0;
+}
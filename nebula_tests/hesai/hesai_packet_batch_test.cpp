@@ -0,0 +1,219 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_common/point_types.hpp>
+#include <nebula_common/util/span.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace nebula::test
+{
+
+namespace hesai_packet = nebula::drivers::hesai_packet;
+using drivers::NebulaPointCloud;
+using drivers::PacketSequenceStats;
+using drivers::PointFieldMask;
+
+using packet_t = hesai_packet::PacketXT32;
+
+struct DecodedScan
+{
+  NebulaPointCloud cloud;
+  double timestamp_s;
+  PacketSequenceStats sequence_stats;
+  PointFieldMask point_fields;
+  size_t packet_index;
+};
+
+struct DecodedRotations
+{
+  std::vector<DecodedScan> scans;
+  std::vector<std::tuple<NebulaPointCloud, double>> sectors;
+};
+
+/// @brief Generates three rotations of synthetic PandarXT32 packets with UDP sequence numbers. A
+/// few packets are lost, and a truncated packet follows the one that completes the second scan.
+std::vector<std::vector<uint8_t>> make_packets()
+{
+  constexpr uint32_t packets_per_rotation = 450;
+  constexpr uint32_t azimuth_step = 36000 / (packets_per_rotation * packet_t::n_blocks);
+
+  std::vector<uint8_t> buffer(sizeof(packet_t));
+  auto & packet = *reinterpret_cast<packet_t *>(buffer.data());
+  packet.header.dis_unit = 4;
+  packet.tail.return_mode = hesai_packet::return_mode::SINGLE_STRONGEST;
+  packet.tail.date_time.year = 124;
+  packet.tail.date_time.month = 1;
+  packet.tail.date_time.day = 1;
+
+  std::vector<std::vector<uint8_t>> packets;
+  for (uint32_t packet_id = 0; packet_id < 3 * packets_per_rotation; ++packet_id) {
+    uint32_t azimuth = packet_id * packet_t::n_blocks * azimuth_step;
+    for (auto & block : packet.body.blocks) {
+      block.azimuth = azimuth % 36000;
+      azimuth += azimuth_step;
+      for (size_t channel = 0; channel < packet_t::n_channels; ++channel) {
+        block.units[channel].distance = 500 + (packet_id + channel) % 1000;
+        block.units[channel].reflectivity = channel;
+      }
+    }
+    packet.udp_sequence = packet_id;
+    packet.tail.timestamp = packet_id * 222;
+
+    if (packet_id >= 600 && packet_id < 603) {
+      continue;
+    }
+
+    packets.push_back(buffer);
+    if (packet_id == packets_per_rotation) {
+      packets.emplace_back(buffer.begin(), buffer.begin() + 100);
+    }
+  }
+
+  return packets;
+}
+
+/// @brief Decodes the packets in batches of `batch_size`, or one by one through
+/// `parse_cloud_packet` if it is zero
+DecodedRotations decode_packets(
+  const std::vector<std::vector<uint8_t>> & packets, size_t batch_size, uint16_t decoder_threads)
+{
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarXT32.csv";
+  EXPECT_EQ(calibration->load_from_file(calibration_path), Status::OK);
+
+  drivers::HesaiSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::HESAI_PANDARXT32;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "hesai";
+  config.min_range = 0.1;
+  config.max_range = 300;
+  config.cloud_min_angle = 0;
+  config.cloud_max_angle = 360;
+  config.cut_angle = 0;
+  config.decoder_threads = decoder_threads;
+  config.sector_angle = 90;
+
+  drivers::HesaiDriver driver(
+    std::make_shared<const drivers::HesaiSensorConfiguration>(config), calibration);
+  EXPECT_EQ(driver.get_status(), Status::OK);
+
+  DecodedRotations result;
+  if (batch_size == 0) {
+    for (size_t i = 0; i < packets.size(); ++i) {
+      auto [pointcloud, timestamp_s] = driver.parse_cloud_packet(packets[i]);
+      for (const auto & [sector, sector_timestamp_s] : driver.get_sectors()) {
+        result.sectors.emplace_back(*sector, sector_timestamp_s);
+      }
+      if (pointcloud) {
+        result.scans.push_back(
+          {*pointcloud, timestamp_s, driver.get_scan_sequence_stats(),
+           driver.get_scan_point_fields(), i});
+      }
+    }
+    return result;
+  }
+
+  drivers::UnpackedPackets unpacked;
+  for (size_t begin = 0; begin < packets.size(); begin += batch_size) {
+    std::vector<util::span<const uint8_t>> batch;
+    for (size_t i = begin; i < std::min(begin + batch_size, packets.size()); ++i) {
+      batch.emplace_back(packets[i]);
+    }
+
+    unpacked.clear();
+    driver.parse_cloud_packets(batch, unpacked);
+    for (const auto & [sector, sector_timestamp_s] : unpacked.sectors) {
+      result.sectors.emplace_back(*sector, sector_timestamp_s);
+    }
+    for (const auto & scan : unpacked.scans) {
+      EXPECT_LT(scan.packet_index, batch.size());
+      result.scans.push_back(
+        {*scan.pointcloud, scan.timestamp_s, scan.sequence_stats, scan.point_fields,
+         begin + scan.packet_index});
+    }
+  }
+  return result;
+}
+
+void expect_same_points(const NebulaPointCloud & expected, const NebulaPointCloud & actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected.points[i].x, actual.points[i].x);
+    EXPECT_EQ(expected.points[i].y, actual.points[i].y);
+    EXPECT_EQ(expected.points[i].z, actual.points[i].z);
+    EXPECT_EQ(expected.points[i].time_stamp, actual.points[i].time_stamp);
+  }
+}
+
+// A truncated packet must not make the scan or sectors completed by the packet before it be
+// returned twice
+TEST(PacketBatchTest, TestMalformedPacketAfterScan)
+{
+  auto decoded = decode_packets(make_packets(), 0, 1);
+  const auto & scans = decoded.scans;
+  ASSERT_EQ(scans.size(), 3U);
+  EXPECT_LT(scans[0].timestamp_s, scans[1].timestamp_s);
+  EXPECT_LT(scans[1].timestamp_s, scans[2].timestamp_s);
+  EXPECT_EQ(scans[2].sequence_stats.n_lost, 3U);
+
+  for (size_t i = 1; i < decoded.sectors.size(); ++i) {
+    EXPECT_LT(std::get<1>(decoded.sectors[i - 1]), std::get<1>(decoded.sectors[i]));
+  }
+}
+
+// Decoding in batches has to give the same scans and sectors, with the same metadata, as decoding
+// packet by packet
+TEST(PacketBatchTest, TestBatchesMatchSinglePackets)
+{
+  const auto packets = make_packets();
+
+  for (uint16_t decoder_threads : {1, 3}) {
+    const auto reference = decode_packets(packets, 0, decoder_threads);
+    ASSERT_EQ(reference.scans.size(), 3U);
+    ASSERT_GT(reference.sectors.size(), 8U);
+
+    for (size_t batch_size : {1, 7, 64, 1000, 10000}) {
+      SCOPED_TRACE("batch size " + std::to_string(batch_size));
+      const auto batched = decode_packets(packets, batch_size, decoder_threads);
+
+      ASSERT_EQ(batched.scans.size(), reference.scans.size());
+      for (size_t i = 0; i < reference.scans.size(); ++i) {
+        const auto & expected = reference.scans[i];
+        const auto & actual = batched.scans[i];
+        EXPECT_EQ(expected.timestamp_s, actual.timestamp_s);
+        EXPECT_EQ(expected.packet_index, actual.packet_index);
+        EXPECT_EQ(expected.point_fields, actual.point_fields);
+        EXPECT_EQ(expected.sequence_stats.n_packets, actual.sequence_stats.n_packets);
+        EXPECT_EQ(expected.sequence_stats.n_lost, actual.sequence_stats.n_lost);
+        expect_same_points(expected.cloud, actual.cloud);
+      }
+
+      ASSERT_EQ(batched.sectors.size(), reference.sectors.size());
+      for (size_t i = 0; i < reference.sectors.size(); ++i) {
+        EXPECT_EQ(std::get<1>(reference.sectors[i]), std::get<1>(batched.sectors[i]));
+        expect_same_points(std::get<0>(reference.sectors[i]), std::get<0>(batched.sectors[i]));
+      }
+    }
+  }
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
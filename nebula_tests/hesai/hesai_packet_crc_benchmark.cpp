@@ -0,0 +1,214 @@
+// Copyright 2024 TIER IV, Inc.
+
+// Measures the cost of packet CRC validation: the throughput of the CRC implementations, and the
+// decoding time per packet with and without `validate_packet_crcs` for all sensors whose packets
+// carry CRCs.
+//
+// Usage: hesai_packet_crc_benchmark [n_repetitions]
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_decoders/nebula_decoders_common/crc32.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_128e4x.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_at128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_qt128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+using Clock = std::chrono::steady_clock;
+namespace crc32 = nebula::drivers::crc32;
+namespace hesai_packet = nebula::drivers::hesai_packet;
+
+double elapsed_ms(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void benchmark_crc_throughput(int n_reps)
+{
+  std::mt19937 rng(42);
+  std::vector<uint8_t> data(1 << 24);
+  for (auto & byte : data) {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  auto measure = [&](const char * name, auto && compute_crc) {
+    double best_ms = 1e9;
+    uint32_t crc = 0;
+    for (int rep = 0; rep < n_reps; ++rep) {
+      auto start = Clock::now();
+      crc = compute_crc();
+      best_ms = std::min(best_ms, elapsed_ms(start));
+    }
+    std::printf(
+      "%-24s %8.2f GB/s   (crc %08x)\n", name, data.size() / best_ms * 1e-6,
+      static_cast<unsigned>(crc));
+  };
+
+  measure("crc32 bytewise", [&]() {
+    return crc32::mpeg2_bytewise(data.data(), data.size(), crc32::mpeg2_initial_value);
+  });
+  measure("crc32 slice-by-8", [&]() {
+    return crc32::mpeg2_slice_by_8(data.data(), data.size(), crc32::mpeg2_initial_value);
+  });
+  measure(
+    crc32::is_mpeg2_accelerated() ? "crc32 (pclmul)" : "crc32 (slice-by-8)",
+    [&]() { return crc32::mpeg2(data.data(), data.size()); });
+}
+
+/// @brief Generate packets of a sensor rotating at 10 Hz in single return mode, with valid CRCs
+template <typename SensorT>
+std::vector<std::vector<uint8_t>> make_packets(size_t n_packets)
+{
+  using packet_t = typename SensorT::packet_t;
+  constexpr size_t tail_offset = offsetof(packet_t, tail);
+  constexpr size_t packet_size = tail_offset + packet_t::tail_crc_offset + sizeof(uint32_t);
+  constexpr uint32_t max_azimuth = 360 * packet_t::degree_subdivisions;
+  constexpr uint32_t azimuth_step = max_azimuth / 1800;
+
+  std::mt19937 rng(42);
+  std::vector<std::vector<uint8_t>> packets;
+  uint32_t azimuth = 0;
+
+  for (size_t packet_id = 0; packet_id < n_packets; ++packet_id) {
+    std::vector<uint8_t> buffer(packet_size);
+    auto & packet = *reinterpret_cast<packet_t *>(buffer.data());
+    packet.header.dis_unit = 4;
+    packet.tail.return_mode = hesai_packet::return_mode::SINGLE_STRONGEST;
+    packet.tail.timestamp = (packet_id * 50) % 1000000;
+
+    for (auto & block : packet.body.blocks) {
+      if constexpr (packet_t::degree_subdivisions == 100) {
+        block.azimuth = azimuth;
+      } else {
+        block.azimuth = azimuth >> 8;
+        block.fine_azimuth = azimuth & 0xFF;
+      }
+      azimuth = (azimuth + azimuth_step) % max_azimuth;
+
+      for (auto & unit : block.units) {
+        unit.distance = rng() % 10 == 0 ? 0 : rng() % 50000;
+        unit.reflectivity = rng();
+      }
+    }
+
+    packet.crc_body =
+      crc32::mpeg2(reinterpret_cast<const uint8_t *>(&packet.body), sizeof(packet.body));
+    if constexpr (hesai_packet::has_functional_safety<packet_t>::value) {
+      packet.fs.crc_fs = crc32::mpeg2(
+        reinterpret_cast<const uint8_t *>(&packet.fs), sizeof(packet.fs) - sizeof(uint32_t));
+    }
+    uint32_t crc_tail = crc32::mpeg2(buffer.data() + tail_offset, packet_t::tail_crc_offset);
+    std::memcpy(
+      buffer.data() + tail_offset + packet_t::tail_crc_offset, &crc_tail, sizeof(crc_tail));
+
+    packets.push_back(std::move(buffer));
+  }
+
+  return packets;
+}
+
+template <typename SensorT>
+void benchmark_decoding(
+  const std::string & name, drivers::SensorModel sensor_model,
+  const std::shared_ptr<const drivers::HesaiCalibrationConfigurationBase> & calibration,
+  int n_reps)
+{
+  auto packets = make_packets<SensorT>(3600);
+
+  std::shared_ptr<const drivers::HesaiSensorConfiguration> configs[2];
+  for (bool validate : {false, true}) {
+    drivers::HesaiSensorConfiguration config{};
+    config.sensor_model = sensor_model;
+    config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+    config.frame_id = "hesai";
+    config.min_range = 0.3;
+    config.max_range = 300.;
+    config.cloud_min_angle = sensor_model == drivers::SensorModel::HESAI_PANDARAT128 ? 30 : 0;
+    config.cloud_max_angle = sensor_model == drivers::SensorModel::HESAI_PANDARAT128 ? 150 : 360;
+    config.cut_angle = sensor_model == drivers::SensorModel::HESAI_PANDARAT128 ? 150 : 0;
+    config.validate_packet_crcs = validate;
+    configs[validate] = std::make_shared<const drivers::HesaiSensorConfiguration>(config);
+  }
+
+  // Runs with and without validation are interleaved so that both are affected by clock frequency
+  // changes and cache state alike
+  double best_ms[2] = {1e9, 1e9};
+  size_t n_rejected[2] = {0, 0};
+  for (int rep = 0; rep < n_reps; ++rep) {
+    for (bool validate : {false, true}) {
+      drivers::HesaiDriver driver(configs[validate], calibration);
+      auto start = Clock::now();
+      for (const auto & packet : packets) {
+        driver.parse_cloud_packet(packet);
+      }
+      best_ms[validate] = std::min(best_ms[validate], elapsed_ms(start));
+      n_rejected[validate] = driver.get_packet_integrity_counters().get_n_rejected();
+    }
+  }
+
+  double decode_ns[2];
+  for (bool validate : {false, true}) {
+    decode_ns[validate] = best_ms[validate] * 1e6 / static_cast<double>(packets.size());
+    std::printf(
+      "%-14s %-12s %10.0f ns/packet   (%zu rejected)\n", name.c_str(),
+      validate ? "validated" : "unvalidated", decode_ns[validate], n_rejected[validate]);
+  }
+
+  std::printf(
+    "%-14s %-12s %10.1f %%\n", name.c_str(), "overhead",
+    (decode_ns[1] - decode_ns[0]) / decode_ns[0] * 100.);
+}
+
+template <typename CalibrationT>
+std::shared_ptr<const CalibrationT> load_calibration(const std::string & file)
+{
+  auto calibration = std::make_shared<CalibrationT>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/" + file;
+  if (calibration->load_from_file(calibration_path) != Status::OK) {
+    std::printf("could not load %s\n", calibration_path.c_str());
+    std::exit(1);
+  }
+  return calibration;
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  using nebula::drivers::HesaiCalibrationConfiguration;
+  using nebula::drivers::HesaiCorrection;
+  using nebula::drivers::SensorModel;
+  namespace test = nebula::test;
+
+  int n_reps = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+  test::benchmark_crc_throughput(n_reps);
+  std::printf("\n");
+
+  test::benchmark_decoding<nebula::drivers::PandarAT128>(
+    "PandarAT128", SensorModel::HESAI_PANDARAT128,
+    test::load_calibration<HesaiCorrection>("PandarAT128.dat"), n_reps);
+  test::benchmark_decoding<nebula::drivers::PandarQT128>(
+    "PandarQT128", SensorModel::HESAI_PANDARQT128,
+    test::load_calibration<HesaiCalibrationConfiguration>("PandarQT128.csv"), n_reps);
+  test::benchmark_decoding<nebula::drivers::Pandar128E4X>(
+    "Pandar128E4X", SensorModel::HESAI_PANDAR128_E4X,
+    test::load_calibration<HesaiCalibrationConfiguration>("Pandar128E4X.csv"), n_reps);
+
+  return 0;
+}
@@ -0,0 +1,248 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_decoders/nebula_decoders_common/crc32.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_128e3x.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_at128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_qt128.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp>
+#include <nebula_ros/hesai/pandar_scan.hpp>
+
+#include <gtest/gtest.h>
+
+#include <pandar_msgs/msg/pandar_packet.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+namespace crc32 = nebula::drivers::crc32;
+namespace hesai_packet = nebula::drivers::hesai_packet;
+
+/// @brief The size of a packet including the optional fields up to and including the tail CRC
+template <typename PacketT>
+constexpr size_t full_packet_size = offsetof(PacketT, tail) + PacketT::tail_crc_offset + 4;
+
+/// @brief Compute and write all CRCs of the packet in the given buffer
+template <typename PacketT>
+void update_crcs(std::vector<uint8_t> & buffer)
+{
+  auto & packet = *reinterpret_cast<PacketT *>(buffer.data());
+  const auto * body = reinterpret_cast<const uint8_t *>(&packet.body);
+  packet.crc_body = crc32::mpeg2_bytewise(body, sizeof(packet.body), crc32::mpeg2_initial_value);
+
+  if constexpr (hesai_packet::has_functional_safety<PacketT>::value) {
+    const auto * fs = reinterpret_cast<const uint8_t *>(&packet.fs);
+    packet.fs.crc_fs = crc32::mpeg2_bytewise(fs, sizeof(packet.fs) - 4, crc32::mpeg2_initial_value);
+  }
+
+  constexpr size_t tail_offset = offsetof(PacketT, tail);
+  uint32_t crc_tail = crc32::mpeg2_bytewise(
+    buffer.data() + tail_offset, PacketT::tail_crc_offset, crc32::mpeg2_initial_value);
+  std::memcpy(buffer.data() + tail_offset + PacketT::tail_crc_offset, &crc_tail, sizeof(crc_tail));
+}
+
+template <typename PacketT>
+std::vector<uint8_t> make_random_packet(std::mt19937 & rng)
+{
+  std::vector<uint8_t> buffer(full_packet_size<PacketT>);
+  for (auto & byte : buffer) {
+    byte = static_cast<uint8_t>(rng());
+  }
+  update_crcs<PacketT>(buffer);
+  return buffer;
+}
+
+// Checks the CRC against the standard check value and all implementations against each other, for
+// all lengths around the block sizes and for unaligned data
+TEST(Crc32Test, TestImplementationsAgree)
+{
+  const std::string check_input = "123456789";
+  const auto * check_data = reinterpret_cast<const uint8_t *>(check_input.data());
+  EXPECT_EQ(crc32::mpeg2(check_data, check_input.size()), 0x0376E6E7U);
+  EXPECT_EQ(
+    crc32::mpeg2_slice_by_8(check_data, check_input.size(), crc32::mpeg2_initial_value),
+    0x0376E6E7U);
+
+  std::mt19937 rng(42);
+  std::vector<uint8_t> data(1200);
+  for (auto & byte : data) {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  for (size_t offset = 0; offset < 16; ++offset) {
+    for (size_t size = 0; size + offset <= data.size(); size += (size < 64 ? 1 : 37)) {
+      uint32_t initial_value = rng();
+      uint32_t expected = crc32::mpeg2_bytewise(data.data() + offset, size, initial_value);
+      ASSERT_EQ(crc32::mpeg2(data.data() + offset, size, initial_value), expected);
+      ASSERT_EQ(crc32::mpeg2_slice_by_8(data.data() + offset, size, initial_value), expected);
+    }
+  }
+}
+
+template <typename PacketT>
+void check_crc_mismatches()
+{
+  std::mt19937 rng(42);
+  auto buffer = make_random_packet<PacketT>(rng);
+  const auto & packet = *reinterpret_cast<const PacketT *>(buffer.data());
+  ASSERT_EQ(hesai_packet::check_crcs(packet, buffer.size()), hesai_packet::CrcCheckResult::OK);
+
+  // A corrupted tail CRC is only detected if the optional fields in front of it were received
+  buffer[buffer.size() - 1] ^= 0x01;
+  EXPECT_EQ(
+    hesai_packet::check_crcs(packet, buffer.size()),
+    hesai_packet::CrcCheckResult::TAIL_CRC_MISMATCH);
+  EXPECT_EQ(hesai_packet::check_crcs(packet, sizeof(PacketT)), hesai_packet::CrcCheckResult::OK);
+  buffer[buffer.size() - 1] ^= 0x01;
+
+  buffer[offsetof(PacketT, tail) + 3] ^= 0x10;
+  EXPECT_EQ(
+    hesai_packet::check_crcs(packet, buffer.size()),
+    hesai_packet::CrcCheckResult::TAIL_CRC_MISMATCH);
+  buffer[offsetof(PacketT, tail) + 3] ^= 0x10;
+
+  buffer[offsetof(PacketT, body) + sizeof(packet.body) / 2] ^= 0x80;
+  EXPECT_EQ(
+    hesai_packet::check_crcs(packet, buffer.size()),
+    hesai_packet::CrcCheckResult::BODY_CRC_MISMATCH);
+  buffer[offsetof(PacketT, body) + sizeof(packet.body) / 2] ^= 0x80;
+
+  if constexpr (hesai_packet::has_functional_safety<PacketT>::value) {
+    buffer[offsetof(PacketT, fs) + 1] ^= 0x04;
+    EXPECT_EQ(
+      hesai_packet::check_crcs(packet, buffer.size()),
+      hesai_packet::CrcCheckResult::FUNCTIONAL_SAFETY_CRC_MISMATCH);
+    buffer[offsetof(PacketT, fs) + 1] ^= 0x04;
+  }
+
+  EXPECT_EQ(hesai_packet::check_crcs(packet, buffer.size()), hesai_packet::CrcCheckResult::OK);
+}
+
+TEST(PacketCrcTest, TestCrcMismatchesPandarAT128)
+{
+  check_crc_mismatches<hesai_packet::PacketAT128E2X>();
+}
+
+TEST(PacketCrcTest, TestCrcMismatchesPandarQT128)
+{
+  check_crc_mismatches<hesai_packet::PacketQT128C2X>();
+}
+
+TEST(PacketCrcTest, TestCrcMismatchesPandar128E3X)
+{
+  check_crc_mismatches<hesai_packet::Packet128E3X>();
+}
+
+// Checks that the decoder drops corrupted packets and counts them, if validation is enabled
+TEST(PacketCrcTest, TestDecoderCountsRejectedPackets)
+{
+  using packet_t = hesai_packet::PacketAT128E2X;
+
+  auto correction = std::make_shared<drivers::HesaiCorrection>();
+  auto correction_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarAT128.dat";
+  ASSERT_EQ(correction->load_from_file(correction_path), Status::OK);
+
+  std::vector<uint8_t> valid_packet(full_packet_size<packet_t>);
+  reinterpret_cast<packet_t *>(valid_packet.data())->tail.return_mode =
+    hesai_packet::return_mode::SINGLE_STRONGEST;
+  update_crcs<packet_t>(valid_packet);
+
+  auto corrupted_packet = valid_packet;
+  corrupted_packet[offsetof(packet_t, body) + 100] ^= 0x01;
+
+  for (bool validate : {false, true}) {
+    drivers::HesaiSensorConfiguration config{};
+    config.sensor_model = drivers::SensorModel::HESAI_PANDARAT128;
+    config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+    config.frame_id = "hesai";
+    config.cloud_min_angle = 30;
+    config.cloud_max_angle = 150;
+    config.cut_angle = 150;
+    config.validate_packet_crcs = validate;
+
+    drivers::HesaiDriver driver(
+      std::make_shared<const drivers::HesaiSensorConfiguration>(config), correction);
+    ASSERT_EQ(driver.get_status(), Status::OK);
+
+    driver.parse_cloud_packet(valid_packet);
+    driver.parse_cloud_packet(corrupted_packet);
+    driver.parse_cloud_packet(valid_packet);
+
+    auto counters = driver.get_packet_integrity_counters();
+    EXPECT_EQ(counters.n_packets_checked, validate ? 3U : 0U);
+    EXPECT_EQ(counters.n_body_crc_errors, validate ? 1U : 0U);
+    EXPECT_EQ(counters.n_functional_safety_crc_errors, 0U);
+    EXPECT_EQ(counters.n_tail_crc_errors, 0U);
+    EXPECT_EQ(counters.get_n_rejected(), validate ? 1U : 0U);
+  }
+}
+
+// Replays packets recorded in a `PandarScan` the way the ROS wrapper does. A packet recorded without
+// the optional fields behind the tail must not have the zero padding of the message checked as its
+// tail CRC.
+TEST(PacketCrcTest, TestPandarScanReplay)
+{
+  using packet_t = hesai_packet::PacketAT128E2X;
+
+  auto correction = std::make_shared<drivers::HesaiCorrection>();
+  auto correction_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarAT128.dat";
+  ASSERT_EQ(correction->load_from_file(correction_path), Status::OK);
+
+  std::vector<uint8_t> full_packet(full_packet_size<packet_t>);
+  reinterpret_cast<packet_t *>(full_packet.data())->tail.return_mode =
+    hesai_packet::return_mode::SINGLE_STRONGEST;
+  update_crcs<packet_t>(full_packet);
+
+  // One packet recorded without and one with the optional fields
+  std::vector<pandar_msgs::msg::PandarPacket> recorded_packets;
+  for (size_t size : {sizeof(packet_t), full_packet.size()}) {
+    auto & recorded = recorded_packets.emplace_back();
+    std::copy(full_packet.begin(), full_packet.begin() + size, recorded.data.begin());
+    recorded.size = size;
+  }
+
+  // Without the optional fields, the tail CRC would be read from the padding
+  const auto & short_packet = *reinterpret_cast<const packet_t *>(recorded_packets[0].data.data());
+  ASSERT_EQ(
+    hesai_packet::check_crcs(short_packet, recorded_packets[0].data.size()),
+    hesai_packet::CrcCheckResult::TAIL_CRC_MISMATCH);
+
+  drivers::HesaiSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::HESAI_PANDARAT128;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "hesai";
+  config.cloud_min_angle = 30;
+  config.cloud_max_angle = 150;
+  config.cut_angle = 150;
+  config.validate_packet_crcs = true;
+
+  drivers::HesaiDriver driver(
+    std::make_shared<const drivers::HesaiSensorConfiguration>(config), correction);
+  ASSERT_EQ(driver.get_status(), Status::OK);
+
+  for (const auto & recorded : recorded_packets) {
+    driver.parse_cloud_packet(ros::get_received_bytes(recorded));
+  }
+
+  auto counters = driver.get_packet_integrity_counters();
+  EXPECT_EQ(counters.n_packets_checked, 2U);
+  EXPECT_EQ(counters.get_n_rejected(), 0U);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
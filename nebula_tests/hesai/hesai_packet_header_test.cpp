@@ -0,0 +1,222 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_common/hesai/hesai_common.hpp>
+#include <nebula_decoders/nebula_decoders_common/packet_sequence_tracker.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_128e3x.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp>
+#include <nebula_ros/hesai/pandar_scan.hpp>
+
+#include <gtest/gtest.h>
+
+#include <pandar_msgs/msg/pandar_packet.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+namespace hesai_packet = nebula::drivers::hesai_packet;
+using drivers::PacketSequenceStats;
+using drivers::PacketSequenceTracker;
+
+PacketSequenceStats track(const std::vector<uint32_t> & sequence)
+{
+  PacketSequenceTracker tracker;
+  PacketSequenceStats stats;
+  for (uint32_t n : sequence) {
+    tracker.update(n, stats);
+  }
+  return stats;
+}
+
+TEST(PacketSequenceTrackerTest, TestInOrder)
+{
+  auto stats = track({10, 11, 12, 13});
+  EXPECT_EQ(stats.n_packets, 4U);
+  EXPECT_EQ(stats.n_lost, 0U);
+  EXPECT_EQ(stats.n_reordered, 0U);
+  EXPECT_EQ(stats.n_duplicates, 0U);
+
+  // Wrapping around is not a gap
+  stats = track({0xFFFFFFFE, 0xFFFFFFFF, 0, 1});
+  EXPECT_EQ(stats.n_lost, 0U);
+  EXPECT_EQ(stats.n_resets, 0U);
+}
+
+TEST(PacketSequenceTrackerTest, TestGapsReorderingAndDuplicates)
+{
+  auto stats = track({1, 2, 5, 6, 10});
+  EXPECT_EQ(stats.n_lost, 5U);
+  EXPECT_EQ(stats.n_reordered, 0U);
+
+  stats = track({1, 2, 4, 3, 5});
+  EXPECT_EQ(stats.n_lost, 1U);
+  EXPECT_EQ(stats.n_reordered, 1U);
+  EXPECT_EQ(stats.n_duplicates, 0U);
+
+  stats = track({1, 2, 2, 3, 1, 4});
+  EXPECT_EQ(stats.n_lost, 0U);
+  EXPECT_EQ(stats.n_reordered, 0U);
+  EXPECT_EQ(stats.n_duplicates, 2U);
+
+  // A late packet is only counted as reordered once, and as duplicate afterwards
+  stats = track({0xFFFFFFF0, 0xFFFFFFF2, 3, 0xFFFFFFF1, 0xFFFFFFF1});
+  EXPECT_EQ(stats.n_lost, 1U + 16U);
+  EXPECT_EQ(stats.n_reordered, 1U);
+  EXPECT_EQ(stats.n_duplicates, 1U);
+  EXPECT_EQ(stats.n_resets, 0U);
+}
+
+TEST(PacketSequenceTrackerTest, TestRestart)
+{
+  auto stats = track({1000000, 1000001, 0, 1, 2, 5000000});
+  EXPECT_EQ(stats.n_packets, 6U);
+  EXPECT_EQ(stats.n_lost, 0U);
+  EXPECT_EQ(stats.n_reordered, 0U);
+  EXPECT_EQ(stats.n_resets, 2U);
+}
+
+// The cached conversion has to match `timegm` on the full date and time, including out-of-range
+// values that `timegm` normalizes
+TEST(PacketHeaderTest, TestCachedTimestampMatchesReference)
+{
+  std::mt19937 rng(42);
+  std::vector<uint8_t> buffer(sizeof(hesai_packet::PacketXT32));
+  auto & packet = *reinterpret_cast<hesai_packet::PacketXT32 *>(buffer.data());
+
+  hesai_packet::TimestampDecoder decoder;
+  for (int i = 0; i < 10000; ++i) {
+    auto & date_time = packet.tail.date_time;
+    if (i % 1000 == 0) {
+      date_time.year = rng() % 256;
+      date_time.month = rng() % 14;
+      date_time.day = rng() % 33;
+    }
+    date_time.hour = rng() % 26;
+    date_time.minute = rng() % 62;
+    date_time.second = rng() % 62;
+    packet.tail.timestamp = rng() % 1000000;
+
+    ASSERT_EQ(decoder.get_timestamp_ns(packet), hesai_packet::get_timestamp_ns(packet));
+  }
+}
+
+TEST(PacketHeaderTest, TestUdpSequence)
+{
+  // Mandatory field
+  hesai_packet::PacketXT32 xt32{};
+  xt32.udp_sequence = 1234;
+  EXPECT_EQ(hesai_packet::get_udp_sequence(xt32, sizeof(xt32)), 1234U);
+
+  // Optional field behind the tail
+  using packet_t = hesai_packet::Packet128E3X;
+  std::vector<uint8_t> buffer(sizeof(packet_t) + 30);
+  uint32_t sequence = 0xDEADBEEF;
+  std::memcpy(buffer.data() + sizeof(packet_t), &sequence, sizeof(sequence));
+  const auto & e3x = *reinterpret_cast<const packet_t *>(buffer.data());
+
+  EXPECT_EQ(hesai_packet::get_udp_sequence(e3x, buffer.size()), 0xDEADBEEFU);
+  EXPECT_EQ(hesai_packet::get_udp_sequence(e3x, sizeof(packet_t) + 4), 0xDEADBEEFU);
+  EXPECT_FALSE(hesai_packet::get_udp_sequence(e3x, sizeof(packet_t) + 3).has_value());
+  EXPECT_FALSE(hesai_packet::get_udp_sequence(e3x, sizeof(packet_t)).has_value());
+}
+
+// Packets replayed from a `PandarScan` only have the optional sequence number if it was received.
+// The zero padding of the message must not be read as a sequence number.
+TEST(PacketHeaderTest, TestUdpSequencePandarScanReplay)
+{
+  using packet_t = hesai_packet::Packet128E3X;
+
+  pandar_msgs::msg::PandarPacket recorded{};
+  recorded.size = sizeof(packet_t);
+  const auto & packet = *reinterpret_cast<const packet_t *>(recorded.data.data());
+  EXPECT_EQ(hesai_packet::get_udp_sequence(packet, recorded.data.size()), 0U);
+  EXPECT_FALSE(
+    hesai_packet::get_udp_sequence(packet, ros::get_received_bytes(recorded).size()).has_value());
+
+  uint32_t sequence = 0xDEADBEEF;
+  std::memcpy(recorded.data.data() + sizeof(packet_t), &sequence, sizeof(sequence));
+  recorded.size = sizeof(packet_t) + 30;
+  EXPECT_EQ(
+    hesai_packet::get_udp_sequence(packet, ros::get_received_bytes(recorded).size()), 0xDEADBEEFU);
+}
+
+// Decodes three rotations with a gap of 3 packets in the second one and checks that the loss is
+// reported for that scan only
+TEST(PacketHeaderTest, TestDecoderReportsLossPerScan)
+{
+  using packet_t = hesai_packet::PacketXT32;
+  constexpr uint32_t packets_per_rotation = 450;
+  constexpr uint32_t azimuth_step = 36000 / (packets_per_rotation * packet_t::n_blocks);
+
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/PandarXT32.csv";
+  ASSERT_EQ(calibration->load_from_file(calibration_path), Status::OK);
+
+  drivers::HesaiSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::HESAI_PANDARXT32;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "hesai";
+  config.cloud_min_angle = 0;
+  config.cloud_max_angle = 360;
+  config.cut_angle = 0;
+
+  drivers::HesaiDriver driver(
+    std::make_shared<const drivers::HesaiSensorConfiguration>(config), calibration);
+  ASSERT_EQ(driver.get_status(), Status::OK);
+
+  std::vector<uint8_t> buffer(sizeof(packet_t));
+  auto & packet = *reinterpret_cast<packet_t *>(buffer.data());
+  packet.header.dis_unit = 4;
+  packet.tail.return_mode = hesai_packet::return_mode::SINGLE_STRONGEST;
+
+  std::vector<PacketSequenceStats> scan_stats;
+  for (uint32_t packet_id = 0; packet_id < 3 * packets_per_rotation + 10; ++packet_id) {
+    // Start in the middle of the first rotation
+    uint32_t azimuth = (packet_id + packets_per_rotation / 2) * packet_t::n_blocks * azimuth_step;
+    for (auto & block : packet.body.blocks) {
+      block.azimuth = azimuth % 36000;
+      azimuth += azimuth_step;
+    }
+    packet.udp_sequence = packet_id;
+    packet.tail.timestamp = packet_id * 222;
+
+    bool is_lost = packet_id >= 400 && packet_id < 403;
+    if (is_lost) continue;
+
+    auto [pointcloud, timestamp_s] = driver.parse_cloud_packet(buffer);
+    if (pointcloud) {
+      scan_stats.push_back(driver.get_scan_sequence_stats());
+    }
+  }
+
+  // The scans before the first full rotation are incomplete, only check the last two
+  ASSERT_GE(scan_stats.size(), 2U);
+  uint64_t n_lost = 0;
+  for (const auto & stats : scan_stats) {
+    n_lost += stats.n_lost;
+  }
+  EXPECT_EQ(n_lost, 3U);
+
+  const auto & lossy_scan = scan_stats[scan_stats.size() - 2];
+  EXPECT_EQ(lossy_scan.n_lost, 3U);
+  EXPECT_EQ(lossy_scan.n_packets, packets_per_rotation - 3);
+  EXPECT_EQ(scan_stats.back().n_lost, 0U);
+  EXPECT_EQ(scan_stats.back().n_packets, packets_per_rotation);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
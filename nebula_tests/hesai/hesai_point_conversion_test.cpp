@@ -0,0 +1,143 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include <nebula_decoders/nebula_decoders_hesai/decoders/point_conversion.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+namespace pc = nebula::drivers::point_conversion;
+
+class PointConversionTest : public ::testing::TestWithParam<pc::SimdLevel>
+{
+protected:
+  void SetUp() override
+  {
+    if (GetParam() > pc::get_max_supported_simd_level()) {
+      GTEST_SKIP() << pc::to_string(GetParam()) << " is not supported on this CPU";
+    }
+  }
+
+  void TearDown() override { pc::set_simd_level(pc::get_max_supported_simd_level()); }
+};
+
+// Checks that the vectorized distance scaling and range checks are bit-identical to the scalar
+// implementation, for all lengths including ones that are not a multiple of the vector width.
+TEST_P(PointConversionTest, TestScaleDistances)
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint16_t> raw_distribution(0, 65535);
+
+  for (size_t n = 0; n <= 131; ++n) {
+    std::vector<uint16_t> raw_distances(n);
+    for (auto & raw : raw_distances) {
+      raw = raw_distribution(rng) % 8 == 0 ? 0 : raw_distribution(rng);
+    }
+
+    for (double dis_unit : {0.004, 0.002, 0.001}) {
+      std::vector<float> expected_distances(n);
+      std::vector<uint8_t> expected_valid(n);
+      pc::set_simd_level(pc::SimdLevel::SCALAR);
+      pc::scale_distances(
+        raw_distances.data(), n, dis_unit, 0.3f, 120.f, expected_distances.data(),
+        expected_valid.data());
+
+      std::vector<float> distances(n);
+      std::vector<uint8_t> valid(n);
+      ASSERT_EQ(pc::set_simd_level(GetParam()), GetParam());
+      pc::scale_distances(
+        raw_distances.data(), n, dis_unit, 0.3f, 120.f, distances.data(), valid.data());
+
+      for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(distances[i], static_cast<float>(raw_distances[i] * dis_unit));
+        ASSERT_EQ(distances[i], expected_distances[i]);
+        ASSERT_EQ(valid[i], expected_valid[i]);
+      }
+    }
+  }
+}
+
+// Checks that the vectorized conversion to cartesian coordinates is bit-identical to the scalar
+// implementation.
+TEST_P(PointConversionTest, TestProjectToCartesian)
+{
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> distance_distribution(0.f, 300.f);
+  std::uniform_real_distribution<float> trig_distribution(-1.f, 1.f);
+
+  for (size_t n = 0; n <= 131; ++n) {
+    std::vector<float> distances(n);
+    std::vector<float> cos_el(n);
+    std::vector<float> sin_el(n);
+    std::vector<float> cos_az(n);
+    std::vector<float> sin_az(n);
+    for (size_t i = 0; i < n; ++i) {
+      distances[i] = distance_distribution(rng);
+      cos_el[i] = trig_distribution(rng);
+      sin_el[i] = trig_distribution(rng);
+      cos_az[i] = trig_distribution(rng);
+      sin_az[i] = trig_distribution(rng);
+    }
+
+    std::vector<float> x(n);
+    std::vector<float> y(n);
+    std::vector<float> z(n);
+    ASSERT_EQ(pc::set_simd_level(GetParam()), GetParam());
+    pc::project_to_cartesian(
+      distances.data(), cos_el.data(), sin_el.data(), cos_az.data(), sin_az.data(), n, x.data(),
+      y.data(), z.data());
+
+    for (size_t i = 0; i < n; ++i) {
+      float xy_distance = distances[i] * cos_el[i];
+      ASSERT_EQ(x[i], xy_distance * sin_az[i]);
+      ASSERT_EQ(y[i], xy_distance * cos_az[i]);
+      ASSERT_EQ(z[i], distances[i] * sin_el[i]);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  TestMain, PointConversionTest,
+  testing::Values(pc::SimdLevel::SCALAR, pc::SimdLevel::SSE4_1, pc::SimdLevel::AVX2),
+  [](const testing::TestParamInfo<pc::SimdLevel> & p) {
+    switch (p.param) {
+      case pc::SimdLevel::SSE4_1:
+        return std::string("SSE4_1");
+      case pc::SimdLevel::AVX2:
+        return std::string("AVX2");
+      default:
+        return std::string("Scalar");
+    }
+  });
+
+// Checks that range checks against float limits derived from double limits reject exactly the
+// same float distances as comparing in double precision.
+TEST(PointConversionBoundsTest, TestFloatBounds)
+{
+  for (double limit : {0.05, 0.1, 0.3, 1. / 3., 60., 120.0, 200.0, 299.99999}) {
+    float ceil = pc::float_ceil(limit);
+    float floor = pc::float_floor(limit);
+    EXPECT_GE(static_cast<double>(ceil), limit);
+    EXPECT_LE(static_cast<double>(floor), limit);
+
+    float below_ceil = std::nextafter(ceil, 0.f);
+    float above_floor = std::nextafter(floor, 1000.f);
+    EXPECT_LT(static_cast<double>(below_ceil), limit);
+    EXPECT_GT(static_cast<double>(above_floor), limit);
+  }
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
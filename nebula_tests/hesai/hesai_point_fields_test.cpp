@@ -0,0 +1,132 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "hesai_common.hpp"
+
+#include <nebula_common/point_types.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace nebula::test
+{
+
+namespace point_field = nebula::drivers::point_field;
+using drivers::NebulaPointCloud;
+using drivers::PointFieldMask;
+
+constexpr PointFieldMask g_xyzic_fields =
+  point_field::xyz | point_field::intensity | point_field::channel;
+
+struct DecodedScan
+{
+  NebulaPointCloud cloud;
+  PointFieldMask fields;
+};
+
+/// @brief Decodes five synthetic dual return rotations. The requested point fields are switched to
+/// `later_fields` after `n_scans_before_switch` scans.
+std::vector<DecodedScan> decode_rotations(
+  PointFieldMask fields, PointFieldMask later_fields = 0, size_t n_scans_before_switch = 0)
+{
+  auto config = make_synthetic_config();
+  config.return_mode = drivers::ReturnMode::DUAL;
+
+  std::vector<DecodedScan> scans;
+  decode_synthetic_rotations(
+    config,
+    [&](auto & driver, uint32_t, const auto & pointcloud, double) {
+      if (!pointcloud) {
+        return;
+      }
+      scans.push_back({*pointcloud, driver.get_scan_point_fields()});
+      if (scans.size() == n_scans_before_switch) {
+        driver.set_point_fields(later_fields);
+      }
+    },
+    5, [&](auto & driver) { driver.set_point_fields(fields); });
+
+  return scans;
+}
+
+// The reduced kernels have to produce the same points as the full one, with the unused fields
+// cleared
+TEST(PointFieldsTest, TestReducedFieldsMatchAllFields)
+{
+  auto full_scans = decode_rotations(point_field::all);
+  ASSERT_GE(full_scans.size(), 3U);
+
+  for (PointFieldMask fields : {PointFieldMask{0}, g_xyzic_fields, point_field::xyz}) {
+    auto reduced_scans = decode_rotations(fields);
+    ASSERT_EQ(full_scans.size(), reduced_scans.size());
+
+    for (size_t i = 0; i < full_scans.size(); ++i) {
+      EXPECT_EQ(full_scans[i].fields, point_field::all);
+      EXPECT_EQ(reduced_scans[i].fields, g_xyzic_fields);
+
+      const auto & full_points = full_scans[i].cloud.points;
+      const auto & reduced_points = reduced_scans[i].cloud.points;
+      ASSERT_EQ(full_points.size(), reduced_points.size());
+      for (size_t j = 0; j < full_points.size(); ++j) {
+        const auto & full = full_points[j];
+        const auto & reduced = reduced_points[j];
+        EXPECT_EQ(full.x, reduced.x);
+        EXPECT_EQ(full.y, reduced.y);
+        EXPECT_EQ(full.z, reduced.z);
+        EXPECT_EQ(full.intensity, reduced.intensity);
+        EXPECT_EQ(full.channel, reduced.channel);
+        EXPECT_EQ(reduced.return_type, 0);
+        EXPECT_EQ(reduced.azimuth, 0);
+        EXPECT_EQ(reduced.elevation, 0);
+        EXPECT_EQ(reduced.distance, 0);
+        EXPECT_EQ(reduced.time_stamp, 0U);
+      }
+    }
+  }
+}
+
+// Fields that are not covered by the reduced kernel select the full one
+TEST(PointFieldsTest, TestOtherFieldsDecodeAllFields)
+{
+  auto full_scans = decode_rotations(point_field::all);
+  auto scans = decode_rotations(g_xyzic_fields | point_field::time_stamp);
+  ASSERT_EQ(full_scans.size(), scans.size());
+
+  for (size_t i = 0; i < full_scans.size(); ++i) {
+    EXPECT_EQ(scans[i].fields, point_field::all);
+    ASSERT_EQ(full_scans[i].cloud.points.size(), scans[i].cloud.points.size());
+    for (size_t j = 0; j < full_scans[i].cloud.points.size(); ++j) {
+      EXPECT_EQ(full_scans[i].cloud.points[j].time_stamp, scans[i].cloud.points[j].time_stamp);
+      EXPECT_EQ(full_scans[i].cloud.points[j].distance, scans[i].cloud.points[j].distance);
+    }
+  }
+}
+
+// Scans already in progress when the fields change are reported with the fields all of their
+// points have
+TEST(PointFieldsTest, TestSwitchingFields)
+{
+  for (auto [fields, later_fields] :
+       {std::pair{point_field::all, g_xyzic_fields}, std::pair{g_xyzic_fields, point_field::all}}) {
+    auto scans = decode_rotations(fields, later_fields, 2);
+    ASSERT_GE(scans.size(), 5U);
+
+    EXPECT_EQ(scans[0].fields, fields);
+    EXPECT_EQ(scans[1].fields, fields);
+    // The scan in progress when switching to fewer fields is completed with fewer fields, a scan in
+    // progress when switching to more fields still started with fewer
+    EXPECT_EQ(scans[2].fields, g_xyzic_fields);
+    EXPECT_EQ(scans.back().fields, later_fields);
+  }
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,197 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "hesai_common.hpp"
+
+#include <nebula_common/nebula_common.hpp>
+#include <nebula_common/point_filter_configuration.hpp>
+#include <nebula_common/point_types.hpp>
+#include <nebula_decoders/nebula_decoders_common/point_filter.hpp>
+#include <nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+namespace hesai_packet = nebula::drivers::hesai_packet;
+using drivers::NebulaPoint;
+using drivers::NebulaPointCloud;
+using drivers::PointFilter;
+using drivers::PointFilterConfiguration;
+using drivers::ReturnType;
+
+TEST(PointFilterConfigurationTest, TestParse)
+{
+  auto config = drivers::point_filter_configuration_from_strings(
+    "-10, -5, -2, 10, 5, 3, 45", "1 1 -1 1 -1 -1", "0,31", "strongest, Last");
+  ASSERT_TRUE(config.has_value());
+  auto value = config.value();
+  EXPECT_EQ(value.crop_box, (std::vector<double>{-10, -5, -2, 10, 5, 3, 45}));
+  EXPECT_EQ(value.mask_polygon, (std::vector<double>{1, 1, -1, 1, -1, -1}));
+  EXPECT_EQ(value.excluded_channels, (std::vector<uint32_t>{0, 31}));
+  EXPECT_EQ(
+    value.kept_return_types, (std::vector<ReturnType>{ReturnType::STRONGEST, ReturnType::LAST}));
+
+  auto empty = drivers::point_filter_configuration_from_strings("", "", "", "");
+  ASSERT_TRUE(empty.has_value());
+  EXPECT_TRUE(empty.value().is_empty());
+}
+
+TEST(PointFilterConfigurationTest, TestParseErrors)
+{
+  auto parse = [](
+                 const std::string & crop_box, const std::string & mask_polygon,
+                 const std::string & excluded_channels, const std::string & kept_return_types) {
+    return drivers::point_filter_configuration_from_strings(
+             crop_box, mask_polygon, excluded_channels, kept_return_types)
+      .has_value();
+  };
+
+  EXPECT_FALSE(parse("1, 2, 3", "", "", ""));
+  EXPECT_FALSE(parse("0, 0, 0, 1, 1, x", "", "", ""));
+  EXPECT_FALSE(parse("1, 0, 0, 0, 1, 1", "", "", ""));
+  EXPECT_FALSE(parse("", "0, 0, 1, 1", "", ""));
+  EXPECT_FALSE(parse("", "0, 0, 1, 1, 2", "", ""));
+  EXPECT_FALSE(parse("", "", "-1", ""));
+  EXPECT_FALSE(parse("", "", "1.5", ""));
+  EXPECT_FALSE(parse("", "", "", "Strongest, Loudest"));
+}
+
+TEST(PointFilterTest, TestCropBox)
+{
+  PointFilterConfiguration config;
+  config.crop_box = {-2, -1, -0.5, 2, 1, 0.5};
+  PointFilter filter(config, 32);
+
+  EXPECT_TRUE(filter.accepts_position(0, 0, 0));
+  EXPECT_TRUE(filter.accepts_position(1.9, -0.9, 0.4));
+  EXPECT_FALSE(filter.accepts_position(2.1, 0, 0));
+  EXPECT_FALSE(filter.accepts_position(0, 1.1, 0));
+  EXPECT_FALSE(filter.accepts_position(0, 0, -0.6));
+}
+
+TEST(PointFilterTest, TestOrientedCropBox)
+{
+  // 4 m x 2 m box centered at (10, 0), rotated by 90 deg
+  PointFilterConfiguration config;
+  config.crop_box = {8, -1, -1, 12, 1, 1, 90};
+  PointFilter filter(config, 32);
+
+  EXPECT_TRUE(filter.accepts_position(10, 0, 0));
+  EXPECT_TRUE(filter.accepts_position(10, 1.9, 0));
+  EXPECT_TRUE(filter.accepts_position(10.9, 0, 0));
+  EXPECT_FALSE(filter.accepts_position(11.5, 0, 0));
+  EXPECT_FALSE(filter.accepts_position(10, 2.1, 0));
+}
+
+TEST(PointFilterTest, TestMaskPolygon)
+{
+  // Concave, L-shaped polygon
+  PointFilterConfiguration config;
+  config.mask_polygon = {0, 0, 2, 0, 2, 1, 1, 1, 1, 2, 0, 2};
+  PointFilter filter(config, 32);
+
+  EXPECT_FALSE(filter.accepts_position(0.5, 0.5, 0));
+  EXPECT_FALSE(filter.accepts_position(1.5, 0.5, 0));
+  EXPECT_FALSE(filter.accepts_position(0.5, 1.5, 100));
+  EXPECT_TRUE(filter.accepts_position(1.5, 1.5, 0));
+  EXPECT_TRUE(filter.accepts_position(-0.5, 0.5, 0));
+  EXPECT_TRUE(filter.accepts_position(3, 0.5, 0));
+}
+
+TEST(PointFilterTest, TestAttributes)
+{
+  PointFilterConfiguration config;
+  config.excluded_channels = {1, 100};
+  config.kept_return_types = {ReturnType::STRONGEST};
+  PointFilter filter(config, 32);
+
+  EXPECT_TRUE(filter.accepts_attributes(0, ReturnType::STRONGEST));
+  EXPECT_FALSE(filter.accepts_attributes(1, ReturnType::STRONGEST));
+  EXPECT_FALSE(filter.accepts_attributes(0, ReturnType::LAST));
+  EXPECT_TRUE(filter.accepts_attributes(0, ReturnType::IDENTICAL));
+
+  PointFilter pass_all(PointFilterConfiguration{}, 32);
+  EXPECT_TRUE(pass_all.accepts_attributes(1, ReturnType::LAST));
+  EXPECT_TRUE(pass_all.accepts_position(1e6, -1e6, 0));
+}
+
+std::vector<NebulaPointCloud> decode_rotations(
+  const PointFilterConfiguration & point_filter, uint16_t threads,
+  bool use_generic_return_kernel = false)
+{
+  auto config = make_synthetic_config();
+  config.return_mode = drivers::ReturnMode::DUAL_LAST_STRONGEST;
+  config.decoder_threads = threads;
+  config.use_generic_return_kernel = use_generic_return_kernel;
+  config.point_filter = point_filter;
+  return decode_synthetic_scans(config);
+}
+
+// Filtering while decoding has to yield exactly the points of the unfiltered cloud that pass the
+// filter, in the same order
+void expect_filtered_while_decoding(const PointFilterConfiguration & config, uint16_t threads)
+{
+  auto unfiltered_clouds = decode_rotations({}, 1);
+  auto filtered_clouds = decode_rotations(config, threads);
+  auto generic_clouds = decode_rotations(config, threads, true);
+  ASSERT_EQ(unfiltered_clouds.size(), filtered_clouds.size());
+  ASSERT_EQ(unfiltered_clouds.size(), generic_clouds.size());
+  ASSERT_GE(unfiltered_clouds.size(), 2U);
+
+  PointFilter filter(config, hesai_packet::PacketXT32::n_channels);
+  size_t n_removed = 0;
+  for (size_t i = 0; i < unfiltered_clouds.size(); ++i) {
+    std::vector<NebulaPoint> expected;
+    for (const auto & point : unfiltered_clouds[i].points) {
+      if (
+        filter.accepts_attributes(point.channel, static_cast<ReturnType>(point.return_type)) &&
+        filter.accepts_position(point.x, point.y, point.z)) {
+        expected.push_back(point);
+      }
+    }
+    n_removed += unfiltered_clouds[i].points.size() - expected.size();
+
+    for (const auto * cloud : {&filtered_clouds[i], &generic_clouds[i]}) {
+      ASSERT_EQ(cloud->points.size(), expected.size());
+      EXPECT_EQ(
+        std::memcmp(cloud->points.data(), expected.data(), expected.size() * sizeof(NebulaPoint)),
+        0);
+    }
+  }
+
+  // The filter has to actually remove some points for the test to be meaningful
+  EXPECT_GT(n_removed, 0U);
+}
+
+TEST(PointFilterDecoderTest, TestCropBoxAndMask)
+{
+  PointFilterConfiguration config;
+  config.crop_box = {-4, -3, -1, 5, 3, 1, 30};
+  config.mask_polygon = {1, 1, -1, 1, -1, -1, 1, -1};
+  expect_filtered_while_decoding(config, 1);
+  expect_filtered_while_decoding(config, 3);
+}
+
+TEST(PointFilterDecoderTest, TestChannelsAndReturnTypes)
+{
+  PointFilterConfiguration config;
+  config.excluded_channels = {0, 5, 31};
+  config.kept_return_types = {ReturnType::STRONGEST};
+  expect_filtered_while_decoding(config, 1);
+  expect_filtered_while_decoding(config, 3);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
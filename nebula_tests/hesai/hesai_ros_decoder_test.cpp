@@ -103,6 +103,9 @@ Status HesaiRosDecoderTest::GetParameters(
   params_.format = params_.format;
   params_.target_topic = params_.target_topic;
   sensor_configuration.dual_return_distance_threshold = params_.dual_return_distance_threshold;
+  if (params_.modify_sensor_configuration) {
+    params_.modify_sensor_configuration(sensor_configuration);
+  }
 
   if (sensor_configuration.sensor_model == nebula::drivers::SensorModel::UNKNOWN) {
     return Status::INVALID_SENSOR_MODEL;
@@ -186,7 +189,7 @@ void HesaiRosDecoderTest::read_bag(
 
       for (auto & pkt : extracted_msg_ptr->packets) {
         auto pointcloud_ts = driver_ptr_->parse_cloud_packet(
-          std::vector<uint8_t>(pkt.data.begin(), std::next(pkt.data.begin(), pkt.size)));
+          nebula::util::span<const uint8_t>(pkt.data.data(), pkt.size));
         auto pointcloud = std::get<0>(pointcloud_ts);
         auto scan_timestamp = std::get<1>(pointcloud_ts);
 
@@ -55,6 +55,8 @@ struct HesaiRosDecoderTestParams
   std::string format = "cdr";
   std::string target_topic = "/pandar_packets";
   double dual_return_distance_threshold = 0.1;
+  /// @brief If set, applied to the sensor configuration built from the parameters above
+  std::function<void(drivers::HesaiSensorConfiguration &)> modify_sensor_configuration;
 };
 
 inline std::ostream & operator<<(
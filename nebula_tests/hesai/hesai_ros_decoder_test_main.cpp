@@ -5,6 +5,7 @@
 #include "hesai_common.hpp"
 #include "hesai_ros_decoder_test.hpp"
 
+#include <nebula_decoders/nebula_decoders_common/point_cloud_pool.hpp>
 #include <pcl/impl/point_types.hpp>
 #include <rclcpp/executors/single_threaded_executor.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -125,6 +126,81 @@ TEST_P(DecoderTest, TestTimezone)
   EXPECT_EQ(decoded_timestamps.back(), decoded_timestamps_cmp.back());
 }
 
+// Compares the output of the compile-time specialized return group kernels against the generic
+// one, which has to yield exactly the same points.
+TEST_P(DecoderTest, TestGenericReturnKernel)
+{
+  expect_same_output([](auto & config) { config.use_generic_return_kernel = true; });
+}
+
+// Compares the output of the decoder using compact trig tables against the one using full tables.
+// Azimuth sin/cos differ by at most 1 ulp between the two, so the points are within a few ulp.
+TEST_P(DecoderTest, TestCompactTrigTables)
+{
+  expect_same_output([](auto & config) { config.use_compact_trig_tables = true; });
+}
+
+// Checks that decoding on multiple threads yields exactly the same pointclouds as decoding
+// sequentially
+TEST_P(DecoderTest, TestParallelDecoding)
+{
+  expect_same_output([](auto & config) { config.decoder_threads = 4; });
+}
+
+// Checks that handed out pointclouds stay intact while decoding continues, i.e. that the decoder
+// does not reuse a pointcloud before the caller has released it.
+TEST_P(DecoderTest, TestPointCloudOwnership)
+{
+  std::vector<nebula::drivers::NebulaPointCloudPtr> copied_pointclouds;
+  std::vector<nebula::drivers::NebulaPointCloudPtr> held_pointclouds;
+  hesai_driver_->read_bag([&](
+                            uint64_t /*msg_timestamp*/, uint64_t /*scan_timestamp*/,
+                            nebula::drivers::NebulaPointCloudPtr pointcloud) {
+    if (!pointcloud) return;
+    copied_pointclouds.push_back(std::make_shared<nebula::drivers::NebulaPointCloud>(*pointcloud));
+    held_pointclouds.push_back(pointcloud);
+  });
+
+  ASSERT_GT(held_pointclouds.size(), 0U);
+  ASSERT_EQ(held_pointclouds.size(), copied_pointclouds.size());
+
+  for (size_t i = 0; i < held_pointclouds.size(); ++i) {
+    for (size_t j = 0; j < i; ++j) {
+      ASSERT_NE(held_pointclouds[i], held_pointclouds[j]);
+    }
+    check_pcds(copied_pointclouds[i], held_pointclouds[i]);
+  }
+}
+
+// Checks that released pointclouds are recycled and that an exhausted pool still hands out clouds
+TEST(PointCloudPoolTest, TestRecycling)
+{
+  nebula::drivers::PointCloudPool pool(3, 100);
+  ASSERT_EQ(pool.size(), 3U);
+
+  std::vector<nebula::drivers::NebulaPointCloudPtr> clouds;
+  for (size_t i = 0; i < pool.size(); ++i) {
+    clouds.push_back(pool.acquire());
+    EXPECT_TRUE(clouds.back()->empty());
+    EXPECT_GE(clouds.back()->points.capacity(), 100U);
+    clouds.back()->push_back(nebula::drivers::NebulaPoint{});
+  }
+  EXPECT_EQ(pool.get_n_misses(), 0U);
+
+  auto extra_cloud = pool.acquire();
+  EXPECT_EQ(pool.get_n_misses(), 1U);
+  for (const auto & cloud : clouds) {
+    EXPECT_NE(extra_cloud, cloud);
+  }
+
+  auto * released_cloud = clouds[1].get();
+  clouds[1].reset();
+  auto recycled_cloud = pool.acquire();
+  EXPECT_EQ(recycled_cloud.get(), released_cloud);
+  EXPECT_TRUE(recycled_cloud->empty());
+  EXPECT_EQ(pool.get_n_misses(), 1U);
+}
+
 void DecoderTest::SetUp()
 {
   auto decoder_params = GetParam();
@@ -152,6 +228,37 @@ void DecoderTest::TearDown()
   logger_.reset();
 }
 
+void DecoderTest::expect_same_output(
+  const std::function<void(drivers::HesaiSensorConfiguration &)> & modify)
+{
+  auto read_pointclouds = [this]() {
+    std::vector<nebula::drivers::NebulaPointCloudPtr> pointclouds;
+    hesai_driver_->read_bag([&](
+                              uint64_t /*msg_timestamp*/, uint64_t /*scan_timestamp*/,
+                              nebula::drivers::NebulaPointCloudPtr pointcloud) {
+      if (!pointcloud) return;
+      // The decoder reuses its buffers, so a copy has to be kept
+      pointclouds.push_back(std::make_shared<nebula::drivers::NebulaPointCloud>(*pointcloud));
+    });
+    return pointclouds;
+  };
+
+  auto reference_pointclouds = read_pointclouds();
+  ASSERT_GT(reference_pointclouds.size(), 0U);
+
+  auto params = GetParam();
+  params.modify_sensor_configuration = modify;
+  hesai_driver_ = std::make_shared<nebula::ros::HesaiRosDecoderTest>(
+    rclcpp::NodeOptions(), "nebula_hesai_decoder_test", params);
+  ASSERT_EQ(hesai_driver_->get_status(), nebula::Status::OK);
+
+  auto pointclouds = read_pointclouds();
+  ASSERT_EQ(pointclouds.size(), reference_pointclouds.size());
+  for (size_t i = 0; i < pointclouds.size(); ++i) {
+    check_pcds(reference_pointclouds[i], pointclouds[i]);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
   TestMain, DecoderTest, testing::ValuesIn(TEST_CONFIGS),
   [](const testing::TestParamInfo<nebula::ros::HesaiRosDecoderTestParams> & p) {
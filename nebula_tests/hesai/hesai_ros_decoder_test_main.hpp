@@ -20,6 +20,7 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
 #include <memory>
 
 namespace nebula::test
@@ -33,6 +34,11 @@ protected:
   /// @brief Destroys the Hesai driver node
   void TearDown() override;
 
+  /// @brief Decodes the bag, then decodes it again with a driver whose sensor configuration is
+  /// changed by `modify`, and expects the same pointclouds
+  void expect_same_output(
+    const std::function<void(drivers::HesaiSensorConfiguration &)> & modify);
+
   std::shared_ptr<nebula::ros::HesaiRosDecoderTest> hesai_driver_;
   std::shared_ptr<rclcpp::Logger> logger_;
 };
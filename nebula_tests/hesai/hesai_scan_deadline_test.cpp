@@ -0,0 +1,115 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "hesai_common.hpp"
+
+#include <nebula_common/point_types.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace nebula::test
+{
+
+using drivers::NebulaPointCloud;
+
+struct DecodedScan
+{
+  NebulaPointCloud cloud;
+  double timestamp_s;
+  bool is_flushed;
+};
+
+/// @brief Decodes four synthetic rotations, flushing the scan in progress after the packet with
+/// index `flush_after_packet`
+std::vector<DecodedScan> decode_rotations(
+  std::optional<uint32_t> flush_after_packet, uint16_t decoder_threads = 1)
+{
+  auto config = make_synthetic_config();
+  config.decoder_threads = decoder_threads;
+  config.scan_deadline_ms = 50;
+
+  std::vector<DecodedScan> scans;
+  decode_synthetic_rotations(
+    config,
+    [&](auto & driver, uint32_t packet_id, const auto & pointcloud, double timestamp_s) {
+      if (pointcloud) {
+        scans.push_back({*pointcloud, timestamp_s, false});
+      }
+
+      if (flush_after_packet == packet_id) {
+        auto [flushed_pointcloud, flushed_timestamp_s] = driver.flush_scan();
+        EXPECT_NE(flushed_pointcloud, nullptr);
+        if (flushed_pointcloud) {
+          scans.push_back({*flushed_pointcloud, flushed_timestamp_s, true});
+        }
+      }
+    },
+    4,
+    // Nothing has been decoded yet
+    [](auto & driver) { EXPECT_EQ(std::get<0>(driver.flush_scan()), nullptr); });
+
+  return scans;
+}
+
+void expect_same_points(
+  const NebulaPointCloud & expected, size_t begin, const NebulaPointCloud & actual)
+{
+  ASSERT_LE(begin + actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    const auto & e = expected.points[begin + i];
+    const auto & a = actual.points[i];
+    EXPECT_EQ(e.x, a.x);
+    EXPECT_EQ(e.y, a.y);
+    EXPECT_EQ(e.z, a.z);
+    EXPECT_EQ(e.channel, a.channel);
+  }
+}
+
+// The points of a flushed scan and of the remainder of its rotation are those of the full scan, and
+// scans after it are not affected
+TEST(ScanDeadlineTest, TestFlushSplitsScan)
+{
+  auto reference_scans = decode_rotations(std::nullopt);
+  ASSERT_EQ(reference_scans.size(), 4U);
+
+  // The first scan ends at the first crossing of the cut angle and the second one spans the first
+  // rotation, so the third one is in progress after one and a third rotations
+  const uint32_t packets_per_rotation = synthetic_packets_per_rotation(make_synthetic_config());
+  const uint32_t flush_after_packet = packets_per_rotation + packets_per_rotation / 3;
+  for (uint16_t decoder_threads : {1, 3}) {
+    auto scans = decode_rotations(flush_after_packet, decoder_threads);
+    ASSERT_EQ(scans.size(), reference_scans.size() + 1);
+    ASSERT_TRUE(scans[2].is_flushed);
+
+    const auto & reference = reference_scans[2].cloud;
+    const auto & flushed = scans[2].cloud;
+    const auto & remainder = scans[3].cloud;
+    EXPECT_EQ(scans[2].timestamp_s, reference_scans[2].timestamp_s);
+    EXPECT_GT(flushed.size(), 0U);
+    EXPECT_LT(flushed.size(), reference.size());
+    EXPECT_EQ(flushed.size() + remainder.size(), reference.size());
+    expect_same_points(reference, 0, flushed);
+    expect_same_points(reference, flushed.size(), remainder);
+    EXPECT_GT(scans[3].timestamp_s, scans[2].timestamp_s);
+
+    for (size_t i = 3; i < reference_scans.size(); ++i) {
+      const auto & scan = scans[i + 1];
+      EXPECT_EQ(scan.timestamp_s, reference_scans[i].timestamp_s);
+      ASSERT_EQ(scan.cloud.size(), reference_scans[i].cloud.size());
+      expect_same_points(reference_scans[i].cloud, 0, scan.cloud);
+    }
+  }
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+// Copyright 2024 TIER IV, Inc.
+
+#include "hesai_common.hpp"
+
+#include <nebula_common/point_types.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace nebula::test
+{
+
+using drivers::NebulaPointCloud;
+
+struct DecodedScan
+{
+  NebulaPointCloud scan;
+  double scan_timestamp_s;
+  std::vector<std::tuple<NebulaPointCloud, double>> sectors;
+};
+
+/// @brief Decodes synthetic rotations, collecting the sectors that precede each scan
+std::vector<DecodedScan> decode_rotations(uint16_t sector_angle)
+{
+  auto config = make_synthetic_config();
+  config.sector_angle = sector_angle;
+
+  std::vector<DecodedScan> scans(1);
+  decode_synthetic_rotations(
+    config, [&](auto & driver, uint32_t, const auto & pointcloud, double timestamp_s) {
+      for (const auto & [sector, sector_timestamp_s] : driver.get_sectors()) {
+        scans.back().sectors.emplace_back(*sector, sector_timestamp_s);
+      }
+
+      if (pointcloud) {
+        scans.back().scan = *pointcloud;
+        scans.back().scan_timestamp_s = timestamp_s;
+        scans.emplace_back();
+      }
+    });
+
+  // Sectors after the last scan are not complete
+  scans.pop_back();
+  return scans;
+}
+
+TEST(SectorTest, TestNoSectorsByDefault)
+{
+  auto scans = decode_rotations(0);
+  ASSERT_GE(scans.size(), 2U);
+  for (const auto & scan : scans) {
+    EXPECT_TRUE(scan.sectors.empty());
+  }
+}
+
+// The sectors preceding a scan have to contain exactly the points of the scan, in order, with
+// timestamps that resolve to the same absolute point times
+TEST(SectorTest, TestSectorsMakeUpScan)
+{
+  auto scans = decode_rotations(30);
+  ASSERT_GE(scans.size(), 2U);
+
+  for (size_t i = 0; i < scans.size(); ++i) {
+    const auto & [scan, scan_timestamp_s, sectors] = scans[i];
+
+    // The first scan is partial
+    if (i > 0) {
+      EXPECT_EQ(sectors.size(), 12U);
+    }
+
+    size_t scan_point_id = 0;
+    double last_sector_timestamp_s = 0;
+    for (const auto & [sector, sector_timestamp_s] : sectors) {
+      ASSERT_FALSE(sector.points.empty());
+      EXPECT_GT(sector_timestamp_s, last_sector_timestamp_s);
+      last_sector_timestamp_s = sector_timestamp_s;
+
+      uint32_t min_time_ns = UINT32_MAX;
+      for (const auto & point : sector.points) {
+        ASSERT_LT(scan_point_id, scan.points.size());
+        const auto & expected = scan.points[scan_point_id++];
+        EXPECT_EQ(point.x, expected.x);
+        EXPECT_EQ(point.azimuth, expected.azimuth);
+        EXPECT_EQ(point.channel, expected.channel);
+        EXPECT_NEAR(
+          sector_timestamp_s + point.time_stamp * 1e-9,
+          scan_timestamp_s + expected.time_stamp * 1e-9, 1e-6);
+        min_time_ns = std::min(min_time_ns, point.time_stamp);
+      }
+
+      // The sector timestamp is that of its earliest point
+      EXPECT_EQ(min_time_ns, 0U);
+    }
+
+    EXPECT_EQ(scan_point_id, scan.points.size());
+  }
+}
+
+TEST(SectorTest, TestParallelMatchesSequential)
+{
+  auto config = make_synthetic_config();
+  config.sector_angle = 45;
+  expect_parallel_matches_sequential(config);
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+// Copyright 2024 TIER IV, Inc.
+
+// Measures the time per packet spent in `VelodyneDecoderWrapper::process_cloud_packets`, i.e. the
+// whole wrapper path including the driver lock, the subscription queries, packet recording,
+// serialization and publishing. Batches of one packet are what the decoder thread used to process
+// (one lock and one set of subscription queries per packet), larger batches model bursts of packets
+// that have queued up. With a narrow FoV, hardly any points are converted, which leaves the fixed
+// cost per packet.
+//
+// Usage: velodyne_decoder_wrapper_benchmark [n_repetitions]
+
+#include <nebula_common/velodyne/velodyne_common.hpp>
+#include <nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_scan_decoder.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_velodyne/velodyne_hw_interface.hpp>
+#include <nebula_ros/velodyne/decoder_wrapper.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <nebula_msgs/msg/nebula_packet.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <velodyne_msgs/msg/velodyne_scan.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nebula::test
+{
+
+using Clock = std::chrono::steady_clock;
+
+/// VLP16 at 600 rpm
+constexpr uint32_t g_packets_per_rotation = 75;
+constexpr double g_packet_period_s = 0.1 / g_packets_per_rotation;
+
+double elapsed_ms(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<nebula_msgs::msg::NebulaPacket> make_packets(size_t n_rotations)
+{
+  constexpr uint32_t azimuth_step =
+    drivers::g_rotation_max_units / (g_packets_per_rotation * drivers::g_blocks_per_packet);
+
+  drivers::raw_packet_t raw{};
+  std::vector<nebula_msgs::msg::NebulaPacket> packets;
+  for (uint32_t packet_id = 0; packet_id < n_rotations * g_packets_per_rotation; ++packet_id) {
+    uint32_t azimuth = packet_id * drivers::g_blocks_per_packet * azimuth_step;
+    for (auto & block : raw.blocks) {
+      block.header = drivers::g_upper_bank;
+      block.rotation = azimuth % drivers::g_rotation_max_units;
+      azimuth += azimuth_step;
+      for (int k = 0; k < drivers::g_block_data_size; k += drivers::g_raw_scan_size) {
+        const uint16_t distance = 500 + (packet_id + k) % 1000;
+        block.data[k] = distance & 0xff;
+        block.data[k + 1] = distance >> 8;
+        block.data[k + 2] = k % 256;
+      }
+    }
+    raw.status[2] = drivers::g_return_mode_strongest;
+
+    nebula_msgs::msg::NebulaPacket packet;
+    const double stamp_s = 1.0 + packet_id * g_packet_period_s;
+    packet.stamp.sec = static_cast<int32_t>(stamp_s);
+    packet.stamp.nanosec = static_cast<uint32_t>((stamp_s - packet.stamp.sec) * 1e9);
+    packet.data.resize(drivers::g_packet_size);
+    std::memcpy(packet.data.data(), &raw, drivers::g_packet_size);
+    packets.push_back(std::move(packet));
+  }
+
+  return packets;
+}
+
+/// @brief Pass all packets to a decoder wrapper in batches of `batch_size`, and print the best time
+/// per packet over `n_reps` repetitions. The point cloud and, if `record_packets` is set, the
+/// packet topic are subscribed to, so that the wrapper publishes like it does in operation.
+void benchmark_batch_size(
+  const std::vector<nebula_msgs::msg::NebulaPacket> & packets, uint16_t cloud_max_angle,
+  bool record_packets, size_t batch_size, int n_reps)
+{
+  auto calibration_path = std::string(_SRC_CALIBRATION_DIR_PATH) + "velodyne/VLP16.yaml";
+  rclcpp::NodeOptions options;
+  options.use_intra_process_comms(true);
+  options.parameter_overrides({{"calibration_file", calibration_path}});
+  auto node = std::make_shared<rclcpp::Node>("velodyne_decoder_wrapper_benchmark", options);
+
+  drivers::VelodyneSensorConfiguration config{};
+  config.sensor_model = drivers::SensorModel::VELODYNE_VLP16;
+  config.return_mode = drivers::ReturnMode::SINGLE_STRONGEST;
+  config.frame_id = "velodyne";
+  config.min_range = 0.3;
+  config.max_range = 300;
+  config.rotation_speed = 600;
+  config.cloud_min_angle = 0;
+  config.cloud_max_angle = cloud_max_angle;
+  auto config_ptr = std::make_shared<const drivers::VelodyneSensorConfiguration>(config);
+
+  // The packets are only recorded for sensors that are connected
+  auto hw_interface = std::make_shared<drivers::VelodyneHwInterface>();
+  ros::VelodyneDecoderWrapper decoder_wrapper(node.get(), hw_interface, config_ptr);
+
+  auto points_sub = node->create_subscription<sensor_msgs::msg::PointCloud2>(
+    "velodyne_points", rclcpp::SensorDataQoS(), [](sensor_msgs::msg::PointCloud2::UniquePtr) {});
+  rclcpp::Subscription<velodyne_msgs::msg::VelodyneScan>::SharedPtr packets_sub;
+  if (record_packets) {
+    packets_sub = node->create_subscription<velodyne_msgs::msg::VelodyneScan>(
+      "velodyne_packets", rclcpp::SensorDataQoS(),
+      [](velodyne_msgs::msg::VelodyneScan::UniquePtr) {});
+  }
+
+  std::vector<const nebula_msgs::msg::NebulaPacket *> batch;
+  double best_ms = 1e9;
+  for (int rep = 0; rep < n_reps; ++rep) {
+    auto start = Clock::now();
+    for (size_t begin = 0; begin < packets.size(); begin += batch_size) {
+      batch.clear();
+      for (size_t i = begin; i < std::min(begin + batch_size, packets.size()); ++i) {
+        batch.push_back(&packets[i]);
+      }
+      decoder_wrapper.process_cloud_packets(batch);
+    }
+    best_ms = std::min(best_ms, elapsed_ms(start));
+  }
+
+  std::printf("batches of %-4zu %8.0f ns/packet\n", batch_size, best_ms * 1e6 / packets.size());
+}
+
+}  // namespace nebula::test
+
+int main(int argc, char * argv[])
+{
+  namespace test = nebula::test;
+
+  rclcpp::init(argc, argv);
+  int n_reps = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+
+  const auto packets = test::make_packets(50);
+  for (bool record_packets : {false, true}) {
+    for (uint16_t cloud_max_angle : {360, 1}) {
+      std::printf(
+        "VLP16, %zu packets, FoV 0-%u deg, packets %srecorded\n", packets.size(),
+        static_cast<unsigned>(cloud_max_angle), record_packets ? "" : "not ");
+      for (size_t batch_size : {1, 16, 64, 128}) {
+        test::benchmark_batch_size(packets, cloud_max_angle, record_packets, batch_size, n_reps);
+      }
+      std::printf("\n");
+    }
+  }
+
+  rclcpp::shutdown();
+  return 0;
+}
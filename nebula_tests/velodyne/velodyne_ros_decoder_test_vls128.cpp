@@ -339,8 +339,7 @@ void VelodyneRosDecoderTest::read_bag()
 
         auto extracted_msg_ptr = std::make_shared<velodyne_msgs::msg::VelodyneScan>(extracted_msg);
         for (auto & pkt : extracted_msg.packets) {
-          auto pointcloud_ts = driver_ptr_->parse_cloud_packet(
-            std::vector<uint8_t>(pkt.data.begin(), pkt.data.end()), pkt.stamp.sec);
+          auto pointcloud_ts = driver_ptr_->parse_cloud_packet(pkt.data, pkt.stamp.sec);
           auto pointcloud = std::get<0>(pointcloud_ts);
 
           if (!pointcloud) {